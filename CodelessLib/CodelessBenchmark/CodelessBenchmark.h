@@ -0,0 +1,118 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Base class of the benchmarks.
+ *
+ * ## Usage ##
+ * Holds the results of a benchmark run and the measurement of the current workload. A benchmark calls
+ * {@link #startMeasurement} before each workload and {@link #addResult:} when the workload is complete,
+ * which creates the result dictionary with the common keys:
+ * <ul>
+ * <li><code>workload</code>: the workload name</li>
+ * <li><code>duration</code> (s): the wall clock time of the workload</li>
+ * <li><code>cpuTime</code> (s): user and system CPU time of the process during the workload</li>
+ * </ul>
+ * The benchmark adds its own keys to the returned dictionary. When all workloads are complete, it calls {@link #complete},
+ * which logs the results and passes them to the {@link #completion} block. Use {@link #resultsJSON} to get them
+ * in a machine-readable format, for tracking regressions.
+ * <p> The benchmarks are not part of the library. They are built by a separate target, which links the library.
+ */
+@interface CodelessBenchmark : NSObject
+
+@property (class, readonly) NSString* TAG;
+
+/// Called when all workloads are complete.
+@property (copy, nullable) void (^completion)(NSArray<NSDictionary<NSString*, id>*>* results);
+/// The results of the completed workloads.
+@property (readonly) NSArray<NSDictionary<NSString*, id>*>* results;
+/// The start time of the current workload measurement (system uptime).
+@property (readonly) NSTimeInterval startTime;
+
+/// Returns the results as a JSON array.
+- (NSString*) resultsJSON;
+
+/// Returns the user and system CPU time used by the process (seconds).
++ (double) cpuTime;
+/// Returns the current resident set size of the process (bytes, 0 if it is not available).
++ (uint64_t) residentSize;
+/// Returns the peak resident set size of the process since it started (bytes, as reported by <code>getrusage</code>).
++ (long) peakResidentSize;
+
+/// Removes the results of the previous run.
+- (void) clearResults;
+/// Starts measuring a workload: the wall clock time, the CPU time and the memory usage of the process.
+- (void) startMeasurement;
+/// Stops measuring the current workload, so that any work done before the result is added is excluded.
+- (void) stopMeasurement;
+/// Returns the wall clock time of the current workload (seconds).
+- (NSTimeInterval) elapsedTime;
+/// Returns the CPU time used by the process during the current workload (seconds).
+- (double) elapsedCpuTime;
+
+/**
+ * Creates the result dictionary of the current workload and adds it to the results.
+ * @param workload the workload name
+ * @return the result dictionary, so that workload specific keys can be added
+ */
+- (NSMutableDictionary<NSString*, id>*) addResult:(NSString*)workload;
+/**
+ * Adds a result that does not follow the workload measurement (for example, a per command breakdown).
+ * @param result the result dictionary
+ */
+- (void) addResultDictionary:(NSDictionary<NSString*, id>*)result;
+/**
+ * Adds the memory usage of the current workload to its result dictionary:
+ * <ul>
+ * <li><code>rssDelta</code> (bytes): the change of the resident set size of the process</li>
+ * <li><code>heapDelta</code> (bytes), <code>allocationsPerMB</code>: the change of the heap size in use, and the net number of heap
+ * allocations (blocks in use) per MB of data (as reported by <code>malloc_zone_statistics</code>). With glibc, the heap size
+ * is reported by <code>mallinfo2</code>, which has no block count, so <code>allocationsPerMB</code> is omitted.</li>
+ * <li><code>peakRss</code>: the peak resident set size of the process since it started</li>
+ * </ul>
+ * @param result    the result dictionary
+ * @param bytes     the number of data bytes processed by the workload
+ */
+- (void) addMemoryResult:(NSMutableDictionary<NSString*, id>*)result bytes:(uint64_t)bytes;
+/// Logs the results and calls the {@link #completion} block.
+- (void) complete;
+
+@end
+
+NS_ASSUME_NONNULL_END
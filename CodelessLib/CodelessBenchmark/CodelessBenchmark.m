@@ -0,0 +1,201 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <sys/resource.h>
+#if __has_include(<mach/mach.h>)
+#import <mach/mach.h>
+#import <malloc/malloc.h>
+#define CODELESS_BENCHMARK_MACH 1
+#else
+#import <malloc.h>
+#import <unistd.h>
+#define CODELESS_BENCHMARK_MACH 0
+#endif
+#import "CodelessBenchmark.h"
+#import "CodelessLibLog.h"
+
+/// Heap usage of the process.
+typedef struct {
+    /// <code>true</code> if the heap usage is reported by the platform.
+    BOOL available;
+    /// The heap size in use (bytes).
+    uint64_t size;
+    /// The number of heap blocks in use, or -1 if it is not reported.
+    int64_t blocks;
+} CodelessHeapStatistics;
+
+@interface CodelessBenchmark ()
+
+@property NSMutableArray<NSDictionary<NSString*, id>*>* resultList;
+@property NSTimeInterval startTime;
+@property double startCpuTime;
+@property NSTimeInterval stopTime;
+@property double stopCpuTime;
+@property BOOL stopped;
+@property uint64_t startRss;
+@property CodelessHeapStatistics startHeap;
+
+@end
+
+@implementation CodelessBenchmark
+
+static NSString* const TAG = @"CodelessBenchmark";
+
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) init {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.resultList = [NSMutableArray array];
+    return self;
+}
+
+- (NSArray<NSDictionary<NSString*, id>*>*) results {
+    return [NSArray arrayWithArray:self.resultList];
+}
+
+- (NSString*) resultsJSON {
+    NSData* json = [NSJSONSerialization dataWithJSONObject:self.resultList options:NSJSONWritingPrettyPrinted error:nil];
+    return [[NSString alloc] initWithData:json encoding:NSUTF8StringEncoding];
+}
+
++ (double) cpuTime {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
++ (uint64_t) residentSize {
+#if CODELESS_BENCHMARK_MACH
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t) &info, &count) != KERN_SUCCESS)
+        return 0;
+    return info.resident_size;
+#else
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm)
+        return 0;
+    unsigned long long size, resident;
+    int fields = fscanf(statm, "%llu %llu", &size, &resident);
+    fclose(statm);
+    return fields == 2 ? resident * (uint64_t) sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
+
++ (long) peakResidentSize {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#if __APPLE__
+    return usage.ru_maxrss;
+#else
+    // Reported in KB
+    return usage.ru_maxrss * 1024;
+#endif
+}
+
+/// Returns the heap usage of the process: the statistics of all malloc zones, or the glibc malloc statistics.
+static CodelessHeapStatistics heapStatistics(void) {
+#if CODELESS_BENCHMARK_MACH
+    malloc_statistics_t stats;
+    malloc_zone_statistics(NULL, &stats);
+    return (CodelessHeapStatistics) { true, stats.size_in_use, stats.blocks_in_use };
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 info = mallinfo2();
+    return (CodelessHeapStatistics) { true, info.uordblks + info.hblkhd, -1 };
+#else
+    return (CodelessHeapStatistics) { false, 0, -1 };
+#endif
+}
+
+- (void) clearResults {
+    [self.resultList removeAllObjects];
+}
+
+- (void) startMeasurement {
+    self.stopped = false;
+    self.startRss = CodelessBenchmark.residentSize;
+    self.startHeap = heapStatistics();
+    self.startTime = NSProcessInfo.processInfo.systemUptime;
+    self.startCpuTime = CodelessBenchmark.cpuTime;
+}
+
+- (void) stopMeasurement {
+    self.stopTime = NSProcessInfo.processInfo.systemUptime;
+    self.stopCpuTime = CodelessBenchmark.cpuTime;
+    self.stopped = true;
+}
+
+- (NSTimeInterval) elapsedTime {
+    return (self.stopped ? self.stopTime : NSProcessInfo.processInfo.systemUptime) - self.startTime;
+}
+
+- (double) elapsedCpuTime {
+    return (self.stopped ? self.stopCpuTime : CodelessBenchmark.cpuTime) - self.startCpuTime;
+}
+
+- (NSMutableDictionary<NSString*, id>*) addResult:(NSString*)workload {
+    NSMutableDictionary<NSString*, id>* result = [NSMutableDictionary dictionary];
+    result[@"workload"] = workload;
+    result[@"duration"] = @(self.elapsedTime);
+    result[@"cpuTime"] = @(self.elapsedCpuTime);
+    [self.resultList addObject:result];
+    return result;
+}
+
+- (void) addResultDictionary:(NSDictionary<NSString*, id>*)result {
+    [self.resultList addObject:result];
+}
+
+- (void) addMemoryResult:(NSMutableDictionary<NSString*, id>*)result bytes:(uint64_t)bytes {
+    CodelessHeapStatistics heap = heapStatistics();
+    result[@"rssDelta"] = @((int64_t) CodelessBenchmark.residentSize - (int64_t) self.startRss);
+    if (heap.available)
+        result[@"heapDelta"] = @((int64_t) heap.size - (int64_t) self.startHeap.size);
+    if (heap.blocks >= 0 && self.startHeap.blocks >= 0)
+        result[@"allocationsPerMB"] = @(bytes ? (heap.blocks - self.startHeap.blocks) * 1e6 / bytes : 0);
+    result[@"peakRss"] = @(CodelessBenchmark.peakResidentSize);
+}
+
+- (void) complete {
+    CodelessLog(self.class.TAG, "Results: %@", self.resultsJSON);
+    if (self.completion)
+        self.completion(self.results);
+}
+
+@end
@@ -0,0 +1,125 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessBenchmark.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Parsing and encoding throughput benchmark.
+ *
+ * ## Usage ##
+ * The benchmark runs a list of CPU bound {@link CODELESS_CODEC_BENCHMARK_WORKLOAD workloads} synchronously,
+ * without a peer device, on the calling thread. Call {@link #run} to run the workloads.
+ *
+ * For each workload, a result dictionary is generated with the following keys:
+ * <ul>
+ * <li><code>workload</code>: the workload name</li>
+ * <li><code>operations</code>, <code>bytes</code>, <code>duration</code> (s): the work done</li>
+ * <li><code>rate</code> (operations/s), <code>nsPerOperation</code>, <code>throughput</code> (MB/s)</li>
+ * <li><code>cpuTime</code> (s): user and system CPU time of the process</li>
+ * <li>workload specific keys (see the workload description)</li>
+ * </ul>
+ * The results are logged, passed to the {@link CodelessBenchmark#completion completion} block and returned.
+ * Use {@link CodelessBenchmark#resultsJSON resultsJSON} to get them in a machine-readable format, for tracking regressions.
+ *
+ * For example:
+ * <blockquote><pre>
+ * CodelessCodecBenchmark* benchmark = [[CodelessCodecBenchmark alloc] init];
+ * [benchmark run];
+ * NSLog(@@"%@", benchmark.resultsJSON);</pre></blockquote>
+ */
+@interface CodelessCodecBenchmark : CodelessBenchmark
+
+/// Benchmark workloads.
+enum CODELESS_CODEC_BENCHMARK_WORKLOAD {
+    /**
+     * Inbound command parsing for the full command set (see {@link CodelessCodecBenchmark#commandCorpus commandCorpus}).
+     * <p> Reports <code>commands</code> (the number of distinct command IDs) and <code>invalid</code> (commands that failed to parse).
+     */
+    CODELESS_CODEC_BENCHMARK_COMMAND_PARSE,
+    /// Hex encoding with {@link CodelessUtil#hex: hex}, for each of the {@link CodelessCodecBenchmark#hexSizes hexSizes}. Reports the <code>size</code>.
+    CODELESS_CODEC_BENCHMARK_HEX_ENCODE,
+    /**
+     * Hex array encoding with {@link CodelessUtil#hexArray: hexArray} (no brackets), for each of the {@link CodelessCodecBenchmark#hexSizes hexSizes}.
+     * <p> Reports the <code>size</code> and <code>valid</code> (the output length and content were checked).
+     */
+    CODELESS_CODEC_BENCHMARK_HEX_ARRAY,
+    /// Hex decoding with {@link CodelessUtil#hex2bytes: hex2bytes}, for each of the {@link CodelessCodecBenchmark#hexSizes hexSizes} (decoded size). Reports the <code>size</code>.
+    CODELESS_CODEC_BENCHMARK_HEX_DECODE,
+    /**
+     * Scan result advertising data parsing with {@link CodelessBluetoothManager#parseAdvertisingData: parseAdvertisingData},
+     * for the {@link CodelessCodecBenchmark#advCorpus advCorpus}. The <code>bytes</code> are the advertised payload bytes.
+     * <p> Reports <code>beacons</code> (the number of entries parsed as beacons) and <code>codeless</code> (CodeLess/DSPS devices).
+     */
+    CODELESS_CODEC_BENCHMARK_ADV_PARSE,
+};
+
+@property (class, readonly) NSString* TAG;
+
+/// The workloads to run (default: all).
+@property NSArray<NSNumber*>* workloads;
+/// The number of passes over the input of each workload (default: 1000).
+@property int iterations;
+/// The inbound command texts used by the command parsing workload (default: one or more per supported command).
+@property NSArray<NSString*>* commandCorpus;
+/// The data sizes used by the hex workloads (bytes, default: 1, 17, 1KB, 16KB, 256KB, 1MB).
+@property NSArray<NSNumber*>* hexSizes;
+/// The amount of data processed by the hex workloads for each size (bytes, default: 16MB). At least one operation is performed.
+@property int hexBytes;
+/// The scan result advertisement data used by the advertising data parsing workload (default: one or more per known device and beacon type).
+@property NSArray<NSDictionary<NSString*, id>*>* advCorpus;
+
+/// Returns the name of a {@link CODELESS_CODEC_BENCHMARK_WORKLOAD workload}.
++ (NSString*) workloadName:(int)workload;
+/// Returns the default command parsing corpus, which covers all the commands supported by the library.
++ (NSArray<NSString*>*) defaultCommandCorpus;
+/**
+ * Returns the default advertising data parsing corpus.
+ * <p> It covers the CodeLess/DSPS devices, the known services and all the supported beacon types. The entries include
+ * the timestamp and PHY keys that the system adds to each scan result.
+ */
++ (NSArray<NSDictionary<NSString*, id>*>*) defaultAdvCorpus;
+
+/**
+ * Runs the workloads.
+ * @return the results
+ */
+- (NSArray<NSDictionary<NSString*, id>*>*) run;
+
+@end
+
+NS_ASSUME_NONNULL_END
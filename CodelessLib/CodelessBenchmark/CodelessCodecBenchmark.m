@@ -0,0 +1,283 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessCoreBluetooth.h"
+#import "CodelessCodecBenchmark.h"
+#import "CodelessBluetoothManager.h"
+#import "CodelessProfile.h"
+#import "CodelessCommand.h"
+#import "CodelessUtil.h"
+#import "CodelessLibLog.h"
+
+@implementation CodelessCodecBenchmark
+
+static NSString* const TAG = @"CodelessCodecBenchmark";
+
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) init {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.workloads = @[ @(CODELESS_CODEC_BENCHMARK_COMMAND_PARSE), @(CODELESS_CODEC_BENCHMARK_HEX_ENCODE), @(CODELESS_CODEC_BENCHMARK_HEX_ARRAY), @(CODELESS_CODEC_BENCHMARK_HEX_DECODE),
+                        @(CODELESS_CODEC_BENCHMARK_ADV_PARSE) ];
+    self.iterations = 1000;
+    self.commandCorpus = CodelessCodecBenchmark.defaultCommandCorpus;
+    self.hexSizes = @[ @1, @17, @1024, @(16 * 1024), @(256 * 1024), @(1024 * 1024) ];
+    self.hexBytes = 16 * 1024 * 1024;
+    self.advCorpus = CodelessCodecBenchmark.defaultAdvCorpus;
+    return self;
+}
+
++ (NSString*) workloadName:(int)workload {
+    switch (workload) {
+        case CODELESS_CODEC_BENCHMARK_COMMAND_PARSE:
+            return @"commandParse";
+        case CODELESS_CODEC_BENCHMARK_HEX_ENCODE:
+            return @"hexEncode";
+        case CODELESS_CODEC_BENCHMARK_HEX_ARRAY:
+            return @"hexArray";
+        case CODELESS_CODEC_BENCHMARK_HEX_DECODE:
+            return @"hexDecode";
+        case CODELESS_CODEC_BENCHMARK_ADV_PARSE:
+            return @"advParse";
+        default:
+            return @"unknown";
+    }
+}
+
++ (NSArray<NSString*>*) defaultCommandCorpus {
+    return @[
+        @"AT", @"ATI", @"ATE", @"ATE=1", @"ATZ", @"ATR", @"ATF=1",
+        @"AT+BINREQ", @"AT+BINREQACK", @"AT+BINREQEXIT", @"AT+BINREQEXITACK", @"AT+BINRESUME", @"AT+BINESC=100,0x2B2B2B,100",
+        @"AT+TMRSTART=0,1,200", @"AT+TMRSTOP=0", @"AT+CURSOR", @"AT+RANDOM", @"AT+BATT", @"AT+BDADDR", @"AT+RSSI", @"AT+SLEEP=1",
+        @"AT+IOCFG", @"AT+IOCFG=10,4", @"AT+IOCFG=10,4,1", @"AT+IO=10", @"AT+IO=10,1", @"AT+ADC=6",
+        @"AT+I2CSCAN", @"AT+I2CCFG=1,100,1", @"AT+I2CREAD=0x50,0x10,4", @"AT+I2CWRITE=0x50,0x10,0xAB",
+        @"AT+PRINT=Hello world", @"AT+MEM=0", @"AT+MEM=1,stored text", @"AT+PIN", @"AT+PIN=123456",
+        @"AT+CMDSTORE=0,AT+IO=10,0;ATZ", @"AT+CMDPLAY=0", @"AT+CMD=0",
+        @"AT+ADVSTOP", @"AT+ADVSTART", @"AT+ADVSTART=100", @"AT+ADVDATA", @"AT+ADVDATA=02:01:06:05:09:54:65:73:74", @"AT+ADVRESP=03:19:00:00",
+        @"AT+CENTRAL", @"AT+PERIPHERAL", @"AT+BROADCASTER", @"AT+GAPSTATUS", @"AT+GAPSCAN", @"AT+GAPCONNECT=48:23:35:00:1B:52,P", @"AT+GAPDISCONNECT",
+        @"AT+CONPAR", @"AT+CONPAR=24,0,300,1", @"AT+MAXMTU", @"AT+MAXMTU=247", @"AT+DLEEN", @"AT+DLEEN=1,251,251",
+        @"AT+SPICFG", @"AT+SPICFG=1,0,8", @"AT+SPIWR=0x0123456789ABCDEF", @"AT+SPIRD=8", @"AT+SPITR=0x0123456789ABCDEF",
+        @"AT+BAUD", @"AT+BAUD=115200", @"AT+PWRLVL", @"AT+PWRLVL=3", @"AT+PWM", @"AT+PWM=1000,50,100",
+        @"AT+EVENT", @"AT+EVENT=2,1", @"AT+HNDL", @"AT+HNDL=1,AT+IO=10,1;AT+PRINT=connected",
+        @"AT+CLRBNDE=0x01", @"AT+CHGBNDP", @"AT+CHGBNDP=0x01,1", @"AT+IEBNDE=1",
+        @"AT+HRTBT", @"AT+HRTBT=1", @"AT+HOSTSLP", @"AT+HOSTSLP=1,255,100,3", @"AT+SEC", @"AT+SEC=1", @"AT+FLOWCONTROL", @"AT+FLOWCONTROL=1,5,6",
+    ];
+}
+
+/// Creates a scan result advertisement dictionary, with the keys added by the system.
+static NSDictionary<NSString*, id>* advEntry(NSDictionary<NSString*, id>* data) {
+    NSMutableDictionary<NSString*, id>* entry = [data mutableCopy];
+    entry[@"kCBAdvDataTimestamp"] = @(NSDate.date.timeIntervalSinceReferenceDate);
+    entry[@"kCBAdvDataRxPrimaryPHY"] = @1;
+    entry[@"kCBAdvDataRxSecondaryPHY"] = @0;
+    if (!entry[CBAdvertisementDataIsConnectable])
+        entry[CBAdvertisementDataIsConnectable] = @NO;
+    return entry;
+}
+
++ (NSArray<NSDictionary<NSString*, id>*>*) defaultAdvCorpus {
+    return @[
+        advEntry(@{ CBAdvertisementDataLocalNameKey : @"CodeLess", CBAdvertisementDataIsConnectable : @YES, CBAdvertisementDataTxPowerLevelKey : @0,
+                    CBAdvertisementDataServiceUUIDsKey : @[ CodelessProfile.CODELESS_SERVICE_UUID ] }),
+        advEntry(@{ CBAdvertisementDataLocalNameKey : @"DSPS", CBAdvertisementDataIsConnectable : @YES,
+                    CBAdvertisementDataServiceUUIDsKey : @[ CodelessProfile.DSPS_SERVICE_UUID ],
+                    CBAdvertisementDataManufacturerDataKey : [CodelessUtil hex2bytes:@"D2 00 01 02 03 04"] }),
+        advEntry(@{ CBAdvertisementDataLocalNameKey : @"DA14585", CBAdvertisementDataIsConnectable : @YES,
+                    CBAdvertisementDataServiceUUIDsKey : @[ CodelessProfile.SUOTA_SERVICE_UUID ],
+                    CBAdvertisementDataOverflowServiceUUIDsKey : @[ CodelessProfile.IOT_SERVICE_UUID ] }),
+        advEntry(@{ CBAdvertisementDataLocalNameKey : @"Tag", CBAdvertisementDataIsConnectable : @YES,
+                    CBAdvertisementDataServiceUUIDsKey : @[ CodelessProfile.IMMEDIATE_ALERT_SERVICE_UUID, CodelessProfile.LINK_LOSS_SERVICE_UUID ] }),
+        advEntry(@{ CBAdvertisementDataManufacturerDataKey : [CodelessUtil hex2bytes:@"4C 00 02 15 58 5C DE 93 1B 01 42 CC 9A 13 25 00 9B ED C6 5E 00 01 00 02 C5"] }),
+        advEntry(@{ CBAdvertisementDataManufacturerDataKey : [CodelessUtil hex2bytes:@"D2 00 02 15 58 5C DE 93 1B 01 42 CC 9A 13 25 00 9B ED C6 5E 00 03 00 04 C5"] }),
+        advEntry(@{ CBAdvertisementDataServiceUUIDsKey : @[ CodelessProfile.EDDYSTONE_SERVICE_UUID ],
+                    CBAdvertisementDataServiceDataKey : @{ CodelessProfile.EDDYSTONE_SERVICE_UUID : [CodelessUtil hex2bytes:@"00 EB 01 02 03 04 05 06 07 08 09 0A 11 12 13 14 15 16 00 00"] } }),
+        advEntry(@{ CBAdvertisementDataServiceUUIDsKey : @[ CodelessProfile.EDDYSTONE_SERVICE_UUID ],
+                    CBAdvertisementDataServiceDataKey : @{ CodelessProfile.EDDYSTONE_SERVICE_UUID : [CodelessUtil hex2bytes:@"10 EB 03 65 78 61 6D 70 6C 65 07"] } }),
+        advEntry(@{ CBAdvertisementDataServiceUUIDsKey : @[ CodelessProfile.EDDYSTONE_SERVICE_UUID ],
+                    CBAdvertisementDataServiceDataKey : @{ CodelessProfile.EDDYSTONE_SERVICE_UUID : [CodelessUtil hex2bytes:@"20 00 0B B8 17 00 00 00 12 34 00 00 56 78"] } }),
+        advEntry(@{ CBAdvertisementDataServiceUUIDsKey : @[ CodelessProfile.EDDYSTONE_SERVICE_UUID ],
+                    CBAdvertisementDataServiceDataKey : @{ CodelessProfile.EDDYSTONE_SERVICE_UUID : [CodelessUtil hex2bytes:@"30 EB 01 02 03 04 05 06 07 08"] } }),
+        advEntry(@{ CBAdvertisementDataManufacturerDataKey : [CodelessUtil hex2bytes:@"06 00 01 09 20 02 01 02 03 04 05 06 07 08 09 0A 0B 0C 0D 0E 0F 10 11 12 13 14 15 16 17"] }),
+        advEntry(@{ CBAdvertisementDataLocalNameKey : @"Sensor", CBAdvertisementDataIsConnectable : @YES,
+                    CBAdvertisementDataManufacturerDataKey : [CodelessUtil hex2bytes:@"FF FF 01 02 03 04"] }),
+        advEntry(@{}),
+    ];
+}
+
+- (NSArray<NSDictionary<NSString*, id>*>*) run {
+    CodelessLog(TAG, "Start: %d workloads, %d iterations", (int) self.workloads.count, self.iterations);
+    [self clearResults];
+    for (NSNumber* workload in self.workloads) {
+        CodelessLog(TAG, "Workload: %@", [CodelessCodecBenchmark workloadName:workload.intValue]);
+        switch (workload.intValue) {
+            case CODELESS_CODEC_BENCHMARK_COMMAND_PARSE:
+                [self runCommandParse];
+                break;
+            case CODELESS_CODEC_BENCHMARK_HEX_ENCODE:
+            case CODELESS_CODEC_BENCHMARK_HEX_ARRAY:
+            case CODELESS_CODEC_BENCHMARK_HEX_DECODE:
+                for (NSNumber* size in self.hexSizes)
+                    [self runHex:workload.intValue size:size.intValue];
+                break;
+            case CODELESS_CODEC_BENCHMARK_ADV_PARSE:
+                [self runAdvParse];
+                break;
+        }
+    }
+    [self complete];
+    return self.results;
+}
+
+/**
+ * Creates the result dictionary of a workload and adds it to the results.
+ * @param workload      the workload
+ * @param operations    the number of operations performed
+ * @param bytes         the number of input bytes processed
+ * @return the result dictionary, so that workload specific keys can be added
+ */
+- (NSMutableDictionary<NSString*, id>*) addResult:(int)workload operations:(uint64_t)operations bytes:(uint64_t)bytes {
+    NSMutableDictionary<NSString*, id>* result = [self addResult:[CodelessCodecBenchmark workloadName:workload]];
+    NSTimeInterval duration = [result[@"duration"] doubleValue];
+    result[@"operations"] = @(operations);
+    result[@"bytes"] = @(bytes);
+    result[@"rate"] = @(duration > 0 ? operations / duration : 0);
+    result[@"nsPerOperation"] = @(operations ? duration / operations * 1e9 : 0);
+    result[@"throughput"] = @(duration > 0 ? bytes / duration / 1e6 : 0);
+    return result;
+}
+
+/// Parses the command corpus, the same way as inbound commands are parsed.
+- (void) runCommandParse {
+    uint64_t bytes = 0;
+    NSMutableSet<NSNumber*>* commands = [NSMutableSet set];
+    int invalid = 0;
+    for (NSString* line in self.commandCorpus) {
+        bytes += line.length;
+        CodelessCommand* command = [CodelessProfile createTextCommand:line manager:nil];
+        [commands addObject:@(command.commandID)];
+        if (!command.isValid) {
+            CodelessLog(TAG, "Invalid command: %@ %@", line, command.error);
+            invalid++;
+        }
+    }
+
+    [self startMeasurement];
+    for (int i = 0; i < self.iterations; ++i) {
+        @autoreleasepool {
+            for (NSString* line in self.commandCorpus)
+                [CodelessProfile createTextCommand:line manager:nil];
+        }
+    }
+    NSMutableDictionary<NSString*, id>* result = [self addResult:CODELESS_CODEC_BENCHMARK_COMMAND_PARSE operations:(uint64_t) self.iterations * self.commandCorpus.count bytes:bytes * self.iterations];
+    result[@"commands"] = @(commands.count);
+    result[@"invalid"] = @(invalid);
+}
+
+/**
+ * Runs a hex workload.
+ * @param workload  the hex workload
+ * @param size      the binary data size
+ */
+- (void) runHex:(int)workload size:(int)size {
+    if (size <= 0)
+        return;
+    NSMutableData* data = [NSMutableData dataWithLength:size];
+    arc4random_buf(data.mutableBytes, size);
+    NSString* hex = [CodelessUtil hex:data];
+    int operations = MAX(1, self.hexBytes / size);
+    BOOL valid = true;
+    if (workload == CODELESS_CODEC_BENCHMARK_HEX_ARRAY) {
+        NSString* hexArray = [CodelessUtil hexArray:data];
+        valid = hexArray.length == size * 3 - 1 && [[hexArray stringByReplacingOccurrencesOfString:@" " withString:@""] isEqualToString:hex];
+        if (!valid)
+            CodelessLog(TAG, "Invalid hex array output: size=%d length=%d", size, (int) hexArray.length);
+    }
+
+    [self startMeasurement];
+    for (int i = 0; i < operations; ++i) {
+        @autoreleasepool {
+            switch (workload) {
+                case CODELESS_CODEC_BENCHMARK_HEX_ENCODE:
+                    [CodelessUtil hex:data];
+                    break;
+                case CODELESS_CODEC_BENCHMARK_HEX_ARRAY:
+                    [CodelessUtil hexArray:data];
+                    break;
+                case CODELESS_CODEC_BENCHMARK_HEX_DECODE:
+                    [CodelessUtil hex2bytes:hex];
+                    break;
+            }
+        }
+    }
+    NSMutableDictionary<NSString*, id>* result = [self addResult:workload operations:operations bytes:(uint64_t) operations * size];
+    result[@"size"] = @(size);
+    if (workload == CODELESS_CODEC_BENCHMARK_HEX_ARRAY)
+        result[@"valid"] = @(valid);
+}
+
+/// Parses the advertising data corpus, the same way as scan results are parsed.
+- (void) runAdvParse {
+    uint64_t bytes = 0;
+    int beacons = 0;
+    int codeless = 0;
+    for (NSDictionary<NSString*, id>* data in self.advCorpus) {
+        bytes += [data[CBAdvertisementDataManufacturerDataKey] length] + [data[CBAdvertisementDataLocalNameKey] length];
+        for (NSData* serviceData in [data[CBAdvertisementDataServiceDataKey] allValues])
+            bytes += serviceData.length;
+        bytes += 16 * ([data[CBAdvertisementDataServiceUUIDsKey] count] + [data[CBAdvertisementDataOverflowServiceUUIDsKey] count]);
+        CodelessAdvData* advData = [CodelessBluetoothManager parseAdvertisingData:data];
+        if (advData.beacon)
+            beacons++;
+        if (advData.codeless || advData.dsps)
+            codeless++;
+    }
+
+    [self startMeasurement];
+    for (int i = 0; i < self.iterations; ++i) {
+        @autoreleasepool {
+            for (NSDictionary<NSString*, id>* data in self.advCorpus)
+                [CodelessBluetoothManager parseAdvertisingData:data];
+        }
+    }
+    NSMutableDictionary<NSString*, id>* result = [self addResult:CODELESS_CODEC_BENCHMARK_ADV_PARSE operations:(uint64_t) self.iterations * self.advCorpus.count bytes:bytes * self.iterations];
+    result[@"beacons"] = @(beacons);
+    result[@"codeless"] = @(codeless);
+}
+
+@end
@@ -0,0 +1,103 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessBenchmark.h"
+
+@class CodelessBluetoothManager;
+@class CodelessManager;
+@class CodelessCommand;
+@class CodelessCommands;
+@class CodelessSimulatedPeer;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Sends a command using the command factory and returns the command object.
+typedef CodelessCommand* _Nonnull (^CodelessBenchmarkCommand)(CodelessCommands* commands);
+
+/**
+ * AT command round-trip benchmark and latency profiler.
+ *
+ * ## Usage ##
+ * The benchmark sends the {@link #commands} through a {@link CodelessManager} connected to a {@link CodelessSimulatedPeer},
+ * one at a time, for the specified number of {@link #iterations}. By default, all the {@link CodelessCommands} methods that
+ * do not change the operation mode or reset the device are used. Use the {@link CodelessSimulatedPeer#commandHandler command handler}
+ * of the {@link #peer} to script the peer responses (the default response is <code>OK</code>).
+ *
+ * When complete, the per-stage latency breakdown (see {@link CodelessManager#commandStageLatency}) is logged as a {@link #report}.
+ * The {@link CodelessBenchmark#results results} contain one dictionary per command ID, with the following keys:
+ * <ul>
+ * <li><code>command</code>, <code>id</code>: the command name and ID</li>
+ * <li><code>count</code>, <code>p50</code>, <code>p99</code> (ms): the total command latency</li>
+ * <li><code>stages</code>: the <code>mean</code>, <code>p50</code> and <code>p99</code> latency (ms) of each stage</li>
+ * </ul>
+ * The results are passed to the {@link CodelessBenchmark#completion completion} block. Use {@link CodelessBenchmark#resultsJSON resultsJSON}
+ * to get them in a machine-readable format.
+ * <p> Requires {@link CodelessLibConfig#COMMAND_STATS statistics} to be enabled.
+ */
+@interface CodelessCommandBenchmark : CodelessBenchmark
+
+@property (class, readonly) NSString* TAG;
+
+/// The simulated peer.
+@property (readonly) CodelessSimulatedPeer* peer;
+/// The manager that is benchmarked.
+@property (readonly) CodelessManager* manager;
+/// The commands to send.
+@property NSArray<CodelessBenchmarkCommand>* commands;
+/// The number of times the command list is sent (default: 20).
+@property int iterations;
+/// <code>true</code> if the benchmark is running.
+@property (readonly) BOOL running;
+
+/**
+ * Creates a benchmark.
+ * @param bluetoothManager the bluetooth manager used by the benchmarked manager
+ */
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager;
+
+/// Returns the name of a {@link CodelessCommand#CODELESS_COMMAND_STAGE command processing stage}.
++ (NSString*) stageName:(int)stage;
+
+/// Connects to the simulated peer and sends the commands.
+- (void) start;
+/// Stops the benchmark.
+- (void) stop;
+/// Returns the per-stage breakdown as text, one line per command ID.
+- (NSString*) report;
+
+@end
+
+NS_ASSUME_NONNULL_END
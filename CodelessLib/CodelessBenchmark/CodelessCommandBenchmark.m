@@ -0,0 +1,254 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessCommandBenchmark.h"
+#import "CodelessBluetoothManager.h"
+#import "CodelessManager.h"
+#import "CodelessCommands.h"
+#import "CodelessSimulatedPeer.h"
+#import "CodelessLatencyHistogram.h"
+#import "CodelessLibEvent.h"
+#import "CodelessLibLog.h"
+#import "CodelessCommand.h"
+
+/// Interval used to check if the current command is complete (seconds).
+#define CODELESS_BENCHMARK_CHECK_INTERVAL   0.001
+
+@interface CodelessCommandBenchmark ()
+
+@property CodelessSimulatedPeer* peer;
+@property CodelessManager* manager;
+@property BOOL running;
+@property int index;
+@property (nullable) CodelessCommand* command;
+@property NSMutableDictionary<NSNumber*, NSString*>* commandNames;
+
+@end
+
+@implementation CodelessCommandBenchmark
+
+static NSString* const TAG = @"CodelessCommandBenchmark";
+
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.peer = [[CodelessSimulatedPeer alloc] init];
+    self.manager = [[CodelessManager alloc] initWithBluetoothManager:bluetoothManager device:nil transport:self.peer];
+    self.iterations = 20;
+    self.commandNames = [NSMutableDictionary dictionary];
+    self.commands = @[
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c ping]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getDeviceInfo]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getBluetoothAddress]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getPeerRssi]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getBatteryLevel]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getConnectionParameters]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getMaxMtu]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c setMaxMtu:247]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getDataLength]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getAdvertisingData]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getScanResponseData]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c readIoConfig]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getPwm]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c readSpiConfig]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c spiRead:4]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c print:@"benchmark"]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c setMemContent:0 content:@"benchmark"]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getMemContent:0]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getStoredCommands:0]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getRandom]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getEventConfigTable]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getEventHandlers]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getBaudRate]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getUartEcho]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c setUartEcho:false]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c setErrorReporting:true]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getHeartbeatStatus]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c timeCursor]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getHostSleepStatus]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getPowerLevel]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getSecurityMode]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getPinCode]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getFlowControl]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getBondingDatabase:1]; },
+        ^(CodelessCommands* c) { return (CodelessCommand*) [c getBondingDatabasePersistenceStatus]; },
+    ];
+    return self;
+}
+
++ (NSString*) stageName:(int)stage {
+    switch (stage) {
+        case CODELESS_COMMAND_STAGE_CREATED:
+            return @"created";
+        case CODELESS_COMMAND_STAGE_QUEUED:
+            return @"queued";
+        case CODELESS_COMMAND_STAGE_EXECUTE:
+            return @"execute";
+        case CODELESS_COMMAND_STAGE_SENT:
+            return @"sent";
+        case CODELESS_COMMAND_STAGE_GATT_WRITE:
+            return @"gattWrite";
+        case CODELESS_COMMAND_STAGE_WRITTEN:
+            return @"written";
+        case CODELESS_COMMAND_STAGE_PENDING:
+            return @"pending";
+        case CODELESS_COMMAND_STAGE_READ:
+            return @"read";
+        case CODELESS_COMMAND_STAGE_COMPLETE:
+            return @"complete";
+        default:
+            return @"unknown";
+    }
+}
+
+- (void) start {
+    if (self.running)
+        return;
+    CodelessLog(TAG, "Start: %d commands, %d iterations", (int) self.commands.count, self.iterations);
+    self.running = true;
+    self.index = 0;
+    [self clearResults];
+    [self.manager resetCommandStats];
+    [self.manager addEventObserver:self selector:@selector(onReady:) event:CodelessLibEvent.Ready];
+    [self.manager connect];
+}
+
+- (void) stop {
+    if (!self.running)
+        return;
+    CodelessLog(TAG, "Stop");
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    [self finish];
+}
+
+- (void) finish {
+    self.running = false;
+    self.command = nil;
+    [self.manager removeEventObserver:self];
+    [self.manager disconnect];
+    CodelessLog(TAG, "Report:\n%@", self.report);
+    [self addCommandResults];
+    [self complete];
+}
+
+- (void) onReady:(CodelessEvent*)event {
+    if (self.running && !self.index)
+        [self sendNext];
+}
+
+/// Sends the next command.
+- (void) sendNext {
+    if (self.index >= self.commands.count * self.iterations) {
+        [self finish];
+        return;
+    }
+    CodelessBenchmarkCommand send = self.commands[self.index % self.commands.count];
+    self.index++;
+    self.command = send(self.manager.commandFactory);
+    self.commandNames[@(self.command.commandID)] = self.command.name;
+    [self performSelector:@selector(checkCommand) withObject:nil afterDelay:CODELESS_BENCHMARK_CHECK_INTERVAL];
+}
+
+/// Checks if the current command is complete.
+- (void) checkCommand {
+    if (!self.command.complete && self.manager.isConnected) {
+        [self performSelector:@selector(checkCommand) withObject:nil afterDelay:CODELESS_BENCHMARK_CHECK_INTERVAL];
+        return;
+    }
+    if (!self.manager.isConnected) {
+        CodelessLog(TAG, "Disconnected");
+        [self finish];
+        return;
+    }
+    [self sendNext];
+}
+
+/// Returns the stages that are measured (all except creation, which is the reference point).
+static NSRange measuredStages(void) {
+    return NSMakeRange(CODELESS_COMMAND_STAGE_CREATED + 1, CODELESS_COMMAND_STAGE_COUNT - 1);
+}
+
+- (NSString*) report {
+    NSDictionary<NSNumber*, NSArray<CodelessLatencyHistogram*>*>* stages = self.manager.commandStageLatency;
+    NSDictionary<NSNumber*, CodelessLatencyHistogram*>* total = self.manager.commandLatency;
+    NSMutableString* report = [NSMutableString stringWithString:@"command count total(p50/p99)"];
+    NSRange range = measuredStages();
+    for (int i = (int) range.location; i < NSMaxRange(range); ++i)
+        [report appendFormat:@" %@", [CodelessCommandBenchmark stageName:i]];
+    [report appendString:@" (p50, ms)"];
+    for (NSNumber* key in [stages.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        CodelessLatencyHistogram* latency = total[key];
+        [report appendFormat:@"\n%@ %lld %.3f/%.3f", self.commandNames[key] ?: key, latency.count, [latency percentile:50] * 1000, [latency percentile:99] * 1000];
+        for (int i = (int) range.location; i < NSMaxRange(range); ++i)
+            [report appendFormat:@" %.3f", [stages[key][i] percentile:50] * 1000];
+    }
+    return report;
+}
+
+/// Adds the per-stage breakdown of each command ID to the results.
+- (void) addCommandResults {
+    NSDictionary<NSNumber*, NSArray<CodelessLatencyHistogram*>*>* stages = self.manager.commandStageLatency;
+    NSDictionary<NSNumber*, CodelessLatencyHistogram*>* total = self.manager.commandLatency;
+    NSRange range = measuredStages();
+    for (NSNumber* key in [stages.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        CodelessLatencyHistogram* latency = total[key];
+        NSMutableDictionary* stageResults = [NSMutableDictionary dictionary];
+        for (int i = (int) range.location; i < NSMaxRange(range); ++i) {
+            CodelessLatencyHistogram* histogram = stages[key][i];
+            if (!histogram.count)
+                continue;
+            stageResults[[CodelessCommandBenchmark stageName:i]] = @{
+                @"mean" : @(histogram.mean * 1000),
+                @"p50" : @([histogram percentile:50] * 1000),
+                @"p99" : @([histogram percentile:99] * 1000),
+            };
+        }
+        [self addResultDictionary:@{
+            @"command" : self.commandNames[key] ?: key.stringValue,
+            @"id" : key,
+            @"count" : @(latency.count),
+            @"p50" : @([latency percentile:50] * 1000),
+            @"p99" : @([latency percentile:99] * 1000),
+            @"stages" : stageResults,
+        }];
+    }
+}
+
+@end
@@ -0,0 +1,121 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessBenchmark.h"
+
+@class CodelessBluetoothManager;
+@class CodelessManager;
+@class CodelessSimulatedPeer;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Connection event dispatch benchmark.
+ *
+ * ## Usage ##
+ * The benchmark creates {@link #count} {@link CodelessManager managers}, each one connected to its own {@link CodelessSimulatedPeer},
+ * and measures how connection events are routed to them by the {@link CodelessBluetoothManager}. The following workloads are run:
+ * <ul>
+ * <li>{@link CODELESS_DISPATCH_BENCHMARK_CONNECT connect}: all managers connect at the same time. The connection events are
+ * dispatched through the {@link CodelessBluetoothManager#managerForIdentifier: manager registry}. The workload is complete
+ * when all managers are ready.</li>
+ * <li>{@link CODELESS_DISPATCH_BENCHMARK_LOOKUP lookup}: {@link #iterations} events are routed with a registry lookup.</li>
+ * <li>{@link CODELESS_DISPATCH_BENCHMARK_BROADCAST broadcast}: {@link #iterations} events are routed with a notification,
+ * which is observed by {@link #count} observers that compare the event device, as the managers did before the registry was added.</li>
+ * <li>{@link CODELESS_DISPATCH_BENCHMARK_DISCONNECT disconnect}: all managers disconnect at the same time.</li>
+ * </ul>
+ *
+ * For each workload, a result dictionary is generated with the following keys:
+ * <ul>
+ * <li><code>workload</code>: the workload name</li>
+ * <li><code>managers</code>, <code>events</code>, <code>duration</code> (s), <code>rate</code> (events/s)</li>
+ * <li><code>nsPerEvent</code>: the routing time of each event</li>
+ * <li><code>latencyP50</code>, <code>latencyP99</code> (ms): the time until each manager is ready or disconnected (connect/disconnect only)</li>
+ * <li><code>cpuTime</code> (s): user and system CPU time of the process</li>
+ * <li><code>timeout</code>: <code>true</code> if the workload did not complete</li>
+ * </ul>
+ * The results are logged and passed to the {@link CodelessBenchmark#completion completion} block. Use {@link CodelessBenchmark#resultsJSON resultsJSON}
+ * to get them in a machine-readable format.
+ */
+@interface CodelessDispatchBenchmark : CodelessBenchmark
+
+/// Benchmark workloads.
+enum CODELESS_DISPATCH_BENCHMARK_WORKLOAD {
+    /// Connect all managers.
+    CODELESS_DISPATCH_BENCHMARK_CONNECT,
+    /// Route events with a registry lookup.
+    CODELESS_DISPATCH_BENCHMARK_LOOKUP,
+    /// Route events with a notification to all managers.
+    CODELESS_DISPATCH_BENCHMARK_BROADCAST,
+    /// Disconnect all managers.
+    CODELESS_DISPATCH_BENCHMARK_DISCONNECT,
+};
+
+@property (class, readonly) NSString* TAG;
+
+/// The simulated peers.
+@property (readonly) NSArray<CodelessSimulatedPeer*>* peers;
+/// The managers that are benchmarked.
+@property (readonly) NSArray<CodelessManager*>* managers;
+/// The number of managers.
+@property (readonly) int count;
+/// The workloads to run (default: all).
+@property NSArray<NSNumber*>* workloads;
+/// The number of routed events of the lookup and broadcast workloads (default: 100000).
+@property int iterations;
+/// The maximum duration of each workload (seconds, default: 60).
+@property NSTimeInterval timeout;
+/// <code>true</code> if the benchmark is running.
+@property (readonly) BOOL running;
+
+/**
+ * Creates a benchmark.
+ * @param bluetoothManager  the bluetooth manager used by the benchmarked managers
+ * @param count             the number of managers (for example, 100)
+ */
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager count:(int)count;
+
+/// Returns the name of a {@link CODELESS_DISPATCH_BENCHMARK_WORKLOAD workload}.
++ (NSString*) workloadName:(int)workload;
+
+/// Runs the workloads.
+- (void) start;
+/// Stops the benchmark. The results of the completed workloads are kept.
+- (void) stop;
+
+@end
+
+NS_ASSUME_NONNULL_END
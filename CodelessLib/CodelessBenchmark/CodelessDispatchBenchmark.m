@@ -0,0 +1,280 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessDispatchBenchmark.h"
+#import "CodelessBluetoothManager.h"
+#import "CodelessManager.h"
+#import "CodelessSimulatedPeer.h"
+#import "CodelessLatencyHistogram.h"
+#import "CodelessLibEvent.h"
+#import "CodelessLibLog.h"
+
+/// Notification used by the broadcast workload.
+static NSString* const BROADCAST_EVENT = @"CodelessDispatchBenchmarkBroadcast";
+
+/// Observer used by the broadcast workload. It compares the device of each event, like a manager observing connection notifications.
+@interface CodelessDispatchBenchmarkObserver : NSObject
+
+@property NSUUID* identifier;
+@property int matches;
+
+@end
+
+@implementation CodelessDispatchBenchmarkObserver
+
+- (void) onEvent:(NSNotification*)notification {
+    if ([notification.userInfo[@"identifier"] isEqual:self.identifier])
+        self.matches++;
+}
+
+@end
+
+
+@interface CodelessDispatchBenchmark ()
+
+@property CodelessBluetoothManager* bluetoothManager;
+@property NSArray<CodelessSimulatedPeer*>* peers;
+@property NSArray<CodelessManager*>* managers;
+@property int count;
+@property BOOL running;
+
+@property int index;
+@property int workload;
+@property int pending;
+@property BOOL done;
+@property CodelessLatencyHistogram* latency;
+
+@end
+
+@implementation CodelessDispatchBenchmark
+
+static NSString* const TAG = @"CodelessDispatchBenchmark";
+
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager count:(int)count {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.bluetoothManager = bluetoothManager;
+    self.count = count;
+    NSMutableArray<CodelessSimulatedPeer*>* peers = [NSMutableArray arrayWithCapacity:count];
+    NSMutableArray<CodelessManager*>* managers = [NSMutableArray arrayWithCapacity:count];
+    for (int i = 0; i < count; ++i) {
+        CodelessSimulatedPeer* peer = [[CodelessSimulatedPeer alloc] init];
+        [peers addObject:peer];
+        [managers addObject:[[CodelessManager alloc] initWithBluetoothManager:bluetoothManager device:nil transport:peer]];
+    }
+    self.peers = peers;
+    self.managers = managers;
+    self.workloads = @[ @(CODELESS_DISPATCH_BENCHMARK_CONNECT), @(CODELESS_DISPATCH_BENCHMARK_LOOKUP),
+                        @(CODELESS_DISPATCH_BENCHMARK_BROADCAST), @(CODELESS_DISPATCH_BENCHMARK_DISCONNECT) ];
+    self.iterations = 100000;
+    self.timeout = 60;
+    self.latency = [[CodelessLatencyHistogram alloc] init];
+    return self;
+}
+
++ (NSString*) workloadName:(int)workload {
+    switch (workload) {
+        case CODELESS_DISPATCH_BENCHMARK_CONNECT:
+            return @"connect";
+        case CODELESS_DISPATCH_BENCHMARK_LOOKUP:
+            return @"lookup";
+        case CODELESS_DISPATCH_BENCHMARK_BROADCAST:
+            return @"broadcast";
+        case CODELESS_DISPATCH_BENCHMARK_DISCONNECT:
+            return @"disconnect";
+        default:
+            return @"unknown";
+    }
+}
+
+- (void) start {
+    if (self.running)
+        return;
+    CodelessLog(TAG, "Start: %d workloads, %d managers", (int) self.workloads.count, self.count);
+    self.running = true;
+    self.index = 0;
+    [self clearResults];
+    for (CodelessManager* manager in self.managers) {
+        [manager addEventObserver:self selector:@selector(onReady:) event:CodelessLibEvent.Ready];
+        [manager addEventObserver:self selector:@selector(onConnection:) event:CodelessLibEvent.Connection];
+    }
+    [self runWorkload];
+}
+
+- (void) stop {
+    if (!self.running)
+        return;
+    CodelessLog(TAG, "Stop");
+    self.done = true;
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    [self finish];
+}
+
+- (void) finish {
+    self.running = false;
+    for (CodelessManager* manager in self.managers) {
+        [manager removeEventObserver:self];
+        [manager disconnect];
+    }
+    [self complete];
+}
+
+/// Starts the next workload.
+- (void) runWorkload {
+    if (self.index >= self.workloads.count) {
+        [self finish];
+        return;
+    }
+    self.workload = self.workloads[self.index].intValue;
+    CodelessLog(TAG, "Workload: %@", [CodelessDispatchBenchmark workloadName:self.workload]);
+    self.done = false;
+    [self.latency reset];
+    [self startMeasurement];
+
+    switch (self.workload) {
+        case CODELESS_DISPATCH_BENCHMARK_CONNECT:
+            self.pending = self.count;
+            [self performSelector:@selector(onTimeout) withObject:nil afterDelay:self.timeout];
+            for (CodelessManager* manager in self.managers)
+                [manager connect];
+            break;
+        case CODELESS_DISPATCH_BENCHMARK_LOOKUP:
+            [self runLookup];
+            break;
+        case CODELESS_DISPATCH_BENCHMARK_BROADCAST:
+            [self runBroadcast];
+            break;
+        case CODELESS_DISPATCH_BENCHMARK_DISCONNECT:
+            self.pending = self.count;
+            [self performSelector:@selector(onTimeout) withObject:nil afterDelay:self.timeout];
+            for (CodelessManager* manager in self.managers)
+                [manager disconnect];
+            break;
+    }
+}
+
+/// Routes the events with a registry lookup, as the {@link CodelessBluetoothManager} does.
+- (void) runLookup {
+    NSArray<NSUUID*>* identifiers = [self.peers valueForKey:@"identifier"];
+    int matches = 0;
+    for (int i = 0; i < self.iterations; ++i) {
+        int device = i % self.count;
+        if ([self.bluetoothManager managerForIdentifier:identifiers[device]] == self.managers[device])
+            matches++;
+    }
+    [self workloadComplete:matches != self.iterations];
+}
+
+/// Routes the events with a notification, which is delivered to one observer per manager.
+- (void) runBroadcast {
+    NSMutableArray<CodelessDispatchBenchmarkObserver*>* observers = [NSMutableArray arrayWithCapacity:self.count];
+    NSMutableArray<NSDictionary*>* userInfo = [NSMutableArray arrayWithCapacity:self.count];
+    for (CodelessSimulatedPeer* peer in self.peers) {
+        CodelessDispatchBenchmarkObserver* observer = [[CodelessDispatchBenchmarkObserver alloc] init];
+        observer.identifier = peer.identifier;
+        [NSNotificationCenter.defaultCenter addObserver:observer selector:@selector(onEvent:) name:BROADCAST_EVENT object:self];
+        [observers addObject:observer];
+        [userInfo addObject:@{ @"identifier" : peer.identifier }];
+    }
+    // Exclude the observer setup and removal
+    [self startMeasurement];
+    for (int i = 0; i < self.iterations; ++i)
+        [NSNotificationCenter.defaultCenter postNotificationName:BROADCAST_EVENT object:self userInfo:userInfo[i % self.count]];
+    [self stopMeasurement];
+
+    int matches = 0;
+    for (CodelessDispatchBenchmarkObserver* observer in observers) {
+        matches += observer.matches;
+        [NSNotificationCenter.defaultCenter removeObserver:observer];
+    }
+    [self workloadComplete:matches != self.iterations];
+}
+
+- (void) onReady:(CodelessEvent*)event {
+    if (!self.running || self.done || self.workload != CODELESS_DISPATCH_BENCHMARK_CONNECT)
+        return;
+    [self.latency record:NSProcessInfo.processInfo.systemUptime - self.startTime];
+    if (--self.pending == 0)
+        [self workloadComplete:false];
+}
+
+- (void) onConnection:(CodelessConnectionEvent*)event {
+    if (!self.running || self.done || self.workload != CODELESS_DISPATCH_BENCHMARK_DISCONNECT || !event.manager.isDisconnected)
+        return;
+    [self.latency record:NSProcessInfo.processInfo.systemUptime - self.startTime];
+    if (--self.pending == 0)
+        [self workloadComplete:false];
+}
+
+- (void) onTimeout {
+    CodelessLog(TAG, "Workload timeout: %@", [CodelessDispatchBenchmark workloadName:self.workload]);
+    [self workloadComplete:true];
+}
+
+/**
+ * Completes the current workload and starts the next one.
+ * @param timeout <code>true</code> if the workload did not complete normally
+ */
+- (void) workloadComplete:(BOOL)timeout {
+    if (self.done)
+        return;
+    self.done = true;
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(onTimeout) object:nil];
+
+    BOOL connection = self.workload == CODELESS_DISPATCH_BENCHMARK_CONNECT || self.workload == CODELESS_DISPATCH_BENCHMARK_DISCONNECT;
+    int events = connection ? self.count - self.pending : self.iterations;
+    NSTimeInterval duration = self.elapsedTime;
+    NSMutableDictionary<NSString*, id>* result = [self addResult:[CodelessDispatchBenchmark workloadName:self.workload]];
+    result[@"managers"] = @(self.count);
+    result[@"events"] = @(events);
+    result[@"rate"] = @(duration > 0 ? events / duration : 0);
+    result[@"nsPerEvent"] = @(events ? duration / events * 1e9 : 0);
+    if (connection) {
+        result[@"latencyP50"] = @([self.latency percentile:50] * 1000);
+        result[@"latencyP99"] = @([self.latency percentile:99] * 1000);
+    }
+    result[@"timeout"] = @(timeout);
+    CodelessLog(TAG, "Result: %@", result);
+
+    self.index++;
+    [self performSelector:@selector(runWorkload) withObject:nil afterDelay:0];
+}
+
+@end
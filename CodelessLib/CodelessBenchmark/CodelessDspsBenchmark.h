@@ -0,0 +1,143 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessBenchmark.h"
+
+@class CodelessBluetoothManager;
+@class CodelessManager;
+@class CodelessSimulatedPeer;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * DSPS throughput and latency benchmark.
+ *
+ * ## Usage ##
+ * The benchmark runs a list of DSPS {@link CODELESS_BENCHMARK_WORKLOAD workloads} through a {@link CodelessManager}
+ * connected to a {@link CodelessSimulatedPeer}, so it runs headless, without a Bluetooth device. Configure the
+ * {@link #peer} (MTU, connection interval, flow control) before calling {@link #start}. The workloads run one
+ * after the other, each one transferring {@link #size} bytes.
+ *
+ * For each workload, a result dictionary is generated with the following keys:
+ * <ul>
+ * <li><code>workload</code>: the workload name</li>
+ * <li><code>bytes</code>, <code>chunks</code>, <code>duration</code> (s), <code>throughput</code> (MB/s)</li>
+ * <li><code>cpuTime</code> (s), <code>cpuPerChunk</code> (us): user and system CPU time of the process</li>
+ * <li><code>latencyP50</code>, <code>latencyP99</code> (ms): DSPS chunk enqueue to write latency (send workloads only)</li>
+ * <li><code>rssDelta</code>, <code>heapDelta</code>, <code>allocationsPerMB</code>, <code>peakRss</code>: the memory usage of the process
+ * during the workload (see {@link CodelessBenchmark#addMemoryResult:bytes: addMemoryResult})</li>
+ * <li><code>mtu</code>, <code>chunkSize</code>, <code>rxLog</code>, <code>logMask</code>, <code>timeout</code>: the test conditions</li>
+ * <li><code>linkBytes</code>, <code>compression</code>: the bytes transferred over the link and the compressed to
+ * uncompressed size ratio (compressed workloads only). For these workloads, <code>bytes</code> and <code>throughput</code>
+ * refer to the uncompressed file data.</li>
+ * </ul>
+ * The results are logged and passed to the {@link CodelessBenchmark#completion completion} block. Use {@link CodelessBenchmark#resultsJSON resultsJSON}
+ * to get them in a machine-readable format, for tracking regressions.
+ * <p> Latency values require {@link CodelessLibConfig#DSPS_STATS statistics} to be enabled.
+ * RX logging is a build time option ({@link CodelessLibConfig#DSPS_RX_LOG}), so it is reported, not changed.
+ * The log off workloads repeat the send workloads with the {@link CodelessLogMask runtime log mask} cleared,
+ * so that the logging overhead on the TX path is the difference from the default workloads.
+ *
+ * For example:
+ * <blockquote><pre>
+ * CodelessDspsBenchmark* benchmark = [[CodelessDspsBenchmark alloc] initWithBluetoothManager:CodelessBluetoothManager.instance];
+ * benchmark.completion = ^(NSArray* results) {
+ *     NSLog(@@"%@", benchmark.resultsJSON);
+ * };
+ * [benchmark start];</pre></blockquote>
+ */
+@interface CodelessDspsBenchmark : CodelessBenchmark
+
+/// Benchmark workloads.
+enum CODELESS_BENCHMARK_WORKLOAD {
+    /// Bulk send with {@link CodelessManager#sendDspsData: sendDspsData}.
+    CODELESS_BENCHMARK_DSPS_DATA,
+    /// File send with no period.
+    CODELESS_BENCHMARK_FILE,
+    /// File send with {@link CodelessDspsBenchmark#period period}.
+    CODELESS_BENCHMARK_FILE_PERIODIC,
+    /// Pattern send with {@link CodelessDspsBenchmark#period period}.
+    CODELESS_BENCHMARK_PATTERN,
+    /// Receive (DSPS RX data events).
+    CODELESS_BENCHMARK_RX,
+    /// Receive with a {@link DspsFileReceive file receive} operation.
+    CODELESS_BENCHMARK_RX_FILE,
+    /// Compressed file send with no period (compressible data).
+    CODELESS_BENCHMARK_FILE_COMPRESSED,
+    /// Compressed file send with no period (random, incompressible data).
+    CODELESS_BENCHMARK_FILE_COMPRESSED_RANDOM,
+    /// Compressed receive with a {@link DspsFileReceive file receive} operation.
+    CODELESS_BENCHMARK_RX_FILE_COMPRESSED,
+    /// Bulk send with {@link CodelessManager#sendDspsData: sendDspsData}, with all log subsystems disabled.
+    CODELESS_BENCHMARK_DSPS_DATA_LOG_OFF,
+    /// File send with no period, with all log subsystems disabled.
+    CODELESS_BENCHMARK_FILE_LOG_OFF,
+};
+
+@property (class, readonly) NSString* TAG;
+
+/// The simulated peer.
+@property (readonly) CodelessSimulatedPeer* peer;
+/// The manager that is benchmarked.
+@property (readonly) CodelessManager* manager;
+/// The workloads to run (default: all).
+@property NSArray<NSNumber*>* workloads;
+/// The data size of each workload (bytes, default: 1MB).
+@property int size;
+/// The period of periodic workloads (ms, default: 5).
+@property int period;
+/// The maximum duration of each workload (seconds, default: 60).
+@property NSTimeInterval timeout;
+/// <code>true</code> if the benchmark is running.
+@property (readonly) BOOL running;
+
+/**
+ * Creates a benchmark.
+ * @param bluetoothManager the bluetooth manager used by the benchmarked manager
+ */
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager;
+
+/// Returns the name of a {@link CODELESS_BENCHMARK_WORKLOAD workload}.
++ (NSString*) workloadName:(int)workload;
+
+/// Connects to the simulated peer, enters binary mode and runs the workloads.
+- (void) start;
+/// Stops the benchmark. The results of the completed workloads are kept.
+- (void) stop;
+
+@end
+
+NS_ASSUME_NONNULL_END
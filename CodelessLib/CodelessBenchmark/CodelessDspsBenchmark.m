@@ -0,0 +1,344 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessDspsBenchmark.h"
+#import "CodelessBluetoothManager.h"
+#import "CodelessManager.h"
+#import "CodelessSimulatedPeer.h"
+#import "CodelessLatencyHistogram.h"
+#import "CodelessLibConfig.h"
+#import "CodelessLibEvent.h"
+#import "CodelessLibLog.h"
+#import "DspsFileSend.h"
+#import "DspsPeriodicSend.h"
+#import "DspsFileReceive.h"
+
+/// Interval used to check if the current workload is complete (seconds).
+#define CODELESS_BENCHMARK_CHECK_INTERVAL   0.01
+
+@interface CodelessDspsBenchmark ()
+
+@property CodelessSimulatedPeer* peer;
+@property CodelessManager* manager;
+@property BOOL running;
+
+@property NSData* data;
+@property NSString* file;
+@property NSString* randomFile;
+@property int64_t linkSize;
+@property int index;
+@property int workload;
+@property uint64_t peerRxStart;
+@property uint64_t rxBytes;
+@property uint32_t logMask;
+@property BOOL logOff;
+@property (nullable) DspsFileSend* fileSend;
+@property (nullable) DspsPeriodicSend* periodicSend;
+@property (nullable) DspsFileReceive* fileReceive;
+
+@end
+
+@implementation CodelessDspsBenchmark
+
+static NSString* const TAG = @"CodelessDspsBenchmark";
+
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.peer = [[CodelessSimulatedPeer alloc] init];
+    self.manager = [[CodelessManager alloc] initWithBluetoothManager:bluetoothManager device:nil transport:self.peer];
+    self.workloads = @[ @(CODELESS_BENCHMARK_DSPS_DATA), @(CODELESS_BENCHMARK_FILE), @(CODELESS_BENCHMARK_FILE_PERIODIC),
+                        @(CODELESS_BENCHMARK_PATTERN), @(CODELESS_BENCHMARK_RX), @(CODELESS_BENCHMARK_RX_FILE),
+                        @(CODELESS_BENCHMARK_FILE_COMPRESSED), @(CODELESS_BENCHMARK_FILE_COMPRESSED_RANDOM), @(CODELESS_BENCHMARK_RX_FILE_COMPRESSED),
+                        @(CODELESS_BENCHMARK_DSPS_DATA_LOG_OFF), @(CODELESS_BENCHMARK_FILE_LOG_OFF) ];
+    self.size = 1024 * 1024;
+    self.period = 5;
+    self.timeout = 60;
+    return self;
+}
+
++ (NSString*) workloadName:(int)workload {
+    switch (workload) {
+        case CODELESS_BENCHMARK_DSPS_DATA:
+            return @"dspsData";
+        case CODELESS_BENCHMARK_FILE:
+            return @"file";
+        case CODELESS_BENCHMARK_FILE_PERIODIC:
+            return @"filePeriodic";
+        case CODELESS_BENCHMARK_PATTERN:
+            return @"pattern";
+        case CODELESS_BENCHMARK_RX:
+            return @"rx";
+        case CODELESS_BENCHMARK_RX_FILE:
+            return @"rxFile";
+        case CODELESS_BENCHMARK_FILE_COMPRESSED:
+            return @"fileCompressed";
+        case CODELESS_BENCHMARK_FILE_COMPRESSED_RANDOM:
+            return @"fileCompressedRandom";
+        case CODELESS_BENCHMARK_RX_FILE_COMPRESSED:
+            return @"rxFileCompressed";
+        case CODELESS_BENCHMARK_DSPS_DATA_LOG_OFF:
+            return @"dspsDataLogOff";
+        case CODELESS_BENCHMARK_FILE_LOG_OFF:
+            return @"fileLogOff";
+        default:
+            return @"unknown";
+    }
+}
+
+- (void) start {
+    if (self.running)
+        return;
+    CodelessLog(TAG, "Start: %d workloads, %d bytes", (int) self.workloads.count, self.size);
+    self.running = true;
+    self.index = 0;
+    [self clearResults];
+
+    // Printable data, so that the file receive header detection works
+    NSMutableData* data = [NSMutableData dataWithLength:self.size];
+    uint8_t* bytes = data.mutableBytes;
+    for (int i = 0; i < self.size; ++i)
+        bytes[i] = 'A' + i % 26;
+    self.data = data;
+    self.file = [NSTemporaryDirectory() stringByAppendingPathComponent:@"codeless_benchmark.bin"];
+    [data writeToFile:self.file atomically:false];
+
+    // Random data, as a worst case for compression
+    self.randomFile = [NSTemporaryDirectory() stringByAppendingPathComponent:@"codeless_benchmark_random.bin"];
+    if ([self.workloads containsObject:@(CODELESS_BENCHMARK_FILE_COMPRESSED_RANDOM)]) {
+        NSMutableData* random = [NSMutableData dataWithLength:self.size];
+        arc4random_buf(random.mutableBytes, random.length);
+        [random writeToFile:self.randomFile atomically:false];
+    }
+
+    [self.manager addEventObserver:self selector:@selector(onReady:) event:CodelessLibEvent.Ready];
+    [self.manager addEventObserver:self selector:@selector(onMode:) event:CodelessLibEvent.Mode];
+    [self.manager addEventObserver:self selector:@selector(onDspsRxData:) event:CodelessLibEvent.DspsRxData];
+    [self.manager connect];
+}
+
+- (void) stop {
+    if (!self.running)
+        return;
+    CodelessLog(TAG, "Stop");
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    [self stopWorkload];
+    [self finish];
+}
+
+- (void) finish {
+    self.running = false;
+    [self.manager removeEventObserver:self];
+    [self.manager disconnect];
+    [NSFileManager.defaultManager removeItemAtPath:self.file error:nil];
+    [NSFileManager.defaultManager removeItemAtPath:self.randomFile error:nil];
+    self.data = nil;
+    [self complete];
+}
+
+- (void) onReady:(CodelessEvent*)event {
+    [self.manager sendTextCommand:@"AT+BINREQ"];
+}
+
+- (void) onMode:(CodelessModeEvent*)event {
+    if (!event.command && self.running && !self.index)
+        [self runWorkload];
+}
+
+- (void) onDspsRxData:(DspsRxDataEvent*)event {
+    self.rxBytes += event.data.length;
+}
+
+/// Starts the next workload.
+- (void) runWorkload {
+    if (self.index >= self.workloads.count) {
+        [self finish];
+        return;
+    }
+    self.workload = self.workloads[self.index].intValue;
+    CodelessLog(TAG, "Workload: %@", [CodelessDspsBenchmark workloadName:self.workload]);
+    self.peerRxStart = self.peer.dspsRxBytes;
+    self.rxBytes = 0;
+    self.linkSize = 0;
+    [self.manager resetDspsTxLatency];
+    self.logMask = CodelessLogMask;
+    self.logOff = self.workload == CODELESS_BENCHMARK_DSPS_DATA_LOG_OFF || self.workload == CODELESS_BENCHMARK_FILE_LOG_OFF;
+    if (self.logOff)
+        CodelessLogSetMask(0);
+    [self startMeasurement];
+
+    switch (self.workload) {
+        case CODELESS_BENCHMARK_DSPS_DATA:
+        case CODELESS_BENCHMARK_DSPS_DATA_LOG_OFF:
+            [self.manager sendDspsData:self.data];
+            break;
+        case CODELESS_BENCHMARK_FILE:
+        case CODELESS_BENCHMARK_FILE_LOG_OFF:
+            self.fileSend = [self.manager sendFile:self.file period:0];
+            break;
+        case CODELESS_BENCHMARK_FILE_PERIODIC:
+            self.fileSend = [self.manager sendFile:self.file period:self.period];
+            break;
+        case CODELESS_BENCHMARK_PATTERN:
+            self.periodicSend = [self.manager sendPattern:self.file period:self.period];
+            break;
+        case CODELESS_BENCHMARK_RX:
+            [self.peer sendDspsData:self.data];
+            break;
+        case CODELESS_BENCHMARK_RX_FILE: {
+            self.fileReceive = [self.manager receiveFile];
+            NSString* header = [NSString stringWithFormat:@"Name: codeless_benchmark.bin\nSize: %d\n", self.size];
+            NSMutableData* data = [[header dataUsingEncoding:NSASCIIStringEncoding] mutableCopy];
+            [data appendBytes:"\0" length:1];
+            [self.peer sendDspsData:data];
+            [self.peer sendDspsData:self.data];
+            break;
+        }
+        case CODELESS_BENCHMARK_FILE_COMPRESSED:
+        case CODELESS_BENCHMARK_FILE_COMPRESSED_RANDOM: {
+            NSString* file = self.workload == CODELESS_BENCHMARK_FILE_COMPRESSED ? self.file : self.randomFile;
+            self.fileSend = [self.manager sendFile:file chunkSize:self.manager.dspsChunkSize period:0 compressed:true];
+            self.linkSize = self.fileSend.transferSize;
+            break;
+        }
+        case CODELESS_BENCHMARK_RX_FILE_COMPRESSED: {
+            self.fileReceive = [self.manager receiveFile];
+            NSData* data = [DspsFileSend compressedTransferData:self.data name:@"codeless_benchmark.bin"];
+            self.linkSize = data.length;
+            if (data)
+                [self.peer sendDspsData:data];
+            break;
+        }
+    }
+    [self performSelector:@selector(checkWorkload) withObject:nil afterDelay:CODELESS_BENCHMARK_CHECK_INTERVAL];
+}
+
+/// Checks if the current workload is complete.
+- (void) checkWorkload {
+    BOOL complete;
+    switch (self.workload) {
+        case CODELESS_BENCHMARK_RX:
+            complete = self.rxBytes >= self.size;
+            break;
+        case CODELESS_BENCHMARK_RX_FILE:
+        case CODELESS_BENCHMARK_RX_FILE_COMPRESSED:
+            complete = self.fileReceive.complete;
+            break;
+        case CODELESS_BENCHMARK_FILE_COMPRESSED:
+        case CODELESS_BENCHMARK_FILE_COMPRESSED_RANDOM:
+            complete = self.peer.dspsRxBytes - self.peerRxStart >= self.linkSize;
+            break;
+        default:
+            complete = self.peer.dspsRxBytes - self.peerRxStart >= self.size;
+            break;
+    }
+    BOOL timeout = NSProcessInfo.processInfo.systemUptime - self.startTime > self.timeout;
+    if (!complete && !timeout) {
+        [self performSelector:@selector(checkWorkload) withObject:nil afterDelay:CODELESS_BENCHMARK_CHECK_INTERVAL];
+        return;
+    }
+
+    [self addWorkloadResult:timeout];
+    [self stopWorkload];
+    self.index++;
+    [self runWorkload];
+}
+
+/// Stops any operations started by the current workload.
+- (void) stopWorkload {
+    if (self.fileSend)
+        [self.manager stopFile:self.fileSend];
+    if (self.periodicSend)
+        [self.manager stopPeriodic:self.periodicSend];
+    if (self.fileReceive)
+        [self.manager stopFileReceive:self.fileReceive];
+    self.fileSend = nil;
+    self.periodicSend = nil;
+    self.fileReceive = nil;
+    if (self.logOff)
+        CodelessLogSetMask(self.logMask);
+    self.logOff = false;
+}
+
+/// Creates the result dictionary of the current workload and adds it to the results.
+- (void) addWorkloadResult:(BOOL)timeout {
+    [self stopMeasurement];
+    NSTimeInterval duration = self.elapsedTime;
+    double cpu = self.elapsedCpuTime;
+    BOOL rx = self.workload == CODELESS_BENCHMARK_RX || self.workload == CODELESS_BENCHMARK_RX_FILE || self.workload == CODELESS_BENCHMARK_RX_FILE_COMPRESSED;
+    BOOL compressed = self.workload == CODELESS_BENCHMARK_FILE_COMPRESSED || self.workload == CODELESS_BENCHMARK_FILE_COMPRESSED_RANDOM || self.workload == CODELESS_BENCHMARK_RX_FILE_COMPRESSED;
+    uint64_t bytes = rx ? (self.workload == CODELESS_BENCHMARK_RX ? self.rxBytes : self.fileReceive.bytesReceived) : self.peer.dspsRxBytes - self.peerRxStart;
+    uint64_t linkBytes = bytes;
+    if (compressed) {
+        // Report the uncompressed file bytes, estimated from the link progress for incomplete sends
+        if (rx) {
+            linkBytes = self.size > 0 ? (uint64_t) self.linkSize * bytes / self.size : 0;
+        } else {
+            linkBytes = MIN(bytes, (uint64_t) self.linkSize);
+            bytes = self.linkSize > 0 ? (uint64_t) self.size * linkBytes / self.linkSize : 0;
+        }
+    }
+    int chunkSize = rx ? self.peer.mtu - 3 : self.manager.dspsChunkSize;
+    uint64_t chunks = chunkSize > 0 ? (linkBytes + chunkSize - 1) / chunkSize : 0;
+
+    NSMutableDictionary<NSString*, id>* result = [self addResult:[CodelessDspsBenchmark workloadName:self.workload]];
+    result[@"bytes"] = @(bytes);
+    result[@"chunks"] = @(chunks);
+    result[@"throughput"] = @(duration > 0 ? bytes / duration / 1e6 : 0);
+    result[@"cpuPerChunk"] = @(chunks ? cpu / chunks * 1e6 : 0);
+    if (compressed) {
+        result[@"linkBytes"] = @(linkBytes);
+        result[@"compression"] = @(self.size > 0 ? (double) self.linkSize / self.size : 0);
+    }
+    if (!rx) {
+        CodelessLatencyHistogram* latency = self.manager.dspsTxLatency;
+        result[@"latencyP50"] = @([latency percentile:50] * 1000);
+        result[@"latencyP99"] = @([latency percentile:99] * 1000);
+    }
+    [self addMemoryResult:result bytes:bytes];
+    result[@"mtu"] = @(self.peer.mtu);
+    result[@"chunkSize"] = @(chunkSize);
+    result[@"rxLog"] = @(CodelessLibConfig.DSPS_RX_LOG);
+    result[@"logMask"] = @(CodelessLogMask);
+    result[@"timeout"] = @(timeout);
+    CodelessLog(TAG, "Result: %@", result);
+}
+
+@end
@@ -0,0 +1,125 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessBenchmark.h"
+
+@class CodelessBluetoothManager;
+@class CodelessConnectionPool;
+@class CodelessSimulatedPeer;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Connection pool scenario benchmark.
+ *
+ * ## Usage ##
+ * The benchmark queues {@link #tasksPerDevice} AT commands to each one of {@link #deviceCount} {@link CodelessSimulatedPeer simulated peers},
+ * through a {@link CodelessConnectionPool} with {@link #maxConnections} connection slots. The device managers are created
+ * with the pool's {@link CodelessConnectionPool#managerFactory manager factory}. There are more devices than slots, so the
+ * scenario exercises the slot scheduling and the LRU eviction of idle connections. Two workloads are run, each one with a new pool:
+ * <ul>
+ * <li>{@link CODELESS_POOL_BENCHMARK_SCHEDULE schedule}: all devices respond.</li>
+ * <li>{@link CODELESS_POOL_BENCHMARK_RETRY retry}: the first device ignores its first connection attempt, so that the pool
+ * retries after the {@link #connectTimeout connection timeout}. The last device ignores all connection attempts, so that
+ * the pool gives up after {@link #connectRetries} retries, drops its tasks and generates a
+ * {@link CodelessLibEvent#PoolConnectionFailed PoolConnectionFailed} event.</li>
+ * </ul>
+ * A workload is complete when all its tasks are complete or dropped.
+ *
+ * For each workload, a result dictionary is generated with the following keys:
+ * <ul>
+ * <li><code>workload</code>: the workload name</li>
+ * <li><code>devices</code>, <code>maxConnections</code>, <code>tasks</code>, <code>connectTimeout</code>, <code>connectRetries</code>: the test conditions</li>
+ * <li><code>tasksCompleted</code>, <code>tasksFailed</code>, <code>connections</code>, <code>evictions</code>, <code>connectFailures</code>:
+ * the {@link CodelessConnectionPool pool} statistics</li>
+ * <li><code>poolConnectionFailed</code>: the number of {@link CodelessLibEvent#PoolConnectionFailed PoolConnectionFailed} events</li>
+ * <li><code>duration</code> (s), <code>taskRate</code> (tasks/s), <code>cpuTime</code> (s)</li>
+ * <li><code>connectLatencyP50</code>, <code>connectLatencyP99</code>, <code>taskLatencyP50</code>, <code>taskLatencyP99</code> (ms)</li>
+ * <li><code>timeout</code>: <code>true</code> if the workload did not complete</li>
+ * </ul>
+ * The results are logged and passed to the {@link CodelessBenchmark#completion completion} block. Use {@link CodelessBenchmark#resultsJSON resultsJSON}
+ * to get them in a machine-readable format.
+ */
+@interface CodelessPoolBenchmark : CodelessBenchmark
+
+/// Benchmark workloads.
+enum CODELESS_POOL_BENCHMARK_WORKLOAD {
+    /// All devices respond.
+    CODELESS_POOL_BENCHMARK_SCHEDULE,
+    /// One device needs a retry and one device never connects.
+    CODELESS_POOL_BENCHMARK_RETRY,
+};
+
+@property (class, readonly) NSString* TAG;
+
+/// The pool of the current workload.
+@property (readonly, nullable) CodelessConnectionPool* pool;
+/// The simulated peers of the current workload.
+@property (readonly) NSArray<CodelessSimulatedPeer*>* peers;
+/// The workloads to run (default: all).
+@property NSArray<NSNumber*>* workloads;
+/// The number of devices (default: 8).
+@property int deviceCount;
+/// The number of connection slots of the pool (default: 2).
+@property int maxConnections;
+/// The number of commands queued to each device (default: 4).
+@property int tasksPerDevice;
+/// The connection timeout of the pool (ms, default: 1000).
+@property int connectTimeout;
+/// The connection retries of the pool (default: 1).
+@property int connectRetries;
+/// The maximum duration of each workload (seconds, default: 60).
+@property NSTimeInterval timeout;
+/// <code>true</code> if the benchmark is running.
+@property (readonly) BOOL running;
+
+/**
+ * Creates a benchmark.
+ * @param bluetoothManager the bluetooth manager used by the pool
+ */
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager;
+
+/// Returns the name of a {@link CODELESS_POOL_BENCHMARK_WORKLOAD workload}.
++ (NSString*) workloadName:(int)workload;
+
+/// Runs the workloads.
+- (void) start;
+/// Stops the benchmark. The results of the completed workloads are kept.
+- (void) stop;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,211 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessPoolBenchmark.h"
+#import "CodelessBluetoothManager.h"
+#import "CodelessConnectionPool.h"
+#import "CodelessManager.h"
+#import "CodelessSimulatedPeer.h"
+#import "CodelessLatencyHistogram.h"
+#import "CodelessLibEvent.h"
+#import "CodelessLibLog.h"
+
+/// Interval used to check if the current workload is complete (seconds).
+#define CODELESS_POOL_BENCHMARK_CHECK_INTERVAL   0.01
+
+@interface CodelessPoolBenchmark ()
+
+@property CodelessBluetoothManager* bluetoothManager;
+@property (nullable) CodelessConnectionPool* pool;
+@property NSArray<CodelessSimulatedPeer*>* peers;
+@property BOOL running;
+
+@property int index;
+@property int workload;
+@property int tasks;
+@property int poolConnectionFailed;
+
+@end
+
+@implementation CodelessPoolBenchmark
+
+static NSString* const TAG = @"CodelessPoolBenchmark";
+
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.bluetoothManager = bluetoothManager;
+    self.peers = @[];
+    self.workloads = @[ @(CODELESS_POOL_BENCHMARK_SCHEDULE), @(CODELESS_POOL_BENCHMARK_RETRY) ];
+    self.deviceCount = 8;
+    self.maxConnections = 2;
+    self.tasksPerDevice = 4;
+    self.connectTimeout = 1000;
+    self.connectRetries = 1;
+    self.timeout = 60;
+    return self;
+}
+
++ (NSString*) workloadName:(int)workload {
+    switch (workload) {
+        case CODELESS_POOL_BENCHMARK_SCHEDULE:
+            return @"schedule";
+        case CODELESS_POOL_BENCHMARK_RETRY:
+            return @"retry";
+        default:
+            return @"unknown";
+    }
+}
+
+- (void) start {
+    if (self.running)
+        return;
+    CodelessLog(TAG, "Start: %d workloads, %d devices, %d slots", (int) self.workloads.count, self.deviceCount, self.maxConnections);
+    self.running = true;
+    self.index = 0;
+    [self clearResults];
+    [self runWorkload];
+}
+
+- (void) stop {
+    if (!self.running)
+        return;
+    CodelessLog(TAG, "Stop");
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    [self closePool];
+    [self finish];
+}
+
+- (void) finish {
+    self.running = false;
+    [self complete];
+}
+
+/// Closes the pool of the current workload, which disconnects all devices.
+- (void) closePool {
+    for (CodelessSimulatedPeer* peer in self.peers) {
+        CodelessManager* manager = [self.pool managerForDevice:peer];
+        [manager removeEventObserver:self];
+    }
+    [self.pool close];
+    self.pool = nil;
+}
+
+/// Starts the next workload, with a new pool and new peers.
+- (void) runWorkload {
+    if (self.index >= self.workloads.count) {
+        [self finish];
+        return;
+    }
+    self.workload = self.workloads[self.index].intValue;
+    CodelessLog(TAG, "Workload: %@", [CodelessPoolBenchmark workloadName:self.workload]);
+
+    NSMutableArray<CodelessSimulatedPeer*>* peers = [NSMutableArray arrayWithCapacity:self.deviceCount];
+    for (int i = 0; i < self.deviceCount; ++i)
+        [peers addObject:[[CodelessSimulatedPeer alloc] init]];
+    if (self.workload == CODELESS_POOL_BENCHMARK_RETRY && peers.count >= 2) {
+        peers.firstObject.ignoredConnections = 1;
+        peers.lastObject.ignoredConnections = -1;
+    }
+    self.peers = peers;
+
+    self.pool = [[CodelessConnectionPool alloc] initWithBluetoothManager:self.bluetoothManager maxConnections:self.maxConnections];
+    self.pool.connectTimeout = self.connectTimeout;
+    self.pool.connectRetries = self.connectRetries;
+    __weak CodelessPoolBenchmark* weakSelf = self;
+    CodelessBluetoothManager* bluetoothManager = self.bluetoothManager;
+    self.pool.managerFactory = ^CodelessManager*(id<CodelessTransport> device) {
+        CodelessManager* manager = [[CodelessManager alloc] initWithBluetoothManager:bluetoothManager device:nil transport:device];
+        [manager addEventObserver:weakSelf selector:@selector(onPoolConnectionFailed:) event:CodelessLibEvent.PoolConnectionFailed];
+        return manager;
+    };
+
+    self.tasks = self.deviceCount * self.tasksPerDevice;
+    self.poolConnectionFailed = 0;
+    [self startMeasurement];
+    // Interleave the devices, so that the slots are shared from the start
+    for (int i = 0; i < self.tasksPerDevice; ++i) {
+        for (CodelessSimulatedPeer* peer in self.peers)
+            [self.pool sendTextCommand:@"AT" device:peer];
+    }
+    [self performSelector:@selector(checkWorkload) withObject:nil afterDelay:CODELESS_POOL_BENCHMARK_CHECK_INTERVAL];
+}
+
+- (void) onPoolConnectionFailed:(CodelessPoolConnectionFailedEvent*)event {
+    self.poolConnectionFailed++;
+}
+
+/// Checks if the current workload is complete.
+- (void) checkWorkload {
+    BOOL complete = self.pool.tasksCompleted + self.pool.tasksFailed >= self.tasks;
+    BOOL timeout = NSProcessInfo.processInfo.systemUptime - self.startTime > self.timeout;
+    if (!complete && !timeout) {
+        [self performSelector:@selector(checkWorkload) withObject:nil afterDelay:CODELESS_POOL_BENCHMARK_CHECK_INTERVAL];
+        return;
+    }
+
+    NSTimeInterval duration = self.elapsedTime;
+    CodelessConnectionPool* pool = self.pool;
+    NSMutableDictionary<NSString*, id>* result = [self addResult:[CodelessPoolBenchmark workloadName:self.workload]];
+    result[@"devices"] = @(self.deviceCount);
+    result[@"maxConnections"] = @(pool.maxConnections);
+    result[@"tasks"] = @(self.tasks);
+    result[@"connectTimeout"] = @(pool.connectTimeout);
+    result[@"connectRetries"] = @(pool.connectRetries);
+    result[@"tasksCompleted"] = @(pool.tasksCompleted);
+    result[@"tasksFailed"] = @(pool.tasksFailed);
+    result[@"connections"] = @(pool.connections);
+    result[@"evictions"] = @(pool.evictions);
+    result[@"connectFailures"] = @(pool.connectFailures);
+    result[@"poolConnectionFailed"] = @(self.poolConnectionFailed);
+    result[@"taskRate"] = @(duration > 0 ? (pool.tasksCompleted + pool.tasksFailed) / duration : 0);
+    result[@"connectLatencyP50"] = @([pool.connectLatency percentile:50] * 1000);
+    result[@"connectLatencyP99"] = @([pool.connectLatency percentile:99] * 1000);
+    result[@"taskLatencyP50"] = @([pool.taskLatency percentile:50] * 1000);
+    result[@"taskLatencyP99"] = @([pool.taskLatency percentile:99] * 1000);
+    result[@"timeout"] = @(timeout);
+    CodelessLog(TAG, "Result: %@", result);
+
+    [self closePool];
+    self.index++;
+    [self runWorkload];
+}
+
+@end
@@ -0,0 +1,111 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessBenchmark.h"
+
+@class CodelessBluetoothManager;
+@class CodelessManager;
+@class CodelessSimulatedPeer;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Script polling loop benchmark.
+ *
+ * ## Usage ##
+ * The benchmark polls an input pin of a {@link CodelessSimulatedPeer} with <code>AT+IO</code>, until the pin goes high.
+ * The {@link #peer} reports the pin low for the first {@link #iterations} polls of each workload. Two workloads are run:
+ * <ul>
+ * <li>{@link CODELESS_SCRIPT_BENCHMARK_SCRIPT script}: the loop runs inside the library, as a {@link CodelessScript} with
+ * <code>@LOOP</code> ... <code>@UNTIL</code> control statements.</li>
+ * <li>{@link CODELESS_SCRIPT_BENCHMARK_EVENTS events}: the loop runs in app code, which checks the response of each command
+ * in the {@link CodelessLibEvent#CommandSuccess CommandSuccess} event and sends the next one.</li>
+ * </ul>
+ * Configure the {@link #peer} (for example, its connection interval) before calling {@link #start}.
+ *
+ * For each workload, a result dictionary is generated with the following keys:
+ * <ul>
+ * <li><code>workload</code>: the workload name</li>
+ * <li><code>iterations</code>, <code>duration</code> (s), <code>rate</code> (polls/s)</li>
+ * <li><code>latencyP50</code>, <code>latencyP99</code> (ms): the time between consecutive polls, as seen by the peer</li>
+ * <li><code>cpuTime</code> (s), <code>cpuPerIteration</code> (us): user and system CPU time of the process</li>
+ * <li><code>connectionInterval</code>, <code>timeout</code>: the test conditions</li>
+ * </ul>
+ * The results are logged and passed to the {@link CodelessBenchmark#completion completion} block. Use {@link CodelessBenchmark#resultsJSON resultsJSON}
+ * to get them in a machine-readable format.
+ */
+@interface CodelessScriptBenchmark : CodelessBenchmark
+
+/// Benchmark workloads.
+enum CODELESS_SCRIPT_BENCHMARK_WORKLOAD {
+    /// Polling loop in a {@link CodelessScript script}.
+    CODELESS_SCRIPT_BENCHMARK_SCRIPT,
+    /// Polling loop in app code, driven by command events.
+    CODELESS_SCRIPT_BENCHMARK_EVENTS,
+};
+
+@property (class, readonly) NSString* TAG;
+
+/// The simulated peer.
+@property (readonly) CodelessSimulatedPeer* peer;
+/// The manager that is benchmarked.
+@property (readonly) CodelessManager* manager;
+/// The workloads to run (default: all).
+@property NSArray<NSNumber*>* workloads;
+/// The number of polls until the pin goes high (default: 200).
+@property int iterations;
+/// The maximum duration of each workload (seconds, default: 60).
+@property NSTimeInterval timeout;
+/// <code>true</code> if the benchmark is running.
+@property (readonly) BOOL running;
+
+/**
+ * Creates a benchmark.
+ * @param bluetoothManager the bluetooth manager used by the benchmarked manager
+ */
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager;
+
+/// Returns the name of a {@link CODELESS_SCRIPT_BENCHMARK_WORKLOAD workload}.
++ (NSString*) workloadName:(int)workload;
+
+/// Connects to the simulated peer and runs the workloads.
+- (void) start;
+/// Stops the benchmark. The results of the completed workloads are kept.
+- (void) stop;
+
+@end
+
+NS_ASSUME_NONNULL_END
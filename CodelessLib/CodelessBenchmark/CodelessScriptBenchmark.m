@@ -0,0 +1,232 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessScriptBenchmark.h"
+#import "CodelessBluetoothManager.h"
+#import "CodelessManager.h"
+#import "CodelessSimulatedPeer.h"
+#import "CodelessScript.h"
+#import "CodelessCommand.h"
+#import "CodelessLatencyHistogram.h"
+#import "CodelessLibEvent.h"
+#import "CodelessLibLog.h"
+
+/// The polled input pin.
+#define CODELESS_SCRIPT_BENCHMARK_PIN   5
+
+@interface CodelessScriptBenchmark ()
+
+@property CodelessSimulatedPeer* peer;
+@property CodelessManager* manager;
+@property BOOL running;
+
+@property int index;
+@property int workload;
+@property int polls;
+@property BOOL done;
+@property NSTimeInterval lastPollTime;
+@property CodelessLatencyHistogram* latency;
+@property (nullable) CodelessScript* script;
+@property NSString* pollCommand;
+
+@end
+
+@implementation CodelessScriptBenchmark
+
+static NSString* const TAG = @"CodelessScriptBenchmark";
+
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.peer = [[CodelessSimulatedPeer alloc] init];
+    self.manager = [[CodelessManager alloc] initWithBluetoothManager:bluetoothManager device:nil transport:self.peer];
+    self.workloads = @[ @(CODELESS_SCRIPT_BENCHMARK_SCRIPT), @(CODELESS_SCRIPT_BENCHMARK_EVENTS) ];
+    self.iterations = 200;
+    self.timeout = 60;
+    self.latency = [[CodelessLatencyHistogram alloc] init];
+    self.pollCommand = [NSString stringWithFormat:@"AT+IO=%d", CODELESS_SCRIPT_BENCHMARK_PIN];
+
+    __weak CodelessScriptBenchmark* weakSelf = self;
+    self.peer.commandHandler = ^NSString*(NSString* command) {
+        CodelessScriptBenchmark* benchmark = weakSelf;
+        if (!benchmark || ![command.uppercaseString isEqualToString:benchmark.pollCommand])
+            return nil;
+        return [benchmark onPoll];
+    };
+    return self;
+}
+
++ (NSString*) workloadName:(int)workload {
+    switch (workload) {
+        case CODELESS_SCRIPT_BENCHMARK_SCRIPT:
+            return @"script";
+        case CODELESS_SCRIPT_BENCHMARK_EVENTS:
+            return @"events";
+        default:
+            return @"unknown";
+    }
+}
+
+- (void) start {
+    if (self.running)
+        return;
+    CodelessLog(TAG, "Start: %d workloads, %d iterations", (int) self.workloads.count, self.iterations);
+    self.running = true;
+    self.index = 0;
+    [self clearResults];
+    [self.manager addEventObserver:self selector:@selector(onReady:) event:CodelessLibEvent.Ready];
+    [self.manager addEventObserver:self selector:@selector(onCommandSuccess:) event:CodelessLibEvent.CommandSuccess];
+    [self.manager addEventObserver:self selector:@selector(onScriptEnd:) event:CodelessLibEvent.ScriptEnd];
+    [self.manager connect];
+}
+
+- (void) stop {
+    if (!self.running)
+        return;
+    CodelessLog(TAG, "Stop");
+    self.done = true;
+    [self.script stop];
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    [self finish];
+}
+
+- (void) finish {
+    self.running = false;
+    self.script = nil;
+    [self.manager removeEventObserver:self];
+    [self.manager disconnect];
+    [self complete];
+}
+
+- (void) onReady:(CodelessEvent*)event {
+    if (self.running && !self.index)
+        [self runWorkload];
+}
+
+/**
+ * Called by the peer when it receives a poll command.
+ * @return the poll response: the pin is low for the first {@link #iterations} polls
+ */
+- (NSString*) onPoll {
+    NSTimeInterval now = NSProcessInfo.processInfo.systemUptime;
+    if (self.polls++)
+        [self.latency record:now - self.lastPollTime];
+    self.lastPollTime = now;
+    return [NSString stringWithFormat:@"%d\nOK", self.polls > self.iterations];
+}
+
+/// Starts the next workload.
+- (void) runWorkload {
+    if (self.index >= self.workloads.count) {
+        [self finish];
+        return;
+    }
+    self.workload = self.workloads[self.index].intValue;
+    CodelessLog(TAG, "Workload: %@", [CodelessScriptBenchmark workloadName:self.workload]);
+    self.polls = 0;
+    self.done = false;
+    [self.latency reset];
+    [self startMeasurement];
+    [self performSelector:@selector(onTimeout) withObject:nil afterDelay:self.timeout];
+
+    switch (self.workload) {
+        case CODELESS_SCRIPT_BENCHMARK_SCRIPT: {
+            NSString* text = [NSString stringWithFormat:@"@LOOP\n%@\n@UNTIL ^1$", self.pollCommand];
+            self.script = [[CodelessScript alloc] initWithName:@"benchmark" manager:self.manager text:text];
+            [self.script start];
+            break;
+        }
+        case CODELESS_SCRIPT_BENCHMARK_EVENTS:
+            [self.manager sendCommand:[self.manager parseTextCommand:self.pollCommand]];
+            break;
+    }
+}
+
+- (void) onScriptEnd:(CodelessScriptEndEvent*)event {
+    if (self.running && event.script == self.script)
+        [self workloadComplete:event.error];
+}
+
+- (void) onCommandSuccess:(CodelessCommandEvent*)event {
+    if (!self.running || self.done || self.workload != CODELESS_SCRIPT_BENCHMARK_EVENTS)
+        return;
+    // App side polling loop: check the response and poll again
+    if ([event.command.response.firstObject isEqualToString:@"1"])
+        [self workloadComplete:false];
+    else
+        [self.manager sendCommand:[self.manager parseTextCommand:self.pollCommand]];
+}
+
+- (void) onTimeout {
+    CodelessLog(TAG, "Workload timeout: %@", [CodelessScriptBenchmark workloadName:self.workload]);
+    CodelessScript* script = self.script;
+    [self workloadComplete:true];
+    [script stop];
+}
+
+/**
+ * Completes the current workload and starts the next one.
+ * @param timeout <code>true</code> if the workload did not complete normally
+ */
+- (void) workloadComplete:(BOOL)timeout {
+    if (self.done)
+        return;
+    self.done = true;
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(onTimeout) object:nil];
+    self.script = nil;
+
+    NSTimeInterval duration = self.elapsedTime;
+    double cpu = self.elapsedCpuTime;
+    NSMutableDictionary<NSString*, id>* result = [self addResult:[CodelessScriptBenchmark workloadName:self.workload]];
+    result[@"iterations"] = @(self.polls);
+    result[@"rate"] = @(duration > 0 ? self.polls / duration : 0);
+    result[@"latencyP50"] = @([self.latency percentile:50] * 1000);
+    result[@"latencyP99"] = @([self.latency percentile:99] * 1000);
+    result[@"cpuPerIteration"] = @(self.polls ? cpu / self.polls * 1e6 : 0);
+    result[@"connectionInterval"] = @(self.peer.connectionInterval);
+    result[@"timeout"] = @(timeout);
+    CodelessLog(TAG, "Result: %@", result);
+
+    self.index++;
+    // Let the last command complete before starting the next workload
+    [self performSelector:@selector(runWorkload) withObject:nil afterDelay:0];
+}
+
+@end
@@ -0,0 +1,109 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessBluetoothManager.h"
+#import "CodelessCodecBenchmark.h"
+#import "CodelessCommandBenchmark.h"
+#import "CodelessDispatchBenchmark.h"
+#import "CodelessDspsBenchmark.h"
+#import "CodelessPoolBenchmark.h"
+#import "CodelessScriptBenchmark.h"
+
+/*
+ * Headless benchmark runner.
+ *
+ * Usage: codeless-benchmark [codec] [command] [dispatch] [dsps] [pool] [script]
+ *
+ * Runs the selected benchmarks (default: all) one after the other against simulated peers, without a Bluetooth
+ * device, and prints the results as a JSON object, with one results array per benchmark, to the standard output.
+ */
+
+/// The number of managers used by the dispatch benchmark.
+#define CODELESS_BENCHMARK_RUNNER_MANAGERS   100
+
+/// Creates the benchmark with the specified name.
+static CodelessBenchmark* createBenchmark(NSString* name, CodelessBluetoothManager* bluetoothManager) {
+    if ([name isEqualToString:@"codec"])
+        return [[CodelessCodecBenchmark alloc] init];
+    if ([name isEqualToString:@"command"])
+        return [[CodelessCommandBenchmark alloc] initWithBluetoothManager:bluetoothManager];
+    if ([name isEqualToString:@"dispatch"])
+        return [[CodelessDispatchBenchmark alloc] initWithBluetoothManager:bluetoothManager count:CODELESS_BENCHMARK_RUNNER_MANAGERS];
+    if ([name isEqualToString:@"dsps"])
+        return [[CodelessDspsBenchmark alloc] initWithBluetoothManager:bluetoothManager];
+    if ([name isEqualToString:@"pool"])
+        return [[CodelessPoolBenchmark alloc] initWithBluetoothManager:bluetoothManager];
+    if ([name isEqualToString:@"script"])
+        return [[CodelessScriptBenchmark alloc] initWithBluetoothManager:bluetoothManager];
+    return nil;
+}
+
+int main(int argc, const char* argv[]) {
+    @autoreleasepool {
+        NSMutableArray<NSString*>* names = [NSMutableArray array];
+        for (int i = 1; i < argc; ++i)
+            [names addObject:@(argv[i])];
+        if (!names.count)
+            [names addObjectsFromArray:@[ @"codec", @"command", @"dispatch", @"dsps", @"pool", @"script" ]];
+
+        CodelessBluetoothManager* bluetoothManager = CodelessBluetoothManager.instance;
+        NSMutableDictionary<NSString*, NSArray*>* output = [NSMutableDictionary dictionary];
+        for (NSString* name in names) {
+            CodelessBenchmark* benchmark = createBenchmark(name, bluetoothManager);
+            if (!benchmark) {
+                fprintf(stderr, "Unknown benchmark: %s\n", name.UTF8String);
+                return 1;
+            }
+            __block BOOL complete = false;
+            benchmark.completion = ^(NSArray<NSDictionary<NSString*, id>*>* results) {
+                complete = true;
+            };
+            if ([benchmark isKindOfClass:CodelessCodecBenchmark.class]) {
+                [(CodelessCodecBenchmark*) benchmark run];
+            } else {
+                [(id) benchmark start];
+                while (!complete)
+                    [NSRunLoop.currentRunLoop runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+            }
+            output[name] = benchmark.results;
+        }
+
+        NSData* json = [NSJSONSerialization dataWithJSONObject:output options:NSJSONWritingPrettyPrinted error:nil];
+        fwrite(json.bytes, 1, json.length, stdout);
+        fputc('\n', stdout);
+    }
+    return 0;
+}
@@ -34,10 +34,18 @@
  */
 
 #import <Foundation/Foundation.h>
-#import <CoreBluetooth/CoreBluetooth.h>
+#import "CodelessCoreBluetooth.h"
+
+@class CodelessManager;
+@class CodelessAdvData;
+@class CodelessScanRecord;
+@class CodelessScanFilter;
 
 NS_ASSUME_NONNULL_BEGIN
 
+/// RSSI value reported by iOS when the RSSI is not available.
+#define CODELESS_RSSI_UNAVAILABLE 127
+
 /**
  * Provides Bluetooth scan and connect functionality and advertising data parsing.
  *
@@ -48,6 +56,8 @@ NS_ASSUME_NONNULL_BEGIN
  * Use the {@link #startScanning} and {@link #stopScanning} methods to start and stop scanning.
  * A {@link CodelessLibEvent#ScanResult ScanResult} event is generated on each advertising event,
  * containing the found device and parsed advertising data.
+ * If {@link #scanAggregation aggregation} is enabled, scan results are aggregated per device and reported
+ * once per {@link #scanReportInterval report interval}.
  *
  * After a device is found, you can create a CodelessManager object for the device and {@link CodelessManager#connect connect} to it.
  * @see CodelessManager
@@ -91,11 +101,71 @@ NS_ASSUME_NONNULL_BEGIN
  * @see CodelessManager#disconnect
  */
 - (void) disconnectPeripheral:(CBPeripheral*)peripheral;
+/**
+ * Used by the library to register the manager of a device.
+ * <p> Connection events for the device are dispatched directly to the registered manager.
+ * Managers are keyed by their {@link CodelessTransport#identifier transport identifier}, so that
+ * {@link CodelessSimulatedPeer simulated peers} are routed the same way as Bluetooth devices.
+ * The manager is not retained. If another manager is registered for the same device, it is replaced.
+ * @param manager the manager to register
+ */
+- (void) registerManager:(CodelessManager*)manager;
+/**
+ * Used by the library to unregister the manager of a device.
+ * @param manager the manager to unregister
+ */
+- (void) unregisterManager:(CodelessManager*)manager;
+/**
+ * Returns the registered manager of a device.
+ * @param peripheral the device
+ * @return the manager, or <code>nil</code> if no manager is registered for the device
+ */
+- (nullable CodelessManager*) managerForPeripheral:(CBPeripheral*)peripheral;
+/**
+ * Returns the registered manager of a device.
+ * @param identifier the {@link CodelessTransport#identifier transport identifier} of the device
+ * @return the manager, or <code>nil</code> if no manager is registered for the device
+ */
+- (nullable CodelessManager*) managerForIdentifier:(NSUUID*)identifier;
 
 /// The associated CBCentralManager object.
 @property (readonly) CBCentralManager* centralManager;
 /// <code>true</code> if a Bluetooth scan is currently active.
 @property (readonly) BOOL scanning;
+/**
+ * The scan filter (<code>nil</code> to accept all devices).
+ * <p> Advertising events that do not match the filter are dropped before the advertising data are parsed.
+ * Set it before starting the scan, so that the filter services are passed to CoreBluetooth.
+ */
+@property (nullable) CodelessScanFilter* scanFilter;
+/**
+ * The {@link CodelessAdvData#CODELESS_BEACON beacon types} that are reported in scan results.
+ * <p> Advertising events of other beacon types are dropped before any event is generated.
+ * Default value is {@link CodelessLibConfig#SCAN_BEACONS}.
+ */
+@property int scanBeacons;
+/**
+ * Aggregate scan results per device.
+ * <p> If enabled, the advertising data are parsed only when they change, and a {@link CodelessLibEvent#ScanResult ScanResult} event
+ * is generated once per {@link #scanReportInterval report interval} for each device that was seen, with the last and average RSSI.
+ * The first advertising event of a device is reported immediately.
+ * <p> Default value is {@link CodelessLibConfig#SCAN_AGGREGATION}. Set it before starting the scan.
+ */
+@property BOOL scanAggregation;
+/// The report interval for aggregated scan results (ms).
+@property int scanReportInterval;
+/**
+ * Returns the aggregated scan results of the current scan, by device identifier.
+ * <p> Only available if {@link #scanAggregation aggregation} is enabled. The table is cleared when a new scan is started. It holds at most {@link CodelessLibConfig#SCAN_RECORD_MAX SCAN_RECORD_MAX} devices, and devices that were not seen for {@link CodelessLibConfig#SCAN_RECORD_TIMEOUT SCAN_RECORD_TIMEOUT} are removed.
+ */
+- (NSDictionary<NSUUID*, CodelessScanRecord*>*) scanRecords;
+/**
+ * Parses the advertisement data of a scan result to an {@link CodelessAdvData} object.
+ * <p> Used by the library for each scan result.
+ * @param data the advertisement data, as reported by %CBCentralManager
+ * @return the parsed advertising data
+ */
++ (CodelessAdvData*) parseAdvertisingData:(NSDictionary<NSString*, id>*)data;
 
 @end
 
@@ -115,6 +185,35 @@ enum {
     CODELESS_MICROSOFT_MANUFACTURER_ID = 0x0006,
 };
 
+/// Beacon type flags.
+enum CODELESS_BEACON {
+    /// Apple iBeacon.
+    CODELESS_BEACON_IBEACON = 1 << 0,
+    /// iBeacon using Dialog's manufacturer ID.
+    CODELESS_BEACON_DIALOG = 1 << 1,
+    /// Eddystone UID frame.
+    CODELESS_BEACON_EDDYSTONE_UID = 1 << 2,
+    /// Eddystone URL frame.
+    CODELESS_BEACON_EDDYSTONE_URL = 1 << 3,
+    /// Eddystone TLM (telemetry) frame.
+    CODELESS_BEACON_EDDYSTONE_TLM = 1 << 4,
+    /// Eddystone EID frame.
+    CODELESS_BEACON_EDDYSTONE_EID = 1 << 5,
+    /// Microsoft beacon.
+    CODELESS_BEACON_MICROSOFT = 1 << 6,
+    /// All beacon types.
+    CODELESS_BEACON_ALL = 0x7f,
+};
+
+/// Eddystone frame type.
+enum CODELESS_EDDYSTONE_FRAME {
+    CODELESS_EDDYSTONE_FRAME_NONE = -1,
+    CODELESS_EDDYSTONE_FRAME_UID = 0x00,
+    CODELESS_EDDYSTONE_FRAME_URL = 0x10,
+    CODELESS_EDDYSTONE_FRAME_TLM = 0x20,
+    CODELESS_EDDYSTONE_FRAME_EID = 0x30,
+};
+
 /// The raw advertising data from the API.
 @property NSDictionary<NSString*, id>* raw;
 /// The advertised device name.
@@ -124,7 +223,12 @@ enum {
 /// List of advertised services.
 @property NSArray<CBUUID*>* services;
 /// Manufacturer specific data (mapped by manufacturer ID).
-@property NSDictionary<NSNumber*, NSData*>* manufacturer;
+/// <p> Created on first access from {@link #manufacturerData}.
+@property (nonatomic) NSDictionary<NSNumber*, NSData*>* manufacturer;
+/// The manufacturer ID of the manufacturer specific data, or -1 if not present.
+@property int manufacturerId;
+/// The raw manufacturer specific data from the API, including the manufacturer ID.
+@property NSData* manufacturerData;
 
 /// <code>true</code> if CodeLess service is advertised, <code>false</code> otherwise.
 @property BOOL codeless;
@@ -146,24 +250,76 @@ enum {
 /// <code>true</code> if the advertising data define an iBeacon, using Dialog's manufacturer ID.
 @property BOOL dialogBeacon;
 /// The iBeacon UUID.
-@property NSUUID* beaconUuid;
+/// <p> Created on first access from {@link #manufacturerData}.
+@property (nonatomic) NSUUID* beaconUuid;
 /// The iBeacon major number.
 @property uint16_t beaconMajor;
 /// The iBeacon minor number.
 @property uint16_t beaconMinor;
 /// <code>true</code> if the advertising data define an Eddystone beacon.
-/// <p> NOTE: Checking for Eddystone beacons is not implemented.
 @property BOOL eddystone;
 /// <code>true</code> if the advertising data define a Microsoft beacon.
 @property BOOL microsoft;
 
+/**
+ * The Eddystone {@link CODELESS_EDDYSTONE_FRAME frame type}, or {@link CODELESS_EDDYSTONE_FRAME_NONE} if not an Eddystone beacon.
+ * <p> The frame fields are decoded on access directly from {@link #eddystoneData}. Fields that do not apply to the frame type are 0 or <code>nil</code>.
+ */
+@property int eddystoneFrame;
+/// The raw Eddystone service data.
+@property (nullable) NSData* eddystoneData;
+/// The calibrated TX power at 0m (UID, URL and EID frames).
+@property (readonly) int eddystoneTxPower;
+/// The 10-byte namespace ID (UID frame).
+@property (readonly, nullable) NSData* eddystoneNamespace;
+/// The 6-byte instance ID (UID frame).
+@property (readonly, nullable) NSData* eddystoneInstance;
+/// The decoded URL (URL frame).
+@property (readonly, nullable) NSString* eddystoneUrl;
+/// The 8-byte ephemeral ID (EID frame).
+@property (readonly, nullable) NSData* eddystoneEid;
+/// The TLM frame version (TLM frame, only version 0 fields are decoded).
+@property (readonly) int eddystoneTlmVersion;
+/// The battery voltage (mV, 0 if not supported) (TLM frame).
+@property (readonly) int eddystoneBattery;
+/// The beacon temperature (Celsius, NAN if not supported or not a TLM frame) (TLM frame).
+@property (readonly) double eddystoneTemperature;
+/// The number of advertising frames sent since power-up or reboot (TLM frame).
+@property (readonly) uint32_t eddystoneAdvCount;
+/// The time since power-up or reboot (seconds, 0.1s resolution) (TLM frame).
+@property (readonly) NSTimeInterval eddystoneUptime;
+
 /// Checks if the advertising data contain known services other than Codeless, DSPS, SUOTA.
 - (BOOL) other;
 /// Checks if the advertising data define a beacon.
 - (BOOL) beacon;
+/// Returns the {@link CODELESS_BEACON beacon type} flag, or 0 if the advertising data do not define a beacon.
+- (int) beaconType;
 /// Checks if the advertising data do not contain any of the known services.
 - (BOOL) unknown;
 
 @end
 
+
+/// Aggregated scan results of a device.
+/// @see CodelessBluetoothManager#scanAggregation
+@interface CodelessScanRecord : NSObject
+
+/// The found device.
+@property (readonly) CBPeripheral* device;
+/// The last parsed advertising data.
+@property (readonly) CodelessAdvData* advData;
+/// The RSSI of the last advertising event.
+@property (readonly) int rssi;
+/// The average RSSI of the advertising events in the current (or last reported) report interval.
+@property (readonly) double rssiAverage;
+/// The total number of received advertising events.
+@property (readonly) int count;
+/// The time the device was first seen (system uptime).
+@property (readonly) NSTimeInterval firstSeen;
+/// The time the device was last seen (system uptime).
+@property (readonly) NSTimeInterval lastSeen;
+
+@end
+
 NS_ASSUME_NONNULL_END
@@ -34,16 +34,71 @@
  */
 
 #import "CodelessBluetoothManager.h"
+#import "CodelessManager.h"
 #import "CodelessLibEvent.h"
+#import "CodelessLibConfig.h"
+#import "CodelessScanFilter.h"
 #import "CodelessLibLog.h"
 #import "CodelessUtil.h"
 #import "CodelessProfile.h"
 
+/// Known advertised services, used as flags when parsing the advertising data.
+enum {
+    CODELESS_ADV_SERVICE_CODELESS = 1 << 0,
+    CODELESS_ADV_SERVICE_DSPS = 1 << 1,
+    CODELESS_ADV_SERVICE_SUOTA = 1 << 2,
+    CODELESS_ADV_SERVICE_IOT = 1 << 3,
+    CODELESS_ADV_SERVICE_WEARABLE = 1 << 4,
+    CODELESS_ADV_SERVICE_MESH = 1 << 5,
+    CODELESS_ADV_SERVICE_IMMEDIATE_ALERT = 1 << 6,
+    CODELESS_ADV_SERVICE_LINK_LOSS = 1 << 7,
+};
+
+@interface CodelessAdvData ()
+
+/// Offset of the iBeacon UUID in the manufacturer specific data (0 if not present).
+@property int beaconUuidOffset;
+
+/// Checks if the advertising data contain an unencrypted Eddystone TLM frame.
+- (BOOL) isEddystoneTlm;
+
+@end
+
+
+@interface CodelessScanRecord ()
+
+@property CBPeripheral* device;
+@property CodelessAdvData* advData;
+@property int rssi;
+@property double rssiAverage;
+@property int count;
+@property NSTimeInterval firstSeen;
+@property NSTimeInterval lastSeen;
+/// RSSI sum and number of valid RSSI values in the current report interval.
+@property int rssiSum;
+@property int rssiSamples;
+/// Number of advertising events in the current report interval.
+@property int reportCount;
+@property BOOL advDataChanged;
+@property BOOL pending;
+
+- (instancetype) initWithDevice:(CBPeripheral*)device;
+- (void) update:(int)rssi time:(NSTimeInterval)time;
+- (void) resetInterval;
+
+@end
+
+
 @interface CodelessBluetoothManager ()
 
 @property CBCentralManager* centralManager;
 @property BOOL scanning;
 @property NSNumber* pendingScanDuration;
+/// Registered managers, by peripheral identifier.
+@property NSMapTable<NSUUID*, CodelessManager*>* managers;
+/// Aggregated scan results, by peripheral identifier.
+@property NSMutableDictionary<NSUUID*, CodelessScanRecord*>* scanRecordTable;
+@property BOOL scanReportScheduled;
 
 @end
 
@@ -54,10 +109,35 @@ static NSString* const TAG = @"CodelessBluetoothManager";
     return TAG;
 }
 
+/// Known advertised services flags, mapped by service UUID.
+static NSDictionary<CBUUID*, NSNumber*>* advServices;
+
++ (void) initialize {
+    if (self != CodelessBluetoothManager.class)
+        return;
+    advServices = @{
+            CodelessProfile.CODELESS_SERVICE_UUID : @(CODELESS_ADV_SERVICE_CODELESS),
+            CodelessProfile.DSPS_SERVICE_UUID : @(CODELESS_ADV_SERVICE_DSPS),
+            CodelessProfile.SUOTA_SERVICE_UUID : @(CODELESS_ADV_SERVICE_SUOTA),
+            CodelessProfile.IOT_SERVICE_UUID : @(CODELESS_ADV_SERVICE_IOT),
+            CodelessProfile.WEARABLES_580_SERVICE_UUID : @(CODELESS_ADV_SERVICE_WEARABLE),
+            CodelessProfile.WEARABLES_680_SERVICE_UUID : @(CODELESS_ADV_SERVICE_WEARABLE),
+            CodelessProfile.MESH_PROVISIONING_SERVICE_UUID : @(CODELESS_ADV_SERVICE_MESH),
+            CodelessProfile.MESH_PROXY_SERVICE_UUID : @(CODELESS_ADV_SERVICE_MESH),
+            CodelessProfile.IMMEDIATE_ALERT_SERVICE_UUID : @(CODELESS_ADV_SERVICE_IMMEDIATE_ALERT),
+            CodelessProfile.LINK_LOSS_SERVICE_UUID : @(CODELESS_ADV_SERVICE_LINK_LOSS),
+    };
+}
+
 - (id) init {
     self = [super init];
     if (!self)
         return nil;
+    self.managers = [NSMapTable strongToWeakObjectsMapTable];
+    self.scanRecordTable = [NSMutableDictionary dictionary];
+    self.scanBeacons = CodelessLibConfig.SCAN_BEACONS;
+    self.scanAggregation = CodelessLibConfig.SCAN_AGGREGATION;
+    self.scanReportInterval = CodelessLibConfig.SCAN_REPORT_INTERVAL;
     self.centralManager = [[CBCentralManager alloc] initWithDelegate:self queue:nil];
     return self;
 }
@@ -85,7 +165,10 @@ static NSString* const TAG = @"CodelessBluetoothManager";
         return;
     self.scanning = true;
     CodelessLog(TAG, @"Start scanning");
-    [self.centralManager scanForPeripheralsWithServices:nil options:@{ CBCentralManagerScanOptionAllowDuplicatesKey : @YES }];
+    [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(reportScanResults) object:nil];
+    self.scanReportScheduled = false;
+    [self.scanRecordTable removeAllObjects];
+    [self.centralManager scanForPeripheralsWithServices:self.scanFilter.scanServices options:@{ CBCentralManagerScanOptionAllowDuplicatesKey : @YES }];
     if (duration > 0)
         [self performSelector:@selector(scanTimer) withObject:nil afterDelay:duration / 1000.];
     [self sendEvent:CodelessLibEvent.ScanStart object:[[CodelessScanStartEvent alloc] initWithManager:self]];
@@ -99,6 +182,8 @@ static NSString* const TAG = @"CodelessBluetoothManager";
     self.scanning = false;
     CodelessLog(TAG, @"Stop scanning");
     [self.centralManager stopScan];
+    [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(reportScanResults) object:nil];
+    [self reportScanResults];
     [self sendEvent:CodelessLibEvent.ScanStop object:[[CodelessScanStopEvent alloc] initWithManager:self]];
 }
 
@@ -117,54 +202,237 @@ static NSString* const TAG = @"CodelessBluetoothManager";
     [self.centralManager cancelPeripheralConnection:peripheral];
 }
 
+- (void) registerManager:(CodelessManager*)manager {
+    [self.managers setObject:manager forKey:manager.transport.identifier];
+}
+
+- (void) unregisterManager:(CodelessManager*)manager {
+    NSUUID* identifier = manager.transport.identifier;
+    if ([self.managers objectForKey:identifier] == manager)
+        [self.managers removeObjectForKey:identifier];
+}
+
+- (CodelessManager*) managerForPeripheral:(CBPeripheral*)peripheral {
+    return [self.managers objectForKey:peripheral.identifier];
+}
+
+- (CodelessManager*) managerForIdentifier:(NSUUID*)identifier {
+    return [self.managers objectForKey:identifier];
+}
+
+- (NSDictionary<NSUUID*, CodelessScanRecord*>*) scanRecords {
+    NSMutableDictionary<NSUUID*, CodelessScanRecord*>* records = [NSMutableDictionary dictionaryWithCapacity:self.scanRecordTable.count];
+    [self.scanRecordTable enumerateKeysAndObjectsUsingBlock:^(NSUUID* identifier, CodelessScanRecord* record, BOOL* stop) {
+        // Records of dropped devices are only kept to avoid parsing their advertising data again.
+        if (record.count)
+            records[identifier] = record;
+    }];
+    return records;
+}
+
+/**
+ * Checks if a scan result should be reported.
+ * <p> Beacons of types not included in {@link #scanBeacons} are dropped.
+ */
+- (BOOL) acceptScanResult:(CodelessAdvData*)advData {
+    int beaconType = advData.beaconType;
+    return !beaconType || (beaconType & self.scanBeacons);
+}
+
+/**
+ * Checks if two advertisement dictionaries contain the same advertising payload.
+ * <p> Only the keys that are parsed to {@link CodelessAdvData} are compared. Other keys, like the timestamp
+ * and PHY entries added by the system, change on every advertising event.
+ */
+static BOOL advertisementPayloadEqual(NSDictionary* a, NSDictionary* b) {
+    static NSArray<NSString*>* keys;
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        keys = @[ CBAdvertisementDataManufacturerDataKey, CBAdvertisementDataServiceDataKey, CBAdvertisementDataServiceUUIDsKey,
+                  CBAdvertisementDataOverflowServiceUUIDsKey, CBAdvertisementDataLocalNameKey, CBAdvertisementDataTxPowerLevelKey,
+                  CBAdvertisementDataIsConnectable ];
+    });
+    for (NSString* key in keys) {
+        id value = a[key];
+        id other = b[key];
+        if (value != other && ![value isEqual:other])
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Removes the scan records of devices that were not seen for {@link CodelessLibConfig#SCAN_RECORD_TIMEOUT SCAN_RECORD_TIMEOUT}.
+ * @return the identifier of the least recently seen device that was kept
+ */
+- (NSUUID*) removeExpiredScanRecords {
+    NSTimeInterval now = NSProcessInfo.processInfo.systemUptime;
+    NSTimeInterval timeout = CodelessLibConfig.SCAN_RECORD_TIMEOUT / 1000.;
+    NSMutableArray<NSUUID*>* expired = [NSMutableArray array];
+    NSUUID* oldest = nil;
+    NSTimeInterval oldestTime = DBL_MAX;
+    for (NSUUID* identifier in self.scanRecordTable) {
+        CodelessScanRecord* record = self.scanRecordTable[identifier];
+        NSTimeInterval lastSeen = MAX(record.lastSeen, record.firstSeen);
+        if (now - lastSeen > timeout)
+            [expired addObject:identifier];
+        else if (lastSeen < oldestTime) {
+            oldest = identifier;
+            oldestTime = lastSeen;
+        }
+    }
+    [self.scanRecordTable removeObjectsForKeys:expired];
+    return oldest;
+}
+
+/**
+ * Updates the aggregated scan results of a device.
+ * <p> The advertising data are parsed only if their payload differs from the previous one.
+ * The first advertising event of a device is reported immediately, the rest are reported by {@link #reportScanResults}.
+ */
+- (void) aggregateScanResult:(CBPeripheral*)peripheral advertisementData:(NSDictionary*)advertisementData rssi:(int)rssi {
+    CodelessScanRecord* record = self.scanRecordTable[peripheral.identifier];
+    if (!record) {
+        // If the table is full, remove the expired records, or else the least recently seen one
+        if (self.scanRecordTable.count >= CodelessLibConfig.SCAN_RECORD_MAX) {
+            NSUUID* oldest = [self removeExpiredScanRecords];
+            if (self.scanRecordTable.count >= CodelessLibConfig.SCAN_RECORD_MAX && oldest)
+                [self.scanRecordTable removeObjectForKey:oldest];
+        }
+        record = [[CodelessScanRecord alloc] initWithDevice:peripheral];
+        self.scanRecordTable[peripheral.identifier] = record;
+    }
+    if (!record.advData || !advertisementPayloadEqual(record.advData.raw, advertisementData)) {
+        record.advData = [CodelessBluetoothManager parseAdvertisingData:advertisementData];
+        record.advDataChanged = true;
+    }
+    if (![self acceptScanResult:record.advData])
+        return;
+    BOOL isNew = !record.count;
+    [record update:rssi time:NSProcessInfo.processInfo.systemUptime];
+
+    if (isNew) {
+        [self reportScanRecord:record];
+        return;
+    }
+    record.pending = true;
+    if (!self.scanReportScheduled) {
+        self.scanReportScheduled = true;
+        [self performSelector:@selector(reportScanResults) withObject:nil afterDelay:self.scanReportInterval / 1000.];
+    }
+}
+
+/**
+ * Generates a {@link CodelessLibEvent#ScanResult ScanResult} event for each device that was seen since the last report.
+ * <p> The records of devices that were not seen recently are removed.
+ */
+- (void) reportScanResults {
+    self.scanReportScheduled = false;
+    for (CodelessScanRecord* record in self.scanRecordTable.allValues) {
+        if (record.pending)
+            [self reportScanRecord:record];
+    }
+    [self removeExpiredScanRecords];
+}
+
+- (void) reportScanRecord:(CodelessScanRecord*)record {
+    NSNumber* rssiAverage = record.rssiSamples ? @((int) lround(record.rssiAverage)) : @(record.rssi);
+    [self sendEvent:CodelessLibEvent.ScanResult object:[[CodelessScanResultEvent alloc] initWithManager:self device:record.device advData:record.advData rssi:@(record.rssi) rssiAverage:rssiAverage count:record.reportCount advDataChanged:record.advDataChanged]];
+    [record resetInterval];
+}
+
 /**
  * Parses the raw advertising data to an {@link CodelessAdvData} object.
+ * <p> The advertised services are matched against the known services with a single hash lookup each.
+ * Beacon fields are decoded directly from the manufacturer specific data bytes. The manufacturer dictionary
+ * and the beacon UUID are created only if accessed.
  * @param data the raw advertising data
  * @return the parsed advertising data
  */
-- (CodelessAdvData*) parseAdvertisingData:(NSDictionary<NSString*, id>*)data {
++ (CodelessAdvData*) parseAdvertisingData:(NSDictionary<NSString*, id>*)data {
     CodelessAdvData* advData = [CodelessAdvData new];
     advData.raw = data;
     advData.name = data[CBAdvertisementDataLocalNameKey];
     advData.connectable = [(NSNumber*) data[CBAdvertisementDataIsConnectable] boolValue];
-    advData.services = data[CBAdvertisementDataServiceUUIDsKey];
-    if (data[CBAdvertisementDataOverflowServiceUUIDsKey])
-        advData.services = [advData.services arrayByAddingObjectsFromArray:data[CBAdvertisementDataOverflowServiceUUIDsKey]];
-    if (data[CBAdvertisementDataManufacturerDataKey]) {
-        CodelessByteBuffer* buffer = [CodelessByteBuffer wrap:data[CBAdvertisementDataManufacturerDataKey] order:CodelessByteBufferLittleEndian];
-        if (buffer.remaining >= 2) {
-            uint16_t manufacturer = [buffer getShort];
-            NSData* manufacturerData = [buffer getData:buffer.remaining];
-            advData.manufacturer = @{ @(manufacturer) : manufacturerData };
+    NSArray<CBUUID*>* services = data[CBAdvertisementDataServiceUUIDsKey];
+    NSArray<CBUUID*>* overflow = data[CBAdvertisementDataOverflowServiceUUIDsKey];
+    advData.services = overflow ? (services ? [services arrayByAddingObjectsFromArray:overflow] : overflow) : services;
+
+    int flags = 0;
+    for (CBUUID* uuid in advData.services)
+        flags |= advServices[uuid].intValue;
+    advData.codeless = (flags & CODELESS_ADV_SERVICE_CODELESS) != 0;
+    advData.dsps = (flags & CODELESS_ADV_SERVICE_DSPS) != 0;
+    advData.suota = (flags & CODELESS_ADV_SERVICE_SUOTA) != 0;
+    advData.iot = (flags & CODELESS_ADV_SERVICE_IOT) != 0;
+    advData.wearable = (flags & CODELESS_ADV_SERVICE_WEARABLE) != 0;
+    advData.mesh = (flags & CODELESS_ADV_SERVICE_MESH) != 0;
+    advData.proximity = (flags & CODELESS_ADV_SERVICE_IMMEDIATE_ALERT) && (flags & CODELESS_ADV_SERVICE_LINK_LOSS);
+
+    // Check for Eddystone beacon
+    NSDictionary<CBUUID*, NSData*>* serviceData = data[CBAdvertisementDataServiceDataKey];
+    NSData* eddystoneData = serviceData[CodelessProfile.EDDYSTONE_SERVICE_UUID];
+    if (eddystoneData.length) {
+        const uint8_t* frame = eddystoneData.bytes;
+        NSUInteger minLength = 0;
+        switch (frame[0]) {
+            case CODELESS_EDDYSTONE_FRAME_UID:
+                minLength = 18;
+                break;
+            case CODELESS_EDDYSTONE_FRAME_URL:
+                minLength = 3;
+                break;
+            case CODELESS_EDDYSTONE_FRAME_TLM:
+                minLength = 14;
+                break;
+            case CODELESS_EDDYSTONE_FRAME_EID:
+                minLength = 10;
+                break;
         }
-    }
-
-    advData.codeless = [advData.services containsObject:CodelessProfile.CODELESS_SERVICE_UUID];
-    advData.dsps = [advData.services containsObject:CodelessProfile.DSPS_SERVICE_UUID];
-    advData.suota = [advData.services containsObject:CodelessProfile.SUOTA_SERVICE_UUID];
-    advData.iot = [advData.services containsObject:CodelessProfile.IOT_SERVICE_UUID];
-    advData.wearable = [advData.services containsObject:CodelessProfile.WEARABLES_580_SERVICE_UUID] || [advData.services containsObject:CodelessProfile.WEARABLES_680_SERVICE_UUID];
-    advData.mesh = [advData.services containsObject:CodelessProfile.MESH_PROVISIONING_SERVICE_UUID] || [advData.services containsObject:CodelessProfile.MESH_PROXY_SERVICE_UUID];
-    advData.proximity = [advData.services containsObject:CodelessProfile.IMMEDIATE_ALERT_SERVICE_UUID] && [advData.services containsObject:CodelessProfile.LINK_LOSS_SERVICE_UUID];
-
-    // Check for Dialog iBeacon
-    NSData* manufacturerData = advData.manufacturer[@(CODELESS_DIALOG_MANUFACTURER_ID)];
-    if (manufacturerData && manufacturerData.length == 23) {
-        CodelessByteBuffer* buffer = [CodelessByteBuffer wrap:manufacturerData order:CodelessByteBufferBigEndian];
-        // Check subtype/length
-        if ([buffer get] == 2 && [buffer get] == 21) {
-            advData.dialogBeacon = true;
-            advData.iBeacon = false;
-            advData.beaconUuid = [[NSUUID alloc] initWithUUIDBytes:(const uint8_t*)[buffer getData:16].bytes];
-            advData.beaconMajor = [buffer getShort];
-            advData.beaconMinor = [buffer getShort];
+        if (minLength && eddystoneData.length >= minLength) {
+            advData.eddystone = true;
+            advData.eddystoneFrame = frame[0];
+            advData.eddystoneData = eddystoneData;
         }
     }
 
-    // Check for Microsoft beacon
-    manufacturerData = advData.manufacturer[@(CODELESS_MICROSOFT_MANUFACTURER_ID)];
-    if (manufacturerData && manufacturerData.length == 27) {
-        advData.microsoft = true;
+    NSData* manufacturerData = data[CBAdvertisementDataManufacturerDataKey];
+    if (manufacturerData.length < 2)
+        return advData;
+    const uint8_t* bytes = manufacturerData.bytes;
+    NSUInteger length = manufacturerData.length - 2;
+    uint16_t manufacturer = bytes[0] | bytes[1] << 8;
+    advData.manufacturerId = manufacturer;
+    advData.manufacturerData = manufacturerData;
+    bytes += 2;
+
+    switch (manufacturer) {
+        case CODELESS_APPLE_MANUFACTURER_ID:
+            // Check for iBeacon (subtype/length)
+            if (length == 23 && bytes[0] == 2 && bytes[1] == 21) {
+                advData.iBeacon = true;
+                advData.beaconUuidOffset = 4;
+                advData.beaconMajor = bytes[18] << 8 | bytes[19];
+                advData.beaconMinor = bytes[20] << 8 | bytes[21];
+            }
+            break;
+
+        case CODELESS_DIALOG_MANUFACTURER_ID:
+            // Check for Dialog iBeacon (subtype/length)
+            if (length == 23 && bytes[0] == 2 && bytes[1] == 21) {
+                advData.dialogBeacon = true;
+                advData.iBeacon = false;
+                advData.beaconUuidOffset = 4;
+                advData.beaconMajor = bytes[18] << 8 | bytes[19];
+                advData.beaconMinor = bytes[20] << 8 | bytes[21];
+            }
+            break;
+
+        case CODELESS_MICROSOFT_MANUFACTURER_ID:
+            // Check for Microsoft beacon
+            if (length == 27)
+                advData.microsoft = true;
+            break;
     }
 
     return advData;
@@ -187,43 +455,65 @@ static NSString* const TAG = @"CodelessBluetoothManager";
         self.pendingScanDuration = nil;
         [self startScanning:duration];
     }
-    [self sendEvent:CodelessLibEvent.BluetoothState object:[[CodelessBluetoothStateEvent alloc] initWithManager:self]];
+    CodelessBluetoothStateEvent* event = [[CodelessBluetoothStateEvent alloc] initWithManager:self];
+    for (CodelessManager* manager in self.managers.objectEnumerator.allObjects)
+        [manager onBluetoothState:event];
+    [self sendEvent:CodelessLibEvent.BluetoothState object:event];
 }
 
 /**
  * %CBCentralManagerDelegate <code>centralManager:didDiscoverPeripheral:advertisementData:RSSI:</code> implementation.
- * <p> A {@link CodelessLibEvent#ScanResult ScanResult} event is generated.
+ * <p> Advertising events that do not match the {@link #scanFilter scan filter} are dropped.
+ * A {@link CodelessLibEvent#ScanResult ScanResult} event is generated, or the result is {@link #scanAggregation aggregated}.
  */
 - (void) centralManager:(CBCentralManager*)central didDiscoverPeripheral:(CBPeripheral*)peripheral advertisementData:(NSDictionary*)advertisementData RSSI:(NSNumber*)RSSI {
-    CodelessLogOpt(CodelessLibLog.SCAN_RESULT, TAG, @"Discovered %@ [%@]: %@", peripheral.name, peripheral.identifier, advertisementData);
-    [self sendEvent:CodelessLibEvent.ScanResult object:[[CodelessScanResultEvent alloc] initWithManager:self device:peripheral advData:[self parseAdvertisingData:advertisementData] rssi:RSSI]];
+    if (self.scanFilter && ![self.scanFilter matches:peripheral advertisementData:advertisementData rssi:RSSI.intValue])
+        return;
+    CodelessLogSubsystem(CODELESS_LOG_SCAN_RESULT, TAG, @"Discovered %@ [%@]: %@", peripheral.name, peripheral.identifier, advertisementData);
+    if (self.scanAggregation) {
+        [self aggregateScanResult:peripheral advertisementData:advertisementData rssi:RSSI.intValue];
+        return;
+    }
+    CodelessAdvData* advData = [CodelessBluetoothManager parseAdvertisingData:advertisementData];
+    if (![self acceptScanResult:advData])
+        return;
+    [self sendEvent:CodelessLibEvent.ScanResult object:[[CodelessScanResultEvent alloc] initWithManager:self device:peripheral advData:advData rssi:RSSI]];
 }
 
 /**
  * %CBCentralManagerDelegate <code>centralManager:didConnectPeripheral:</code> implementation.
- * <p> A {@link CodelessLibEvent#DeviceConnected DeviceConnected} event is generated.
+ * <p> The registered manager of the device is notified directly.
+ * A {@link CodelessLibEvent#DeviceConnected DeviceConnected} event is generated.
  */
 - (void) centralManager:(CBCentralManager*)central didConnectPeripheral:(CBPeripheral*)peripheral {
     CodelessLog(TAG, @"Connected to device: %@", peripheral);
-    [self sendEvent:CodelessLibEvent.DeviceConnected object:[[CodelessDeviceConnectedEvent alloc] initWithManager:self device:peripheral]];
+    CodelessDeviceConnectedEvent* event = [[CodelessDeviceConnectedEvent alloc] initWithManager:self device:peripheral];
+    [[self managerForPeripheral:peripheral] onConnection:event];
+    [self sendEvent:CodelessLibEvent.DeviceConnected object:event];
 }
 
 /**
  * %CBCentralManagerDelegate <code>centralManager:didDisconnectPeripheral:error:</code> implementation.
- * <p> A {@link CodelessLibEvent#DeviceDisconnected DeviceDisconnected} event is generated.
+ * <p> The registered manager of the device is notified directly.
+ * A {@link CodelessLibEvent#DeviceDisconnected DeviceDisconnected} event is generated.
  */
 - (void) centralManager:(CBCentralManager*)central didDisconnectPeripheral:(CBPeripheral*)peripheral error:(NSError*)error {
     CodelessLog(TAG, @"Disconnected from device: %@", peripheral);
-    [self sendEvent:CodelessLibEvent.DeviceDisconnected object:[[CodelessDeviceDisconnectedEvent alloc] initWithManager:self device:peripheral error:error]];
+    CodelessDeviceDisconnectedEvent* event = [[CodelessDeviceDisconnectedEvent alloc] initWithManager:self device:peripheral error:error];
+    [[self managerForPeripheral:peripheral] onDisconnection:event];
+    [self sendEvent:CodelessLibEvent.DeviceDisconnected object:event];
 }
 
 /**
  * %CBCentralManagerDelegate <code>centralManager:didFailToConnectPeripheral:error:</code> implementation.
- * <p> A {@link CodelessLibEvent#ConnectionFailed ConnectionFailed} event is generated.
+ * <p> The registered manager of the device is notified directly.
+ * A {@link CodelessLibEvent#ConnectionFailed ConnectionFailed} event is generated.
  */
 - (void) centralManager:(CBCentralManager*)central didFailToConnectPeripheral:(CBPeripheral*)peripheral error:(NSError*)error {
     CodelessLog(TAG, @"Failed to connect to device: %@", peripheral);
-    [self sendEvent:CodelessLibEvent.ConnectionFailed object:[[CodelessConnectionFailedEvent alloc] initWithManager:self device:peripheral error:error]];
+    CodelessConnectionFailedEvent* event = [[CodelessConnectionFailedEvent alloc] initWithManager:self device:peripheral error:error];
+    [[self managerForPeripheral:peripheral] onConnectionFailed:event];
+    [self sendEvent:CodelessLibEvent.ConnectionFailed object:event];
 }
 
 @end
@@ -231,6 +521,27 @@ static NSString* const TAG = @"CodelessBluetoothManager";
 
 @implementation CodelessAdvData
 
+- (instancetype) init {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.manufacturerId = -1;
+    self.eddystoneFrame = CODELESS_EDDYSTONE_FRAME_NONE;
+    return self;
+}
+
+- (NSDictionary<NSNumber*, NSData*>*) manufacturer {
+    if (!_manufacturer && self.manufacturerData)
+        _manufacturer = @{ @(self.manufacturerId) : [self.manufacturerData subdataWithRange:NSMakeRange(2, self.manufacturerData.length - 2)] };
+    return _manufacturer;
+}
+
+- (NSUUID*) beaconUuid {
+    if (!_beaconUuid && self.beaconUuidOffset)
+        _beaconUuid = [[NSUUID alloc] initWithUUIDBytes:(const uint8_t*) self.manufacturerData.bytes + self.beaconUuidOffset];
+    return _beaconUuid;
+}
+
 - (BOOL) other {
     return self.iot || self.wearable || self.mesh || self.proximity;
 }
@@ -239,8 +550,139 @@ static NSString* const TAG = @"CodelessBluetoothManager";
     return self.iBeacon || self.dialogBeacon || self.eddystone || self.microsoft;
 }
 
+- (int) beaconType {
+    if (self.iBeacon)
+        return CODELESS_BEACON_IBEACON;
+    if (self.dialogBeacon)
+        return CODELESS_BEACON_DIALOG;
+    if (self.microsoft)
+        return CODELESS_BEACON_MICROSOFT;
+    switch (self.eddystoneFrame) {
+        case CODELESS_EDDYSTONE_FRAME_UID:
+            return CODELESS_BEACON_EDDYSTONE_UID;
+        case CODELESS_EDDYSTONE_FRAME_URL:
+            return CODELESS_BEACON_EDDYSTONE_URL;
+        case CODELESS_EDDYSTONE_FRAME_TLM:
+            return CODELESS_BEACON_EDDYSTONE_TLM;
+        case CODELESS_EDDYSTONE_FRAME_EID:
+            return CODELESS_BEACON_EDDYSTONE_EID;
+    }
+    return 0;
+}
+
 - (BOOL) unknown {
     return !self.suota && !self.dsps && !self.other && !self.beacon;
 }
 
+#pragma mark - Eddystone
+
+static NSString* const eddystoneUrlSchemes[] = { @"http://www.", @"https://www.", @"http://", @"https://" };
+static NSString* const eddystoneUrlExpansions[] = { @".com/", @".org/", @".edu/", @".net/", @".info/", @".biz/", @".gov/", @".com", @".org", @".edu", @".net", @".info", @".biz", @".gov" };
+
+/// Reads a big endian 16-bit value from the Eddystone frame.
+static inline uint16_t eddystoneGet16(const uint8_t* frame, int offset) {
+    return frame[offset] << 8 | frame[offset + 1];
+}
+
+/// Reads a big endian 32-bit value from the Eddystone frame.
+static inline uint32_t eddystoneGet32(const uint8_t* frame, int offset) {
+    return (uint32_t) frame[offset] << 24 | frame[offset + 1] << 16 | frame[offset + 2] << 8 | frame[offset + 3];
+}
+
+- (BOOL) isEddystoneTlm {
+    return self.eddystoneFrame == CODELESS_EDDYSTONE_FRAME_TLM && ((const uint8_t*) self.eddystoneData.bytes)[1] == 0;
+}
+
+- (int) eddystoneTxPower {
+    if (self.eddystoneFrame == CODELESS_EDDYSTONE_FRAME_NONE || self.eddystoneFrame == CODELESS_EDDYSTONE_FRAME_TLM)
+        return 0;
+    return (int8_t) ((const uint8_t*) self.eddystoneData.bytes)[1];
+}
+
+- (NSData*) eddystoneNamespace {
+    return self.eddystoneFrame == CODELESS_EDDYSTONE_FRAME_UID ? [self.eddystoneData subdataWithRange:NSMakeRange(2, 10)] : nil;
+}
+
+- (NSData*) eddystoneInstance {
+    return self.eddystoneFrame == CODELESS_EDDYSTONE_FRAME_UID ? [self.eddystoneData subdataWithRange:NSMakeRange(12, 6)] : nil;
+}
+
+- (NSData*) eddystoneEid {
+    return self.eddystoneFrame == CODELESS_EDDYSTONE_FRAME_EID ? [self.eddystoneData subdataWithRange:NSMakeRange(2, 8)] : nil;
+}
+
+- (NSString*) eddystoneUrl {
+    if (self.eddystoneFrame != CODELESS_EDDYSTONE_FRAME_URL)
+        return nil;
+    const uint8_t* frame = self.eddystoneData.bytes;
+    if (frame[2] >= sizeof(eddystoneUrlSchemes) / sizeof(eddystoneUrlSchemes[0]))
+        return nil;
+    NSMutableString* url = [NSMutableString stringWithString:eddystoneUrlSchemes[frame[2]]];
+    for (int i = 3; i < self.eddystoneData.length; i++) {
+        uint8_t c = frame[i];
+        if (c < sizeof(eddystoneUrlExpansions) / sizeof(eddystoneUrlExpansions[0]))
+            [url appendString:eddystoneUrlExpansions[c]];
+        else if (c > 0x20 && c < 0x7f)
+            [url appendFormat:@"%c", c];
+    }
+    return url;
+}
+
+- (int) eddystoneTlmVersion {
+    return self.eddystoneFrame == CODELESS_EDDYSTONE_FRAME_TLM ? ((const uint8_t*) self.eddystoneData.bytes)[1] : 0;
+}
+
+- (int) eddystoneBattery {
+    return self.isEddystoneTlm ? eddystoneGet16(self.eddystoneData.bytes, 2) : 0;
+}
+
+- (double) eddystoneTemperature {
+    if (!self.isEddystoneTlm)
+        return NAN;
+    uint16_t temperature = eddystoneGet16(self.eddystoneData.bytes, 4);
+    return temperature != 0x8000 ? (int16_t) temperature / 256. : NAN;
+}
+
+- (uint32_t) eddystoneAdvCount {
+    return self.isEddystoneTlm ? eddystoneGet32(self.eddystoneData.bytes, 6) : 0;
+}
+
+- (NSTimeInterval) eddystoneUptime {
+    return self.isEddystoneTlm ? eddystoneGet32(self.eddystoneData.bytes, 10) / 10. : 0;
+}
+
+@end
+
+
+@implementation CodelessScanRecord
+
+- (instancetype) initWithDevice:(CBPeripheral*)device {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.device = device;
+    self.firstSeen = NSProcessInfo.processInfo.systemUptime;
+    return self;
+}
+
+- (void) update:(int)rssi time:(NSTimeInterval)time {
+    self.rssi = rssi;
+    self.count++;
+    self.reportCount++;
+    self.lastSeen = time;
+    if (rssi != CODELESS_RSSI_UNAVAILABLE) {
+        self.rssiSum += rssi;
+        self.rssiSamples++;
+        self.rssiAverage = (double) self.rssiSum / self.rssiSamples;
+    }
+}
+
+- (void) resetInterval {
+    self.rssiSum = 0;
+    self.rssiSamples = 0;
+    self.reportCount = 0;
+    self.advDataChanged = false;
+    self.pending = false;
+}
+
 @end
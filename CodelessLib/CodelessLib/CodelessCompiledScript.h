@@ -0,0 +1,116 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+@class CodelessCommand;
+@class CodelessManager;
+@class CodelessScript;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Precompiled CodeLess commands script, which can be used to run the same script on many devices.
+ *
+ * ## Usage ##
+ * The script text is parsed and validated once, when the compiled script is created. The compiled script
+ * is not associated with any {@link CodelessManager manager} and is immutable, so it can be shared between
+ * managers and threads. Use {@link #scriptWithManager:} to create a {@link CodelessScript} for a specific
+ * device. The script commands are created from the compiled ones, without parsing and validating the
+ * command text again. The command text that is sent to the peer device is also reused.
+ *
+ * For example, run the same script on all connected devices:
+ * <blockquote><pre>
+ * %CodelessCompiledScript* compiled = [[%CodelessCompiledScript alloc] initWithName:@@"Setup" text:text];
+ * if (compiled.hasInvalid)
+ *     return;
+ * for (CodelessManager* manager in managers)
+ *     [[compiled scriptWithManager:manager] start];</pre></blockquote>
+ *
+ * @see CodelessScript
+ */
+@interface CodelessCompiledScript : NSObject
+
+@property (class, readonly) NSString* TAG;
+
+/// The script name.
+@property (readonly, nullable) NSString* name;
+/// The normalized script text (one command per line).
+@property (readonly) NSArray<NSString*>* script;
+/// The number of script commands.
+@property (readonly) int count;
+/// <code>true</code> if the script contains invalid commands.
+@property (readonly, getter=hasInvalid) BOOL invalid;
+/// <code>true</code> if the script contains unidentified commands.
+@property (readonly, getter=hasCustom) BOOL custom;
+
+/**
+ * Compiles a script.
+ * @param text the script text (empty lines are ignored)
+ */
+- (instancetype) initWithText:(NSString*)text;
+/**
+ * Compiles a script.
+ * @param script the script text (one command per line)
+ */
+- (instancetype) initWithScript:(NSArray<NSString*>*)script;
+/**
+ * Compiles a named script.
+ * @param name the script name
+ * @param text the script text (empty lines are ignored)
+ */
+- (instancetype) initWithName:(nullable NSString*)name text:(NSString*)text;
+/**
+ * Compiles a named script.
+ * @param name      the script name
+ * @param script    the script text (one command per line)
+ */
+- (instancetype) initWithName:(nullable NSString*)name script:(NSArray<NSString*>*)script;
+
+/**
+ * Creates a {@link CodelessScript} that runs the compiled script on the specified device.
+ * <p> Each call creates a new script, which can be started independently.
+ * @param manager the manager used to run the script
+ */
+- (CodelessScript*) scriptWithManager:(CodelessManager*)manager;
+/**
+ * Creates new command objects for the compiled script commands.
+ * @param manager the associated manager
+ */
+- (NSArray<CodelessCommand*>*) commandsWithManager:(CodelessManager*)manager;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,134 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessCompiledScript.h"
+#import "CodelessScript.h"
+#import "CodelessProfile.h"
+#import "CodelessCommand.h"
+#import "CodelessLibLog.h"
+
+@interface CodelessCompiledScript ()
+
+@property NSString* name;
+@property NSArray<NSString*>* script;
+@property NSArray<CodelessCommand*>* commands;
+@property BOOL invalid;
+@property BOOL custom;
+
+@end
+
+@implementation CodelessCompiledScript
+
+static NSString* const TAG = @"CodelessCompiledScript";
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) initWithText:(NSString*)text {
+    return self = [self initWithName:nil text:text];
+}
+
+- (instancetype) initWithScript:(NSArray<NSString*>*)script {
+    return self = [self initWithName:nil script:script];
+}
+
+- (instancetype) initWithName:(NSString*)name text:(NSString*)text {
+    NSMutableArray<NSString*>* script = [NSMutableArray array];
+    for (__strong NSString* line in [text componentsSeparatedByString:@"\n"]) {
+        line = [line stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
+        if (line.length)
+            [script addObject:line];
+    }
+    return self = [self initWithName:name script:script];
+}
+
+- (instancetype) initWithName:(NSString*)name script:(NSArray<NSString*>*)script {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.name = name;
+    [self compile:script];
+    return self;
+}
+
+/**
+ * Parses and validates the script text.
+ * <p> Control statements are kept in the script text and are compiled when the script is created.
+ * <p> The parsed commands are not associated with a manager and are never sent. They are used as templates for the script commands.
+ * @param script the script text (one command per line)
+ */
+- (void) compile:(NSArray<NSString*>*)script {
+    NSMutableArray<NSString*>* text = [NSMutableArray arrayWithCapacity:script.count];
+    NSMutableArray<CodelessCommand*>* commands = [NSMutableArray arrayWithCapacity:script.count];
+    for (NSString* line in script) {
+        // Control statements are compiled by the script.
+        if ([CodelessScript isControlStatement:line]) {
+            [text addObject:line];
+            continue;
+        }
+        NSString* normalized = [CodelessProfile normalizeTextCommand:line];
+        CodelessCommand* command = [CodelessProfile createTextCommand:normalized manager:nil];
+        if (!command.isValid && ![line containsString:@"$"])
+            self.invalid = true;
+        if (command.commandID == CODELESS_COMMAND_ID_CUSTOM)
+            self.custom = true;
+        [text addObject:normalized];
+        [commands addObject:command];
+    }
+    self.script = [NSArray arrayWithArray:text];
+    self.commands = [NSArray arrayWithArray:commands];
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script compiled: %@ commands=%d%@%@", self, self.count, self.invalid ? @" (invalid)" : @"", self.custom ? @" (custom)" : @"");
+}
+
+- (int) count {
+    return (int) self.commands.count;
+}
+
+- (NSArray<CodelessCommand*>*) commandsWithManager:(CodelessManager*)manager {
+    NSMutableArray<CodelessCommand*>* commands = [NSMutableArray arrayWithCapacity:self.commands.count];
+    for (CodelessCommand* command in self.commands)
+        [commands addObject:[[command.class alloc] initWithManager:manager parsedCommand:command]];
+    return [NSArray arrayWithArray:commands];
+}
+
+- (CodelessScript*) scriptWithManager:(CodelessManager*)manager {
+    return [[CodelessScript alloc] initWithManager:manager compiledScript:self];
+}
+
+- (NSString*) description {
+    return [NSString stringWithFormat:@"[%@]", self.name ? self.name : @"Compiled script"];
+}
+
+@end
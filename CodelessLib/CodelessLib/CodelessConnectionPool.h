@@ -0,0 +1,192 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessTransport.h"
+
+@class CodelessBluetoothManager;
+@class CodelessManager;
+@class CodelessCommand;
+@class CodelessLatencyHistogram;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A unit of work queued to a {@link CodelessConnectionPool connection pool}.
+ *
+ * The task is called when the device is ready. It must call <code>complete</code> exactly once when the
+ * work is done, so that the next queued task can run and the connection can be reused or evicted.
+ * @param manager   the manager of the device
+ * @param complete  completion callback, <code>success</code> is used for the pool statistics
+ */
+typedef void (^CodelessPoolTask)(CodelessManager* manager, void (^complete)(BOOL success));
+
+/// Creates the {@link CodelessManager manager} of a pooled device (for example, a simulated peer).
+typedef CodelessManager* _Nonnull (^CodelessPoolManagerFactory)(id<CodelessTransport> device);
+
+/**
+ * Multi-device connection manager with connection-slot scheduling.
+ *
+ * ## Usage ##
+ * Work (commands, scripts, file transfers) is {@link #addTask:device: queued} per device. The pool connects to a device
+ * on demand, when it has queued work, and runs its tasks one at a time when the device is {@link CodelessManager#isReady ready}.
+ * The tasks of different devices run concurrently.
+ *
+ * At most {@link #maxConnections} devices are connected (or connecting) at the same time. Devices that wait for a connection
+ * slot are served in FIFO order. When all slots are taken, the least recently used idle connection is disconnected to free a slot.
+ * Idle connections are kept open otherwise, so that new work for the same device does not pay the connection cost again.
+ *
+ * If a device does not become ready within {@link #connectTimeout}, or the connection fails, the connection is retried up to
+ * {@link #connectRetries} times. After that, the queued tasks of the device are dropped and a
+ * {@link CodelessLibEvent#PoolConnectionFailed PoolConnectionFailed} event is generated by the device manager.
+ *
+ * The pool keeps aggregate statistics: connection and task latency histograms, task throughput and the total DSPS receive speed.
+ * Devices are identified by their {@link CodelessTransport#identifier identifier}. A device is usually a %CBPeripheral, but any
+ * {@link CodelessTransport transport} can be used, for example a {@link CodelessSimulatedPeer}.
+ * Use {@link #managerFactory} to create the device managers, for example to configure them before they are used.
+ *
+ * For example, read the firmware version of a list of devices, using at most 2 connections:
+ * <blockquote><pre>
+ * CodelessConnectionPool* pool = [[CodelessConnectionPool alloc] initWithBluetoothManager:CodelessBluetoothManager.instance maxConnections:2];
+ * for (CBPeripheral* device in devices)
+ *     [pool sendTextCommand:@@"ATI" device:device];</pre></blockquote>
+ *
+ * @see CodelessManager
+ */
+@interface CodelessConnectionPool : NSObject
+
+@property (class, readonly) NSString* TAG;
+
+/// The {@link CodelessBluetoothManager} used to create the device managers.
+@property (readonly) CodelessBluetoothManager* bluetoothManager;
+/// The maximum number of concurrent connections.
+@property (nonatomic) int maxConnections;
+/// Time to wait for a device to become ready (ms, 0 to disable).
+@property int connectTimeout;
+/// Number of times a failed connection is retried.
+@property int connectRetries;
+/// Creates the device managers (<code>nil</code> to use {@link CodelessManager}).
+@property (nullable, copy) CodelessPoolManagerFactory managerFactory;
+
+/// The number of connections that were established (device ready).
+@property (readonly) int connections;
+/// The number of idle connections that were closed to free a connection slot.
+@property (readonly) int evictions;
+/// The number of failed connection attempts.
+@property (readonly) int connectFailures;
+/// The number of tasks that completed successfully.
+@property (readonly) int tasksCompleted;
+/// The number of tasks that failed or were dropped.
+@property (readonly) int tasksFailed;
+/// Connection latency, from connection request until the device is ready.
+@property (readonly) CodelessLatencyHistogram* connectLatency;
+/// Task latency, from the time the task is queued until it is complete.
+@property (readonly) CodelessLatencyHistogram* taskLatency;
+
+/**
+ * Creates a connection pool with the default {@link CodelessLibConfig#POOL_MAX_CONNECTIONS maximum number of connections}.
+ * @param bluetoothManager the {@link CodelessBluetoothManager} used to connect to the devices
+ */
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager;
+/**
+ * Creates a connection pool.
+ * @param bluetoothManager  the {@link CodelessBluetoothManager} used to connect to the devices
+ * @param maxConnections    the maximum number of concurrent connections
+ */
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager maxConnections:(int)maxConnections;
+
+/**
+ * Returns the manager used by the pool for a device, creating it if needed.
+ * <p> If a manager is already {@link CodelessBluetoothManager#registerManager: registered} for the device, it is used.
+ * @param device the device
+ */
+- (CodelessManager*) managerForDevice:(id<CodelessTransport>)device;
+/// Returns the devices known to the pool.
+- (NSArray<id<CodelessTransport>>*) devices;
+/// Returns the number of devices that are connected or connecting.
+- (int) activeConnections;
+/// Returns the number of queued tasks (not including running tasks).
+- (int) pendingTasks;
+
+/**
+ * Queues a task for a device.
+ * <p> The pool connects to the device, if needed, and runs the task when the device is ready.
+ * @param task      the task
+ * @param device    the device
+ */
+- (void) addTask:(CodelessPoolTask)task device:(id<CodelessTransport>)device;
+/**
+ * Queues an AT command for a device.
+ * <p> The command is parsed when the task runs. The task is complete when the command completes or fails.
+ * @param line      the command text
+ * @param device    the device
+ */
+- (void) sendTextCommand:(NSString*)line device:(id<CodelessTransport>)device;
+/**
+ * Queues a command script for a device.
+ * <p> The task is complete when the {@link CodelessScript script} ends.
+ * @param script    the script text, one command per line
+ * @param device    the device
+ */
+- (void) runScript:(NSString*)script device:(id<CodelessTransport>)device;
+/**
+ * Queues a DSPS file transfer for a device.
+ * <p> The task is complete when all file chunks are sent. The device must be in binary mode when the task runs.
+ * @param file      the file path
+ * @param device    the device
+ */
+- (void) sendFile:(NSString*)file device:(id<CodelessTransport>)device;
+
+/**
+ * Drops the queued tasks of a device, disconnects it and removes it from the pool.
+ * <p> A running task is not waited for.
+ * @param device the device
+ */
+- (void) removeDevice:(id<CodelessTransport>)device;
+/// Drops all queued tasks and disconnects all devices.
+- (void) close;
+
+/// Returns the command response latency, aggregated over all devices.
+- (CodelessLatencyHistogram*) commandLatency;
+/// Returns the task throughput since the statistics were reset (tasks per second).
+- (double) taskRate;
+/// Returns the total DSPS receive speed of the connected devices (bytes per second).
+- (int) dspsRxSpeed;
+/// Resets the pool statistics.
+- (void) resetStats;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,549 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessConnectionPool.h"
+#import "CodelessBluetoothManager.h"
+#import "CodelessManager.h"
+#import "CodelessScript.h"
+#import "CodelessLatencyHistogram.h"
+#import "CodelessLibConfig.h"
+#import "CodelessLibEvent.h"
+#import "CodelessLibLog.h"
+#import "CodelessCommand.h"
+#import "DspsFileSend.h"
+
+/// Task queued to a {@link CodelessConnectionPool}.
+@interface CodelessConnectionPool_Task : NSObject
+
+@property (copy) CodelessPoolTask task;
+/// The time the task was queued (system uptime).
+@property NSTimeInterval queueTime;
+/// The command, script or file operation the task is waiting for (convenience tasks only).
+@property (nullable) id operation;
+@property BOOL complete;
+
+- (instancetype) initWithTask:(CodelessPoolTask)task;
+
+@end
+
+@implementation CodelessConnectionPool_Task
+
+- (instancetype) initWithTask:(CodelessPoolTask)task {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.task = task;
+    self.queueTime = NSProcessInfo.processInfo.systemUptime;
+    return self;
+}
+
+@end
+
+
+/// Device managed by a {@link CodelessConnectionPool}.
+@interface CodelessConnectionPool_Device : NSObject
+
+@property id<CodelessTransport> device;
+@property CodelessManager* manager;
+@property NSMutableArray<CodelessConnectionPool_Task*>* tasks;
+@property (nullable) CodelessConnectionPool_Task* running;
+/// The last time the connection was used (system uptime), for LRU eviction.
+@property NSTimeInterval lastUsed;
+/// The time of the last connection request (system uptime).
+@property NSTimeInterval connectTime;
+/// The number of consecutive failed connection attempts.
+@property int attempts;
+/// <code>true</code> if the pool requested a connection and the device is not ready yet.
+@property BOOL connecting;
+/// <code>true</code> if the pool disconnects the device to free a connection slot.
+@property BOOL evicting;
+/// <code>true</code> if the device waits for a connection slot.
+@property BOOL waiting;
+
+- (instancetype) initWithDevice:(id<CodelessTransport>)device manager:(CodelessManager*)manager;
+- (BOOL) isIdle;
+
+@end
+
+@implementation CodelessConnectionPool_Device
+
+- (instancetype) initWithDevice:(id<CodelessTransport>)device manager:(CodelessManager*)manager {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.device = device;
+    self.manager = manager;
+    self.tasks = [NSMutableArray array];
+    return self;
+}
+
+- (BOOL) isIdle {
+    return self.manager.isReady && !self.running && !self.tasks.count && !self.evicting;
+}
+
+@end
+
+
+@interface CodelessConnectionPool ()
+
+@property CodelessBluetoothManager* bluetoothManager;
+@property NSMutableDictionary<NSUUID*, CodelessConnectionPool_Device*>* deviceMap;
+/// Devices waiting for a connection slot, in FIFO order.
+@property NSMutableArray<CodelessConnectionPool_Device*>* waiting;
+@property int connections;
+@property int evictions;
+@property int connectFailures;
+@property int tasksCompleted;
+@property int tasksFailed;
+@property CodelessLatencyHistogram* connectLatency;
+@property CodelessLatencyHistogram* taskLatency;
+@property NSTimeInterval statsStartTime;
+
+@end
+
+@implementation CodelessConnectionPool
+
+static NSString* const TAG = @"CodelessConnectionPool";
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager {
+    return self = [self initWithBluetoothManager:bluetoothManager maxConnections:CodelessLibConfig.POOL_MAX_CONNECTIONS];
+}
+
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)bluetoothManager maxConnections:(int)maxConnections {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.bluetoothManager = bluetoothManager;
+    _maxConnections = MAX(maxConnections, 1);
+    self.connectTimeout = CodelessLibConfig.POOL_CONNECT_TIMEOUT;
+    self.connectRetries = CodelessLibConfig.POOL_CONNECT_RETRIES;
+    self.deviceMap = [NSMutableDictionary dictionary];
+    self.waiting = [NSMutableArray array];
+    self.connectLatency = [[CodelessLatencyHistogram alloc] init];
+    self.taskLatency = [[CodelessLatencyHistogram alloc] init];
+    self.statsStartTime = NSProcessInfo.processInfo.systemUptime;
+    return self;
+}
+
+- (void) setMaxConnections:(int)maxConnections {
+    _maxConnections = MAX(maxConnections, 1);
+    [self schedule];
+}
+
+- (CodelessManager*) managerForDevice:(id<CodelessTransport>)device {
+    return [self entryForDevice:device].manager;
+}
+
+- (NSArray<id<CodelessTransport>>*) devices {
+    NSMutableArray<id<CodelessTransport>>* devices = [NSMutableArray arrayWithCapacity:self.deviceMap.count];
+    for (CodelessConnectionPool_Device* entry in self.deviceMap.allValues)
+        [devices addObject:entry.device];
+    return devices;
+}
+
+- (int) activeConnections {
+    int active = 0;
+    for (CodelessConnectionPool_Device* entry in self.deviceMap.allValues) {
+        if (!entry.manager.isDisconnected)
+            active++;
+    }
+    return active;
+}
+
+- (int) pendingTasks {
+    int pending = 0;
+    for (CodelessConnectionPool_Device* entry in self.deviceMap.allValues)
+        pending += (int) entry.tasks.count;
+    return pending;
+}
+
+/// Returns the pool entry of a device, creating the device manager if needed.
+- (CodelessConnectionPool_Device*) entryForDevice:(id<CodelessTransport>)device {
+    CodelessConnectionPool_Device* entry = self.deviceMap[device.identifier];
+    if (entry)
+        return entry;
+
+    CodelessManager* manager;
+    if (self.managerFactory)
+        manager = self.managerFactory(device);
+    else
+        manager = [self.bluetoothManager managerForIdentifier:device.identifier];
+    if (!manager) {
+        CBPeripheral* peripheral = [device isKindOfClass:CBPeripheral.class] ? (CBPeripheral*) device : nil;
+        manager = [[CodelessManager alloc] initWithBluetoothManager:self.bluetoothManager device:peripheral transport:device];
+    }
+
+    entry = [[CodelessConnectionPool_Device alloc] initWithDevice:device manager:manager];
+    self.deviceMap[device.identifier] = entry;
+    [manager addEventObserver:self selector:@selector(onConnection:) event:CodelessLibEvent.Connection];
+    [manager addEventObserver:self selector:@selector(onReady:) event:CodelessLibEvent.Ready];
+    [manager addEventObserver:self selector:@selector(onError:) event:CodelessLibEvent.Error];
+    [manager addEventObserver:self selector:@selector(onCommandSuccess:) event:CodelessLibEvent.CommandSuccess];
+    [manager addEventObserver:self selector:@selector(onCommandError:) event:CodelessLibEvent.CommandError];
+    [manager addEventObserver:self selector:@selector(onScriptEnd:) event:CodelessLibEvent.ScriptEnd];
+    [manager addEventObserver:self selector:@selector(onDspsFileChunk:) event:CodelessLibEvent.DspsFileChunk];
+    [manager addEventObserver:self selector:@selector(onDspsFileError:) event:CodelessLibEvent.DspsFileError];
+    return entry;
+}
+
+/// Returns the pool entry of the device that generated an event, if the device is managed by the pool.
+- (CodelessConnectionPool_Device*) entryForManager:(CodelessManager*)manager {
+    CodelessConnectionPool_Device* entry = self.deviceMap[manager.transport.identifier];
+    return entry.manager == manager ? entry : nil;
+}
+
+- (void) addTask:(CodelessPoolTask)task device:(id<CodelessTransport>)device {
+    CodelessConnectionPool_Device* entry = [self entryForDevice:device];
+    [entry.tasks addObject:[[CodelessConnectionPool_Task alloc] initWithTask:task]];
+    [self scheduleDevice:entry];
+}
+
+/**
+ * Queues a task that waits for a command, script or file operation.
+ * <p> The operation is created and registered before it is started, so that synchronous completion is not missed.
+ * @param create    creates the operation (<code>nil</code> on failure)
+ * @param start     starts the operation
+ * @param device    the device
+ */
+- (void) addOperation:(id (^)(CodelessManager* manager))create start:(void (^)(CodelessManager* manager, id operation))start device:(id<CodelessTransport>)device {
+    __weak CodelessConnectionPool* weakSelf = self;
+    [self addTask:^(CodelessManager* manager, void (^complete)(BOOL success)) {
+        CodelessConnectionPool_Device* entry = [weakSelf entryForManager:manager];
+        id operation = create(manager);
+        if (!entry || !operation) {
+            complete(false);
+            return;
+        }
+        entry.running.operation = operation;
+        start(manager, operation);
+    } device:device];
+}
+
+- (void) sendTextCommand:(NSString*)line device:(id<CodelessTransport>)device {
+    [self addOperation:^id(CodelessManager* manager) {
+        return [manager parseTextCommand:line];
+    } start:^(CodelessManager* manager, CodelessCommand* command) {
+        [manager sendCommand:command];
+    } device:device];
+}
+
+- (void) runScript:(NSString*)script device:(id<CodelessTransport>)device {
+    [self addOperation:^id(CodelessManager* manager) {
+        return [[CodelessScript alloc] initWithManager:manager text:script];
+    } start:^(CodelessManager* manager, CodelessScript* script) {
+        [script start];
+    } device:device];
+}
+
+- (void) sendFile:(NSString*)file device:(id<CodelessTransport>)device {
+    [self addOperation:^id(CodelessManager* manager) {
+        DspsFileSend* operation = [[DspsFileSend alloc] initWithManager:manager file:file];
+        return operation.isLoaded ? operation : nil;
+    } start:^(CodelessManager* manager, DspsFileSend* operation) {
+        [operation start];
+    } device:device];
+}
+
+- (void) removeDevice:(id<CodelessTransport>)device {
+    CodelessConnectionPool_Device* entry = self.deviceMap[device.identifier];
+    if (!entry)
+        return;
+    CodelessLog(TAG, "Remove device: %@", device.identifier);
+    [self.deviceMap removeObjectForKey:device.identifier];
+    [self.waiting removeObject:entry];
+    [self dropTasks:entry];
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(onConnectTimeout:) object:entry];
+    [entry.manager removeEventObserver:self];
+    if (!entry.manager.isDisconnected)
+        [entry.manager disconnect];
+    [self schedule];
+}
+
+- (void) close {
+    for (CodelessConnectionPool_Device* entry in self.deviceMap.allValues)
+        [self removeDevice:entry.device];
+}
+
+/// Drops the queued and running tasks of a device, which are counted as failed.
+- (int) dropTasks:(CodelessConnectionPool_Device*)entry {
+    int dropped = (int) entry.tasks.count;
+    for (CodelessConnectionPool_Task* task in entry.tasks)
+        task.complete = true;
+    [entry.tasks removeAllObjects];
+    if (entry.running) {
+        entry.running.complete = true;
+        entry.running = nil;
+        dropped++;
+    }
+    self.tasksFailed += dropped;
+    return dropped;
+}
+
+#pragma mark - Scheduling
+
+/// Runs the next task of a device, or queues the device for a connection slot.
+- (void) scheduleDevice:(CodelessConnectionPool_Device*)entry {
+    // Evicted devices are queued again when disconnected.
+    if (entry.evicting)
+        return;
+    if (entry.manager.isReady) {
+        [self runNext:entry];
+        return;
+    }
+    if (entry.manager.isDisconnected && !entry.waiting) {
+        entry.waiting = true;
+        [self.waiting addObject:entry];
+    }
+    [self schedule];
+}
+
+/**
+ * Assigns the free connection slots to the waiting devices, in FIFO order.
+ * <p> If all slots are taken, the least recently used idle connections are closed, one for each waiting device.
+ */
+- (void) schedule {
+    while (self.waiting.count) {
+        if (self.activeConnections < self.maxConnections) {
+            CodelessConnectionPool_Device* entry = self.waiting.firstObject;
+            [self.waiting removeObjectAtIndex:0];
+            entry.waiting = false;
+            [self connect:entry];
+            continue;
+        }
+
+        int evicting = 0;
+        CodelessConnectionPool_Device* lru = nil;
+        for (CodelessConnectionPool_Device* entry in self.deviceMap.allValues) {
+            if (entry.evicting)
+                evicting++;
+            else if (entry.isIdle && (!lru || entry.lastUsed < lru.lastUsed))
+                lru = entry;
+        }
+        if (evicting >= self.waiting.count || !lru)
+            break;
+        CodelessLog(TAG, "Evict idle connection: %@", lru.device.identifier);
+        lru.evicting = true;
+        self.evictions++;
+        [lru.manager disconnect];
+    }
+}
+
+- (void) connect:(CodelessConnectionPool_Device*)entry {
+    entry.attempts++;
+    CodelessLog(TAG, "Connect: %@ attempt=%d", entry.device.identifier, entry.attempts);
+    entry.connecting = true;
+    entry.connectTime = NSProcessInfo.processInfo.systemUptime;
+    if (self.connectTimeout > 0)
+        [self performSelector:@selector(onConnectTimeout:) withObject:entry afterDelay:self.connectTimeout / 1000.];
+    [entry.manager connect];
+}
+
+- (void) onConnectTimeout:(CodelessConnectionPool_Device*)entry {
+    if (!entry.connecting)
+        return;
+    CodelessLog(TAG, "Connection timeout: %@", entry.device.identifier);
+    [entry.manager disconnect];
+}
+
+- (void) runNext:(CodelessConnectionPool_Device*)entry {
+    if (entry.running || !entry.tasks.count || !entry.manager.isReady || entry.evicting)
+        return;
+    CodelessConnectionPool_Task* task = entry.tasks.firstObject;
+    [entry.tasks removeObjectAtIndex:0];
+    entry.running = task;
+    entry.lastUsed = NSProcessInfo.processInfo.systemUptime;
+    __weak CodelessConnectionPool* weakSelf = self;
+    task.task(entry.manager, ^(BOOL success) {
+        [weakSelf completeTask:task device:entry success:success];
+    });
+}
+
+- (void) completeTask:(CodelessConnectionPool_Task*)task device:(CodelessConnectionPool_Device*)entry success:(BOOL)success {
+    if (task.complete)
+        return;
+    task.complete = true;
+    task.operation = nil;
+    if (entry.running == task)
+        entry.running = nil;
+    NSTimeInterval now = NSProcessInfo.processInfo.systemUptime;
+    if (success)
+        self.tasksCompleted++;
+    else
+        self.tasksFailed++;
+    [self.taskLatency record:now - task.queueTime];
+    entry.lastUsed = now;
+
+    [self runNext:entry];
+    // The connection may now be idle and available for eviction.
+    if (entry.isIdle && self.waiting.count)
+        [self schedule];
+}
+
+/// Completes the running task of a device, if it waits for the specified operation.
+- (void) operationComplete:(id)operation manager:(CodelessManager*)manager success:(BOOL)success {
+    CodelessConnectionPool_Device* entry = [self entryForManager:manager];
+    if (entry.running && entry.running.operation == operation)
+        [self completeTask:entry.running device:entry success:success];
+}
+
+#pragma mark - Events
+
+- (void) onConnection:(CodelessConnectionEvent*)event {
+    CodelessConnectionPool_Device* entry = [self entryForManager:event.manager];
+    if (!entry || !entry.manager.isDisconnected)
+        return;
+
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(onConnectTimeout:) object:entry];
+    BOOL failed = entry.connecting;
+    entry.connecting = false;
+    entry.evicting = false;
+    if (entry.running)
+        [self completeTask:entry.running device:entry success:false];
+
+    if (failed) {
+        self.connectFailures++;
+        if (entry.attempts > self.connectRetries) {
+            int attempts = entry.attempts;
+            entry.attempts = 0;
+            int dropped = [self dropTasks:entry];
+            CodelessLog(TAG, "Connection failed: %@ attempts=%d dropped=%d", entry.device.identifier, attempts, dropped);
+            [entry.manager sendEvent:CodelessLibEvent.PoolConnectionFailed object:[[CodelessPoolConnectionFailedEvent alloc] initWithManager:entry.manager attempts:attempts dropped:dropped]];
+        }
+    }
+
+    if (entry.tasks.count && !entry.waiting) {
+        entry.waiting = true;
+        [self.waiting addObject:entry];
+    }
+    [self schedule];
+}
+
+- (void) onReady:(CodelessReadyEvent*)event {
+    CodelessConnectionPool_Device* entry = [self entryForManager:event.manager];
+    if (!entry)
+        return;
+    NSTimeInterval now = NSProcessInfo.processInfo.systemUptime;
+    if (entry.connecting) {
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(onConnectTimeout:) object:entry];
+        entry.connecting = false;
+        entry.attempts = 0;
+        self.connections++;
+        [self.connectLatency record:now - entry.connectTime];
+    }
+    entry.lastUsed = now;
+    [self runNext:entry];
+}
+
+- (void) onError:(CodelessErrorEvent*)event {
+    CodelessConnectionPool_Device* entry = [self entryForManager:event.manager];
+    if (!entry)
+        return;
+    switch (event.error) {
+        case CODELESS_ERROR_INIT_SERVICES:
+            if (entry.connecting)
+                [entry.manager disconnect];
+            break;
+        // Rejected commands and file operations complete without a result event.
+        case CODELESS_ERROR_NOT_READY:
+        case CODELESS_ERROR_OPERATION_NOT_ALLOWED:
+        case CODELESS_ERROR_INVALID_PREFIX:
+        case CODELESS_ERROR_INVALID_COMMAND:
+            if ([entry.running.operation isKindOfClass:CodelessCommand.class] || [entry.running.operation isKindOfClass:DspsFileSend.class])
+                [self completeTask:entry.running device:entry success:false];
+            break;
+    }
+}
+
+- (void) onCommandSuccess:(CodelessCommandSuccessEvent*)event {
+    [self operationComplete:event.command manager:event.manager success:true];
+}
+
+- (void) onCommandError:(CodelessCommandErrorEvent*)event {
+    [self operationComplete:event.command manager:event.manager success:false];
+}
+
+- (void) onScriptEnd:(CodelessScriptEndEvent*)event {
+    [self operationComplete:event.script manager:event.manager success:!event.error];
+}
+
+- (void) onDspsFileChunk:(DspsFileChunkEvent*)event {
+    if (event.chunk == event.operation.totalChunks)
+        [self operationComplete:event.operation manager:event.manager success:true];
+}
+
+- (void) onDspsFileError:(DspsFileErrorEvent*)event {
+    [self operationComplete:event.operation manager:event.manager success:false];
+}
+
+#pragma mark - Statistics
+
+- (CodelessLatencyHistogram*) commandLatency {
+    CodelessLatencyHistogram* latency = [[CodelessLatencyHistogram alloc] init];
+    for (CodelessConnectionPool_Device* entry in self.deviceMap.allValues) {
+        for (CodelessLatencyHistogram* histogram in entry.manager.commandLatency.allValues)
+            [latency add:histogram];
+    }
+    return latency;
+}
+
+- (double) taskRate {
+    NSTimeInterval elapsed = NSProcessInfo.processInfo.systemUptime - self.statsStartTime;
+    return elapsed > 0 ? (self.tasksCompleted + self.tasksFailed) / elapsed : 0;
+}
+
+- (int) dspsRxSpeed {
+    int speed = 0;
+    for (CodelessConnectionPool_Device* entry in self.deviceMap.allValues) {
+        if (entry.manager.isConnected && entry.manager.dspsRxSpeed != CodelessManager.SPEED_INVALID)
+            speed += entry.manager.dspsRxSpeed;
+    }
+    return speed;
+}
+
+- (void) resetStats {
+    self.connections = 0;
+    self.evictions = 0;
+    self.connectFailures = 0;
+    self.tasksCompleted = 0;
+    self.tasksFailed = 0;
+    [self.connectLatency reset];
+    [self.taskLatency reset];
+    self.statsStartTime = NSProcessInfo.processInfo.systemUptime;
+}
+
+@end
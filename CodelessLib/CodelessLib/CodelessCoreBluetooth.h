@@ -0,0 +1,202 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ * CoreBluetooth types used by the library.
+ *
+ * On Apple platforms, this imports CoreBluetooth and defines {@link CODELESS_CORE_BLUETOOTH} as 1.
+ * Otherwise (for example, GNUstep on Linux), it declares minimal stand-ins for the CoreBluetooth types, with the same
+ * names and signatures, so that the protocol engine can be built and run with a {@link CodelessSimulatedPeer} or a
+ * {@link CodelessGattReplay} transport. The stand-in %CBCentralManager reports an unsupported state and cannot scan or connect.
+ */
+#if __has_include(<CoreBluetooth/CoreBluetooth.h>)
+
+#import <CoreBluetooth/CoreBluetooth.h>
+#define CODELESS_CORE_BLUETOOTH 1
+
+#else
+
+#define CODELESS_CORE_BLUETOOTH 0
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, CBManagerState) {
+    CBManagerStateUnknown = 0,
+    CBManagerStateResetting,
+    CBManagerStateUnsupported,
+    CBManagerStateUnauthorized,
+    CBManagerStatePoweredOff,
+    CBManagerStatePoweredOn,
+};
+
+typedef NS_ENUM(NSInteger, CBCentralManagerState) {
+    CBCentralManagerStateUnknown = CBManagerStateUnknown,
+    CBCentralManagerStateResetting = CBManagerStateResetting,
+    CBCentralManagerStateUnsupported = CBManagerStateUnsupported,
+    CBCentralManagerStateUnauthorized = CBManagerStateUnauthorized,
+    CBCentralManagerStatePoweredOff = CBManagerStatePoweredOff,
+    CBCentralManagerStatePoweredOn = CBManagerStatePoweredOn,
+};
+
+typedef NS_ENUM(NSInteger, CBCharacteristicWriteType) {
+    CBCharacteristicWriteWithResponse = 0,
+    CBCharacteristicWriteWithoutResponse,
+};
+
+typedef NS_OPTIONS(NSUInteger, CBCharacteristicProperties) {
+    CBCharacteristicPropertyBroadcast = 0x01,
+    CBCharacteristicPropertyRead = 0x02,
+    CBCharacteristicPropertyWriteWithoutResponse = 0x04,
+    CBCharacteristicPropertyWrite = 0x08,
+    CBCharacteristicPropertyNotify = 0x10,
+    CBCharacteristicPropertyIndicate = 0x20,
+};
+
+typedef NS_OPTIONS(NSUInteger, CBAttributePermissions) {
+    CBAttributePermissionsReadable = 0x01,
+    CBAttributePermissionsWriteable = 0x02,
+};
+
+typedef NS_ENUM(NSInteger, CBError) {
+    CBErrorUnknown = 0,
+};
+
+FOUNDATION_EXPORT NSString* const CBErrorDomain;
+FOUNDATION_EXPORT NSString* const CBAdvertisementDataLocalNameKey;
+FOUNDATION_EXPORT NSString* const CBAdvertisementDataTxPowerLevelKey;
+FOUNDATION_EXPORT NSString* const CBAdvertisementDataServiceUUIDsKey;
+FOUNDATION_EXPORT NSString* const CBAdvertisementDataServiceDataKey;
+FOUNDATION_EXPORT NSString* const CBAdvertisementDataManufacturerDataKey;
+FOUNDATION_EXPORT NSString* const CBAdvertisementDataOverflowServiceUUIDsKey;
+FOUNDATION_EXPORT NSString* const CBAdvertisementDataIsConnectable;
+FOUNDATION_EXPORT NSString* const CBCentralManagerScanOptionAllowDuplicatesKey;
+
+/// Bluetooth UUID (16, 32 or 128 bit).
+@interface CBUUID : NSObject <NSCopying>
+
+/// The UUID bytes.
+@property (readonly, nonatomic) NSData* data;
+/// The UUID string (4, 8 or 36 characters).
+@property (readonly, nonatomic) NSString* UUIDString;
+
++ (CBUUID*) UUIDWithString:(NSString*)string;
++ (CBUUID*) UUIDWithData:(NSData*)data;
+
+@end
+
+@class CBPeripheral, CBService, CBCharacteristic, CBCentralManager;
+
+@interface CBAttribute : NSObject
+@property (readonly, nonatomic) CBUUID* UUID;
+@end
+
+@interface CBService : CBAttribute
+@property (weak, readonly, nonatomic, nullable) CBPeripheral* peripheral;
+@property (readonly, nonatomic) BOOL isPrimary;
+@property (readonly, nullable) NSArray<CBCharacteristic*>* characteristics;
+@end
+
+@interface CBMutableService : CBService
+@property (readwrite, nullable) NSArray<CBCharacteristic*>* characteristics;
+- (instancetype) initWithType:(CBUUID*)UUID primary:(BOOL)isPrimary;
+@end
+
+@interface CBCharacteristic : CBAttribute
+@property (weak, readonly, nullable) CBService* service;
+@property (readonly, nonatomic) CBCharacteristicProperties properties;
+@property (readonly, nullable) NSData* value;
+@property (readonly) BOOL isNotifying;
+@end
+
+@interface CBMutableCharacteristic : CBCharacteristic
+@property (readwrite, nullable) NSData* value;
+@property (readwrite, nonatomic) CBCharacteristicProperties properties;
+@property (assign, nonatomic) CBAttributePermissions permissions;
+- (instancetype) initWithType:(CBUUID*)UUID properties:(CBCharacteristicProperties)properties value:(nullable NSData*)value permissions:(CBAttributePermissions)permissions;
+@end
+
+@protocol CBPeripheralDelegate <NSObject>
+@optional
+- (void) peripheral:(CBPeripheral*)peripheral didDiscoverServices:(nullable NSError*)error;
+- (void) peripheral:(CBPeripheral*)peripheral didDiscoverCharacteristicsForService:(CBService*)service error:(nullable NSError*)error;
+- (void) peripheral:(CBPeripheral*)peripheral didUpdateNotificationStateForCharacteristic:(CBCharacteristic*)characteristic error:(nullable NSError*)error;
+- (void) peripheral:(CBPeripheral*)peripheral didUpdateValueForCharacteristic:(CBCharacteristic*)characteristic error:(nullable NSError*)error;
+- (void) peripheral:(CBPeripheral*)peripheral didWriteValueForCharacteristic:(CBCharacteristic*)characteristic error:(nullable NSError*)error;
+- (void) peripheralIsReadyToSendWriteWithoutResponse:(CBPeripheral*)peripheral;
+- (void) peripheral:(CBPeripheral*)peripheral didReadRSSI:(NSNumber*)RSSI error:(nullable NSError*)error;
+@end
+
+/// Remote peripheral. Never created by the stand-in central manager.
+@interface CBPeripheral : NSObject
+@property (readonly, nonatomic) NSUUID* identifier;
+@property (readonly, nullable) NSString* name;
+@property (weak, nonatomic, nullable) id<CBPeripheralDelegate> delegate;
+@property (readonly, nullable) NSArray<CBService*>* services;
+- (void) discoverServices:(nullable NSArray<CBUUID*>*)serviceUUIDs;
+- (void) discoverCharacteristics:(nullable NSArray<CBUUID*>*)characteristicUUIDs forService:(CBService*)service;
+- (void) setNotifyValue:(BOOL)enabled forCharacteristic:(CBCharacteristic*)characteristic;
+- (void) readValueForCharacteristic:(CBCharacteristic*)characteristic;
+- (void) writeValue:(NSData*)data forCharacteristic:(CBCharacteristic*)characteristic type:(CBCharacteristicWriteType)type;
+- (NSUInteger) maximumWriteValueLengthForType:(CBCharacteristicWriteType)type;
+- (void) readRSSI;
+@end
+
+@protocol CBCentralManagerDelegate <NSObject>
+@required
+- (void) centralManagerDidUpdateState:(CBCentralManager*)central;
+@optional
+- (void) centralManager:(CBCentralManager*)central didDiscoverPeripheral:(CBPeripheral*)peripheral advertisementData:(NSDictionary<NSString*, id>*)advertisementData RSSI:(NSNumber*)RSSI;
+- (void) centralManager:(CBCentralManager*)central didConnectPeripheral:(CBPeripheral*)peripheral;
+- (void) centralManager:(CBCentralManager*)central didDisconnectPeripheral:(CBPeripheral*)peripheral error:(nullable NSError*)error;
+- (void) centralManager:(CBCentralManager*)central didFailToConnectPeripheral:(CBPeripheral*)peripheral error:(nullable NSError*)error;
+@end
+
+/// Central manager without a Bluetooth adapter. The state is always unsupported.
+@interface CBCentralManager : NSObject
+@property (weak, nonatomic, nullable) id<CBCentralManagerDelegate> delegate;
+@property (readonly, nonatomic) CBManagerState state;
+@property (readonly) BOOL isScanning;
+- (instancetype) initWithDelegate:(nullable id<CBCentralManagerDelegate>)delegate queue:(nullable dispatch_queue_t)queue;
+- (void) scanForPeripheralsWithServices:(nullable NSArray<CBUUID*>*)serviceUUIDs options:(nullable NSDictionary<NSString*, id>*)options;
+- (void) stopScan;
+- (void) connectPeripheral:(CBPeripheral*)peripheral options:(nullable NSDictionary<NSString*, id>*)options;
+- (void) cancelPeripheralConnection:(CBPeripheral*)peripheral;
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
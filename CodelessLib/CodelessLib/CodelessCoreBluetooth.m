@@ -0,0 +1,280 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessCoreBluetooth.h"
+
+#if !CODELESS_CORE_BLUETOOTH
+
+NSString* const CBErrorDomain = @"CBErrorDomain";
+NSString* const CBAdvertisementDataLocalNameKey = @"kCBAdvDataLocalName";
+NSString* const CBAdvertisementDataTxPowerLevelKey = @"kCBAdvDataTxPowerLevel";
+NSString* const CBAdvertisementDataServiceUUIDsKey = @"kCBAdvDataServiceUUIDs";
+NSString* const CBAdvertisementDataServiceDataKey = @"kCBAdvDataServiceData";
+NSString* const CBAdvertisementDataManufacturerDataKey = @"kCBAdvDataManufacturerData";
+NSString* const CBAdvertisementDataOverflowServiceUUIDsKey = @"kCBAdvDataOverflowServiceUUIDs";
+NSString* const CBAdvertisementDataIsConnectable = @"kCBAdvDataIsConnectable";
+NSString* const CBCentralManagerScanOptionAllowDuplicatesKey = @"kCBScanOptionAllowDuplicates";
+
+
+@interface CBUUID ()
+
+@property (nonatomic) NSData* data;
+
+@end
+
+@implementation CBUUID
+
++ (CBUUID*) UUIDWithString:(NSString*)string {
+    if (string.length == 36) {
+        NSUUID* uuid = [[NSUUID alloc] initWithUUIDString:string];
+        if (!uuid)
+            [NSException raise:NSInvalidArgumentException format:@"Invalid UUID string: %@", string];
+        uint8_t bytes[16];
+        [uuid getUUIDBytes:bytes];
+        return [self UUIDWithData:[NSData dataWithBytes:bytes length:sizeof(bytes)]];
+    }
+    if (string.length != 4 && string.length != 8)
+        [NSException raise:NSInvalidArgumentException format:@"Invalid UUID string: %@", string];
+    NSMutableData* data = [NSMutableData dataWithLength:string.length / 2];
+    uint8_t* bytes = data.mutableBytes;
+    for (int i = 0; i < data.length; ++i) {
+        unsigned int value;
+        NSScanner* scanner = [NSScanner scannerWithString:[string substringWithRange:NSMakeRange(i * 2, 2)]];
+        if (![scanner scanHexInt:&value] || !scanner.isAtEnd)
+            [NSException raise:NSInvalidArgumentException format:@"Invalid UUID string: %@", string];
+        bytes[i] = value;
+    }
+    return [self UUIDWithData:data];
+}
+
++ (CBUUID*) UUIDWithData:(NSData*)data {
+    if (data.length != 2 && data.length != 4 && data.length != 16)
+        [NSException raise:NSInvalidArgumentException format:@"Invalid UUID data: %@", data];
+    CBUUID* uuid = [[CBUUID alloc] init];
+    uuid.data = [data copy];
+    return uuid;
+}
+
+- (NSString*) UUIDString {
+    if (self.data.length == 16)
+        return [[NSUUID alloc] initWithUUIDBytes:self.data.bytes].UUIDString;
+    NSMutableString* string = [NSMutableString stringWithCapacity:self.data.length * 2];
+    const uint8_t* bytes = self.data.bytes;
+    for (int i = 0; i < self.data.length; ++i)
+        [string appendFormat:@"%02X", bytes[i]];
+    return string;
+}
+
+- (BOOL) isEqual:(id)object {
+    return self == object || ([object isKindOfClass:CBUUID.class] && [self.data isEqualToData:((CBUUID*) object).data]);
+}
+
+- (NSUInteger) hash {
+    return self.data.hash;
+}
+
+- (id) copyWithZone:(NSZone*)zone {
+    return self;
+}
+
+- (NSString*) description {
+    return self.UUIDString;
+}
+
+@end
+
+
+@interface CBAttribute ()
+
+@property (nonatomic) CBUUID* UUID;
+
+@end
+
+@implementation CBAttribute
+@end
+
+
+@interface CBService ()
+
+@property (weak, nonatomic, nullable) CBPeripheral* peripheral;
+@property (nonatomic) BOOL isPrimary;
+@property (nullable) NSArray<CBCharacteristic*>* characteristics;
+
+@end
+
+@implementation CBService
+@end
+
+
+@interface CBCharacteristic ()
+
+@property (weak, nullable) CBService* service;
+@property (nonatomic) CBCharacteristicProperties properties;
+@property (nullable) NSData* value;
+@property BOOL isNotifying;
+
+@end
+
+@implementation CBCharacteristic
+@end
+
+
+@implementation CBMutableService
+
+@dynamic characteristics;
+
+- (instancetype) initWithType:(CBUUID*)UUID primary:(BOOL)isPrimary {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.UUID = UUID;
+    self.isPrimary = isPrimary;
+    return self;
+}
+
+- (void) setCharacteristics:(NSArray<CBCharacteristic*>*)characteristics {
+    for (CBCharacteristic* characteristic in characteristics)
+        characteristic.service = self;
+    [super setCharacteristics:characteristics];
+}
+
+@end
+
+
+@implementation CBMutableCharacteristic
+
+@dynamic value, properties;
+
+- (instancetype) initWithType:(CBUUID*)UUID properties:(CBCharacteristicProperties)properties value:(NSData*)value permissions:(CBAttributePermissions)permissions {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.UUID = UUID;
+    self.properties = properties;
+    self.value = value;
+    self.permissions = permissions;
+    return self;
+}
+
+@end
+
+
+@interface CBPeripheral ()
+
+@property (nonatomic) NSUUID* identifier;
+
+@end
+
+// The stand-in central manager never discovers peripherals, so the GATT operations are never called.
+@implementation CBPeripheral
+
+- (instancetype) init {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.identifier = [NSUUID UUID];
+    return self;
+}
+
+- (NSString*) name {
+    return nil;
+}
+
+- (NSArray<CBService*>*) services {
+    return nil;
+}
+
+- (void) discoverServices:(NSArray<CBUUID*>*)serviceUUIDs {
+}
+
+- (void) discoverCharacteristics:(NSArray<CBUUID*>*)characteristicUUIDs forService:(CBService*)service {
+}
+
+- (void) setNotifyValue:(BOOL)enabled forCharacteristic:(CBCharacteristic*)characteristic {
+}
+
+- (void) readValueForCharacteristic:(CBCharacteristic*)characteristic {
+}
+
+- (void) writeValue:(NSData*)data forCharacteristic:(CBCharacteristic*)characteristic type:(CBCharacteristicWriteType)type {
+}
+
+- (NSUInteger) maximumWriteValueLengthForType:(CBCharacteristicWriteType)type {
+    return 20;
+}
+
+- (void) readRSSI {
+}
+
+@end
+
+
+@implementation CBCentralManager
+
+- (instancetype) initWithDelegate:(id<CBCentralManagerDelegate>)delegate queue:(dispatch_queue_t)queue {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.delegate = delegate;
+    // Report the state asynchronously, like CoreBluetooth.
+    dispatch_async(queue ?: dispatch_get_main_queue(), ^{
+        [self.delegate centralManagerDidUpdateState:self];
+    });
+    return self;
+}
+
+- (CBManagerState) state {
+    return CBManagerStateUnsupported;
+}
+
+- (BOOL) isScanning {
+    return false;
+}
+
+- (void) scanForPeripheralsWithServices:(NSArray<CBUUID*>*)serviceUUIDs options:(NSDictionary<NSString*, id>*)options {
+}
+
+- (void) stopScan {
+}
+
+- (void) connectPeripheral:(CBPeripheral*)peripheral options:(NSDictionary<NSString*, id>*)options {
+}
+
+- (void) cancelPeripheralConnection:(CBPeripheral*)peripheral {
+}
+
+@end
+
+#endif
@@ -0,0 +1,211 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessCoreBluetooth.h"
+#import "CodelessTransport.h"
+
+@class CodelessManager;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * GATT trace record types.
+ *
+ * Operations are issued by the manager, callbacks are received by the manager.
+ * If the {@link CODELESS_GATT_TRACE_ERROR} bit is set, the callback reported an error.
+ */
+enum CODELESS_GATT_TRACE_RECORD {
+    // Operations
+    CODELESS_GATT_TRACE_CONNECT = 0x01,
+    CODELESS_GATT_TRACE_DISCONNECT,
+    CODELESS_GATT_TRACE_DISCOVER_SERVICES,
+    CODELESS_GATT_TRACE_DISCOVER_CHARACTERISTICS,
+    CODELESS_GATT_TRACE_SET_NOTIFY,
+    CODELESS_GATT_TRACE_READ,
+    CODELESS_GATT_TRACE_WRITE,
+    CODELESS_GATT_TRACE_WRITE_COMMAND,
+    /// Data: the maximum write length (uint16).
+    CODELESS_GATT_TRACE_MTU,
+    CODELESS_GATT_TRACE_READ_RSSI,
+    // Callbacks
+    /// Data: the indices of the discovered {@link CODELESS_GATT_TRACE_SERVICE services}.
+    CODELESS_GATT_TRACE_SERVICES_DISCOVERED = 0x20,
+    CODELESS_GATT_TRACE_CHARACTERISTICS_DISCOVERED,
+    CODELESS_GATT_TRACE_NOTIFY_STATE,
+    /// Data: the characteristic value (read response or notification).
+    CODELESS_GATT_TRACE_VALUE,
+    CODELESS_GATT_TRACE_WRITTEN,
+    CODELESS_GATT_TRACE_READY_TO_SEND,
+    /// Data: the RSSI (int8).
+    CODELESS_GATT_TRACE_RSSI,
+
+    CODELESS_GATT_TRACE_ERROR = 0x80,
+};
+
+/// Services that can be referenced in a GATT trace.
+enum CODELESS_GATT_TRACE_SERVICE {
+    CODELESS_GATT_TRACE_CODELESS_SERVICE,
+    CODELESS_GATT_TRACE_DSPS_SERVICE,
+    CODELESS_GATT_TRACE_SERVICE_COUNT
+};
+
+/// Characteristics that can be referenced in a GATT trace.
+enum CODELESS_GATT_TRACE_CHARACTERISTIC {
+    CODELESS_GATT_TRACE_CODELESS_INBOUND,
+    CODELESS_GATT_TRACE_CODELESS_OUTBOUND,
+    CODELESS_GATT_TRACE_CODELESS_FLOW_CONTROL,
+    CODELESS_GATT_TRACE_DSPS_SERVER_TX,
+    CODELESS_GATT_TRACE_DSPS_SERVER_RX,
+    CODELESS_GATT_TRACE_DSPS_FLOW_CONTROL,
+    CODELESS_GATT_TRACE_CHARACTERISTIC_COUNT,
+    /// Not a CodeLess or DSPS attribute (for example, Device Information).
+    CODELESS_GATT_TRACE_OTHER = 0xff,
+};
+
+/// The GATT trace file magic ("CGT" and version).
+#define CODELESS_GATT_TRACE_MAGIC   "CGT\x01"
+/// The GATT trace record header size: type (uint8), attribute (uint8), time delta in us (uint32), data length (uint16), little endian.
+#define CODELESS_GATT_TRACE_RECORD_HEADER_SIZE   8
+
+
+/**
+ * {@link CodelessTransport Transport} that records the GATT traffic of a {@link CodelessManager} to a binary trace file.
+ *
+ * The recorder wraps the actual transport (usually the %CBPeripheral). Every GATT operation issued by the manager and
+ * every callback it receives are written to the trace, with the time since the previous record (microseconds) and the
+ * associated data (written values, notifications, read values, MTU, RSSI). The trace can be fed back into a manager
+ * with {@link CodelessGattReplay}, without a Bluetooth device.
+ * <p> Only the CodeLess and DSPS attributes are recorded with their data. Other attributes are recorded as
+ * {@link CODELESS_GATT_TRACE_OTHER}, without data.
+ *
+ * For example:
+ * <blockquote><pre>
+ * CodelessGattRecorder* recorder = [[CodelessGattRecorder alloc] initWithTransport:peripheral file:path];
+ * CodelessManager* manager = [[CodelessManager alloc] initWithBluetoothManager:CodelessBluetoothManager.instance device:peripheral transport:recorder];</pre></blockquote>
+ * Call {@link #close} to write any buffered records to the file.
+ */
+@interface CodelessGattRecorder : NSObject <CodelessTransport, CBPeripheralDelegate>
+
+@property (class, readonly) NSString* TAG;
+
+/// The recorded transport.
+@property (readonly) id<CodelessTransport> transport;
+/// The identifier of the recorded transport.
+@property (readonly, nonatomic) NSUUID* identifier;
+/// The trace file path.
+@property (readonly) NSString* file;
+/// The object that receives the GATT operation results (the manager).
+@property (weak, nonatomic, nullable) id<CBPeripheralDelegate> delegate;
+/// The number of recorded records.
+@property (readonly) int records;
+
+/**
+ * Creates a recorder.
+ * @param transport the transport to record
+ * @param file      the trace file path (overwritten)
+ */
+- (instancetype) initWithTransport:(id<CodelessTransport>)transport file:(NSString*)file;
+
+/// Writes any buffered records and closes the trace file. No more records are written.
+- (void) close;
+
+/// Returns the {@link CODELESS_GATT_TRACE_CHARACTERISTIC trace index} of a characteristic UUID.
++ (int) characteristicIndex:(CBUUID*)uuid;
+/// Returns the {@link CODELESS_GATT_TRACE_SERVICE trace index} of a service UUID, or {@link CODELESS_GATT_TRACE_OTHER}.
++ (int) serviceIndex:(CBUUID*)uuid;
+
+@end
+
+
+/**
+ * {@link CodelessTransport Transport} that replays a GATT trace recorded by {@link CodelessGattRecorder}.
+ *
+ * The recorded callbacks are delivered to the manager in order. Before continuing after a recorded operation,
+ * the replay waits until the manager issues an operation of the same type, so that the GATT operation queue of the
+ * manager stays in sync with the trace. Operations that do not match the trace are counted in {@link #mismatches}.
+ * If the manager does not issue an expected operation within {@link #stallTimeout}, the operation is skipped.
+ * <p> The trace can be replayed at full speed (callbacks delivered as soon as possible) or in {@link #realTime real time}
+ * (recorded delays between records are preserved). This allows to reproduce issues (for example, stalls after XOFF)
+ * and measure the library processing time without a Bluetooth device.
+ *
+ * For example:
+ * <blockquote><pre>
+ * CodelessGattReplay* replay = [[CodelessGattReplay alloc] initWithFile:path];
+ * CodelessManager* manager = [[CodelessManager alloc] initWithBluetoothManager:CodelessBluetoothManager.instance device:nil transport:replay];
+ * replay.completion = ^(CodelessGattReplay* replay) { ... };
+ * [manager connect];</pre></blockquote>
+ */
+@interface CodelessGattReplay : NSObject <CodelessTransport>
+
+@property (class, readonly) NSString* TAG;
+
+/// A random identifier, unique for each replay.
+@property (readonly, nonatomic) NSUUID* identifier;
+/// The object that receives the GATT operation results (the manager).
+@property (weak, nonatomic, nullable) id<CBPeripheralDelegate> delegate;
+/// The services discovered in the trace.
+@property (readonly, nullable) NSArray<CBService*>* services;
+/// <code>true</code> to preserve the recorded delays, <code>false</code> for full speed (default).
+@property BOOL realTime;
+/// The maximum time to wait for an expected operation (seconds, default: 5).
+@property NSTimeInterval stallTimeout;
+/// Called when the end of the trace is reached.
+@property (copy, nullable) void (^completion)(CodelessGattReplay* replay);
+/// The number of replayed records.
+@property (readonly) int records;
+/// The number of operations that did not match the trace.
+@property (readonly) int mismatches;
+/// The replay duration (seconds).
+@property (readonly) NSTimeInterval duration;
+/// <code>true</code> if the end of the trace was reached.
+@property (readonly) BOOL complete;
+
+/**
+ * Creates a replay from a trace file.
+ * @param file the trace file path
+ * @return the replay, or <code>nil</code> if the file is not a valid trace
+ */
+- (nullable instancetype) initWithFile:(NSString*)file;
+/**
+ * Creates a replay from trace data.
+ * @param data the trace data
+ * @return the replay, or <code>nil</code> if the data are not a valid trace
+ */
+- (nullable instancetype) initWithData:(NSData*)data;
+
+@end
+
+NS_ASSUME_NONNULL_END
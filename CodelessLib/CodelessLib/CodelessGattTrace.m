@@ -0,0 +1,575 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessGattTrace.h"
+#import "CodelessManager.h"
+#import "CodelessBluetoothManager.h"
+#import "CodelessProfile.h"
+#import "CodelessLibEvent.h"
+#import "CodelessLibLog.h"
+
+/// Records are buffered and written to the trace file in blocks of this size.
+#define CODELESS_GATT_TRACE_BUFFER_SIZE   65536
+
+static NSArray<CBUUID*>* traceServiceUUIDs;
+static NSArray<CBUUID*>* traceCharacteristicUUIDs;
+
+static void initTraceUUIDs(void) {
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+        traceServiceUUIDs = @[ CodelessProfile.CODELESS_SERVICE_UUID, CodelessProfile.DSPS_SERVICE_UUID ];
+        traceCharacteristicUUIDs = @[
+            CodelessProfile.CODELESS_INBOUND_COMMAND_UUID, CodelessProfile.CODELESS_OUTBOUND_COMMAND_UUID, CodelessProfile.CODELESS_FLOW_CONTROL_UUID,
+            CodelessProfile.DSPS_SERVER_TX_UUID, CodelessProfile.DSPS_SERVER_RX_UUID, CodelessProfile.DSPS_FLOW_CONTROL_UUID,
+        ];
+    });
+}
+
+
+@interface CodelessGattRecorder ()
+
+@property id<CodelessTransport> transport;
+@property NSString* file;
+@property int records;
+@property (nullable) NSFileHandle* handle;
+@property NSMutableData* buffer;
+@property NSTimeInterval lastTime;
+
+@end
+
+@implementation CodelessGattRecorder
+
+static NSString* const TAG = @"CodelessGattRecorder";
+
++ (NSString*) TAG {
+    return TAG;
+}
+
++ (int) characteristicIndex:(CBUUID*)uuid {
+    initTraceUUIDs();
+    NSUInteger index = [traceCharacteristicUUIDs indexOfObject:uuid];
+    return index != NSNotFound ? (int) index : CODELESS_GATT_TRACE_OTHER;
+}
+
++ (int) serviceIndex:(CBUUID*)uuid {
+    initTraceUUIDs();
+    NSUInteger index = [traceServiceUUIDs indexOfObject:uuid];
+    return index != NSNotFound ? (int) index : CODELESS_GATT_TRACE_OTHER;
+}
+
+- (instancetype) initWithTransport:(id<CodelessTransport>)transport file:(NSString*)file {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.transport = transport;
+    self.file = file;
+    self.buffer = [NSMutableData dataWithCapacity:CODELESS_GATT_TRACE_BUFFER_SIZE];
+    [self.buffer appendBytes:CODELESS_GATT_TRACE_MAGIC length:4];
+    if ([NSFileManager.defaultManager createFileAtPath:file contents:nil attributes:nil])
+        self.handle = [NSFileHandle fileHandleForWritingAtPath:file];
+    if (!self.handle)
+        CodelessLog(TAG, "Failed to create trace file: %@", file);
+    transport.delegate = self;
+    return self;
+}
+
+- (void) dealloc {
+    [self close];
+}
+
+- (NSString*) description {
+    return [NSString stringWithFormat:@"REC-%@", self.transport.description];
+}
+
+- (void) close {
+    if (!self.handle)
+        return;
+    [self flush];
+    [self.handle closeFile];
+    self.handle = nil;
+    CodelessLog(TAG, "Trace closed: %@ (%d records)", self.file, self.records);
+}
+
+- (void) flush {
+    if (!self.buffer.length)
+        return;
+    [self.handle writeData:self.buffer];
+    [self.buffer setLength:0];
+}
+
+/// Appends a record to the trace.
+- (void) record:(int)type attribute:(int)attribute data:(nullable NSData*)data {
+    if (!self.handle)
+        return;
+    NSTimeInterval now = NSProcessInfo.processInfo.systemUptime;
+    uint32_t delta = self.lastTime ? (uint32_t) MIN((now - self.lastTime) * 1000000, UINT32_MAX) : 0;
+    self.lastTime = now;
+    uint16_t length = (uint16_t) MIN(data.length, UINT16_MAX);
+    uint8_t header[CODELESS_GATT_TRACE_RECORD_HEADER_SIZE] = {
+        type, attribute, delta, delta >> 8, delta >> 16, delta >> 24, length, length >> 8
+    };
+    [self.buffer appendBytes:header length:sizeof(header)];
+    if (length)
+        [self.buffer appendBytes:data.bytes length:length];
+    self.records++;
+    if (self.buffer.length >= CODELESS_GATT_TRACE_BUFFER_SIZE)
+        [self flush];
+}
+
+/// Appends a characteristic record to the trace. The data of non CodeLess/DSPS characteristics are not recorded.
+- (void) record:(int)type characteristic:(CBCharacteristic*)characteristic data:(nullable NSData*)data error:(nullable NSError*)error {
+    int attribute = [CodelessGattRecorder characteristicIndex:characteristic.UUID];
+    [self record:type | (error ? CODELESS_GATT_TRACE_ERROR : 0) attribute:attribute data:attribute != CODELESS_GATT_TRACE_OTHER ? data : nil];
+}
+
+#pragma mark - CodelessTransport
+
+- (NSUUID*) identifier {
+    return self.transport.identifier;
+}
+
+- (NSArray<CBService*>*) services {
+    return self.transport.services;
+}
+
+- (void) connect {
+    [self record:CODELESS_GATT_TRACE_CONNECT attribute:0 data:nil];
+    if ([self.transport respondsToSelector:@selector(connect)]) {
+        [self.transport connect];
+    } else {
+        CodelessManager* manager = (CodelessManager*) self.delegate;
+        [manager.bluetoothManager connectToPeripheral:manager.device];
+    }
+}
+
+- (void) disconnect {
+    [self record:CODELESS_GATT_TRACE_DISCONNECT attribute:0 data:nil];
+    if ([self.transport respondsToSelector:@selector(disconnect)]) {
+        [self.transport disconnect];
+    } else {
+        CodelessManager* manager = (CodelessManager*) self.delegate;
+        [manager.bluetoothManager disconnectPeripheral:manager.device];
+    }
+}
+
+- (void) discoverServices:(NSArray<CBUUID*>*)serviceUUIDs {
+    [self record:CODELESS_GATT_TRACE_DISCOVER_SERVICES attribute:0 data:nil];
+    [self.transport discoverServices:serviceUUIDs];
+}
+
+- (void) discoverCharacteristics:(NSArray<CBUUID*>*)characteristicUUIDs forService:(CBService*)service {
+    [self record:CODELESS_GATT_TRACE_DISCOVER_CHARACTERISTICS attribute:[CodelessGattRecorder serviceIndex:service.UUID] data:nil];
+    [self.transport discoverCharacteristics:characteristicUUIDs forService:service];
+}
+
+- (void) setNotifyValue:(BOOL)enabled forCharacteristic:(CBCharacteristic*)characteristic {
+    [self record:CODELESS_GATT_TRACE_SET_NOTIFY characteristic:characteristic data:nil error:nil];
+    [self.transport setNotifyValue:enabled forCharacteristic:characteristic];
+}
+
+- (void) readValueForCharacteristic:(CBCharacteristic*)characteristic {
+    [self record:CODELESS_GATT_TRACE_READ characteristic:characteristic data:nil error:nil];
+    [self.transport readValueForCharacteristic:characteristic];
+}
+
+- (void) writeValue:(NSData*)data forCharacteristic:(CBCharacteristic*)characteristic type:(CBCharacteristicWriteType)type {
+    [self record:type == CBCharacteristicWriteWithResponse ? CODELESS_GATT_TRACE_WRITE : CODELESS_GATT_TRACE_WRITE_COMMAND characteristic:characteristic data:data error:nil];
+    [self.transport writeValue:data forCharacteristic:characteristic type:type];
+}
+
+- (NSUInteger) maximumWriteValueLengthForType:(CBCharacteristicWriteType)type {
+    NSUInteger length = [self.transport maximumWriteValueLengthForType:type];
+    uint16_t value = (uint16_t) MIN(length, UINT16_MAX);
+    uint8_t bytes[] = { value, value >> 8 };
+    [self record:CODELESS_GATT_TRACE_MTU attribute:0 data:[NSData dataWithBytes:bytes length:sizeof(bytes)]];
+    return length;
+}
+
+- (void) readRSSI {
+    [self record:CODELESS_GATT_TRACE_READ_RSSI attribute:0 data:nil];
+    [self.transport readRSSI];
+}
+
+#pragma mark - CBPeripheralDelegate
+
+- (void) peripheral:(CBPeripheral*)peripheral didDiscoverServices:(NSError*)error {
+    NSMutableData* indices = [NSMutableData data];
+    for (CBService* service in self.transport.services) {
+        uint8_t index = [CodelessGattRecorder serviceIndex:service.UUID];
+        if (index != CODELESS_GATT_TRACE_OTHER)
+            [indices appendBytes:&index length:1];
+    }
+    [self record:CODELESS_GATT_TRACE_SERVICES_DISCOVERED | (error ? CODELESS_GATT_TRACE_ERROR : 0) attribute:0 data:indices];
+    [self.delegate peripheral:peripheral didDiscoverServices:error];
+}
+
+- (void) peripheral:(CBPeripheral*)peripheral didDiscoverCharacteristicsForService:(CBService*)service error:(NSError*)error {
+    [self record:CODELESS_GATT_TRACE_CHARACTERISTICS_DISCOVERED | (error ? CODELESS_GATT_TRACE_ERROR : 0) attribute:[CodelessGattRecorder serviceIndex:service.UUID] data:nil];
+    [self.delegate peripheral:peripheral didDiscoverCharacteristicsForService:service error:error];
+}
+
+- (void) peripheral:(CBPeripheral*)peripheral didUpdateNotificationStateForCharacteristic:(CBCharacteristic*)characteristic error:(NSError*)error {
+    [self record:CODELESS_GATT_TRACE_NOTIFY_STATE characteristic:characteristic data:nil error:error];
+    [self.delegate peripheral:peripheral didUpdateNotificationStateForCharacteristic:characteristic error:error];
+}
+
+- (void) peripheral:(CBPeripheral*)peripheral didUpdateValueForCharacteristic:(CBCharacteristic*)characteristic error:(NSError*)error {
+    [self record:CODELESS_GATT_TRACE_VALUE characteristic:characteristic data:characteristic.value error:error];
+    [self.delegate peripheral:peripheral didUpdateValueForCharacteristic:characteristic error:error];
+}
+
+- (void) peripheral:(CBPeripheral*)peripheral didWriteValueForCharacteristic:(CBCharacteristic*)characteristic error:(NSError*)error {
+    [self record:CODELESS_GATT_TRACE_WRITTEN characteristic:characteristic data:nil error:error];
+    [self.delegate peripheral:peripheral didWriteValueForCharacteristic:characteristic error:error];
+}
+
+- (void) peripheralIsReadyToSendWriteWithoutResponse:(CBPeripheral*)peripheral {
+    [self record:CODELESS_GATT_TRACE_READY_TO_SEND attribute:0 data:nil];
+    [self.delegate peripheralIsReadyToSendWriteWithoutResponse:peripheral];
+}
+
+- (void) peripheral:(CBPeripheral*)peripheral didReadRSSI:(NSNumber*)RSSI error:(NSError*)error {
+    int8_t rssi = RSSI.charValue;
+    [self record:CODELESS_GATT_TRACE_RSSI | (error ? CODELESS_GATT_TRACE_ERROR : 0) attribute:0 data:[NSData dataWithBytes:&rssi length:1]];
+    [self.delegate peripheral:peripheral didReadRSSI:RSSI error:error];
+}
+
+@end
+
+
+/// Parsed GATT trace record.
+typedef struct {
+    int type;
+    int attribute;
+    uint32_t delta;
+    NSRange data;
+    NSUInteger size;
+} CodelessGattTraceRecord;
+
+/// Parses the record at the specified position. Returns <code>false</code> at the end of the trace.
+static BOOL parseTraceRecord(NSData* trace, NSUInteger position, CodelessGattTraceRecord* record) {
+    if (position + CODELESS_GATT_TRACE_RECORD_HEADER_SIZE > trace.length)
+        return false;
+    const uint8_t* header = (const uint8_t*) trace.bytes + position;
+    uint16_t length = header[6] | header[7] << 8;
+    if (position + CODELESS_GATT_TRACE_RECORD_HEADER_SIZE + length > trace.length)
+        return false;
+    record->type = header[0];
+    record->attribute = header[1];
+    record->delta = header[2] | header[3] << 8 | header[4] << 16 | (uint32_t) header[5] << 24;
+    record->data = NSMakeRange(position + CODELESS_GATT_TRACE_RECORD_HEADER_SIZE, length);
+    record->size = CODELESS_GATT_TRACE_RECORD_HEADER_SIZE + length;
+    return true;
+}
+
+
+@interface CodelessGattReplay ()
+
+@property (nonatomic) NSUUID* identifier;
+@property NSData* trace;
+@property NSUInteger position;
+@property (nullable) NSArray<CBService*>* services;
+@property NSArray<CBMutableService*>* traceServices;
+@property NSArray<CBMutableCharacteristic*>* traceCharacteristics;
+@property NSUInteger maxWriteLength;
+/// Operations issued by the manager that were not matched yet (type << 8 | attribute).
+@property NSMutableArray<NSNumber*>* issued;
+@property BOOL waiting;
+@property BOOL delayed;
+@property BOOL stopped;
+@property NSTimeInterval startTime;
+@property int records;
+@property int mismatches;
+@property NSTimeInterval duration;
+@property BOOL complete;
+
+@end
+
+@implementation CodelessGattReplay
+
+static NSString* const REPLAY_TAG = @"CodelessGattReplay";
+
++ (NSString*) TAG {
+    return REPLAY_TAG;
+}
+
+- (instancetype) initWithFile:(NSString*)file {
+    NSData* data = [NSData dataWithContentsOfFile:file];
+    if (!data) {
+        CodelessLog(REPLAY_TAG, "Failed to read trace file: %@", file);
+        return nil;
+    }
+    return self = [self initWithData:data];
+}
+
+- (instancetype) initWithData:(NSData*)data {
+    self = [super init];
+    if (!self)
+        return nil;
+    if (data.length < 4 || memcmp(data.bytes, CODELESS_GATT_TRACE_MAGIC, 4)) {
+        CodelessLog(REPLAY_TAG, "Invalid trace");
+        return nil;
+    }
+    self.identifier = [NSUUID UUID];
+    self.trace = data;
+    self.position = 4;
+    self.stallTimeout = 5;
+    self.issued = [NSMutableArray array];
+
+    initTraceUUIDs();
+    NSMutableArray<CBMutableCharacteristic*>* characteristics = [NSMutableArray array];
+    for (CBUUID* uuid in traceCharacteristicUUIDs)
+        [characteristics addObject:[[CBMutableCharacteristic alloc] initWithType:uuid properties:CBCharacteristicPropertyRead | CBCharacteristicPropertyWrite | CBCharacteristicPropertyNotify value:nil permissions:CBAttributePermissionsReadable | CBAttributePermissionsWriteable]];
+    self.traceCharacteristics = characteristics;
+    CBMutableService* codeless = [[CBMutableService alloc] initWithType:traceServiceUUIDs[CODELESS_GATT_TRACE_CODELESS_SERVICE] primary:true];
+    codeless.characteristics = [characteristics subarrayWithRange:NSMakeRange(CODELESS_GATT_TRACE_CODELESS_INBOUND, 3)];
+    CBMutableService* dsps = [[CBMutableService alloc] initWithType:traceServiceUUIDs[CODELESS_GATT_TRACE_DSPS_SERVICE] primary:true];
+    dsps.characteristics = [characteristics subarrayWithRange:NSMakeRange(CODELESS_GATT_TRACE_DSPS_SERVER_TX, 3)];
+    self.traceServices = @[ codeless, dsps ];
+
+    // The MTU is constant during a connection, use the first recorded value.
+    self.maxWriteLength = CODELESS_MTU_DEFAULT - 3;
+    CodelessGattTraceRecord record;
+    for (NSUInteger position = 4; parseTraceRecord(data, position, &record); position += record.size) {
+        if (record.type == CODELESS_GATT_TRACE_MTU && record.data.length >= 2) {
+            const uint8_t* value = (const uint8_t*) data.bytes + record.data.location;
+            self.maxWriteLength = value[0] | value[1] << 8;
+            break;
+        }
+    }
+    return self;
+}
+
+- (NSString*) description {
+    return [NSString stringWithFormat:@"REPLAY-%p", self];
+}
+
+/// The peripheral passed to the delegate (the manager's device, if any).
+- (CBPeripheral*) peripheral {
+    id delegate = self.delegate;
+    return [delegate isKindOfClass:CodelessManager.class] ? ((CodelessManager*) delegate).device : nil;
+}
+
+/// Called when the manager issues an operation.
+- (void) issue:(int)type attribute:(int)attribute {
+    if (self.stopped || attribute == CODELESS_GATT_TRACE_OTHER)
+        return;
+    [self.issued addObject:@(type << 8 | attribute)];
+    if (self.waiting) {
+        self.waiting = false;
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(onStall) object:nil];
+        [self step];
+    }
+}
+
+/// Replays the trace until an expected operation is not issued yet, or a callback is delivered.
+- (void) step {
+    CodelessGattTraceRecord record;
+    while (!self.stopped) {
+        if (!parseTraceRecord(self.trace, self.position, &record)) {
+            [self finish];
+            return;
+        }
+
+        // Skip attributes that are not replayed
+        if (record.attribute == CODELESS_GATT_TRACE_OTHER) {
+            self.position += record.size;
+            continue;
+        }
+
+        int type = record.type & ~CODELESS_GATT_TRACE_ERROR;
+        if (type < CODELESS_GATT_TRACE_SERVICES_DISCOVERED) {
+            if (!self.issued.count) {
+                self.waiting = true;
+                [self performSelector:@selector(onStall) withObject:nil afterDelay:self.stallTimeout];
+                return;
+            }
+            if (self.issued.firstObject.intValue != (type << 8 | record.attribute)) {
+                CodelessLogSubsystem(CODELESS_LOG_GATT_OPERATION, REPLAY_TAG, "%@ Operation mismatch: expected %02x:%02x", self, type, record.attribute);
+                self.mismatches++;
+            }
+            [self.issued removeObjectAtIndex:0];
+            self.position += record.size;
+            self.records++;
+            if (type == CODELESS_GATT_TRACE_CONNECT) {
+                CodelessManager* manager = (CodelessManager*) self.delegate;
+                [manager onConnection:[[CodelessDeviceConnectedEvent alloc] initWithManager:manager.bluetoothManager device:manager.device]];
+            }
+            continue;
+        }
+
+        if (self.realTime && record.delta && !self.delayed) {
+            self.delayed = true;
+            [self performSelector:@selector(step) withObject:nil afterDelay:record.delta / 1000000.];
+            return;
+        }
+        self.delayed = false;
+        self.position += record.size;
+        self.records++;
+        [self deliver:record];
+
+        // Let the manager process the callback before the next one
+        __weak CodelessGattReplay* weakSelf = self;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [weakSelf step];
+        });
+        return;
+    }
+}
+
+/// Skips an expected operation that was not issued by the manager.
+- (void) onStall {
+    if (!self.waiting)
+        return;
+    CodelessLog(REPLAY_TAG, "%@ Stalled, skip expected operation", self);
+    self.waiting = false;
+    self.mismatches++;
+    CodelessGattTraceRecord record;
+    if (parseTraceRecord(self.trace, self.position, &record)) {
+        self.position += record.size;
+        self.records++;
+    }
+    [self step];
+}
+
+/// Delivers a recorded callback to the manager.
+- (void) deliver:(CodelessGattTraceRecord)record {
+    NSError* error = record.type & CODELESS_GATT_TRACE_ERROR ? [NSError errorWithDomain:CBErrorDomain code:CBErrorUnknown userInfo:nil] : nil;
+    NSData* data = [self.trace subdataWithRange:record.data];
+    BOOL characteristic = record.attribute < CODELESS_GATT_TRACE_CHARACTERISTIC_COUNT;
+    BOOL service = record.attribute < CODELESS_GATT_TRACE_SERVICE_COUNT;
+
+    switch (record.type & ~CODELESS_GATT_TRACE_ERROR) {
+        case CODELESS_GATT_TRACE_SERVICES_DISCOVERED: {
+            NSMutableArray<CBService*>* services = [NSMutableArray array];
+            for (int i = 0; i < data.length; ++i) {
+                uint8_t index = ((const uint8_t*) data.bytes)[i];
+                if (index < CODELESS_GATT_TRACE_SERVICE_COUNT)
+                    [services addObject:self.traceServices[index]];
+            }
+            self.services = services;
+            [self.delegate peripheral:self.peripheral didDiscoverServices:error];
+            break;
+        }
+        case CODELESS_GATT_TRACE_CHARACTERISTICS_DISCOVERED:
+            if (service)
+                [self.delegate peripheral:self.peripheral didDiscoverCharacteristicsForService:self.traceServices[record.attribute] error:error];
+            break;
+        case CODELESS_GATT_TRACE_NOTIFY_STATE:
+            if (characteristic)
+                [self.delegate peripheral:self.peripheral didUpdateNotificationStateForCharacteristic:self.traceCharacteristics[record.attribute] error:error];
+            break;
+        case CODELESS_GATT_TRACE_VALUE:
+            if (characteristic) {
+                self.traceCharacteristics[record.attribute].value = data;
+                [self.delegate peripheral:self.peripheral didUpdateValueForCharacteristic:self.traceCharacteristics[record.attribute] error:error];
+            }
+            break;
+        case CODELESS_GATT_TRACE_WRITTEN:
+            if (characteristic)
+                [self.delegate peripheral:self.peripheral didWriteValueForCharacteristic:self.traceCharacteristics[record.attribute] error:error];
+            break;
+        case CODELESS_GATT_TRACE_READY_TO_SEND:
+            [self.delegate peripheralIsReadyToSendWriteWithoutResponse:self.peripheral];
+            break;
+        case CODELESS_GATT_TRACE_RSSI:
+            [self.delegate peripheral:self.peripheral didReadRSSI:@(data.length ? ((const int8_t*) data.bytes)[0] : 0) error:error];
+            break;
+    }
+}
+
+/// Called when the end of the trace is reached.
+- (void) finish {
+    if (self.complete)
+        return;
+    self.complete = true;
+    self.duration = NSProcessInfo.processInfo.systemUptime - self.startTime;
+    CodelessLog(REPLAY_TAG, "%@ Replay complete: %d records, %d mismatches, %.3f s", self, self.records, self.mismatches, self.duration);
+    if (self.completion)
+        self.completion(self);
+}
+
+#pragma mark - CodelessTransport
+
+- (void) connect {
+    if (self.startTime)
+        return;
+    self.startTime = NSProcessInfo.processInfo.systemUptime;
+    [self issue:CODELESS_GATT_TRACE_CONNECT attribute:0];
+    [self step];
+}
+
+- (void) disconnect {
+    if (self.stopped)
+        return;
+    self.stopped = true;
+    self.waiting = false;
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        CodelessManager* manager = (CodelessManager*) self.delegate;
+        [manager onDisconnection:[[CodelessDeviceDisconnectedEvent alloc] initWithManager:manager.bluetoothManager device:manager.device error:nil]];
+    });
+}
+
+- (void) discoverServices:(NSArray<CBUUID*>*)serviceUUIDs {
+    [self issue:CODELESS_GATT_TRACE_DISCOVER_SERVICES attribute:0];
+}
+
+- (void) discoverCharacteristics:(NSArray<CBUUID*>*)characteristicUUIDs forService:(CBService*)service {
+    [self issue:CODELESS_GATT_TRACE_DISCOVER_CHARACTERISTICS attribute:[CodelessGattRecorder serviceIndex:service.UUID]];
+}
+
+- (void) setNotifyValue:(BOOL)enabled forCharacteristic:(CBCharacteristic*)characteristic {
+    [self issue:CODELESS_GATT_TRACE_SET_NOTIFY attribute:[CodelessGattRecorder characteristicIndex:characteristic.UUID]];
+}
+
+- (void) readValueForCharacteristic:(CBCharacteristic*)characteristic {
+    [self issue:CODELESS_GATT_TRACE_READ attribute:[CodelessGattRecorder characteristicIndex:characteristic.UUID]];
+}
+
+- (void) writeValue:(NSData*)data forCharacteristic:(CBCharacteristic*)characteristic type:(CBCharacteristicWriteType)type {
+    [self issue:type == CBCharacteristicWriteWithResponse ? CODELESS_GATT_TRACE_WRITE : CODELESS_GATT_TRACE_WRITE_COMMAND attribute:[CodelessGattRecorder characteristicIndex:characteristic.UUID]];
+}
+
+- (NSUInteger) maximumWriteValueLengthForType:(CBCharacteristicWriteType)type {
+    [self issue:CODELESS_GATT_TRACE_MTU attribute:0];
+    return self.maxWriteLength;
+}
+
+- (void) readRSSI {
+    [self issue:CODELESS_GATT_TRACE_READ_RSSI attribute:0];
+}
+
+@end
@@ -0,0 +1,80 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Latency histogram with logarithmic buckets and bounded relative error (similar to HdrHistogram).
+ *
+ * Values are recorded with microsecond resolution. Values below 32us are recorded exactly, larger values
+ * are recorded in 16 linear sub-buckets per power of two, so the relative error is less than 1/16.
+ * The histogram uses a fixed amount of memory and recording a value does not allocate.
+ * <p> Used by {@link CodelessManager} to track the latency of sent commands, per {@link CodelessProfile#CODELESS_COMMAND_ID command ID}.
+ */
+@interface CodelessLatencyHistogram : NSObject <NSCopying>
+
+/// The number of recorded values.
+@property (readonly) int64_t count;
+/// The minimum recorded value (seconds).
+@property (readonly) NSTimeInterval min;
+/// The maximum recorded value (seconds).
+@property (readonly) NSTimeInterval max;
+/// The mean of the recorded values (seconds).
+@property (readonly) NSTimeInterval mean;
+
+/**
+ * Records a value.
+ * @param latency the value to record (seconds)
+ */
+- (void) record:(NSTimeInterval)latency;
+/**
+ * Returns the value at the specified percentile.
+ * @param percentile the percentile (0-100)
+ * @return the value (seconds), which is the upper bound of the matching bucket, or 0 if there are no recorded values
+ */
+- (NSTimeInterval) percentile:(double)percentile;
+/**
+ * Adds the values of another histogram to this one.
+ * @param histogram the histogram to add
+ */
+- (void) add:(CodelessLatencyHistogram*)histogram;
+/// Removes all recorded values.
+- (void) reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
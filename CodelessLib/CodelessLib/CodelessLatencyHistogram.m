@@ -0,0 +1,150 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessLatencyHistogram.h"
+
+#define HISTOGRAM_SUB_BUCKET_BITS 4
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BUCKET_BITS)
+#define HISTOGRAM_LINEAR_LIMIT (2 * HISTOGRAM_SUB_BUCKETS)
+// Values up to 2^40us (about 12 days).
+#define HISTOGRAM_BUCKETS (HISTOGRAM_SUB_BUCKETS * (40 - HISTOGRAM_SUB_BUCKET_BITS + 1))
+
+@interface CodelessLatencyHistogram () {
+    int64_t counts[HISTOGRAM_BUCKETS];
+    uint64_t minValue;
+    uint64_t maxValue;
+    double total;
+}
+
+@property int64_t count;
+
+@end
+
+@implementation CodelessLatencyHistogram
+
+- (instancetype) init {
+    self = [super init];
+    if (!self)
+        return nil;
+    [self reset];
+    return self;
+}
+
+- (id) copyWithZone:(NSZone*)zone {
+    CodelessLatencyHistogram* copy = [[CodelessLatencyHistogram allocWithZone:zone] init];
+    [copy add:self];
+    return copy;
+}
+
+/// Returns the bucket index for a value (microseconds).
+static int bucketIndex(uint64_t value) {
+    if (value < HISTOGRAM_LINEAR_LIMIT)
+        return (int) value;
+    int shift = 63 - __builtin_clzll(value) - HISTOGRAM_SUB_BUCKET_BITS;
+    int index = HISTOGRAM_SUB_BUCKETS * shift + (int) (value >> shift);
+    return MIN(index, HISTOGRAM_BUCKETS - 1);
+}
+
+/// Returns the highest value (microseconds) that is recorded in a bucket.
+static uint64_t bucketValue(int index) {
+    if (index < HISTOGRAM_LINEAR_LIMIT)
+        return index;
+    int shift = index / HISTOGRAM_SUB_BUCKETS - 1;
+    uint64_t sub = index % HISTOGRAM_SUB_BUCKETS + HISTOGRAM_SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+- (void) record:(NSTimeInterval)latency {
+    uint64_t value = latency > 0 ? (uint64_t) (latency * 1000000) : 0;
+    counts[bucketIndex(value)]++;
+    if (value < minValue)
+        minValue = value;
+    if (value > maxValue)
+        maxValue = value;
+    total += value;
+    self.count++;
+}
+
+- (NSTimeInterval) percentile:(double)percentile {
+    if (!self.count)
+        return 0;
+    int64_t target = (int64_t) ceil(MAX(0, MIN(percentile, 100)) / 100. * self.count);
+    if (target < 1)
+        target = 1;
+    int64_t sum = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        sum += counts[i];
+        if (sum >= target)
+            return MIN(bucketValue(i), maxValue) / 1000000.;
+    }
+    return maxValue / 1000000.;
+}
+
+- (void) add:(CodelessLatencyHistogram*)histogram {
+    if (!histogram.count)
+        return;
+    for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+        counts[i] += histogram->counts[i];
+    minValue = MIN(minValue, histogram->minValue);
+    maxValue = MAX(maxValue, histogram->maxValue);
+    total += histogram->total;
+    self.count += histogram.count;
+}
+
+- (void) reset {
+    memset(counts, 0, sizeof(counts));
+    minValue = UINT64_MAX;
+    maxValue = 0;
+    total = 0;
+    self.count = 0;
+}
+
+- (NSTimeInterval) min {
+    return self.count ? minValue / 1000000. : 0;
+}
+
+- (NSTimeInterval) max {
+    return maxValue / 1000000.;
+}
+
+- (NSTimeInterval) mean {
+    return self.count ? total / self.count / 1000000. : 0;
+}
+
+- (NSString*) description {
+    return [NSString stringWithFormat:@"count=%lld min=%.1fms p50=%.1fms p90=%.1fms p99=%.1fms max=%.1fms", self.count, self.min * 1000, [self percentile:50] * 1000, [self percentile:90] * 1000, [self percentile:99] * 1000, self.max * 1000];
+}
+
+@end
@@ -37,18 +37,29 @@
 
 #import "CodelessBluetoothManager.h"
 #import "CodelessCommands.h"
+#import "CodelessCompiledScript.h"
+#import "CodelessConnectionPool.h"
+#import "CodelessCoreBluetooth.h"
+#import "CodelessGattTrace.h"
+#import "CodelessLatencyHistogram.h"
 #import "CodelessLibConfig.h"
 #import "CodelessLibEvent.h"
 #import "CodelessLibLog.h"
 #import "CodelessManager.h"
+#import "CodelessMetrics.h"
 #import "CodelessProfile.h"
+#import "CodelessProvisioning.h"
+#import "CodelessScanFilter.h"
 #import "CodelessScript.h"
+#import "CodelessSimulatedPeer.h"
+#import "CodelessTransport.h"
 #import "CodelessUtil.h"
 #import "command/CodelessAdcReadCommand.h"
 #import "command/CodelessAdvertisingDataCommand.h"
 #import "command/CodelessAdvertisingResponseCommand.h"
 #import "command/CodelessAdvertisingStartCommand.h"
 #import "command/CodelessAdvertisingStopCommand.h"
+#import "command/CodelessArgumentParser.h"
 #import "command/CodelessBasicCommand.h"
 #import "command/CodelessBatteryLevelCommand.h"
 #import "command/CodelessBaudRateCommand.h"
@@ -112,6 +123,10 @@
 #import "dsps/DspsFileSend.h"
 #import "dsps/DspsFileReceive.h"
 #import "dsps/DspsPeriodicSend.h"
+#import "dsps/DspsRxAggregator.h"
+#import "dsps/DspsStats.h"
+#import "log/CodelessLogBackend.h"
+#import "log/DspsCaptureFile.h"
 
 /**
  * Main import file of the CodeLess library.
@@ -41,6 +41,16 @@ NS_ASSUME_NONNULL_BEGIN
 
 
 #define CODELESS_LIB_CONFIG_SCAN_DURATION   10000 // ms
+/// Aggregate scan results per device, reporting each device once per report interval, instead of once per advertising event.
+#define CODELESS_LIB_CONFIG_SCAN_AGGREGATION   false
+/// Report interval for aggregated scan results.
+#define CODELESS_LIB_CONFIG_SCAN_REPORT_INTERVAL   1000 // ms
+/// Maximum number of aggregated scan records. If the table is full, the least recently seen device is removed.
+#define CODELESS_LIB_CONFIG_SCAN_RECORD_MAX   1024
+/// Aggregated scan records of devices that were not seen for this time are removed.
+#define CODELESS_LIB_CONFIG_SCAN_RECORD_TIMEOUT   60000 // ms
+/// Beacon types that are reported in scan results ({@link CodelessAdvData#CODELESS_BEACON} flags). Other beacons are dropped before any event is generated.
+#define CODELESS_LIB_CONFIG_SCAN_BEACONS   0x7f // all beacon types
 
 /// ATI command response (if <code>nil</code>, the app version is used).
 #define CODELESS_LIB_CONFIG_INFO nil
@@ -71,6 +81,18 @@ NS_ASSUME_NONNULL_BEGIN
 #define CODELESS_LIB_CONFIG_DSPS_RX_LOG_FLUSH   true
 /// Prefix used for the DSPS received data log file name.
 #define CODELESS_LIB_CONFIG_DSPS_RX_LOG_FILE_PREFIX   @"DSPS_RX_"
+/// Enable {@link DspsCaptureFile DSPS capture file}: a memory-mapped ring buffer of timestamped DSPS records (received and sent data, flow control).
+#define CODELESS_LIB_CONFIG_DSPS_CAPTURE   false
+/// DSPS capture file size. The file is preallocated, and the oldest records are overwritten when it is full.
+#define CODELESS_LIB_CONFIG_DSPS_CAPTURE_SIZE   8388608 // bytes
+/// Prefix used for the DSPS capture file name.
+#define CODELESS_LIB_CONFIG_DSPS_CAPTURE_FILE_PREFIX   @"DSPS_CAPTURE_"
+/// Buffer size of the {@link DspsRxAggregator DSPS RX aggregator}. Frames are handed to the writer in blocks of this size.
+#define CODELESS_LIB_CONFIG_DSPS_RX_AGGREGATE_BUFFER_SIZE   65536 // bytes
+/// Maximum time that frames stay in the {@link DspsRxAggregator DSPS RX aggregator} buffer before they are handed to the writer (ms).
+#define CODELESS_LIB_CONFIG_DSPS_RX_AGGREGATE_FLUSH_INTERVAL   500 // ms
+/// Maximum amount of data waiting to be written by the {@link DspsRxAggregator DSPS RX aggregator}. Incoming data are dropped (and counted) while it is exceeded.
+#define CODELESS_LIB_CONFIG_DSPS_RX_AGGREGATE_MAX_PENDING   4194304 // bytes
 
 /**
  * Enable priority for DSPS send data GATT operations.
@@ -83,6 +105,14 @@ NS_ASSUME_NONNULL_BEGIN
 #define CODELESS_LIB_CONFIG_GATT_DEQUEUE_BEFORE_PROCESSING   true
 /// Monitor Bluetooth state and perform required actions.
 #define CODELESS_LIB_CONFIG_BLUETOOTH_STATE_MONITOR   true
+/// Post the events generated by each {@link CodelessManager} as notifications. The manager {@link CodelessManager#delegate delegate} and event observers are always called.
+#define CODELESS_LIB_CONFIG_EVENT_NOTIFICATIONS   true
+/// Maximum number of concurrent connections managed by a {@link CodelessConnectionPool}.
+#define CODELESS_LIB_CONFIG_POOL_MAX_CONNECTIONS   4
+/// Time to wait for a pooled device to become ready, before the connection attempt is considered failed (0 to disable).
+#define CODELESS_LIB_CONFIG_POOL_CONNECT_TIMEOUT   10000 // ms
+/// Number of times a failed pooled connection is retried, before the queued tasks of the device are dropped.
+#define CODELESS_LIB_CONFIG_POOL_CONNECT_RETRIES   2
 
 // WARNING: Modifying these may cause parse failure on peer device.
 /// Used character set for conversion between text and bytes.
@@ -110,9 +140,31 @@ NS_ASSUME_NONNULL_BEGIN
 #define CODELESS_LIB_CONFIG_DISALLOW_INVALID_PREFIX   true
 /// Automatically add the AT command prefix (if missing).
 #define CODELESS_LIB_CONFIG_AUTO_ADD_PREFIX   true
+/**
+ * Default timeout for sent commands, if the peer device does not respond (0 to disable). Command classes may override it.
+ * <p> When a command times out, the next command is sent after the {@link #COMMAND_LATE_RESPONSE_WINDOW late response window}.
+ * If the peer device responds before the next command is sent, the late response is dropped (up to the <code>OK</code> or <code>ERROR</code>),
+ * so that it is not parsed as the response of the next command. If the late response arrives after the next command is sent,
+ * the command responses may still get out of sync. Use a timeout that is well above the expected response time.
+ */
+#define CODELESS_LIB_CONFIG_COMMAND_TIMEOUT   10000 // ms
+/// Timeout for long running commands (for example, <code>AT+CMDPLAY</code>, <code>AT+I2CSCAN</code>, <code>AT+GAPSCAN</code>, <code>AT+GAPCONNECT</code>, <code>AT+BINREQ</code>, unidentified commands).
+#define CODELESS_LIB_CONFIG_COMMAND_TIMEOUT_LONG   60000 // ms
+/// After a command timeout, delay for sending the next queued command. Lines received in the meantime (up to the final response) are dropped as the late response of the timed out command.
+#define CODELESS_LIB_CONFIG_COMMAND_LATE_RESPONSE_WINDOW   1000 // ms
+/// Record the response latency of sent commands and generate {@link CodelessLibEvent#CommandStats CommandStats} events.
+#define CODELESS_LIB_CONFIG_COMMAND_STATS   true
+/// Command statistics update interval.
+#define CODELESS_LIB_CONFIG_COMMAND_STATS_INTERVAL   10000 // ms
+/// Generate periodic {@link CodelessLibEvent#Metrics Metrics} events with a snapshot of the manager counters.
+#define CODELESS_LIB_CONFIG_METRICS_EVENT   false
+/// Metrics event interval.
+#define CODELESS_LIB_CONFIG_METRICS_INTERVAL   10000 // ms
 
 /// Enable {@link CodelessLibEvent#Line Line} events.
 #define CODELESS_LIB_CONFIG_LINE_EVENTS   true
+/// Maximum number of consecutive script control statements that do not send a command or wait (infinite loop protection).
+#define CODELESS_LIB_CONFIG_SCRIPT_MAX_CONTROL_STEPS   10000
 
 /// Start in command mode operation, if the peer device supports CodeLess.
 #define CODELESS_LIB_CONFIG_START_IN_COMMAND_MODE   true
@@ -166,12 +218,22 @@ NS_ASSUME_NONNULL_BEGIN
 /// Log receive file operation data to the DSPS RX log file (if {@link #DSPS_RX_LOG enabled}).
 #define CODELESS_LIB_CONFIG_DSPS_RX_FILE_LOG_DATA   false
 /// Received file header pattern, used to detect the file header, if a receive file operation is active.
-#define CODELESS_LIB_CONFIG_DSPS_RX_FILE_HEADER_PATTERN_STRING   @"(?s)(.{0,100})Name:\\s*(\\S{1,100})\\s*Size:\\s*(\\d{1,9})\\s*(?:CRC:\\s*([0-9a-f]{8})\\s*)?(?:\\x00|END\\s*)(.*)" // <ignored> <name> <size> <crc> <data>
+#define CODELESS_LIB_CONFIG_DSPS_RX_FILE_HEADER_PATTERN_STRING   @"(?s)(.{0,100})Name:\\s*(\\S{1,100})\\s*Size:\\s*(\\d{1,18})\\s*(?:CRC:\\s*([0-9a-f]{8})\\s*)?(?:Compression:\\s*(deflate)\\s*)?(?:\\x00|END\\s*)(.*)" // <ignored> <name> <size> <crc> <compression> <data>
+/// Compression level (1-9) used by DSPS file send operations with {@link DspsFileSend#compressed compression} enabled.
+#define CODELESS_LIB_CONFIG_DSPS_FILE_COMPRESSION_LEVEL   6
 
 /// Enable DSPS statistics calculation.
 #define CODELESS_LIB_CONFIG_DSPS_STATS   true
 /// DSPS statistics update interval (ms).
 #define CODELESS_LIB_CONFIG_DSPS_STATS_INTERVAL   1000 // ms
+/// Number of {@link #DSPS_STATS_INTERVAL statistics intervals} used for the sliding window current speed calculation.
+#define CODELESS_LIB_CONFIG_DSPS_STATS_WINDOW   5
+/// Smoothing factor (0-1) of the exponentially weighted moving average speed. Higher values follow speed changes faster.
+#define CODELESS_LIB_CONFIG_DSPS_STATS_EWMA_ALPHA   0.25
+/// Coalesce high rate DSPS events ({@link CodelessLibEvent#DspsRxData DspsRxData}, {@link CodelessLibEvent#DspsFileChunk DspsFileChunk}, {@link CodelessLibEvent#DspsPatternChunk DspsPatternChunk}). If disabled, an event is generated for each packet.
+#define CODELESS_LIB_CONFIG_DSPS_EVENT_COALESCING   false
+/// Time window for coalescing DSPS events (ms). If 0, the events are coalesced per run loop turn.
+#define CODELESS_LIB_CONFIG_DSPS_EVENT_COALESCING_INTERVAL   0 // ms
 
 /// Check the timer index value in command arguments.
 #define CODELESS_LIB_CONFIG_CHECK_TIMER_INDEX   true
@@ -287,6 +349,17 @@ NS_ASSUME_NONNULL_BEGIN
 /// Configuration options that configure the library behavior.
 @interface CodelessLibConfig : NSObject
 
+/// Aggregate scan results per device, reporting each device once per report interval, instead of once per advertising event.
+@property (class, readonly) BOOL SCAN_AGGREGATION;
+/// Report interval for aggregated scan results.
+@property (class, readonly) int SCAN_REPORT_INTERVAL;
+/// Maximum number of aggregated scan records. If the table is full, the least recently seen device is removed.
+@property (class, readonly) int SCAN_RECORD_MAX;
+/// Aggregated scan records of devices that were not seen for this time are removed.
+@property (class, readonly) int SCAN_RECORD_TIMEOUT;
+/// Beacon types that are reported in scan results ({@link CodelessAdvData#CODELESS_BEACON} flags). Other beacons are dropped before any event is generated.
+@property (class, readonly) int SCAN_BEACONS;
+
 /// ATI command response (if <code>nil</code>, the app version is used).
 @property (class, readonly) NSString* CODELESS_LIB_INFO;
 
@@ -316,6 +389,18 @@ NS_ASSUME_NONNULL_BEGIN
 @property (class, readonly) BOOL DSPS_RX_LOG_FLUSH;
 /// Prefix used for the DSPS received data log file name.
 @property (class, readonly) NSString* DSPS_RX_LOG_FILE_PREFIX;
+/// Enable {@link DspsCaptureFile DSPS capture file}: a memory-mapped ring buffer of timestamped DSPS records (received and sent data, flow control).
+@property (class, readonly) BOOL DSPS_CAPTURE;
+/// DSPS capture file size. The file is preallocated, and the oldest records are overwritten when it is full.
+@property (class, readonly) int DSPS_CAPTURE_SIZE;
+/// Prefix used for the DSPS capture file name.
+@property (class, readonly) NSString*DSPS_CAPTURE_FILE_PREFIX;
+/// Buffer size of the {@link DspsRxAggregator DSPS RX aggregator}. Frames are handed to the writer in blocks of this size.
+@property (class, readonly) int DSPS_RX_AGGREGATE_BUFFER_SIZE;
+/// Maximum time that frames stay in the {@link DspsRxAggregator DSPS RX aggregator} buffer before they are handed to the writer (ms).
+@property (class, readonly) int DSPS_RX_AGGREGATE_FLUSH_INTERVAL;
+/// Maximum amount of data waiting to be written by the {@link DspsRxAggregator DSPS RX aggregator}. Incoming data are dropped (and counted) while it is exceeded.
+@property (class, readonly) int DSPS_RX_AGGREGATE_MAX_PENDING;
 
 /**
  * Enable priority for DSPS send data GATT operations.
@@ -328,6 +413,14 @@ NS_ASSUME_NONNULL_BEGIN
 @property (class, readonly) BOOL GATT_DEQUEUE_BEFORE_PROCESSING;
 /// Monitor Bluetooth state and perform required actions.
 @property (class, readonly) BOOL BLUETOOTH_STATE_MONITOR;
+/// Post the events generated by each {@link CodelessManager} as notifications. The manager {@link CodelessManager#delegate delegate} and event observers are always called.
+@property (class, readonly) BOOL EVENT_NOTIFICATIONS;
+/// Maximum number of concurrent connections managed by a {@link CodelessConnectionPool}.
+@property (class, readonly) int POOL_MAX_CONNECTIONS;
+/// Time to wait for a pooled device to become ready, before the connection attempt is considered failed (0 to disable).
+@property (class, readonly) int POOL_CONNECT_TIMEOUT;
+/// Number of times a failed pooled connection is retried, before the queued tasks of the device are dropped.
+@property (class, readonly) int POOL_CONNECT_RETRIES;
 
 /// Used character set for conversion between text and bytes.
 @property (class, readonly) NSStringEncoding CHARSET;
@@ -354,9 +447,25 @@ NS_ASSUME_NONNULL_BEGIN
 @property (class, readonly) BOOL DISALLOW_INVALID_PREFIX;
 /// Automatically add the AT command prefix (if missing).
 @property (class, readonly) BOOL AUTO_ADD_PREFIX;
+/// Default timeout for sent commands, if the peer device does not respond (0 to disable). Command classes may override it.
+@property (class, readonly) int COMMAND_TIMEOUT;
+/// Timeout for long running commands (for example, <code>AT+CMDPLAY</code>, <code>AT+I2CSCAN</code>, <code>AT+GAPSCAN</code>, <code>AT+GAPCONNECT</code>, <code>AT+BINREQ</code>, unidentified commands).
+@property (class, readonly) int COMMAND_TIMEOUT_LONG;
+/// After a command timeout, delay for sending the next queued command. Lines received in the meantime (up to the final response) are dropped as the late response of the timed out command.
+@property (class, readonly) int COMMAND_LATE_RESPONSE_WINDOW;
+/// Record the response latency of sent commands and generate {@link CodelessLibEvent#CommandStats CommandStats} events.
+@property (class, readonly) BOOL COMMAND_STATS;
+/// Command statistics update interval.
+@property (class, readonly) int COMMAND_STATS_INTERVAL;
+/// Generate periodic {@link CodelessLibEvent#Metrics Metrics} events with a snapshot of the manager counters.
+@property (class, readonly) BOOL METRICS_EVENT;
+/// Metrics event interval.
+@property (class, readonly) int METRICS_INTERVAL;
 
 /// Enable {@link CodelessLibEvent#Line Line} events.
 @property (class, readonly) BOOL LINE_EVENTS;
+/// Maximum number of consecutive script control statements that do not send a command or wait (infinite loop protection).
+@property (class, readonly) int SCRIPT_MAX_CONTROL_STEPS;
 
 /// Start in command mode operation, if the peer device supports CodeLess.
 @property (class, readonly) BOOL START_IN_COMMAND_MODE;
@@ -414,11 +523,21 @@ NS_ASSUME_NONNULL_BEGIN
 /// Received file header pattern, used to detect the file header, if a receive file operation is active.
 @property (class, readonly) NSString* DSPS_RX_FILE_HEADER_PATTERN_STRING;
 @property (class, readonly) NSRegularExpression* DSPS_RX_FILE_HEADER_PATTERN;
+/// Compression level (1-9) used by DSPS file send operations with {@link DspsFileSend#compressed compression} enabled.
+@property (class, readonly) int DSPS_FILE_COMPRESSION_LEVEL;
 
 /// Enable DSPS statistics calculation.
 @property (class, readonly) BOOL DSPS_STATS;
 /// DSPS statistics update interval (ms).
 @property (class, readonly) int DSPS_STATS_INTERVAL;
+/// Number of {@link #DSPS_STATS_INTERVAL statistics intervals} used for the sliding window current speed calculation.
+@property (class, readonly) int DSPS_STATS_WINDOW;
+/// Smoothing factor (0-1) of the exponentially weighted moving average speed. Higher values follow speed changes faster.
+@property (class, readonly) float DSPS_STATS_EWMA_ALPHA;
+/// Coalesce high rate DSPS events ({@link CodelessLibEvent#DspsRxData DspsRxData}, {@link CodelessLibEvent#DspsFileChunk DspsFileChunk}, {@link CodelessLibEvent#DspsPatternChunk DspsPatternChunk}). If disabled, an event is generated for each packet.
+@property (class, readonly) BOOL DSPS_EVENT_COALESCING;
+/// Time window for coalescing DSPS events (ms). If 0, the events are coalesced per run loop turn.
+@property (class, readonly) int DSPS_EVENT_COALESCING_INTERVAL;
 
 /// Check the timer index value in command arguments.
 @property (class, readonly) BOOL CHECK_TIMER_INDEX;
@@ -149,6 +149,26 @@ static NSSet<NSNumber*>* hostCommands;
     ]];
 }
 
++ (BOOL) SCAN_AGGREGATION {
+    return CODELESS_LIB_CONFIG_SCAN_AGGREGATION;
+}
+
++ (int) SCAN_REPORT_INTERVAL {
+    return CODELESS_LIB_CONFIG_SCAN_REPORT_INTERVAL;
+}
+
++ (int) SCAN_RECORD_MAX {
+    return CODELESS_LIB_CONFIG_SCAN_RECORD_MAX;
+}
+
++ (int) SCAN_RECORD_TIMEOUT {
+    return CODELESS_LIB_CONFIG_SCAN_RECORD_TIMEOUT;
+}
+
++ (int) SCAN_BEACONS {
+    return CODELESS_LIB_CONFIG_SCAN_BEACONS;
+}
+
 + (NSString*) CODELESS_LIB_INFO {
     return CODELESS_LIB_CONFIG_INFO;
 }
@@ -205,6 +225,30 @@ static NSSet<NSNumber*>* hostCommands;
     return CODELESS_LIB_CONFIG_DSPS_RX_LOG_FILE_PREFIX;
 }
 
++ (BOOL) DSPS_CAPTURE {
+    return CODELESS_LIB_CONFIG_DSPS_CAPTURE;
+}
+
++ (int) DSPS_CAPTURE_SIZE {
+    return CODELESS_LIB_CONFIG_DSPS_CAPTURE_SIZE;
+}
+
++ (NSString*) DSPS_CAPTURE_FILE_PREFIX {
+    return CODELESS_LIB_CONFIG_DSPS_CAPTURE_FILE_PREFIX;
+}
+
++ (int) DSPS_RX_AGGREGATE_BUFFER_SIZE {
+    return CODELESS_LIB_CONFIG_DSPS_RX_AGGREGATE_BUFFER_SIZE;
+}
+
++ (int) DSPS_RX_AGGREGATE_FLUSH_INTERVAL {
+    return CODELESS_LIB_CONFIG_DSPS_RX_AGGREGATE_FLUSH_INTERVAL;
+}
+
++ (int) DSPS_RX_AGGREGATE_MAX_PENDING {
+    return CODELESS_LIB_CONFIG_DSPS_RX_AGGREGATE_MAX_PENDING;
+}
+
 + (BOOL) GATT_QUEUE_PRIORITY {
     return CODELESS_LIB_CONFIG_GATT_QUEUE_PRIORITY;
 }
@@ -217,6 +261,22 @@ static NSSet<NSNumber*>* hostCommands;
     return CODELESS_LIB_CONFIG_BLUETOOTH_STATE_MONITOR;
 }
 
++ (BOOL) EVENT_NOTIFICATIONS {
+    return CODELESS_LIB_CONFIG_EVENT_NOTIFICATIONS;
+}
+
++ (int) POOL_MAX_CONNECTIONS {
+    return CODELESS_LIB_CONFIG_POOL_MAX_CONNECTIONS;
+}
+
++ (int) POOL_CONNECT_TIMEOUT {
+    return CODELESS_LIB_CONFIG_POOL_CONNECT_TIMEOUT;
+}
+
++ (int) POOL_CONNECT_RETRIES {
+    return CODELESS_LIB_CONFIG_POOL_CONNECT_RETRIES;
+}
+
 + (NSStringEncoding) CHARSET {
     return CODELESS_LIB_CONFIG_CHARSET;
 }
@@ -265,10 +325,42 @@ static NSSet<NSNumber*>* hostCommands;
     return CODELESS_LIB_CONFIG_AUTO_ADD_PREFIX;
 }
 
++ (int) COMMAND_TIMEOUT {
+    return CODELESS_LIB_CONFIG_COMMAND_TIMEOUT;
+}
+
++ (int) COMMAND_TIMEOUT_LONG {
+    return CODELESS_LIB_CONFIG_COMMAND_TIMEOUT_LONG;
+}
+
++ (int) COMMAND_LATE_RESPONSE_WINDOW {
+    return CODELESS_LIB_CONFIG_COMMAND_LATE_RESPONSE_WINDOW;
+}
+
++ (BOOL) COMMAND_STATS {
+    return CODELESS_LIB_CONFIG_COMMAND_STATS;
+}
+
++ (int) COMMAND_STATS_INTERVAL {
+    return CODELESS_LIB_CONFIG_COMMAND_STATS_INTERVAL;
+}
+
++ (BOOL) METRICS_EVENT {
+    return CODELESS_LIB_CONFIG_METRICS_EVENT;
+}
+
++ (int) METRICS_INTERVAL {
+    return CODELESS_LIB_CONFIG_METRICS_INTERVAL;
+}
+
 + (BOOL) LINE_EVENTS {
     return CODELESS_LIB_CONFIG_LINE_EVENTS;
 }
 
++ (int) SCRIPT_MAX_CONTROL_STEPS {
+    return CODELESS_LIB_CONFIG_SCRIPT_MAX_CONTROL_STEPS;
+}
+
 + (BOOL) START_IN_COMMAND_MODE {
     return CODELESS_LIB_CONFIG_START_IN_COMMAND_MODE;
 }
@@ -345,6 +437,10 @@ static NSSet<NSNumber*>* hostCommands;
     return DSPS_RX_FILE_HEADER_PATTERN;
 }
 
++ (int) DSPS_FILE_COMPRESSION_LEVEL {
+    return CODELESS_LIB_CONFIG_DSPS_FILE_COMPRESSION_LEVEL;
+}
+
 + (BOOL) DSPS_STATS {
     return CODELESS_LIB_CONFIG_DSPS_STATS;
 }
@@ -353,6 +449,22 @@ static NSSet<NSNumber*>* hostCommands;
     return CODELESS_LIB_CONFIG_DSPS_STATS_INTERVAL;
 }
 
++ (int) DSPS_STATS_WINDOW {
+    return CODELESS_LIB_CONFIG_DSPS_STATS_WINDOW;
+}
+
++ (float) DSPS_STATS_EWMA_ALPHA {
+    return CODELESS_LIB_CONFIG_DSPS_STATS_EWMA_ALPHA;
+}
+
++ (BOOL) DSPS_EVENT_COALESCING {
+    return CODELESS_LIB_CONFIG_DSPS_EVENT_COALESCING;
+}
+
++ (int) DSPS_EVENT_COALESCING_INTERVAL {
+    return CODELESS_LIB_CONFIG_DSPS_EVENT_COALESCING_INTERVAL;
+}
+
 + (BOOL) CHECK_TIMER_INDEX {
     return CODELESS_LIB_CONFIG_CHECK_TIMER_INDEX;
 }
@@ -37,6 +37,8 @@
 
 @class CodelessManager;
 @class CodelessCommand;
+@class CodelessLatencyHistogram;
+@class CodelessMetrics;
 @class CodelessDeviceInformationCommand;
 @class CodelessUartEchoCommand;
 @class CodelessBinEscCommand;
@@ -91,6 +93,8 @@
 @class CBUUID;
 @class CodelessLine;
 @class CodelessScript;
+@class CodelessProvisioning;
+@class CodelessProvisioningStep;
 @class DspsFileSend;
 @class DspsFileReceive;
 @class DspsPeriodicSend;
@@ -203,6 +207,18 @@ NS_ASSUME_NONNULL_BEGIN
 /// @see CodelessScriptCommandEvent
 @property (class, readonly) NSString* ScriptCommand;
 
+/// Event generated when a step of a {@link CodelessProvisioning provisioning} operation is complete.
+/// @see CodelessProvisioningStepEvent
+@property (class, readonly) NSString* ProvisioningStep;
+
+/// Event generated when a {@link CodelessProvisioning provisioning} operation is complete.
+/// @see CodelessProvisioningEndEvent
+@property (class, readonly) NSString* ProvisioningEnd;
+
+/// Event generated when a {@link CodelessConnectionPool connection pool} fails to connect to a device, after all retries.
+/// @see CodelessPoolConnectionFailedEvent
+@property (class, readonly) NSString* PoolConnectionFailed;
+
 /// Event generated when the sent AT command completes successfully.
 /// @see CodelessCommandSuccessEvent
 @property (class, readonly) NSString* CommandSuccess;
@@ -211,6 +227,14 @@ NS_ASSUME_NONNULL_BEGIN
 /// @see CodelessCommandErrorEvent
 @property (class, readonly) NSString* CommandError;
 
+/// Event generated periodically with the response latency statistics of the sent AT commands.
+/// @see CodelessCommandStatsEvent
+@property (class, readonly) NSString* CommandStats;
+
+/// Event generated periodically with a snapshot of the manager {@link CodelessMetrics metrics}.
+/// @see CodelessMetricsEvent
+@property (class, readonly) NSString* Metrics;
+
 /// Event generated after <code>AT+</code> command completes successfully.
 /// @see CodelessPingEvent
 @property (class, readonly) NSString* Ping;
@@ -485,9 +509,16 @@ NS_ASSUME_NONNULL_BEGIN
 @property CBPeripheral* device;
 /// Parsed advertising data from the advertising event.
 @property CodelessAdvData* advData;
-/// The RSSI of the received advertising event.
+/// The RSSI of the received advertising event (the last one, if {@link CodelessBluetoothManager#scanAggregation aggregated}).
 @property NSNumber* rssi;
+/// The average RSSI of the aggregated advertising events (same as {@link #rssi} if not aggregated).
+@property NSNumber* rssiAverage;
+/// The number of aggregated advertising events (1 if not aggregated).
+@property int count;
+/// <code>true</code> if the advertising data changed since the previous event for the device.
+@property BOOL advDataChanged;
 - (instancetype) initWithManager:(CodelessBluetoothManager*)manager device:(CBPeripheral*)device advData:(CodelessAdvData*)advData rssi:(NSNumber*)rssi;
+- (instancetype) initWithManager:(CodelessBluetoothManager*)manager device:(CBPeripheral*)device advData:(CodelessAdvData*)advData rssi:(NSNumber*)rssi rssiAverage:(NSNumber*)rssiAverage count:(int)count advDataChanged:(BOOL)advDataChanged;
 @end
 
 
@@ -579,6 +610,8 @@ enum CODELESS_ERROR {
     CODELESS_ERROR_INVALID_PREFIX = 4,
     /// The command is invalid (for example, missing or invalid arguments).
     CODELESS_ERROR_INVALID_COMMAND = 5,
+    /// The peer device did not respond to the sent command in time.
+    CODELESS_ERROR_COMMAND_TIMEOUT = 6,
 };
 
 @end
@@ -675,6 +708,39 @@ enum CODELESS_ERROR {
 @end
 
 
+/// Event generated when a step of a {@link CodelessProvisioning provisioning} operation is complete.
+/// @see CodelessLibEvent#ProvisioningStep
+@interface CodelessProvisioningStepEvent : CodelessEvent
+/// The provisioning operation.
+@property CodelessProvisioning* provisioning;
+/// The provisioning step that is complete.
+@property CodelessProvisioningStep* step;
+- (instancetype) initWithProvisioning:(CodelessProvisioning*)provisioning step:(CodelessProvisioningStep*)step;
+@end
+
+
+/// Event generated when a {@link CodelessProvisioning provisioning} operation is complete.
+/// @see CodelessLibEvent#ProvisioningEnd
+@interface CodelessProvisioningEndEvent : CodelessEvent
+/// The provisioning operation that is complete.
+@property CodelessProvisioning* provisioning;
+/// <code>true</code> if one of the provisioning steps failed, <code>false</code> otherwise.
+@property BOOL error;
+- (instancetype) initWithProvisioning:(CodelessProvisioning*)provisioning error:(BOOL)error;
+@end
+
+
+/// Event generated when a {@link CodelessConnectionPool connection pool} fails to connect to a device, after all retries.
+/// @see CodelessLibEvent#PoolConnectionFailed
+@interface CodelessPoolConnectionFailedEvent : CodelessEvent
+/// The number of connection attempts.
+@property int attempts;
+/// The number of queued tasks that were dropped.
+@property int dropped;
+- (instancetype) initWithManager:(CodelessManager*)manager attempts:(int)attempts dropped:(int)dropped;
+@end
+
+
 /// Base class for CodeLess AT command events.
 @interface CodelessCommandEvent : CodelessEvent
 /// The AT command that generated the event.
@@ -699,6 +765,26 @@ enum CODELESS_ERROR {
 @end
 
 
+/// Event generated periodically with the response latency statistics of the sent AT commands.
+/// @see CodelessLibEvent#CommandStats
+@interface CodelessCommandStatsEvent : CodelessEvent
+/// The response latency histograms, per {@link CodelessProfile#CODELESS_COMMAND_ID command ID} (snapshot).
+@property NSDictionary<NSNumber*, CodelessLatencyHistogram*>* latency;
+/// The number of sent commands that timed out.
+@property int timeouts;
+- (instancetype) initWithManager:(CodelessManager*)manager latency:(NSDictionary<NSNumber*, CodelessLatencyHistogram*>*)latency timeouts:(int)timeouts;
+@end
+
+
+/// Event generated periodically with a snapshot of the manager {@link CodelessMetrics metrics}.
+/// @see CodelessLibEvent#Metrics
+@interface CodelessMetricsEvent : CodelessEvent
+/// The metrics snapshot.
+@property CodelessMetrics* metrics;
+- (instancetype) initWithManager:(CodelessManager*)manager metrics:(CodelessMetrics*)metrics;
+@end
+
+
 /// Event generated after <code>AT+</code> command completes successfully.
 /// @see CodelessLibEvent#Ping
 @interface CodelessPingEvent : CodelessCommandEvent
@@ -1200,11 +1286,15 @@ enum CODELESS_ERROR {
 
 
 /// Event generated when binary data are received from the peer DSPS device.
+/// <p> If {@link CodelessManager#dspsEventCoalescing coalescing} is enabled, the event may contain multiple received packets.
 /// @see CodelessLibEvent#DspsRxData
 @interface DspsRxDataEvent : CodelessEvent
-/// The data that were received.
-@property NSData* data;
+/// The data that were received. If the event contains multiple packets, this is their concatenation.
+@property (nonatomic) NSData* data;
+/// The received packets, in order of reception.
+@property (nonatomic) NSArray<NSData*>* buffers;
 - (instancetype) initWithManager:(CodelessManager*)manager data:(NSData*)data;
+- (instancetype) initWithManager:(CodelessManager*)manager buffers:(NSArray<NSData*>*)buffers;
 @end
 
 
@@ -1233,6 +1323,8 @@ enum CODELESS_ERROR {
 @property DspsFileSend* operation;
 /// The file chunk number.
 @property int chunk;
+/// The number of chunks sent since the previous event (1 if {@link CodelessManager#dspsEventCoalescing coalescing} is disabled).
+@property int chunks;
 - (instancetype) initWithManager:(CodelessManager*)manager operation:(DspsFileSend*)operation chunk:(int)chunk;
 @end
 
@@ -1252,10 +1344,10 @@ enum CODELESS_ERROR {
 /// The DSPS file receive operation that contains the file chunk.
 @property DspsFileReceive* operation;
 /// The total number of bytes.
-@property int size;
+@property int64_t size;
 /// The number of bytes that have been received.
-@property int bytesReceived;
-- (instancetype) initWithManager:(CodelessManager*)manager operation:(DspsFileReceive*)operation size:(int)size bytesReceived:(int)bytesReceived;
+@property int64_t bytesReceived;
+- (instancetype) initWithManager:(CodelessManager*)manager operation:(DspsFileReceive*)operation size:(int64_t)size bytesReceived:(int64_t)bytesReceived;
 @end
 
 
@@ -1277,6 +1369,8 @@ enum CODELESS_ERROR {
 @property DspsPeriodicSend* operation;
 /// The pattern chunk number.
 @property int count;
+/// The number of chunks sent since the previous event (1 if {@link CodelessManager#dspsEventCoalescing coalescing} is disabled).
+@property int chunks;
 - (instancetype) initWithManager:(CodelessManager*)manager operation:(DspsPeriodicSend*)operation count:(int)count;
 @end
 
@@ -33,9 +33,10 @@
  **********************************************************************************
  */
 
-#import <CoreBluetooth/CoreBluetooth.h>
+#import "CodelessCoreBluetooth.h"
 #import "CodelessProfile.h"
 #import "CodelessScript.h"
+#import "CodelessProvisioning.h"
 #import "CodelessLibEvent.h"
 #import "CodelessBluetoothManager.h"
 #import "CodelessManager.h"
@@ -104,8 +105,13 @@ static NSString* const Line = @"CodelessLineEvent";
 static NSString* const ScriptStart = @"CodelessScriptStartEvent";
 static NSString* const ScriptEnd = @"CodelessScriptEndEvent";
 static NSString* const ScriptCommand = @"CodelessScriptCommandEvent";
+static NSString* const ProvisioningStep = @"CodelessProvisioningStepEvent";
+static NSString* const ProvisioningEnd = @"CodelessProvisioningEndEvent";
+static NSString* const PoolConnectionFailed = @"CodelessPoolConnectionFailedEvent";
 static NSString* const CommandSuccess = @"CodelessCommandSuccessEvent";
 static NSString* const CommandError = @"CodelessCommandErrorEvent";
+static NSString* const CommandStats = @"CodelessCommandStatsEvent";
+static NSString* const Metrics = @"CodelessMetricsEvent";
 static NSString* const Ping = @"CodelessPingEvent";
 static NSString* const DeviceInformation = @"CodelessDeviceInformationEvent";
 static NSString* const UartEcho = @"CodelessUartEchoEvent";
@@ -242,6 +248,18 @@ static NSString* const DspsStats = @"DspsStats";
     return ScriptCommand;
 }
 
++ (NSString*) ProvisioningStep {
+    return ProvisioningStep;
+}
+
++ (NSString*) ProvisioningEnd {
+    return ProvisioningEnd;
+}
+
++ (NSString*) PoolConnectionFailed {
+    return PoolConnectionFailed;
+}
+
 + (NSString*) CommandSuccess {
     return CommandSuccess;
 }
@@ -250,6 +268,14 @@ static NSString* const DspsStats = @"DspsStats";
     return CommandError;
 }
 
++ (NSString*) CommandStats {
+    return CommandStats;
+}
+
++ (NSString*) Metrics {
+    return Metrics;
+}
+
 + (NSString*) Ping {
     return Ping;
 }
@@ -528,12 +554,19 @@ static NSString* const DspsStats = @"DspsStats";
 @implementation CodelessScanResultEvent
 
 - (instancetype) initWithManager:(CodelessBluetoothManager*)manager device:(CBPeripheral*)device advData:(CodelessAdvData*)advData rssi:(NSNumber*)rssi {
+    return self = [self initWithManager:manager device:device advData:advData rssi:rssi rssiAverage:rssi count:1 advDataChanged:true];
+}
+
+- (instancetype) initWithManager:(CodelessBluetoothManager*)manager device:(CBPeripheral*)device advData:(CodelessAdvData*)advData rssi:(NSNumber*)rssi rssiAverage:(NSNumber*)rssiAverage count:(int)count advDataChanged:(BOOL)advDataChanged {
     self = [super initWithManager:manager];
     if (!self)
         return nil;
     self.device = device;
     self.advData = advData;
     self.rssi = rssi;
+    self.rssiAverage = rssiAverage;
+    self.count = count;
+    self.advDataChanged = advDataChanged;
     return self;
 }
 
@@ -730,6 +763,48 @@ static NSString* const DspsStats = @"DspsStats";
 @end
 
 
+@implementation CodelessProvisioningStepEvent
+
+- (instancetype) initWithProvisioning:(CodelessProvisioning*)provisioning step:(CodelessProvisioningStep*)step {
+    self = [super initWithManager:provisioning.manager];
+    if (!self)
+        return nil;
+    self.provisioning = provisioning;
+    self.step = step;
+    return self;
+}
+
+@end
+
+
+@implementation CodelessProvisioningEndEvent
+
+- (instancetype) initWithProvisioning:(CodelessProvisioning*)provisioning error:(BOOL)error {
+    self = [super initWithManager:provisioning.manager];
+    if (!self)
+        return nil;
+    self.provisioning = provisioning;
+    self.error = error;
+    return self;
+}
+
+@end
+
+
+@implementation CodelessPoolConnectionFailedEvent
+
+- (instancetype) initWithManager:(CodelessManager*)manager attempts:(int)attempts dropped:(int)dropped {
+    self = [super initWithManager:manager];
+    if (!self)
+        return nil;
+    self.attempts = attempts;
+    self.dropped = dropped;
+    return self;
+}
+
+@end
+
+
 @implementation CodelessCommandEvent
 
 - (instancetype) initWithCodelessCommand:(CodelessCommand*)command {
@@ -765,6 +840,33 @@ static NSString* const DspsStats = @"DspsStats";
 @end
 
 
+@implementation CodelessCommandStatsEvent
+
+- (instancetype) initWithManager:(CodelessManager*)manager latency:(NSDictionary<NSNumber*, CodelessLatencyHistogram*>*)latency timeouts:(int)timeouts {
+    self = [super initWithManager:manager];
+    if (!self)
+        return nil;
+    self.latency = latency;
+    self.timeouts = timeouts;
+    return self;
+}
+
+@end
+
+
+@implementation CodelessMetricsEvent
+
+- (instancetype) initWithManager:(CodelessManager*)manager metrics:(CodelessMetrics*)metrics {
+    self = [super initWithManager:manager];
+    if (!self)
+        return nil;
+    self.metrics = metrics;
+    return self;
+}
+
+@end
+
+
 @implementation CodelessPingEvent
 
 - (instancetype) initWithCommand:(CodelessBasicCommand*)command {
@@ -1425,6 +1527,36 @@ static NSString* const DspsStats = @"DspsStats";
     return self;
 }
 
+- (instancetype) initWithManager:(CodelessManager*)manager buffers:(NSArray<NSData*>*)buffers {
+    self = [super initWithManager:manager];
+    if (!self)
+        return nil;
+    self.buffers = buffers;
+    if (buffers.count == 1)
+        self.data = buffers[0];
+    return self;
+}
+
+- (NSData*) data {
+    // Concatenated on first access, so observers that only use the buffers avoid the copy.
+    if (!_data && _buffers) {
+        NSUInteger length = 0;
+        for (NSData* buffer in _buffers)
+            length += buffer.length;
+        NSMutableData* data = [NSMutableData dataWithCapacity:length];
+        for (NSData* buffer in _buffers)
+            [data appendData:buffer];
+        _data = data;
+    }
+    return _data;
+}
+
+- (NSArray<NSData*>*) buffers {
+    if (!_buffers && _data)
+        _buffers = @[ _data ];
+    return _buffers;
+}
+
 @end
 
 
@@ -1462,6 +1594,7 @@ static NSString* const DspsStats = @"DspsStats";
         return nil;
     self.operation = operation;
     self.chunk = chunk;
+    self.chunks = 1;
     return self;
 }
 
@@ -1483,7 +1616,7 @@ static NSString* const DspsStats = @"DspsStats";
 
 @implementation DspsRxFileDataEvent
 
-- (instancetype) initWithManager:(CodelessManager*)manager operation:(DspsFileReceive*)operation size:(int)size bytesReceived:(int)bytesReceived {
+- (instancetype) initWithManager:(CodelessManager*)manager operation:(DspsFileReceive*)operation size:(int64_t)size bytesReceived:(int64_t)bytesReceived {
     self = [super initWithManager:manager];
     if (!self)
         return nil;
@@ -1518,6 +1651,7 @@ static NSString* const DspsStats = @"DspsStats";
         return nil;
     self.operation = operation;
     self.count = count;
+    self.chunks = 1;
     return self;
 }
 
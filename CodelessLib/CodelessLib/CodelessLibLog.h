@@ -35,13 +35,82 @@
 
 #import <Foundation/Foundation.h>
 
+@protocol CodelessLogBackend;
+
 NS_ASSUME_NONNULL_BEGIN
 
 
 /// Creates a log entry with a tag prefix.
-#define CodelessLog(TAG, fmt, ...) NSLog(@"%@: " fmt, TAG, ##__VA_ARGS__)
-/// Creates an log entry with a tag prefix, which can be disabled.
-#define CodelessLogOpt(enabled, TAG, fmt, ...) do { if (enabled) NSLog(@"%@: " fmt, TAG, ##__VA_ARGS__); } while(0)
+#define CodelessLog(TAG, fmt, ...) CodelessLogWrite(TAG, nil, @"" fmt, ##__VA_ARGS__)
+/// Creates an log entry with a tag prefix, if the log option is enabled.
+#define CodelessLogOpt(enabled, TAG, fmt, ...) do { if (enabled) CodelessLogWrite(TAG, nil, @"" fmt, ##__VA_ARGS__); } while(0)
+/// Creates an log entry with a tag prefix, if logging is enabled for the specified {@link CODELESS_LOG_SUBSYSTEM subsystem}.
+#define CodelessLogSubsystem(subsystem, TAG, fmt, ...) do { if (CodelessLogEnabled(subsystem)) CodelessLogWrite(TAG, nil, @"" fmt, ##__VA_ARGS__); } while(0)
+/// Creates an log entry with a tag prefix, if logging is enabled for the specified {@link CODELESS_LOG_SUBSYSTEM subsystem}. The data are appended to the message as a hex array.
+#define CodelessLogDataSubsystem(subsystem, TAG, data, fmt, ...) do { if (CodelessLogEnabled(subsystem)) CodelessLogWrite(TAG, data, @"" fmt, ##__VA_ARGS__); } while(0)
+/// Checks if logging is enabled for any of the specified subsystems. A disabled check costs a single load and branch.
+#define CodelessLogEnabled(subsystem) ((CodelessLogMask & (subsystem)) != 0)
+
+/// Log subsystems. Each subsystem is a bit in the {@link CodelessLogMask runtime log mask}.
+enum CODELESS_LOG_SUBSYSTEM {
+    /// Bluetooth scan results.
+    CODELESS_LOG_SCAN_RESULT = 1 << 0,
+    /// GATT operations.
+    CODELESS_LOG_GATT_OPERATION = 1 << 1,
+    /// CodeLess operations.
+    CODELESS_LOG_CODELESS = 1 << 2,
+    /// Command specific messages.
+    CODELESS_LOG_COMMAND = 1 << 3,
+    /// CodeLess script operations.
+    CODELESS_LOG_SCRIPT = 1 << 4,
+    /// DSPS operations.
+    CODELESS_LOG_DSPS = 1 << 5,
+    /// Sent/received DSPS data.
+    CODELESS_LOG_DSPS_DATA = 1 << 6,
+    /// Sending of DSPS data chunks.
+    CODELESS_LOG_DSPS_CHUNK = 1 << 7,
+    /// Queueing/sending/receiving of DSPS file chunks.
+    CODELESS_LOG_DSPS_FILE_CHUNK = 1 << 8,
+    /// Queueing/sending of DSPS periodic/pattern chunks.
+    CODELESS_LOG_DSPS_PERIODIC_CHUNK = 1 << 9,
+    /// All subsystems.
+    CODELESS_LOG_ALL = (1 << 10) - 1,
+};
+
+/**
+ * Runtime log mask, which contains the enabled {@link CODELESS_LOG_SUBSYSTEM subsystems}.
+ * <p> Initialized from the <code>CODELESS_LIB_LOG_*</code> options. It is read by the log macros and must not be written directly.
+ * Use {@link CodelessLogSetMask} or the {@link CodelessLibLog} properties to modify it. Updates are atomic.
+ */
+FOUNDATION_EXPORT volatile uint32_t CodelessLogMask;
+
+/**
+ * Replaces the {@link CodelessLogMask runtime log mask}.
+ * @param mask the enabled {@link CODELESS_LOG_SUBSYSTEM subsystems}
+ * @return the previous log mask
+ */
+FOUNDATION_EXPORT uint32_t CodelessLogSetMask(uint32_t mask);
+
+/**
+ * Writes a log entry to the active {@link CodelessLibLog#backend log backend}.
+ * <p> Used by the log macros.
+ * @param tag       the log tag
+ * @param data      optional data, which are appended to the message as a hex array
+ * @param format    the message format
+ */
+FOUNDATION_EXPORT void CodelessLogWrite(NSString* tag, NSData* _Nullable data, NSString* format, ...) NS_FORMAT_FUNCTION(3, 4);
+
+
+/// Use the {@link CodelessRingLogBackend ring buffer} log backend by default. If <code>false</code>, each log entry is written with <code>NSLog</code>.
+#define CODELESS_LIB_LOG_BACKEND_RING   true
+/// The number of records kept in the ring buffer log backend.
+#define CODELESS_LIB_LOG_RING_BUFFER_SIZE   4096
+/// Write the ring buffer log records to the console from a background reader.
+#define CODELESS_LIB_LOG_CONSOLE   true
+/// Interval for writing the ring buffer log records to the console (ms).
+#define CODELESS_LIB_LOG_CONSOLE_INTERVAL   100
+/// Write the log records of the last seconds to the console when an error event is generated (0 to disable).
+#define CODELESS_LIB_LOG_DUMP_ON_ERROR   0
 
 
 /// Log Bluetooth scan results.
@@ -68,31 +137,51 @@ NS_ASSUME_NONNULL_BEGIN
 #define CODELESS_LIB_LOG_DSPS_PERIODIC_CHUNK   true
 
 
-/// Configuration options that configure the log output produced by the library.
+/**
+ * Configuration options that configure the log output produced by the library.
+ * <p> The subsystem options can be changed at runtime. They are backed by the {@link CodelessLogMask} bits.
+ */
 @interface CodelessLibLog : NSObject
 
+/**
+ * The active log backend.
+ * <p> If it is changed, it should be set before using the library.
+ */
+@property (class) id<CodelessLogBackend> backend;
+
+/// Use the {@link CodelessRingLogBackend ring buffer} log backend by default.
+@property (class, readonly) BOOL BACKEND_RING;
+/// The number of records kept in the ring buffer log backend.
+@property (class, readonly) int RING_BUFFER_SIZE;
+/// Write the ring buffer log records to the console from a background reader.
+@property (class, readonly) BOOL CONSOLE;
+/// Interval for writing the ring buffer log records to the console (ms).
+@property (class, readonly) int CONSOLE_INTERVAL;
+/// Write the log records of the last seconds to the console when an error event is generated (0 to disable).
+@property (class, readonly) int DUMP_ON_ERROR;
+
 /// Log Bluetooth scan results.
-@property (class, readonly) BOOL SCAN_RESULT;
+@property (class) BOOL SCAN_RESULT;
 /// Log GATT operations.
-@property (class, readonly) BOOL GATT_OPERATION;
+@property (class) BOOL GATT_OPERATION;
 
-/// Log Bluetooth scan results.
-@property (class, readonly) BOOL CODELESS;
+/// Log CodeLess operations.
+@property (class) BOOL CODELESS;
 /// Log command specific messages.
-@property (class, readonly) BOOL COMMAND;
+@property (class) BOOL COMMAND;
 /// Log CodeLess script operations.
-@property (class, readonly) BOOL SCRIPT;
+@property (class) BOOL SCRIPT;
 
 /// Log DSPS operations. Data operations are configured separately.
-@property (class, readonly) BOOL DSPS;
+@property (class) BOOL DSPS;
 /// Log sent/received DSPS data.
-@property (class, readonly) BOOL DSPS_DATA;
+@property (class) BOOL DSPS_DATA;
 /// Log sending of DSPS data chunks.
-@property (class, readonly) BOOL DSPS_CHUNK;
+@property (class) BOOL DSPS_CHUNK;
 /// Log queueing/sending/receiving of DSPS file chunks.
-@property (class, readonly) BOOL DSPS_FILE_CHUNK;
+@property (class) BOOL DSPS_FILE_CHUNK;
 /// Log queueing/sending of DSPS periodic/pattern chunks.
-@property (class, readonly) BOOL DSPS_PERIODIC_CHUNK;
+@property (class) BOOL DSPS_PERIODIC_CHUNK;
 
 @end
 
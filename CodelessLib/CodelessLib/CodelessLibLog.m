@@ -34,47 +34,157 @@
  */
 
 #import "CodelessLibLog.h"
+#import "CodelessLogBackend.h"
+
+static id<CodelessLogBackend> backend;
+
+volatile uint32_t CodelessLogMask =
+        (CODELESS_LIB_LOG_SCAN_RESULT ? CODELESS_LOG_SCAN_RESULT : 0)
+        | (CODELESS_LIB_LOG_GATT_OPERATION ? CODELESS_LOG_GATT_OPERATION : 0)
+        | (CODELESS_LIB_LOG_CODELESS ? CODELESS_LOG_CODELESS : 0)
+        | (CODELESS_LIB_LOG_COMMAND ? CODELESS_LOG_COMMAND : 0)
+        | (CODELESS_LIB_LOG_SCRIPT ? CODELESS_LOG_SCRIPT : 0)
+        | (CODELESS_LIB_LOG_DSPS ? CODELESS_LOG_DSPS : 0)
+        | (CODELESS_LIB_LOG_DSPS_DATA ? CODELESS_LOG_DSPS_DATA : 0)
+        | (CODELESS_LIB_LOG_DSPS_CHUNK ? CODELESS_LOG_DSPS_CHUNK : 0)
+        | (CODELESS_LIB_LOG_DSPS_FILE_CHUNK ? CODELESS_LOG_DSPS_FILE_CHUNK : 0)
+        | (CODELESS_LIB_LOG_DSPS_PERIODIC_CHUNK ? CODELESS_LOG_DSPS_PERIODIC_CHUNK : 0);
+
+// The mask is exported as a plain volatile word, so that the public header is usable from C++ and Swift.
+// All updates are done here with the atomic builtins.
+static void setSubsystem(uint32_t subsystem, BOOL enabled) {
+    if (enabled)
+        __atomic_fetch_or(&CodelessLogMask, subsystem, __ATOMIC_RELAXED);
+    else
+        __atomic_fetch_and(&CodelessLogMask, ~subsystem, __ATOMIC_RELAXED);
+}
+
+uint32_t CodelessLogSetMask(uint32_t mask) {
+    return __atomic_exchange_n(&CodelessLogMask, mask, __ATOMIC_RELAXED);
+}
+
+void CodelessLogWrite(NSString* tag, NSData* data, NSString* format, ...) {
+    va_list args;
+    va_start(args, format);
+    [CodelessLibLog.backend log:tag data:data format:format arguments:args];
+    va_end(args);
+}
 
 @implementation CodelessLibLog
 
++ (void) initialize {
+    if (self != CodelessLibLog.class)
+        return;
+
+    backend = CODELESS_LIB_LOG_BACKEND_RING ? [[CodelessRingLogBackend alloc] initWithCapacity:CODELESS_LIB_LOG_RING_BUFFER_SIZE console:CODELESS_LIB_LOG_CONSOLE] : [CodelessConsoleLogBackend new];
+}
+
++ (id<CodelessLogBackend>) backend {
+    return backend;
+}
+
++ (void) setBackend:(id<CodelessLogBackend>)value {
+    backend = value;
+}
+
++ (BOOL) BACKEND_RING {
+    return CODELESS_LIB_LOG_BACKEND_RING;
+}
+
++ (int) RING_BUFFER_SIZE {
+    return CODELESS_LIB_LOG_RING_BUFFER_SIZE;
+}
+
++ (BOOL) CONSOLE {
+    return CODELESS_LIB_LOG_CONSOLE;
+}
+
++ (int) CONSOLE_INTERVAL {
+    return CODELESS_LIB_LOG_CONSOLE_INTERVAL;
+}
+
++ (int) DUMP_ON_ERROR {
+    return CODELESS_LIB_LOG_DUMP_ON_ERROR;
+}
+
 + (BOOL) SCAN_RESULT {
-    return CODELESS_LIB_LOG_SCAN_RESULT;
+    return CodelessLogEnabled(CODELESS_LOG_SCAN_RESULT);
+}
+
++ (void) setSCAN_RESULT:(BOOL)enabled {
+    setSubsystem(CODELESS_LOG_SCAN_RESULT, enabled);
 }
 
 + (BOOL) GATT_OPERATION {
-    return CODELESS_LIB_LOG_GATT_OPERATION;
+    return CodelessLogEnabled(CODELESS_LOG_GATT_OPERATION);
+}
+
++ (void) setGATT_OPERATION:(BOOL)enabled {
+    setSubsystem(CODELESS_LOG_GATT_OPERATION, enabled);
 }
 
 + (BOOL) CODELESS {
-    return CODELESS_LIB_LOG_CODELESS;
+    return CodelessLogEnabled(CODELESS_LOG_CODELESS);
+}
+
++ (void) setCODELESS:(BOOL)enabled {
+    setSubsystem(CODELESS_LOG_CODELESS, enabled);
 }
 
 + (BOOL) COMMAND {
-    return CODELESS_LIB_LOG_COMMAND;
+    return CodelessLogEnabled(CODELESS_LOG_COMMAND);
+}
+
++ (void) setCOMMAND:(BOOL)enabled {
+    setSubsystem(CODELESS_LOG_COMMAND, enabled);
 }
 
 + (BOOL) SCRIPT {
-    return CODELESS_LIB_LOG_SCRIPT;
+    return CodelessLogEnabled(CODELESS_LOG_SCRIPT);
+}
+
++ (void) setSCRIPT:(BOOL)enabled {
+    setSubsystem(CODELESS_LOG_SCRIPT, enabled);
 }
 
 + (BOOL) DSPS {
-    return CODELESS_LIB_LOG_DSPS;
+    return CodelessLogEnabled(CODELESS_LOG_DSPS);
+}
+
++ (void) setDSPS:(BOOL)enabled {
+    setSubsystem(CODELESS_LOG_DSPS, enabled);
 }
 
 + (BOOL) DSPS_DATA {
-    return CODELESS_LIB_LOG_DSPS_DATA;
+    return CodelessLogEnabled(CODELESS_LOG_DSPS_DATA);
+}
+
++ (void) setDSPS_DATA:(BOOL)enabled {
+    setSubsystem(CODELESS_LOG_DSPS_DATA, enabled);
 }
 
 + (BOOL) DSPS_CHUNK {
-    return CODELESS_LIB_LOG_DSPS_CHUNK;
+    return CodelessLogEnabled(CODELESS_LOG_DSPS_CHUNK);
+}
+
++ (void) setDSPS_CHUNK:(BOOL)enabled {
+    setSubsystem(CODELESS_LOG_DSPS_CHUNK, enabled);
 }
 
 + (BOOL) DSPS_FILE_CHUNK {
-    return CODELESS_LIB_LOG_DSPS_FILE_CHUNK;
+    return CodelessLogEnabled(CODELESS_LOG_DSPS_FILE_CHUNK);
+}
+
++ (void) setDSPS_FILE_CHUNK:(BOOL)enabled {
+    setSubsystem(CODELESS_LOG_DSPS_FILE_CHUNK, enabled);
 }
 
 + (BOOL) DSPS_PERIODIC_CHUNK {
-    return CODELESS_LIB_LOG_DSPS_PERIODIC_CHUNK;
+    return CodelessLogEnabled(CODELESS_LOG_DSPS_PERIODIC_CHUNK);
+}
+
++ (void) setDSPS_PERIODIC_CHUNK:(BOOL)enabled {
+    setSubsystem(CODELESS_LOG_DSPS_PERIODIC_CHUNK, enabled);
 }
 
 @end
@@ -34,7 +34,7 @@
  */
 
 #import <Foundation/Foundation.h>
-#import <CoreBluetooth/CoreBluetooth.h>
+#import "CodelessCoreBluetooth.h"
 
 @class CodelessBluetoothManager;
 @class CBPeripheral;
@@ -47,10 +47,80 @@
 @class DspsPeriodicSend;
 @class DspsFileSend;
 @class DspsFileReceive;
+@class DspsStats;
+@class DspsRxAggregator;
 @class CodelessScript;
+@class CodelessLatencyHistogram;
+@class CodelessMetrics;
+@class CodelessManager;
+@class CodelessEvent;
+@class CodelessConnectionEvent;
+@class CodelessReadyEvent;
+@class CodelessErrorEvent;
+@class CodelessModeEvent;
+@class CodelessCommandSuccessEvent;
+@class CodelessCommandErrorEvent;
+@class CodelessInboundCommandEvent;
+@class CodelessHostCommandEvent;
+@class DspsRxDataEvent;
+@class DspsTxFlowControlEvent;
+@class DspsFileChunkEvent;
+@class DspsStatsEvent;
+@class CodelessDeviceConnectedEvent;
+@class CodelessDeviceDisconnectedEvent;
+@class CodelessConnectionFailedEvent;
+@class CodelessBluetoothStateEvent;
+@protocol CodelessTransport;
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * Delegate that receives the events generated by a {@link CodelessManager}, including the events generated by its commands,
+ * scripts and DSPS operations.
+ *
+ * The delegate is called directly, before any notification is posted, without a <code>userInfo</code> dictionary.
+ * {@link #manager:event:object:} is called for all events. The typed methods are called, in addition, for the corresponding events.
+ * All methods are optional.
+ */
+@protocol CodelessManagerDelegate <NSObject>
+@optional
+
+/**
+ * Called for each event generated by the manager.
+ * @param manager   the manager that generated the event
+ * @param event     the event name (see {@link CodelessLibEvent})
+ * @param object    the event object
+ */
+- (void) manager:(CodelessManager*)manager event:(NSString*)event object:(CodelessEvent*)object;
+
+/// Called for {@link CodelessLibEvent#Connection Connection} events.
+- (void) manager:(CodelessManager*)manager connectionEvent:(CodelessConnectionEvent*)event;
+/// Called for {@link CodelessLibEvent#Ready Ready} events.
+- (void) manager:(CodelessManager*)manager readyEvent:(CodelessReadyEvent*)event;
+/// Called for {@link CodelessLibEvent#Error Error} events.
+- (void) manager:(CodelessManager*)manager errorEvent:(CodelessErrorEvent*)event;
+/// Called for {@link CodelessLibEvent#Mode Mode} events.
+- (void) manager:(CodelessManager*)manager modeEvent:(CodelessModeEvent*)event;
+/// Called for {@link CodelessLibEvent#CommandSuccess CommandSuccess} events.
+- (void) manager:(CodelessManager*)manager commandSuccessEvent:(CodelessCommandSuccessEvent*)event;
+/// Called for {@link CodelessLibEvent#CommandError CommandError} events.
+- (void) manager:(CodelessManager*)manager commandErrorEvent:(CodelessCommandErrorEvent*)event;
+/// Called for {@link CodelessLibEvent#InboundCommand InboundCommand} events.
+- (void) manager:(CodelessManager*)manager inboundCommandEvent:(CodelessInboundCommandEvent*)event;
+/// Called for {@link CodelessLibEvent#HostCommand HostCommand} events.
+- (void) manager:(CodelessManager*)manager hostCommandEvent:(CodelessHostCommandEvent*)event;
+/// Called for {@link CodelessLibEvent#DspsRxData DspsRxData} events.
+- (void) manager:(CodelessManager*)manager dspsRxDataEvent:(DspsRxDataEvent*)event;
+/// Called for {@link CodelessLibEvent#DspsTxFlowControl DspsTxFlowControl} events.
+- (void) manager:(CodelessManager*)manager dspsTxFlowControlEvent:(DspsTxFlowControlEvent*)event;
+/// Called for {@link CodelessLibEvent#DspsFileChunk DspsFileChunk} events.
+- (void) manager:(CodelessManager*)manager dspsFileChunkEvent:(DspsFileChunkEvent*)event;
+/// Called for {@link CodelessLibEvent#DspsStats DspsStats} events.
+- (void) manager:(CodelessManager*)manager dspsStatsEvent:(DspsStatsEvent*)event;
+
+@end
+
+
 /**
  * Manages the connection and communication with the peer CodeLess/DSPS device.
  *
@@ -109,8 +179,10 @@ enum CODELESS_STATE {
 
 /// The CodelessBluetoothManager to be used for the connection.
 @property (readonly) CodelessBluetoothManager* bluetoothManager;
-/// The associated device.
-@property (readonly) CBPeripheral* device;
+/// The associated device (<code>nil</code> for simulated devices).
+@property (readonly, nullable) CBPeripheral* device;
+/// The GATT {@link CodelessTransport transport} (the {@link #device} by default).
+@property (readonly) id<CodelessTransport> transport;
 /// The connection {@link #CODELESS_STATE state}.
 @property (readonly) int state;
 /// The connection MTU.
@@ -133,10 +205,38 @@ enum CODELESS_STATE {
  * The library reads the CodeLess Outbound characteristic to get the incoming data.
  */
 @property (readonly) int inboundPending;
+/**
+ * The response latency statistics of the sent commands, per {@link CodelessProfile#CODELESS_COMMAND_ID command ID}.
+ * <p> A snapshot is returned. Available only if {@link CodelessLibConfig#COMMAND_STATS statistics} are enabled.
+ */
+@property (readonly) NSDictionary<NSNumber*, CodelessLatencyHistogram*>* commandLatency;
+/**
+ * The latency profile of the sent commands, per {@link CodelessProfile#CODELESS_COMMAND_ID command ID}.
+ *
+ * For each command ID, there is a latency histogram per {@link CodelessCommand#CODELESS_COMMAND_STAGE processing stage},
+ * which contains the time from the previous stage to that stage. This separates the library overhead (queueing, parsing)
+ * from the link time (GATT write, peer response).
+ * <p> A snapshot is returned. Available only if {@link CodelessLibConfig#COMMAND_STATS statistics} are enabled.
+ */
+@property (readonly) NSDictionary<NSNumber*, NSArray<CodelessLatencyHistogram*>*>* commandStageLatency;
+/// The number of sent commands that failed because the peer device did not respond in time.
+@property (readonly) int commandTimeouts;
 // DSPS
 /// The DSPS chunk size.
 /// <p> WARNING: The chunk size must not exceed the value (MTU - 3), otherwise chunks will be truncated when sent.
 @property int dspsChunkSize;
+/**
+ * The latency of the sent DSPS chunks, from the time they are enqueued until they are written.
+ * <p> A snapshot is returned. Available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
+ */
+@property (readonly) CodelessLatencyHistogram* dspsTxLatency;
+/**
+ * A snapshot of the manager counters (GATT queue, flow control, DSPS data, commands).
+ * <p> The counters are always maintained, regardless of the statistics configuration.
+ * If {@link CodelessLibConfig#METRICS_EVENT} is enabled, a {@link CodelessLibEvent#Metrics Metrics} event
+ * with the snapshot is generated every {@link CodelessLibConfig#METRICS_INTERVAL}.
+ */
+@property (readonly) CodelessMetrics* metrics;
 /**
  * <code>true</code> if the DSPS RX flow control in on.
  *
@@ -160,11 +260,31 @@ enum CODELESS_STATE {
 /// The DSPS echo configuration.
 /// <p> If echo is enabled, all incoming binary data are sent back to the peer device.
 @property BOOL dspsEcho;
+/**
+ * The DSPS event coalescing configuration.
+ * <p> If enabled, the high rate {@link CodelessLibEvent#DspsRxData DspsRxData}, {@link CodelessLibEvent#DspsFileChunk DspsFileChunk}
+ * and {@link CodelessLibEvent#DspsPatternChunk DspsPatternChunk} events are coalesced per {@link CodelessLibConfig#DSPS_EVENT_COALESCING_INTERVAL time window}.
+ * A single DspsRxData event is generated for all packets received in the window, and a single chunk event, for the last chunk, is generated per operation.
+ * Otherwise, an event is generated for each packet.
+ */
+@property BOOL dspsEventCoalescing;
+/// The delegate that receives the events generated by the manager.
+@property (nonatomic, weak, nullable) id<CodelessManagerDelegate> delegate;
+/// <code>true</code> if events are also posted as notifications (default: {@link CodelessLibConfig#EVENT_NOTIFICATIONS EVENT_NOTIFICATIONS}).
+@property BOOL postNotifications;
 /// The active DSPS file receive operation, if available.
 @property (readonly) DspsFileReceive* dspsFileReceive;
 /// The calculated current receive speed.
 /// <p> Available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
 @property (readonly) int dspsRxSpeed;
+/// The receive throughput statistics, active while in binary mode.
+/// <p> The speed values are available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
+@property (readonly) DspsStats* dspsRxStats;
+/**
+ * The aggregator that receives the DSPS received data, if the manager is part of a multi-connection aggregate output.
+ * <p> Set by {@link DspsRxAggregator#addManager:}. If set, the received data are not written to the DSPS RX log file.
+ */
+@property (weak, nullable) DspsRxAggregator* dspsRxAggregator;
 // Service database
 /// <code>true</code> if the service discovery is complete.
 @property (readonly) BOOL servicesDiscovered;
@@ -181,6 +301,14 @@ enum CODELESS_STATE {
  * @param device    the device to connect to
  */
 - (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)manager device:(CBPeripheral*)device;
+/**
+ * Creates a CodelessManager that uses a custom GATT transport.
+ * <p> For example, use a {@link CodelessSimulatedPeer} to run the manager without a Bluetooth device.
+ * @param manager   the CodelessBluetoothManager to be used for the connection
+ * @param device    the associated device (<code>nil</code> for simulated devices)
+ * @param transport the GATT transport
+ */
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)manager device:(nullable CBPeripheral*)device transport:(id<CodelessTransport>)transport;
 
 /// Connects to the peer device.
 - (void) connect;
@@ -190,6 +318,14 @@ enum CODELESS_STATE {
 - (BOOL) isConnected;
 /// Checks if the connection is in progress.
 - (BOOL) isConnecting;
+/// Called by the {@link CodelessBluetoothManager} when the peer device is connected.
+- (void) onConnection:(CodelessDeviceConnectedEvent*)event;
+/// Called by the {@link CodelessBluetoothManager} when the peer device is disconnected.
+- (void) onDisconnection:(CodelessDeviceDisconnectedEvent*)event;
+/// Called by the {@link CodelessBluetoothManager} when the connection to the peer device fails.
+- (void) onConnectionFailed:(CodelessConnectionFailedEvent*)event;
+/// Called by the {@link CodelessBluetoothManager} when the Bluetooth state changes.
+- (void) onBluetoothState:(CodelessBluetoothStateEvent*)event;
 /// Checks if the peer device is ready for Codeless/DSPS operations.
 /// <p> The device becomes ready after the service discovery is complete and the required notifications are enabled.
 - (BOOL) isReady;
@@ -314,11 +450,59 @@ enum CODELESS_STATE {
  * @see CodelessScript
  */
 - (void) sendCommands:(NSArray<CodelessCommand*>*)commands;
+/**
+ * Removes the queued commands with the specified {@link CodelessCommand#origin origin}.
+ * <p> The commands are not sent to the peer device. A command that has already been sent is not affected.
+ * @param origin the commands origin
+ * @return the number of removed commands
+ */
+- (int) cancelCommands:(NSObject*)origin;
 /**
  * Completes the specified outgoing command, if it is currently pending.
  * @param command the command to complete
  */
 - (void) completePendingCommand:(CodelessCommand*)command;
+/**
+ * Returns the response latency statistics of the sent commands with the specified ID (snapshot).
+ * @param commandID the {@link CodelessProfile#CODELESS_COMMAND_ID command ID}
+ * @return the latency histogram, or <code>nil</code> if no command with this ID has completed
+ */
+- (nullable CodelessLatencyHistogram*) commandLatencyForID:(int)commandID;
+/// Clears the command statistics.
+- (void) resetCommandStats;
+/// Clears the DSPS chunk latency statistics.
+- (void) resetDspsTxLatency;
+/// Clears the manager counters reported by {@link #metrics}.
+- (void) resetMetrics;
+
+/**
+ * Generates an event.
+ * <p> The event is delivered to the {@link #delegate}, then to the event observers, and, if {@link #postNotifications} is enabled,
+ * it is posted as a notification with the manager as the object.
+ * <p> Used by the library to generate all manager related events.
+ * @param event     the event name (see {@link CodelessLibEvent})
+ * @param object    the event object
+ */
+- (void) sendEvent:(NSString*)event object:(CodelessEvent*)object;
+/**
+ * Registers an observer for an event generated by the manager.
+ * <p> The observer is called directly, only for events of this manager. It is not retained.
+ * @param observer  the observer
+ * @param selector  the observer method to call, which takes the event object as its only argument
+ * @param event     the event name (see {@link CodelessLibEvent})
+ */
+- (void) addEventObserver:(id)observer selector:(SEL)selector event:(NSString*)event;
+/**
+ * Removes an observer for an event.
+ * @param observer  the observer
+ * @param event     the event name
+ */
+- (void) removeEventObserver:(id)observer event:(NSString*)event;
+/**
+ * Removes an observer for all events.
+ * @param observer the observer
+ */
+- (void) removeEventObserver:(id)observer;
 /**
  * Sends a success response to the peer device.
  * <p> Use this to respond to a supported incoming command.
@@ -427,6 +611,20 @@ enum CODELESS_STATE {
  * @return the DSPS file send operation
  */
 - (DspsFileSend*) sendFile:(NSString*)file chunkSize:(int)chunkSize period:(int)period;
+/**
+ * Creates and starts a DSPS file send operation, with optional compression.
+ * <p> If compression is enabled, a file header is sent first, followed by the compressed file data.
+ * The peer must support the {@link DspsFileReceive compressed file header}.
+ * <p> The file is compressed in memory when the operation is created. The compressed data and the chunks built from them
+ * may take up to about twice the file size (see {@link DspsFileSend#compressedTransferData:name: compressedTransferData}).
+ * @param file          the file to send
+ * @param chunkSize     the chunk size to use when splitting the file
+ * @param period        the chunks enqueueing period (ms).
+ *                      Set to 0 to enqueue all chunks (may be slower for large files).
+ * @param compressed    <code>true</code> to send the file compressed
+ * @return the DSPS file send operation
+ */
+- (DspsFileSend*) sendFile:(NSString*)file chunkSize:(int)chunkSize period:(int)period compressed:(BOOL)compressed;
 /**
  * Creates and starts a DSPS file send operation, using the current chunk size.
  * @param file      the file to send
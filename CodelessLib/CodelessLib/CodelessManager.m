@@ -33,29 +33,51 @@
  **********************************************************************************
  */
 
-#import <CoreBluetooth/CoreBluetooth.h>
+#import "CodelessCoreBluetooth.h"
 #import "CodelessManager.h"
 #import "CodelessBluetoothManager.h"
+#import "CodelessTransport.h"
 #import "CodelessProfile.h"
 #import "CodelessLibEvent.h"
 #import "CodelessUtil.h"
 #import "CodelessLibConfig.h"
 #import "CodelessLibLog.h"
+#import "CodelessLogBackend.h"
 #import "CodelessCommands.h"
 #import "CodelessBinRequestCommand.h"
 #import "CodelessBinRequestAckCommand.h"
 #import "CodelessBinExitCommand.h"
 #import "CodelessLogFile.h"
 #import "DspsRxLogFile.h"
+#import "DspsCaptureFile.h"
+#import "CodelessGattTrace.h"
 #import "CodelessCustomCommand.h"
 #import "DspsFileSend.h"
 #import "DspsFileReceive.h"
 #import "DspsPeriodicSend.h"
+#import "DspsStats.h"
+#import "DspsRxAggregator.h"
 #import "CodelessScript.h"
+#import "CodelessLatencyHistogram.h"
+#import "CodelessMetrics.h"
 
 
 #define CodelessLogPrefix(TAG, fmt, ...) CodelessLog(TAG, "%@" fmt, self.logPrefix, ##__VA_ARGS__)
-#define CodelessLogPrefixOpt(enabled, TAG, fmt, ...) CodelessLogOpt(enabled, TAG, "%@" fmt, self.logPrefix, ##__VA_ARGS__)
+#define CodelessLogPrefixOpt(subsystem, TAG, fmt, ...) CodelessLogSubsystem(subsystem, TAG, "%@" fmt, self.logPrefix, ##__VA_ARGS__)
+#define CodelessLogPrefixDataOpt(subsystem, TAG, data, fmt, ...) CodelessLogDataSubsystem(subsystem, TAG, data, "%@" fmt, self.logPrefix, ##__VA_ARGS__)
+
+
+/// Event observer registered with {@link CodelessManager#addEventObserver:selector:event:}.
+@interface CodelessManager_EventObserver : NSObject
+
+@property (weak) id observer;
+@property SEL selector;
+/// The observer method implementation, resolved when the observer is registered.
+@property IMP method;
+
+- (instancetype) initWithObserver:(id)observer selector:(SEL)selector;
+
+@end
 
 
 /// GATT operation wrapper class, used for the GATT operation queue implementation.
@@ -100,6 +122,8 @@ enum {
 @interface CodelessManager_DspsGattOperation : CodelessManager_GattOperation
 
 @property (weak) CodelessManager* manager;
+/// The time the operation was created (system uptime), used for the latency statistics.
+@property NSTimeInterval enqueueTime;
 
 - (instancetype) initWithManager:(CodelessManager*)manager data:(NSData*)data;
 
@@ -147,10 +171,34 @@ enum {
 @end
 
 
-@interface CodelessManager ()
+/// Hot path counters, reported by {@link CodelessManager#metrics}.
+typedef struct {
+    int gattQueueHighWater;
+    int64_t gattReads;
+    int64_t gattWrites;
+    int64_t gattWriteCommands;
+    NSTimeInterval gattWriteReadyWaitStart;
+    NSTimeInterval gattWriteReadyWaitTime;
+    int64_t dspsTxXoffCount;
+    NSTimeInterval dspsTxXoffStart;
+    NSTimeInterval dspsTxXoffTime;
+    int64_t dspsRxXoffCount;
+    int64_t dspsTxBytes;
+    int64_t dspsRxBytes;
+    int64_t dspsTxDroppedChunks;
+    int64_t commandsSent;
+    int64_t commandTimeouts;
+    int64_t parseErrors;
+} CodelessManager_Counters;
+
+
+@interface CodelessManager () {
+    CodelessManager_Counters counters;
+}
 
 @property CodelessBluetoothManager* bluetoothManager;
 @property CBPeripheral* device;
+@property id<CodelessTransport> transport;
 @property int state;
 @property int mtu;
 @property NSMutableArray<CodelessManager_GattOperation*>* gattQueue;
@@ -169,6 +217,12 @@ enum {
 @property NSMutableArray<NSString*>* parsePending;
 @property CodelessLogFile* codelessLogFile;
 @property NSMutableArray<CodelessScript*>* scripts;
+@property NSMutableDictionary<NSNumber*, CodelessLatencyHistogram*>* commandLatencyStats;
+@property NSMutableDictionary<NSNumber*, NSArray<CodelessLatencyHistogram*>*>* commandStageStats;
+@property int commandTimeouts;
+@property BOOL lateResponsePending;
+@property BOOL commandStatsUpdated;
+@property CodelessLatencyHistogram* dspsTxLatencyStats;
 
 // DSPS
 @property BOOL dspsTxFlowOn;
@@ -177,9 +231,12 @@ enum {
 @property NSMutableArray<DspsFileSend*>* dspsFiles;
 @property DspsFileReceive* dspsFileReceive;
 @property DspsRxLogFile* dspsRxLogFile;
-@property NSTimeInterval dspsLastInterval;
-@property int dspsRxBytesInterval;
-@property int dspsRxSpeed;
+@property DspsCaptureFile* dspsCaptureFile;
+@property DspsStats* dspsRxStats;
+@property NSMutableArray<NSData*>* dspsRxDataPending;
+@property NSMutableArray<DspsFileChunkEvent*>* dspsFileChunkEventsPending;
+@property NSMutableArray<DspsPatternChunkEvent*>* dspsPatternChunkEventsPending;
+@property BOOL dspsEventFlushScheduled;
 
 // Service database
 @property BOOL servicesDiscovered;
@@ -199,6 +256,13 @@ enum {
 
 @property NSString* logPrefix;
 
+// Event delivery
+/// Typed delegate methods implemented by the delegate, per event.
+@property NSDictionary<NSString*, void (^)(id<CodelessManagerDelegate>, CodelessManager*, CodelessEvent*)>* delegateMethods;
+@property BOOL delegateEvents;
+/// Immutable observer lists per event, replaced when observers are added or removed.
+@property NSMutableDictionary<NSString*, NSArray<CodelessManager_EventObserver*>*>* eventObservers;
+
 @end
 
 @implementation CodelessManager
@@ -222,30 +286,40 @@ static NSString* const TAG = @"CodelessManager";
     self.commandQueue = [NSMutableArray array];
     self.parsePending = [NSMutableArray array];
     self.scripts = [NSMutableArray array];
+    self.commandLatencyStats = [NSMutableDictionary dictionary];
+    self.commandStageStats = [NSMutableDictionary dictionary];
+    self.dspsTxLatencyStats = [[CodelessLatencyHistogram alloc] init];
     self.dspsChunkSize = CodelessLibConfig.DEFAULT_DSPS_CHUNK_SIZE;
     _dspsRxFlowOn = CodelessLibConfig.DEFAULT_DSPS_RX_FLOW_CONTROL;
     self.dspsTxFlowOn = CodelessLibConfig.DEFAULT_DSPS_TX_FLOW_CONTROL;
     self.dspsPending = [NSMutableArray array];
     self.dspsPeriodic = [NSMutableArray array];
     self.dspsFiles = [NSMutableArray array];
-    self.dspsRxSpeed = CodelessManager.SPEED_INVALID;
+    self.dspsRxStats = [[DspsStats alloc] init];
+    self.dspsEventCoalescing = CodelessLibConfig.DSPS_EVENT_COALESCING;
+    self.dspsRxDataPending = [NSMutableArray array];
+    self.dspsFileChunkEventsPending = [NSMutableArray array];
+    self.dspsPatternChunkEventsPending = [NSMutableArray array];
+    self.postNotifications = CodelessLibConfig.EVENT_NOTIFICATIONS;
+    self.eventObservers = [NSMutableDictionary dictionary];
     return self;
 }
 
 - (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)manager device:(CBPeripheral*)device {
+    return self = [self initWithBluetoothManager:manager device:device transport:device];
+}
+
+- (instancetype) initWithBluetoothManager:(CodelessBluetoothManager*)manager device:(CBPeripheral*)device transport:(id<CodelessTransport>)transport {
     self = [self init];
     if (!self)
         return nil;
     self.bluetoothManager = manager;
     self.device = device;
+    self.transport = transport;
     self.commandFactory = [[CodelessCommands alloc] initWithManager:self];
-    self.logPrefix = [NSString stringWithFormat:@"[%@] ", device.identifier.UUIDString];
-    device.delegate = self;
-    [NSNotificationCenter.defaultCenter addObserver:self selector:@selector(onConnection:) name:CodelessLibEvent.DeviceConnected object:self.bluetoothManager];
-    [NSNotificationCenter.defaultCenter addObserver:self selector:@selector(onDisconnection:) name:CodelessLibEvent.DeviceDisconnected object:self.bluetoothManager];
-    [NSNotificationCenter.defaultCenter addObserver:self selector:@selector(onConnectionFailed:) name:CodelessLibEvent.ConnectionFailed object:self.bluetoothManager];
-    if (CodelessLibConfig.BLUETOOTH_STATE_MONITOR)
-        [NSNotificationCenter.defaultCenter addObserver:self selector:@selector(onBluetoothState:) name:CodelessLibEvent.BluetoothState object:self.bluetoothManager];
+    self.logPrefix = [NSString stringWithFormat:@"[%@] ", device ? device.identifier.UUIDString : transport.description];
+    transport.delegate = self;
+    [manager registerManager:self];
     return self;
 }
 
@@ -253,8 +327,88 @@ static NSString* const TAG = @"CodelessManager";
     [NSNotificationCenter.defaultCenter removeObserver:self];
 }
 
+/// Typed delegate method dispatch, per event.
+static NSDictionary<NSString*, NSArray*>* delegateMethodTable(void) {
+    static NSDictionary<NSString*, NSArray*>* table;
+    static dispatch_once_t once;
+#define DELEGATE_METHOD(EVENT, METHOD, CLASS) CodelessLibEvent.EVENT : @[ NSStringFromSelector(@selector(manager:METHOD:)), \
+        ^(id<CodelessManagerDelegate> delegate, CodelessManager* manager, CodelessEvent* event) { [delegate manager:manager METHOD:(CLASS*) event]; } ]
+    dispatch_once(&once, ^{
+        table = @{
+            DELEGATE_METHOD(Connection, connectionEvent, CodelessConnectionEvent),
+            DELEGATE_METHOD(Ready, readyEvent, CodelessReadyEvent),
+            DELEGATE_METHOD(Error, errorEvent, CodelessErrorEvent),
+            DELEGATE_METHOD(Mode, modeEvent, CodelessModeEvent),
+            DELEGATE_METHOD(CommandSuccess, commandSuccessEvent, CodelessCommandSuccessEvent),
+            DELEGATE_METHOD(CommandError, commandErrorEvent, CodelessCommandErrorEvent),
+            DELEGATE_METHOD(InboundCommand, inboundCommandEvent, CodelessInboundCommandEvent),
+            DELEGATE_METHOD(HostCommand, hostCommandEvent, CodelessHostCommandEvent),
+            DELEGATE_METHOD(DspsRxData, dspsRxDataEvent, DspsRxDataEvent),
+            DELEGATE_METHOD(DspsTxFlowControl, dspsTxFlowControlEvent, DspsTxFlowControlEvent),
+            DELEGATE_METHOD(DspsFileChunk, dspsFileChunkEvent, DspsFileChunkEvent),
+            DELEGATE_METHOD(DspsStats, dspsStatsEvent, DspsStatsEvent),
+        };
+    });
+#undef DELEGATE_METHOD
+    return table;
+}
+
+- (void) setDelegate:(id<CodelessManagerDelegate>)delegate {
+    _delegate = delegate;
+    self.delegateEvents = [delegate respondsToSelector:@selector(manager:event:object:)];
+    NSMutableDictionary* methods = [NSMutableDictionary dictionary];
+    [delegateMethodTable() enumerateKeysAndObjectsUsingBlock:^(NSString* event, NSArray* method, BOOL* stop) {
+        if ([delegate respondsToSelector:NSSelectorFromString(method[0])])
+            methods[event] = method[1];
+    }];
+    self.delegateMethods = methods;
+}
+
 - (void) sendEvent:(NSString*)event object:(CodelessEvent*)object {
-    [NSNotificationCenter.defaultCenter postNotificationName:event object:self userInfo:@{ @"event" : object }];
+    if (CodelessLibLog.DUMP_ON_ERROR > 0 && event == CodelessLibEvent.Error && [(id)CodelessLibLog.backend isKindOfClass:CodelessRingLogBackend.class])
+        [(CodelessRingLogBackend*)CodelessLibLog.backend dumpToConsole:CodelessLibLog.DUMP_ON_ERROR];
+
+    id<CodelessManagerDelegate> delegate = self.delegate;
+    if (delegate) {
+        if (self.delegateEvents)
+            [delegate manager:self event:event object:object];
+        void (^method)(id<CodelessManagerDelegate>, CodelessManager*, CodelessEvent*) = self.delegateMethods[event];
+        if (method)
+            method(delegate, self, object);
+    }
+
+    for (CodelessManager_EventObserver* entry in self.eventObservers[event]) {
+        id observer = entry.observer;
+        if (observer)
+            ((void (*)(id, SEL, CodelessEvent*)) entry.method)(observer, entry.selector, object);
+    }
+
+    if (self.postNotifications)
+        [NSNotificationCenter.defaultCenter postNotificationName:event object:self userInfo:@{ @"event" : object }];
+}
+
+- (void) addEventObserver:(id)observer selector:(SEL)selector event:(NSString*)event {
+    NSArray<CodelessManager_EventObserver*>* observers = self.eventObservers[event];
+    CodelessManager_EventObserver* entry = [[CodelessManager_EventObserver alloc] initWithObserver:observer selector:selector];
+    self.eventObservers[event] = observers ? [observers arrayByAddingObject:entry] : @[ entry ];
+}
+
+- (void) removeEventObserver:(id)observer event:(NSString*)event {
+    NSArray<CodelessManager_EventObserver*>* observers = self.eventObservers[event];
+    if (!observers)
+        return;
+    // Also drops the entries of released observers.
+    NSPredicate* keep = [NSPredicate predicateWithBlock:^BOOL(CodelessManager_EventObserver* entry, NSDictionary* bindings) {
+        id current = entry.observer;
+        return current && current != observer;
+    }];
+    observers = [observers filteredArrayUsingPredicate:keep];
+    self.eventObservers[event] = observers.count ? observers : nil;
+}
+
+- (void) removeEventObserver:(id)observer {
+    for (NSString* event in self.eventObservers.allKeys)
+        [self removeEventObserver:observer event:event];
 }
 
 - (void) connect {
@@ -263,12 +417,18 @@ static NSString* const TAG = @"CodelessManager";
         return;
     self.state = CODELESS_STATE_CONNECTING;
     [self sendEvent:CodelessLibEvent.Connection object:[[CodelessConnectionEvent alloc] initWithManager:self]];
-    [self.bluetoothManager connectToPeripheral:self.device];
+    if ([self.transport respondsToSelector:@selector(connect)])
+        [self.transport connect];
+    else
+        [self.bluetoothManager connectToPeripheral:self.device];
 }
 
 - (void) disconnect {
     CodelessLogPrefix(TAG, "Disconnect");
-    [self.bluetoothManager disconnectPeripheral:self.device];
+    if ([self.transport respondsToSelector:@selector(disconnect)])
+        [self.transport disconnect];
+    else
+        [self.bluetoothManager disconnectPeripheral:self.device];
 }
 
 - (BOOL) isConnected {
@@ -329,7 +489,7 @@ static NSString* const TAG = @"CodelessManager";
 
 - (void) getRssi {
     if (self.isConnected)
-        [self.device readRSSI];
+        [self.transport readRSSI];
 }
 
 /**
@@ -346,13 +506,15 @@ static NSString* const TAG = @"CodelessManager";
         if (CodelessLibConfig.SET_FLOW_CONTROL_ON_CONNECTION)
             self.dspsRxFlowOn = _dspsRxFlowOn;
         if (CodelessLibConfig.DSPS_STATS) {
-            if (!self.commandMode) {
-                self.dspsRxBytesInterval = 0;
-                self.dspsLastInterval = [NSDate date].timeIntervalSince1970;
-                [self performSelector:@selector(dspsUpdateStats) withObject:nil afterDelay:CodelessLibConfig.DSPS_STATS_INTERVAL / 1000.];
-            }
+            if (!self.commandMode)
+                [self.dspsRxStats start];
+            [self performSelector:@selector(dspsUpdateStats) withObject:nil afterDelay:CodelessLibConfig.DSPS_STATS_INTERVAL / 1000.];
         }
     }
+    if (self.codelessSupport && CodelessLibConfig.COMMAND_STATS)
+        [self performSelector:@selector(commandUpdateStats) withObject:nil afterDelay:CodelessLibConfig.COMMAND_STATS_INTERVAL / 1000.];
+    if (CodelessLibConfig.METRICS_EVENT)
+        [self performSelector:@selector(metricsUpdate) withObject:nil afterDelay:CodelessLibConfig.METRICS_INTERVAL / 1000.];
     [self sendEvent:CodelessLibEvent.Ready object:[[CodelessReadyEvent alloc] initWithManager:self]];
 }
 
@@ -471,11 +633,8 @@ static NSString* const TAG = @"CodelessManager";
     if (CodelessLibConfig.CODELESS_LOG)
         [self.codelessLogFile log:@"=========== BINARY MODE =========="];
 
-    if (CodelessLibConfig.DSPS_STATS) {
-        self.dspsRxBytesInterval = 0;
-        self.dspsLastInterval = [NSDate date].timeIntervalSince1970;
-        [self performSelector:@selector(dspsUpdateStats) withObject:nil afterDelay:CodelessLibConfig.DSPS_STATS_INTERVAL / 1000.];
-    }
+    if (CodelessLibConfig.DSPS_STATS)
+        [self.dspsRxStats start];
     [self resumeDspsOperations];
 }
 
@@ -487,9 +646,8 @@ static NSString* const TAG = @"CodelessManager";
     self.commandMode = true;
     [self sendEvent:CodelessLibEvent.Mode object:[[CodelessModeEvent alloc] initWithManager:self command:self.commandMode]];
 
-    if (CodelessLibConfig.DSPS_STATS) {
-        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(dspsUpdateStats) object:nil];
-    }
+    if (CodelessLibConfig.DSPS_STATS)
+        [self.dspsRxStats stop];
     [self pauseDspsOperations:false];
 
     if (CodelessLibConfig.CODELESS_LOG)
@@ -573,32 +731,16 @@ static NSString* const TAG = @"CodelessManager";
 }
 
 - (CodelessCommand*) parseTextCommand:(NSString*)line {
-    line = [line stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
-    if (CodelessLibConfig.AUTO_ADD_PREFIX && ![CodelessProfile hasPrefix:line])
-        line = [CodelessProfile.PREFIX stringByAppendingString:line];
+    line = [CodelessProfile normalizeTextCommand:line];
 
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Text command: %@", line);
+    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Text command: %@", line);
 
     if (CodelessLibConfig.CODELESS_LOG)
         [self.codelessLogFile logText:line];
 
-    CodelessCommand* command;
-    NSString* id = [CodelessProfile getCommand:line];
-    if (!id) {
-        command = [[CodelessCustomCommand alloc] initWithManager:self command:line parse:true];
-    } else {
-        Class commandClass = CodelessProfile.commandMap[id];
-        if (!commandClass) {
-            command = [[CodelessCustomCommand alloc] initWithManager:self command:line parse:true];
-        } else {
-            NSString* prefix = [CodelessProfile getPrefix:line];
-            line = [CodelessProfile removeCommandPrefix:line];
-            command = [CodelessProfile createCommand:self commandClass:commandClass command:line];
-            command.prefix = prefix;
-        }
-    }
+    CodelessCommand* command = [CodelessProfile createTextCommand:line manager:self];
 
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Text command identified: %@%@", command, command.isValid ? @"" : @" (invalid)");
+    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Text command identified: %@%@", command, command.isValid ? @"" : @" (invalid)");
     return command;
 }
 
@@ -614,11 +756,26 @@ static NSString* const TAG = @"CodelessManager";
     [self enqueueCommands:commands];
 }
 
+- (int) cancelCommands:(NSObject*)origin {
+    int count = 0;
+    for (int i = 0; i < self.commandQueue.count; ++i) {
+        if (self.commandQueue[i].origin == origin) {
+            [self.commandQueue removeObjectAtIndex:i--];
+            count++;
+        }
+    }
+    if (count)
+        CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Cancelled %d queued commands: %@", count, origin);
+    return count;
+}
+
 /**
  * Enqueues a command to be sent.
  * @param command the command to send
  */
 - (void) enqueueCommand:(CodelessCommand*)command {
+    if (CodelessLibConfig.COMMAND_STATS)
+        [command markStage:CODELESS_COMMAND_STAGE_QUEUED];
     if (self.commandPending || self.commandInbound || self.inboundPending > 0) {
         [self.commandQueue addObject:command];
     } else {
@@ -632,6 +789,10 @@ static NSString* const TAG = @"CodelessManager";
  * @param commands the commands to send
  */
 - (void) enqueueCommands:(NSArray<CodelessCommand*>*)commands {
+    if (CodelessLibConfig.COMMAND_STATS) {
+        for (CodelessCommand* command in commands)
+            [command markStage:CODELESS_COMMAND_STAGE_QUEUED];
+    }
     [self.commandQueue addObjectsFromArray:commands];
     if (!self.commandPending) {
         [self dequeueCommand];
@@ -640,7 +801,7 @@ static NSString* const TAG = @"CodelessManager";
 
 /// Dequeues and sends the next command from the command queue.
 - (void) dequeueCommand {
-    if (self.commandQueue.count == 0 || self.commandInbound || self.inboundPending > 0)
+    if (self.commandQueue.count == 0 || self.commandInbound || self.inboundPending > 0 || self.lateResponsePending)
         return;
     self.commandPending = self.commandQueue[0];
     [self.commandQueue removeObjectAtIndex:0];
@@ -652,7 +813,9 @@ static NSString* const TAG = @"CodelessManager";
  * @param dequeue <code>true</code> to dequeue and send the next command
  */
 - (void) commandComplete:(BOOL)dequeue {
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Command complete: %@", self.commandPending);
+    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Command complete: %@", self.commandPending);
+    if (self.commandPending)
+        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(onCommandTimeout:) object:self.commandPending];
     [self.parsePending removeAllObjects];
     self.commandPending = nil;
     if (dequeue)
@@ -661,7 +824,7 @@ static NSString* const TAG = @"CodelessManager";
 
 /// Actions performed when the pending incoming command is complete.
 - (void) inboundCommandComplete {
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Inbound command complete: %@", self.commandInbound);
+    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Inbound command complete: %@", self.commandInbound);
     if (CodelessLibConfig.SINGLE_WRITE_RESPONSE)
         [self.parsePending removeAllObjects];
     else
@@ -672,7 +835,9 @@ static NSString* const TAG = @"CodelessManager";
 
 /// Sends a command to the peer device.
 - (void) executeCommand:(CodelessCommand*)command {
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Send codeless command: %@", command);
+    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Send codeless command: %@", command);
+    if (CodelessLibConfig.COMMAND_STATS)
+        [command markStage:CODELESS_COMMAND_STAGE_EXECUTE];
     if (![self checkReady]) {
         [command setComplete];
         [self commandComplete:true];
@@ -686,7 +851,8 @@ static NSString* const TAG = @"CodelessManager";
         NSString* prefix = ![CodelessProfile isModeCommand:command] ? CodelessProfile.PREFIX_REMOTE : CodelessProfile.PREFIX_LOCAL;
         text = [prefix stringByAppendingString:[CodelessProfile removeCommandPrefix:text]];
     } else if (CodelessLibConfig.DISALLOW_INVALID_PREFIX && ![CodelessProfile hasPrefix:text]) {
-        CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Invalid prefix: %@", text);
+        CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Invalid prefix: %@", text);
+        counters.parseErrors++;
         [self sendEvent:CodelessLibEvent.Error object:[[CodelessErrorEvent alloc] initWithManager:self error:CODELESS_ERROR_INVALID_PREFIX]];
         [command setComplete];
         [self commandComplete:true];
@@ -695,6 +861,7 @@ static NSString* const TAG = @"CodelessManager";
 
     if (CodelessLibConfig.DISALLOW_INVALID_COMMAND && !command.parsed && !command.isValid) {
         CodelessLogPrefix(TAG, "Invalid command: %@", text);
+        counters.parseErrors++;
         [self sendEvent:CodelessLibEvent.Error object:[[CodelessErrorEvent alloc] initWithManager:self error:CODELESS_ERROR_INVALID_COMMAND]];
         [command setComplete];
         [self commandComplete:true];
@@ -702,17 +869,216 @@ static NSString* const TAG = @"CodelessManager";
     }
 
     if (CodelessLibConfig.DISALLOW_INVALID_PARSED_COMMAND && command.parsed && !command.isValid) {
-        CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Invalid command: %@", text);
+        CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Invalid command: %@", text);
+        counters.parseErrors++;
         [self sendEvent:CodelessLibEvent.Error object:[[CodelessErrorEvent alloc] initWithManager:self error:CODELESS_ERROR_INVALID_COMMAND]];
         [command setComplete];
         [self commandComplete:true];
         return;
     }
 
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Codeless command text: %@", text);
+    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Codeless command text: %@", text);
+    command.sendTime = NSProcessInfo.processInfo.systemUptime;
+    counters.commandsSent++;
+    if (CodelessLibConfig.COMMAND_STATS)
+        [command markStage:CODELESS_COMMAND_STAGE_SENT];
+    // Responses received from now on belong to this command.
+    if (self.lateResponsePending) {
+        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(lateResponseWindowEnd) object:nil];
+        self.lateResponsePending = false;
+    }
+    NSTimeInterval timeout = command.timeout;
+    if (timeout > 0)
+        [self performSelector:@selector(onCommandTimeout:) withObject:command afterDelay:timeout];
     [self sendText:text type:CodelessLineOutboundCommand];
 }
 
+/**
+ * Called if the peer device does not respond to the pending outgoing command in time.
+ * <p> The command fails with a timeout error and the next command is sent after the
+ * {@link CodelessLibConfig#COMMAND_LATE_RESPONSE_WINDOW late response window}.
+ * A {@link CodelessLibEvent#Error Error} event is generated.
+ * @param command the command that timed out
+ */
+- (void) onCommandTimeout:(CodelessCommand*)command {
+    if (self.commandPending != command || command.complete)
+        return;
+    CodelessLogPrefix(TAG, "Command timeout: %@", command);
+    self.commandTimeouts++;
+    counters.commandTimeouts++;
+    self.commandStatsUpdated = true;
+    [self sendEvent:CodelessLibEvent.Error object:[[CodelessErrorEvent alloc] initWithManager:self error:CODELESS_ERROR_COMMAND_TIMEOUT]];
+    [command onError:CodelessProfile.COMMAND_TIMEOUT_ERROR];
+    if (self.commandPending != command)
+        return;
+    // Hold the queue for a while, so that a late response is not parsed as the response of the next command.
+    self.lateResponsePending = true;
+    [self commandComplete:false];
+    [self performSelector:@selector(lateResponseWindowEnd) withObject:nil afterDelay:CodelessLibConfig.COMMAND_LATE_RESPONSE_WINDOW / 1000.];
+}
+
+/// Ends the late response window of a timed out command and sends the next command.
+- (void) lateResponseWindowEnd {
+    [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(lateResponseWindowEnd) object:nil];
+    self.lateResponsePending = false;
+    if (!self.commandPending)
+        [self dequeueCommand];
+}
+
+/**
+ * Drops a line of a late response to a command that timed out.
+ * <p> Lines are dropped only until the next command is sent, up to the final response (<code>OK</code> or <code>ERROR</code>).
+ * Peer commands are not dropped.
+ * @param line the received line
+ * @return <code>true</code> if the line was dropped
+ */
+- (BOOL) dropLateResponse:(NSString*)line {
+    if (!self.lateResponsePending || self.commandPending || [CodelessProfile isCommand:line])
+        return false;
+    CodelessLogPrefix(TAG, "Drop late response: %@", line);
+    // The next command is sent after the received lines are processed.
+    if ([CodelessProfile isSuccess:line] || [CodelessProfile isError:line]) {
+        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(lateResponseWindowEnd) object:nil];
+        self.lateResponsePending = false;
+    }
+    return true;
+}
+
+/**
+ * Records the response latency of the pending outgoing command.
+ * <p> Called when the final response (success or error) is received.
+ */
+- (void) recordCommandLatency {
+    if (!CodelessLibConfig.COMMAND_STATS || !self.commandPending.sendTime)
+        return;
+    NSNumber* key = @(self.commandPending.commandID);
+    CodelessLatencyHistogram* histogram = self.commandLatencyStats[key];
+    if (!histogram) {
+        histogram = [[CodelessLatencyHistogram alloc] init];
+        self.commandLatencyStats[key] = histogram;
+    }
+    [histogram record:NSProcessInfo.processInfo.systemUptime - self.commandPending.sendTime];
+    [self recordCommandStages:self.commandPending];
+    self.commandStatsUpdated = true;
+}
+
+/**
+ * Records the time spent in each processing stage of a completed command.
+ * <p> Each stage is measured from the previous stage that was reached.
+ */
+- (void) recordCommandStages:(CodelessCommand*)command {
+    [command markStage:CODELESS_COMMAND_STAGE_COMPLETE];
+    NSNumber* key = @(command.commandID);
+    NSArray<CodelessLatencyHistogram*>* stages = self.commandStageStats[key];
+    if (!stages) {
+        NSMutableArray<CodelessLatencyHistogram*>* histograms = [NSMutableArray arrayWithCapacity:CODELESS_COMMAND_STAGE_COUNT];
+        for (int i = 0; i < CODELESS_COMMAND_STAGE_COUNT; ++i)
+            [histograms addObject:[[CodelessLatencyHistogram alloc] init]];
+        stages = [NSArray arrayWithArray:histograms];
+        self.commandStageStats[key] = stages;
+    }
+    NSTimeInterval previous = [command stageTime:CODELESS_COMMAND_STAGE_CREATED];
+    for (int i = CODELESS_COMMAND_STAGE_CREATED + 1; i < CODELESS_COMMAND_STAGE_COUNT; ++i) {
+        NSTimeInterval time = [command stageTime:i];
+        if (!time)
+            continue;
+        if (previous)
+            [stages[i] record:time - previous];
+        previous = time;
+    }
+}
+
+- (NSDictionary<NSNumber*, CodelessLatencyHistogram*>*) commandLatency {
+    NSMutableDictionary<NSNumber*, CodelessLatencyHistogram*>* snapshot = [NSMutableDictionary dictionaryWithCapacity:self.commandLatencyStats.count];
+    for (NSNumber* key in self.commandLatencyStats)
+        snapshot[key] = [self.commandLatencyStats[key] copy];
+    return [NSDictionary dictionaryWithDictionary:snapshot];
+}
+
+- (NSDictionary<NSNumber*, NSArray<CodelessLatencyHistogram*>*>*) commandStageLatency {
+    NSMutableDictionary<NSNumber*, NSArray<CodelessLatencyHistogram*>*>* snapshot = [NSMutableDictionary dictionaryWithCapacity:self.commandStageStats.count];
+    for (NSNumber* key in self.commandStageStats)
+        snapshot[key] = [[NSArray alloc] initWithArray:self.commandStageStats[key] copyItems:true];
+    return [NSDictionary dictionaryWithDictionary:snapshot];
+}
+
+- (CodelessLatencyHistogram*) commandLatencyForID:(int)commandID {
+    return [self.commandLatencyStats[@(commandID)] copy];
+}
+
+- (void) resetCommandStats {
+    [self.commandLatencyStats removeAllObjects];
+    [self.commandStageStats removeAllObjects];
+    self.commandTimeouts = 0;
+    self.commandStatsUpdated = false;
+}
+
+- (CodelessLatencyHistogram*) dspsTxLatency {
+    return [self.dspsTxLatencyStats copy];
+}
+
+- (void) resetDspsTxLatency {
+    [self.dspsTxLatencyStats reset];
+}
+
+- (CodelessMetrics*) metrics {
+    NSTimeInterval now = NSProcessInfo.processInfo.systemUptime;
+    CodelessMetrics* metrics = [[CodelessMetrics alloc] init];
+    metrics.time = now;
+    metrics.gattQueueDepth = (int) self.gattQueue.count;
+    metrics.gattQueueHighWater = counters.gattQueueHighWater;
+    metrics.gattReads = counters.gattReads;
+    metrics.gattWrites = counters.gattWrites;
+    metrics.gattWriteCommands = counters.gattWriteCommands;
+    metrics.gattWriteReadyWaitTime = counters.gattWriteReadyWaitTime;
+    metrics.dspsTxXoffCount = counters.dspsTxXoffCount;
+    metrics.dspsTxXoffTime = counters.dspsTxXoffTime + (counters.dspsTxXoffStart ? now - counters.dspsTxXoffStart : 0);
+    metrics.dspsRxXoffCount = counters.dspsRxXoffCount;
+    metrics.dspsTxBytes = counters.dspsTxBytes;
+    metrics.dspsRxBytes = counters.dspsRxBytes;
+    metrics.dspsTxDroppedChunks = counters.dspsTxDroppedChunks;
+    metrics.commandQueueDepth = (int) self.commandQueue.count;
+    metrics.commandsInFlight = (self.commandPending != nil) + (self.commandInbound != nil);
+    metrics.commandsSent = counters.commandsSent;
+    metrics.commandTimeouts = counters.commandTimeouts;
+    metrics.parseErrors = counters.parseErrors;
+    return metrics;
+}
+
+- (void) resetMetrics {
+    NSTimeInterval now = NSProcessInfo.processInfo.systemUptime;
+    BOOL xoff = counters.dspsTxXoffStart != 0;
+    BOOL writeReadyWait = counters.gattWriteReadyWaitStart != 0;
+    counters = (CodelessManager_Counters) {0};
+    counters.gattQueueHighWater = (int) self.gattQueue.count;
+    // Keep ongoing intervals, so that they are measured from the reset time.
+    if (xoff)
+        counters.dspsTxXoffStart = now;
+    if (writeReadyWait)
+        counters.gattWriteReadyWaitStart = now;
+}
+
+/**
+ * Reports the manager metrics, called every {@link CodelessLibConfig#METRICS_INTERVAL}.
+ * <p> A {@link CodelessLibEvent#Metrics Metrics} event is generated.
+ */
+- (void) metricsUpdate {
+    [self performSelector:@selector(metricsUpdate) withObject:nil afterDelay:CodelessLibConfig.METRICS_INTERVAL / 1000.];
+    [self sendEvent:CodelessLibEvent.Metrics object:[[CodelessMetricsEvent alloc] initWithManager:self metrics:self.metrics]];
+}
+
+/**
+ * Reports the command statistics, called every {@link CodelessLibConfig#COMMAND_STATS_INTERVAL}.
+ * <p> A {@link CodelessLibEvent#CommandStats CommandStats} event is generated, if there are new values.
+ */
+- (void) commandUpdateStats {
+    [self performSelector:@selector(commandUpdateStats) withObject:nil afterDelay:CodelessLibConfig.COMMAND_STATS_INTERVAL / 1000.];
+    if (!self.commandStatsUpdated)
+        return;
+    self.commandStatsUpdated = false;
+    [self sendEvent:CodelessLibEvent.CommandStats object:[[CodelessCommandStatsEvent alloc] initWithManager:self latency:self.commandLatency timeouts:self.commandTimeouts]];
+}
+
 - (void) completePendingCommand:(CodelessCommand*)command {
     if (self.commandPending != command) {
         CodelessLogPrefix(TAG, "Not current pending command: %@", command);
@@ -740,7 +1106,7 @@ static NSString* const TAG = @"CodelessManager";
         CodelessLogPrefix(TAG, "No inbound command pending");
         return;
     }
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Send success: %@", self.commandInbound);
+    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Send success: %@", self.commandInbound);
     if (CodelessLibConfig.SINGLE_WRITE_RESPONSE) {
         [self sendText:[self createSingleWriteResponse:true message:nil] type:CodelessLineOutboundResponse];
     } else {
@@ -756,7 +1122,7 @@ static NSString* const TAG = @"CodelessManager";
         return;
     }
     if (CodelessLibConfig.SINGLE_WRITE_RESPONSE) {
-        if (CodelessLibLog.CODELESS) {
+        if (CodelessLogEnabled(CODELESS_LOG_CODELESS)) {
             CodelessLogPrefix(TAG, "Send response: %@ %@", self.commandInbound, response);
             CodelessLogPrefix(TAG, "Send success: %@", self.commandInbound);
         }
@@ -774,7 +1140,7 @@ static NSString* const TAG = @"CodelessManager";
         CodelessLogPrefix(TAG, "No inbound command pending");
         return;
     }
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Send error: %@ %@", self.commandInbound, error);
+    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Send error: %@ %@", self.commandInbound, error);
     if (CodelessLibConfig.SINGLE_WRITE_RESPONSE) {
         [self sendText:[self createSingleWriteResponse:false message:error]  type:CodelessLineOutboundError];
     } else {
@@ -789,7 +1155,7 @@ static NSString* const TAG = @"CodelessManager";
         CodelessLogPrefix(TAG, "No inbound command pending");
         return;
     }
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Send response: %@ %@", self.commandInbound, response);
+    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Send response: %@ %@", self.commandInbound, response);
     if (CodelessLibConfig.SINGLE_WRITE_RESPONSE) {
         [self.parsePending addObject:response];
     } else {
@@ -811,7 +1177,8 @@ static NSString* const TAG = @"CodelessManager";
  * @param error the error message
  */
 - (void) sendParseError:(NSString*)error {
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Send error: %@", error);
+    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Send error: %@", error);
+    counters.parseErrors++;
     error = [CodelessProfile.ERROR_PREFIX stringByAppendingString:error];
     if (CodelessLibConfig.SINGLE_WRITE_RESPONSE) {
         [self sendText:[[error stringByAppendingString:@"\n"] stringByAppendingString:CodelessProfile.ERROR] type:CodelessLineOutboundError];
@@ -892,7 +1259,7 @@ static NSString* const TAG = @"CodelessManager";
         return;
     }
     if ([CodelessProfile isSuccess:line]) {
-        CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Received OK");
+        CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Received OK");
         for (NSString* response in self.parsePending) {
             if (response.length == 0) {
                 if (CodelessLibConfig.CODELESS_LOG || CodelessLibConfig.LINE_EVENTS)
@@ -906,9 +1273,10 @@ static NSString* const TAG = @"CodelessManager";
         [self.parsePending removeAllObjects];
         if (CodelessLibConfig.CODELESS_LOG || CodelessLibConfig.LINE_EVENTS)
             [self processCodelessLine:line type:CodelessLineInboundOK];
+        [self recordCommandLatency];
         [self.commandPending onSuccess];
     } else if ([CodelessProfile isError:line]) {
-        CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Received ERROR");
+        CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Received ERROR");
         NSMutableString* error = [NSMutableString string];
         for (NSString* msg in self.parsePending) {
             if (msg.length == 0) {
@@ -931,12 +1299,13 @@ static NSString* const TAG = @"CodelessManager";
         [self.parsePending removeAllObjects];
         if (CodelessLibConfig.CODELESS_LOG || CodelessLibConfig.LINE_EVENTS)
             [self processCodelessLine:line type:CodelessLineInboundError];
+        [self recordCommandLatency];
         [self.commandPending onError:error.length > 0 ? [NSString stringWithString:error] : line];
     } else if ([CodelessProfile isErrorMessage:line]) {
-        CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Received potential error: %@", line);
+        CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Received potential error: %@", line);
         [self.parsePending addObject:line];
     } else {
-        CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Received response: %@", line);
+        CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Received response: %@", line);
         if (self.parsePending.count == 0 && self.commandPending.parsePartialResponse) {
             if (CodelessLibConfig.CODELESS_LOG || CodelessLibConfig.LINE_EVENTS)
                 [self processCodelessLine:line type:CodelessLineInboundResponse];
@@ -951,12 +1320,12 @@ static NSString* const TAG = @"CodelessManager";
 
 /// Parses the text that was received from the peer device as an incoming command.
 - (void) parseInboundCommand:(NSString*)line {
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Received command: %@", line);
+    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Received command: %@", line);
     if (CodelessLibConfig.CODELESS_LOG || CodelessLibConfig.LINE_EVENTS)
         [self processCodelessLine:line type:CodelessLineInboundCommand];
 
     if (self.commandInbound) {
-        CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Inbound command in progress. Ignore inbound data.");
+        CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Inbound command in progress. Ignore inbound data.");
         return;
     }
 
@@ -984,12 +1353,13 @@ static NSString* const TAG = @"CodelessManager";
             } else if ([CodelessLibConfig.supportedCommands containsObject:@(command.commandID)]) {
                 if (![self checkCommandMode:false command:command])
                     return;
-                CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Library command: %@", command);
+                CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Library command: %@", command);
                 self.commandInbound = command;
                 [self.commandInbound setInbound];
                 [self sendEvent:CodelessLibEvent.InboundCommand object:[[CodelessInboundCommandEvent alloc] initWithCommand:self.commandInbound]];
                 if (!command.isValid) {
-                    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Invalid command: %@ %@", command, command.error);
+                    CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Invalid command: %@ %@", command, command.error);
+                    counters.parseErrors++;
                     [self.commandInbound setComplete];
                     [self sendError:[CodelessProfile.ERROR_PREFIX stringByAppendingString:self.commandInbound.error]];
                 } else {
@@ -1004,7 +1374,7 @@ static NSString* const TAG = @"CodelessManager";
     if (hostCommand) {
         if (![self checkCommandMode:false command:hostCommand])
             return;
-        CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Host command: %@", hostCommand);
+        CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Host command: %@", hostCommand);
         self.commandInbound = hostCommand;
         [self.commandInbound setInbound];
         [self sendEvent:CodelessLibEvent.HostCommand object:[[CodelessHostCommandEvent alloc] initWithCommand:self.commandInbound]];
@@ -1017,8 +1387,10 @@ static NSString* const TAG = @"CodelessManager";
  */
 - (void) onCodelessFlowControl:(NSData*)data {
     if (data.length > 0 && ((uint8_t*)data.bytes)[0] == CODELESS_DATA_PENDING) {
+        if (CodelessLibConfig.COMMAND_STATS)
+            [self.commandPending markStage:CODELESS_COMMAND_STAGE_PENDING];
         self.inboundPending++;
-        CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Pending codeless inbound data: %d", self.inboundPending);
+        CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Pending codeless inbound data: %d", self.inboundPending);
         [self readCharacteristic:self.codelessOutbound];
     } else {
         CodelessLogPrefix(TAG, "Invalid codeless flow control value: %@", [CodelessUtil hexArrayLog:data]);
@@ -1030,14 +1402,16 @@ static NSString* const TAG = @"CodelessManager";
  * <p> The incoming data may be an incoming command or a response to an outgoing command.
  */
 - (void) onCodelessInbound:(NSData*)data {
-    CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Codeless inbound data: %@", [CodelessUtil hexArrayLog:data]);
+    CodelessLogPrefixDataOpt(CODELESS_LOG_CODELESS, TAG, data, "Codeless inbound data: ");
+    if (CodelessLibConfig.COMMAND_STATS)
+        [self.commandPending markStage:CODELESS_COMMAND_STAGE_READ];
 
     // Remove trailing zero
     if (data.length > 0 && ((uint8_t*)data.bytes)[data.length - 1] == 0)
         data = [NSData dataWithBytes:data.bytes length:data.length - 1];
 
     if (data.length == 0)
-        CodelessLogPrefixOpt(CodelessLibLog.CODELESS, TAG, "Received empty buffer");
+        CodelessLogPrefixOpt(CODELESS_LOG_CODELESS, TAG, "Received empty buffer");
 
     NSString* inbound = [[NSString alloc] initWithData:data encoding:CodelessLibConfig.CHARSET];
     inbound = [inbound stringByReplacingOccurrencesOfString:@"\r\n" withString:@"\n"];
@@ -1051,6 +1425,8 @@ static NSString* const TAG = @"CodelessManager";
 
     for (__strong NSString* line in lines) {
         line = [line stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
+        if (line.length && [self dropLateResponse:line])
+            continue;
         if (self.commandPending) {
             [self parseCommandResponse:line];
         } else {
@@ -1084,12 +1460,12 @@ static NSString* const TAG = @"CodelessManager";
 }
 
 - (void) sendDspsText:(NSString*)text {
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS_DATA, TAG, "DSPS TX text: %@", text);
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS_DATA, TAG, "DSPS TX text: %@", text);
     [self sendDspsData:[text dataUsingEncoding:CodelessLibConfig.CHARSET]];
 }
 
 - (void) sendDspsHexData:(NSString*)hex {
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS_DATA, TAG, "DSPS TX hex: %@", hex);
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS_DATA, TAG, "DSPS TX hex: %@", hex);
     NSData* data = [CodelessUtil hex2bytes:hex];
     if (data)
         [self sendDspsData:data];
@@ -1104,7 +1480,7 @@ static NSString* const TAG = @"CodelessManager";
 - (void) sendDspsData:(NSData*)data chunkSize:(int)chunkSize {
     if (![self checkReady] || ![self checkBinaryMode:true])
         return;
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS_DATA, TAG, "DSPS TX data: %@", [CodelessUtil hexArrayLog:data]);
+    CodelessLogPrefixDataOpt(CODELESS_LOG_DSPS_DATA, TAG, data, "DSPS TX data: ");
     if (chunkSize > self.dspsChunkSize)
         chunkSize = self.dspsChunkSize;
     if (data.length <= chunkSize) {
@@ -1113,7 +1489,8 @@ static NSString* const TAG = @"CodelessManager";
         } else if (self.dspsPending.count <= CodelessLibConfig.DSPS_PENDING_MAX_SIZE) {
             [self.dspsPending addObject:[[CodelessManager_DspsChunkOperation alloc] initWithManager:self data:data]];
         } else {
-            CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "DSPS TX data dropped (flow off, queue full)");
+            CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "DSPS TX data dropped (flow off, queue full)");
+            counters.dspsTxDroppedChunks++;
         }
     } else {
         NSMutableArray<CodelessManager_GattOperation*>* chunks = [NSMutableArray array];
@@ -1125,7 +1502,8 @@ static NSString* const TAG = @"CodelessManager";
         } else if (self.dspsPending.count <= CodelessLibConfig.DSPS_PENDING_MAX_SIZE) {
             [self.dspsPending addObjectsFromArray:chunks];
         } else {
-            CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "DSPS TX data dropped (flow off, queue full)");
+            CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "DSPS TX data dropped (flow off, queue full)");
+            counters.dspsTxDroppedChunks += chunks.count;
         }
     }
 }
@@ -1136,18 +1514,29 @@ static NSString* const TAG = @"CodelessManager";
  * @param data the received binary data
  */
 - (void) onDspsData:(NSData*)data {
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS_DATA, TAG, "DSPS RX data: %@", [CodelessUtil hexArrayLog:data]);
+    CodelessLogPrefixDataOpt(CODELESS_LOG_DSPS_DATA, TAG, data, "DSPS RX data: ");
+    counters.dspsRxBytes += data.length;
+    if (CodelessLibConfig.DSPS_CAPTURE)
+        [self.dspsCaptureFile log:data direction:DSPS_CAPTURE_RX characteristic:CODELESS_GATT_TRACE_DSPS_SERVER_TX];
     if (![self checkBinaryMode:false])
         return;
     if (self.dspsEcho)
         [self sendDspsData:data];
     if (self.dspsFileReceive)
         [self.dspsFileReceive onDspsData:data];
-    if (CodelessLibConfig.DSPS_RX_LOG && (!self.dspsFileReceive || CodelessLibConfig.DSPS_RX_FILE_LOG_DATA))
+    DspsRxAggregator* aggregator = self.dspsRxAggregator;
+    if (aggregator)
+        [aggregator manager:self didReceiveData:data];
+    else if (CodelessLibConfig.DSPS_RX_LOG && (!self.dspsFileReceive || CodelessLibConfig.DSPS_RX_FILE_LOG_DATA))
         [self.dspsRxLogFile log:data];
     if (CodelessLibConfig.DSPS_STATS)
-        self.dspsRxBytesInterval += data.length;
-    [self sendEvent:CodelessLibEvent.DspsRxData object:[[DspsRxDataEvent alloc] initWithManager:self data:data]];
+        [self.dspsRxStats addBytes:data.length];
+    if (self.dspsEventCoalescing) {
+        [self.dspsRxDataPending addObject:data];
+        [self scheduleDspsEventFlush];
+    } else {
+        [self sendEvent:CodelessLibEvent.DspsRxData object:[[DspsRxDataEvent alloc] initWithManager:self data:data]];
+    }
 }
 
 /**
@@ -1159,7 +1548,9 @@ static NSString* const TAG = @"CodelessManager";
  */
 - (void) setDspsRxFlowOn:(BOOL)on {
     _dspsRxFlowOn = on;
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "DSPS RX flow control: %@", _dspsRxFlowOn ? @"ON" : @"OFF");
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "DSPS RX flow control: %@", _dspsRxFlowOn ? @"ON" : @"OFF");
+    if (!_dspsRxFlowOn)
+        counters.dspsRxXoffCount++;
     uint8_t value = _dspsRxFlowOn ? (uint8_t) CODELESS_DSPS_XON : (uint8_t) CODELESS_DSPS_XOFF;
     NSData* data = [NSData dataWithBytes:&value length:1];
     [self writeCharacteristic:_dspsFlowControl value:data response:false];
@@ -1172,6 +1563,8 @@ static NSString* const TAG = @"CodelessManager";
  * @param data the notification data
  */
 - (void) onDspsFlowControl:(NSData*)data {
+    if (CodelessLibConfig.DSPS_CAPTURE)
+        [self.dspsCaptureFile log:data direction:DSPS_CAPTURE_RX characteristic:CODELESS_GATT_TRACE_DSPS_FLOW_CONTROL];
     int value = data.length > 0 ? ((uint8_t*)data.bytes)[0] : INT_MIN;
     BOOL prev = self.dspsTxFlowOn;
     switch (value) {
@@ -1189,7 +1582,16 @@ static NSString* const TAG = @"CodelessManager";
     if (prev == self.dspsTxFlowOn)
         return;
 
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "DSPS TX flow control: %@", self.dspsTxFlowOn ? @"ON" : @"OFF");
+    NSTimeInterval now = NSProcessInfo.processInfo.systemUptime;
+    if (!self.dspsTxFlowOn) {
+        counters.dspsTxXoffCount++;
+        counters.dspsTxXoffStart = now;
+    } else if (counters.dspsTxXoffStart) {
+        counters.dspsTxXoffTime += now - counters.dspsTxXoffStart;
+        counters.dspsTxXoffStart = 0;
+    }
+
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "DSPS TX flow control: %@", self.dspsTxFlowOn ? @"ON" : @"OFF");
     [self sendEvent:CodelessLibEvent.DspsTxFlowControl object:[[DspsTxFlowControlEvent alloc] initWithManager:self flowOn:self.dspsTxFlowOn]];
 
     if (self.dspsTxFlowOn) {
@@ -1200,7 +1602,11 @@ static NSString* const TAG = @"CodelessManager";
 }
 
 - (DspsFileSend*) sendFile:(NSString*)file chunkSize:(int)chunkSize period:(int)period {
-    DspsFileSend* operation = [[DspsFileSend alloc] initWithManager:self file:file chunkSize:chunkSize period:period];
+    return [self sendFile:file chunkSize:chunkSize period:period compressed:false];
+}
+
+- (DspsFileSend*) sendFile:(NSString*)file chunkSize:(int)chunkSize period:(int)period compressed:(BOOL)compressed {
+    DspsFileSend* operation = [[DspsFileSend alloc] initWithManager:self file:file chunkSize:chunkSize period:period compressed:compressed];
     if (operation.isLoaded)
         [operation start];
     return operation;
@@ -1225,7 +1631,7 @@ static NSString* const TAG = @"CodelessManager";
     if (operation.period > 0) {
         [operation performSelector:@selector(sendChunk) withObject:nil afterDelay:resume ? operation.period / 1000. : 0];
     } else {
-        CodelessLogPrefixOpt(CodelessLibLog.DSPS_FILE_CHUNK, TAG, "Queue all file chunks: %@", operation);
+        CodelessLogPrefixOpt(CODELESS_LOG_DSPS_FILE_CHUNK, TAG, "Queue all file chunks: %@", operation);
         NSMutableArray<CodelessManager_GattOperation*>* chunks = [NSMutableArray array];
         for (int i = resume ? operation.chunk : 0; i < operation.totalChunks; i++) {
             [chunks addObject:[[CodelessManager_DspsFileChunkOperation alloc] initWithOperation:operation data:operation.chunks[i] chunk:i + 1]];
@@ -1354,21 +1760,110 @@ static NSString* const TAG = @"CodelessManager";
     return operation;
 }
 
+- (int) dspsRxSpeed {
+    return self.dspsRxStats.currentSpeed;
+}
+
 /**
  * Performs statistics calculations, called every {@link CodelessLibConfig#DSPS_STATS_INTERVAL}.
- * <p> A {@link CodelessLibEvent#DspsStats DspsStats} event is generated.
+ * <p> This is the only statistics timer. It updates the receive statistics (in binary mode),
+ * as well as the statistics of all active DSPS operations.
+ * <p> A {@link CodelessLibEvent#DspsStats DspsStats} event is generated for each one of them.
  */
 - (void) dspsUpdateStats {
-    if (self.commandMode)
-        return;
-    NSTimeInterval now = [NSDate date].timeIntervalSince1970;
-    if (now == self.dspsLastInterval)
-        now += 0.001;
-    self.dspsRxSpeed = (int) (self.dspsRxBytesInterval / (now - self.dspsLastInterval));
-    self.dspsLastInterval = now;
-    self.dspsRxBytesInterval = 0;
     [self performSelector:@selector(dspsUpdateStats) withObject:nil afterDelay:CodelessLibConfig.DSPS_STATS_INTERVAL / 1000.];
-    [self sendEvent:CodelessLibEvent.DspsStats object:[[DspsStatsEvent alloc] initWithManager:self operation:nil currentSpeed:self.dspsRxSpeed averageSpeed:CodelessManager.SPEED_INVALID]];
+    if (!self.commandMode && self.dspsRxStats.running) {
+        [self.dspsRxStats update];
+        [self sendEvent:CodelessLibEvent.DspsStats object:[[DspsStatsEvent alloc] initWithManager:self operation:nil currentSpeed:self.dspsRxSpeed averageSpeed:CodelessManager.SPEED_INVALID]];
+    }
+    for (DspsPeriodicSend* operation in [NSArray arrayWithArray:self.dspsPeriodic])
+        [operation updateStats];
+    for (DspsFileSend* operation in [NSArray arrayWithArray:self.dspsFiles])
+        [operation updateStats];
+    if (self.dspsFileReceive)
+        [self.dspsFileReceive updateStats];
+}
+
+/**
+ * Generates a {@link CodelessLibEvent#DspsFileChunk DspsFileChunk} event.
+ * <p> If {@link #dspsEventCoalescing coalescing} is enabled, the event is merged with any pending event for the same operation.
+ * The last chunk of the file is delivered immediately.
+ */
+- (void) sendDspsFileChunkEvent:(DspsFileSend*)operation chunk:(int)chunk {
+    if (!self.dspsEventCoalescing) {
+        [self sendEvent:CodelessLibEvent.DspsFileChunk object:[[DspsFileChunkEvent alloc] initWithManager:self operation:operation chunk:chunk]];
+        return;
+    }
+    DspsFileChunkEvent* pending = nil;
+    for (DspsFileChunkEvent* event in self.dspsFileChunkEventsPending) {
+        if (event.operation == operation) {
+            pending = event;
+            break;
+        }
+    }
+    if (pending) {
+        pending.chunk = chunk;
+        pending.chunks++;
+    } else {
+        [self.dspsFileChunkEventsPending addObject:[[DspsFileChunkEvent alloc] initWithManager:self operation:operation chunk:chunk]];
+    }
+    if (chunk == operation.totalChunks)
+        [self flushDspsEvents];
+    else
+        [self scheduleDspsEventFlush];
+}
+
+/**
+ * Generates a {@link CodelessLibEvent#DspsPatternChunk DspsPatternChunk} event.
+ * <p> If {@link #dspsEventCoalescing coalescing} is enabled, the event is merged with any pending event for the same operation.
+ */
+- (void) sendDspsPatternChunkEvent:(DspsPeriodicSend*)operation count:(int)count {
+    if (!self.dspsEventCoalescing) {
+        [self sendEvent:CodelessLibEvent.DspsPatternChunk object:[[DspsPatternChunkEvent alloc] initWithManager:self operation:operation count:count]];
+        return;
+    }
+    for (DspsPatternChunkEvent* event in self.dspsPatternChunkEventsPending) {
+        if (event.operation == operation) {
+            event.count = count;
+            event.chunks++;
+            return;
+        }
+    }
+    [self.dspsPatternChunkEventsPending addObject:[[DspsPatternChunkEvent alloc] initWithManager:self operation:operation count:count]];
+    [self scheduleDspsEventFlush];
+}
+
+/// Schedules the delivery of the pending coalesced DSPS events, at the end of the current {@link CodelessLibConfig#DSPS_EVENT_COALESCING_INTERVAL time window}.
+- (void) scheduleDspsEventFlush {
+    if (self.dspsEventFlushScheduled)
+        return;
+    self.dspsEventFlushScheduled = true;
+    [self performSelector:@selector(flushDspsEvents) withObject:nil afterDelay:CodelessLibConfig.DSPS_EVENT_COALESCING_INTERVAL / 1000.];
+}
+
+/// Delivers the pending coalesced DSPS events.
+- (void) flushDspsEvents {
+    if (self.dspsEventFlushScheduled) {
+        self.dspsEventFlushScheduled = false;
+        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(flushDspsEvents) object:nil];
+    }
+    if (self.dspsRxDataPending.count) {
+        NSArray<NSData*>* buffers = [NSArray arrayWithArray:self.dspsRxDataPending];
+        [self.dspsRxDataPending removeAllObjects];
+        [self sendEvent:CodelessLibEvent.DspsRxData object:[[DspsRxDataEvent alloc] initWithManager:self buffers:buffers]];
+    }
+    if (self.dspsFileChunkEventsPending.count) {
+        NSArray<DspsFileChunkEvent*>* events = [NSArray arrayWithArray:self.dspsFileChunkEventsPending];
+        [self.dspsFileChunkEventsPending removeAllObjects];
+        for (DspsFileChunkEvent* event in events)
+            [self sendEvent:CodelessLibEvent.DspsFileChunk object:event];
+    }
+    if (self.dspsPatternChunkEventsPending.count) {
+        NSArray<DspsPatternChunkEvent*>* events = [NSArray arrayWithArray:self.dspsPatternChunkEventsPending];
+        [self.dspsPatternChunkEventsPending removeAllObjects];
+        for (DspsPatternChunkEvent* event in events)
+            [self sendEvent:CodelessLibEvent.DspsPatternChunk object:event];
+    }
 }
 
 /**
@@ -1377,17 +1872,14 @@ static NSString* const TAG = @"CodelessManager";
  * A {@link CodelessLibEvent#Connection Connection} event is generated.
  * After connection, a service discovery is started automatically and a {@link CodelessLibEvent#ServiceDiscovery ServiceDiscovery} event is generated.
  */
-- (void) onConnection:(NSNotification*)notification {
-    CodelessDeviceConnectedEvent* event = notification.userInfo[@"event"];
-    if (![event.device isEqual:self.device])
-        return;
+- (void) onConnection:(CodelessDeviceConnectedEvent*)event {
     CodelessLogPrefix(TAG, "Connected");
     self.state = CODELESS_STATE_CONNECTED;
     [self sendEvent:CodelessLibEvent.Connection object:[[CodelessConnectionEvent alloc] initWithManager:self]];
     CodelessLogPrefix(TAG, "Discover services");
     self.state = CODELESS_STATE_SERVICE_DISCOVERY;
     [self sendEvent:CodelessLibEvent.ServiceDiscovery object:[[CodelessServiceDiscoveryEvent alloc] initWithManager:self complete:false]];
-    [self.device discoverServices:@[CodelessProfile.CODELESS_SERVICE_UUID, CodelessProfile.DSPS_SERVICE_UUID, CodelessProfile.DEVICE_INFORMATION_SERVICE_UUID]];
+    [self.transport discoverServices:@[CodelessProfile.CODELESS_SERVICE_UUID, CodelessProfile.DSPS_SERVICE_UUID, CodelessProfile.DEVICE_INFORMATION_SERVICE_UUID]];
     [self initialize];
 }
 
@@ -1395,10 +1887,7 @@ static NSString* const TAG = @"CodelessManager";
  * Called when the peer device is disconnected.
  * <p> A {@link CodelessLibEvent#Connection Connection} event is generated.
  */
-- (void) onDisconnection:(NSNotification*)notification {
-    CodelessDeviceDisconnectedEvent* event = notification.userInfo[@"event"];
-    if (![event.device isEqual:self.device])
-        return;
+- (void) onDisconnection:(CodelessDeviceDisconnectedEvent*)event {
     CodelessLogPrefix(TAG, "Disconnected: error=%@", event.error);
     self.state = CODELESS_STATE_DISCONNECTED;
     [self reset];
@@ -1409,18 +1898,16 @@ static NSString* const TAG = @"CodelessManager";
  * Called when the connection to the peer device fails.
  * <p> A {@link CodelessLibEvent#Connection Connection} event is generated.
  */
-- (void) onConnectionFailed:(NSNotification*)notification {
-    CodelessConnectionFailedEvent* event = notification.userInfo[@"event"];
-    if (![event.device isEqual:self.device])
-        return;
+- (void) onConnectionFailed:(CodelessConnectionFailedEvent*)event {
     CodelessLogPrefix(TAG, "Connection failed: error=%@", event.error);
     self.state = CODELESS_STATE_DISCONNECTED;
     [self sendEvent:CodelessLibEvent.Connection object:[[CodelessConnectionEvent alloc] initWithManager:self]];
 }
 
 /// Handles Bluetooth state changes.
-- (void) onBluetoothState:(NSNotification*)notification {
-    CodelessBluetoothStateEvent* event = notification.userInfo[@"event"];
+- (void) onBluetoothState:(CodelessBluetoothStateEvent*)event {
+    if (!CodelessLibConfig.BLUETOOTH_STATE_MONITOR)
+        return;
     if (event.state.intValue != CBCentralManagerStatePoweredOn && !self.isDisconnected) {
         CodelessLogPrefix(TAG, "Disconnected: Bluetooth OFF");
         self.state = CODELESS_STATE_DISCONNECTED;
@@ -1435,12 +1922,16 @@ static NSString* const TAG = @"CodelessManager";
         self.codelessLogFile = [[CodelessLogFile alloc] initWithManager:self];
     if (CodelessLibConfig.DSPS_RX_LOG)
         self.dspsRxLogFile = [[DspsRxLogFile alloc] initWithManager:self];
+    if (CodelessLibConfig.DSPS_CAPTURE)
+        self.dspsCaptureFile = [[DspsCaptureFile alloc] initWithManager:self];
 }
 
 /// Resets the manager when the peer device is disconnected.
 - (void) reset {
     self.mtu = CODELESS_MTU_DEFAULT;
 
+    [self flushDspsEvents];
+
     [self.dspsPending removeAllObjects];
     for (DspsPeriodicSend* operation in [NSArray arrayWithArray:self.dspsPeriodic])
         [operation stop];
@@ -1449,17 +1940,32 @@ static NSString* const TAG = @"CodelessManager";
     if (self.dspsFileReceive)
         [self.dspsFileReceive stop];
 
-    if (CodelessLibConfig.DSPS_STATS)
+    if (CodelessLibConfig.DSPS_STATS) {
         [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(dspsUpdateStats) object:nil];
+        [self.dspsRxStats stop];
+    }
+    if (CodelessLibConfig.COMMAND_STATS)
+        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(commandUpdateStats) object:nil];
+    if (CodelessLibConfig.METRICS_EVENT)
+        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(metricsUpdate) object:nil];
+    if (self.commandPending)
+        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(onCommandTimeout:) object:self.commandPending];
 
     if (CodelessLibConfig.CODELESS_LOG && self.codelessLogFile)
         [self.codelessLogFile close];
     if (CodelessLibConfig.DSPS_RX_LOG && self.dspsRxLogFile)
         [self.dspsRxLogFile close];
+    if (CodelessLibConfig.DSPS_CAPTURE && self.dspsCaptureFile)
+        [self.dspsCaptureFile close];
 
     self.gattOperationPending = nil;
     [self.gattQueue removeAllObjects];
 
+    if (counters.dspsTxXoffStart)
+        counters.dspsTxXoffTime += NSProcessInfo.processInfo.systemUptime - counters.dspsTxXoffStart;
+    counters.dspsTxXoffStart = 0;
+    counters.gattWriteReadyWaitStart = 0;
+
     self.commandMode = false;
     self.binaryRequestPending = false;
     self.binaryExitRequestPending = false;
@@ -1469,6 +1975,8 @@ static NSString* const TAG = @"CodelessManager";
     self.commandInbound = nil;
     self.inboundPending = 0;
     self.outboundResponseLines = 0;
+    self.lateResponsePending = false;
+    [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(lateResponseWindowEnd) object:nil];
     [self.parsePending removeAllObjects];
     [self.scripts removeAllObjects];
 
@@ -1495,7 +2003,7 @@ static NSString* const TAG = @"CodelessManager";
  * @return the found service, or <code>nil</code> if not found
  */
 - (CBService*) findServiceWithUUID:(CBUUID*)UUID {
-    for (CBService* service in self.device.services) {
+    for (CBService* service in self.transport.services) {
         if ([service.UUID isEqual:UUID])
             return service;
     }
@@ -1531,7 +2039,7 @@ static NSString* const TAG = @"CodelessManager";
     self.pendingDiscoverCharacteristics = [NSMutableArray array];
     self.pendingEnableNotifications = [NSMutableArray array];
 
-    self.mtu = [self.device maximumWriteValueLengthForType:CBCharacteristicWriteWithoutResponse] + 3;
+    self.mtu = [self.transport maximumWriteValueLengthForType:CBCharacteristicWriteWithoutResponse] + 3;
     CodelessLogPrefix(TAG, "MTU: %d", self.mtu);
     if (CodelessLibConfig.DSPS_CHUNK_SIZE_INCREASE_TO_MTU || self.dspsChunkSize > self.mtu - 3)
         self.dspsChunkSize = self.mtu - 3;
@@ -1539,21 +2047,21 @@ static NSString* const TAG = @"CodelessManager";
     self.deviceInfoService = [self findServiceWithUUID:CodelessProfile.DEVICE_INFORMATION_SERVICE_UUID];
     if (self.deviceInfoService) {
         [self.pendingDiscoverCharacteristics addObject:self.deviceInfoService];
-        [self.device discoverCharacteristics:nil forService:self.deviceInfoService];
+        [self.transport discoverCharacteristics:nil forService:self.deviceInfoService];
     }
 
     self.codelessService = [self findServiceWithUUID:CodelessProfile.CODELESS_SERVICE_UUID];
     CodelessLogPrefix(TAG, "Codeless service %@", self.codelessService ? @"found" : @"not found");
     if (self.codelessService) {
         [self.pendingDiscoverCharacteristics addObject:self.codelessService];
-        [self.device discoverCharacteristics:nil forService:self.codelessService];
+        [self.transport discoverCharacteristics:nil forService:self.codelessService];
     }
 
     self.dspsService = [self findServiceWithUUID:CodelessProfile.DSPS_SERVICE_UUID];
     CodelessLogPrefix(TAG, "DSPS service %@", self.dspsService ? @"found" : @"not found");
     if (self.dspsService) {
         [self.pendingDiscoverCharacteristics addObject:self.dspsService];
-        [self.device discoverCharacteristics:nil forService:self.dspsService];
+        [self.transport discoverCharacteristics:nil forService:self.dspsService];
     }
 
     if (!self.pendingDiscoverCharacteristics.count) {
@@ -1631,7 +2139,7 @@ static NSString* const TAG = @"CodelessManager";
     if (!self.isConnected)
         return;
     CodelessLogPrefix(TAG, "Enable notifications: %@", characteristic.UUID);
-    [self.device setNotifyValue:true forCharacteristic:characteristic];
+    [self.transport setNotifyValue:true forCharacteristic:characteristic];
 }
 
 /**
@@ -1639,7 +2147,7 @@ static NSString* const TAG = @"CodelessManager";
  * <p> A {@link CodelessLibEvent#Ready Ready} event is generated after all required notifications are enabled.
  */
 - (void) peripheral:(CBPeripheral*)peripheral didUpdateNotificationStateForCharacteristic:(CBCharacteristic*)characteristic error:(nullable NSError*)error {
-    CodelessLogPrefixOpt(CodelessLibLog.GATT_OPERATION, TAG, "didUpdateNotificationStateForCharacteristic: %@", characteristic.UUID);
+    CodelessLogPrefixOpt(CODELESS_LOG_GATT_OPERATION, TAG, "didUpdateNotificationStateForCharacteristic: %@", characteristic.UUID);
     if (!error) {
         if (self.pendingEnableNotifications) {
             [self.pendingEnableNotifications removeObject:characteristic];
@@ -1663,13 +2171,13 @@ static NSString* const TAG = @"CodelessManager";
 
 /// Executes a read characteristic operation.
 - (void) executeReadCharacteristic:(CBCharacteristic*)characteristic {
-    CodelessLogPrefixOpt(CodelessLibLog.GATT_OPERATION, TAG, "Read characteristic: %@", characteristic.UUID);
-    [self.device readValueForCharacteristic:characteristic];
+    CodelessLogPrefixOpt(CODELESS_LOG_GATT_OPERATION, TAG, "Read characteristic: %@", characteristic.UUID);
+    [self.transport readValueForCharacteristic:characteristic];
 }
 
 /// %CBPeripheralDelegate <code>peripheral:didUpdateValueForCharacteristic:error:</code> implementation.
 - (void) peripheral:(CBPeripheral*)peripheral didUpdateValueForCharacteristic:(CBCharacteristic*)characteristic error:(nullable NSError*)error {
-    CodelessLogPrefixOpt(CodelessLibLog.GATT_OPERATION, TAG, "didUpdateValueForCharacteristic: %@ %@", characteristic.UUID, [CodelessUtil hexArrayLog:characteristic.value]);
+    CodelessLogPrefixDataOpt(CODELESS_LOG_GATT_OPERATION, TAG, characteristic.value, "didUpdateValueForCharacteristic: %@ ", characteristic.UUID);
     BOOL read = self.gattOperationPending.type == GattOperationReadCharacteristic && [self.gattOperationPending.characteristic isEqual:characteristic];
     if (read && CodelessLibConfig.GATT_DEQUEUE_BEFORE_PROCESSING)
         [self dequeueGattOperation];
@@ -1710,13 +2218,23 @@ static NSString* const TAG = @"CodelessManager";
 
 /// Executes a write characteristic operation.
 - (void) executeWriteCharacteristic:(CBCharacteristic*)characteristic value:(NSData*)value response:(BOOL)response {
-    CodelessLogPrefixOpt(CodelessLibLog.GATT_OPERATION, TAG, "Write characteristic%@: %@ %@", !response ? @" (no response)" : @"", characteristic.UUID, [CodelessUtil hexArrayLog:value]);
-    [self.device writeValue:value forCharacteristic:characteristic type:response ? CBCharacteristicWriteWithResponse : CBCharacteristicWriteWithoutResponse];
+    CodelessLogPrefixDataOpt(CODELESS_LOG_GATT_OPERATION, TAG, value, "Write characteristic%@: %@ ", !response ? @" (no response)" : @"", characteristic.UUID);
+    if (CodelessLibConfig.COMMAND_STATS && [characteristic isEqual:self.codelessInbound])
+        [self.commandPending markStage:CODELESS_COMMAND_STAGE_GATT_WRITE];
+    if (CodelessLibConfig.DSPS_CAPTURE && self.dspsCaptureFile) {
+        if (characteristic == self.dspsServerRx)
+            [self.dspsCaptureFile log:value direction:DSPS_CAPTURE_TX characteristic:CODELESS_GATT_TRACE_DSPS_SERVER_RX];
+        else if (characteristic == self.dspsFlowControl)
+            [self.dspsCaptureFile log:value direction:DSPS_CAPTURE_TX characteristic:CODELESS_GATT_TRACE_DSPS_FLOW_CONTROL];
+    }
+    [self.transport writeValue:value forCharacteristic:characteristic type:response ? CBCharacteristicWriteWithResponse : CBCharacteristicWriteWithoutResponse];
 }
 
 /// %CBPeripheralDelegate <code>peripheral:didWriteValueForCharacteristic:error:</code> implementation.
 - (void) peripheral:(CBPeripheral*)peripheral didWriteValueForCharacteristic:(CBCharacteristic*)characteristic error:(nullable NSError*)error {
-    CodelessLogPrefixOpt(CodelessLibLog.GATT_OPERATION, TAG, "didWriteValueForCharacteristic: %@", characteristic.UUID);
+    CodelessLogPrefixOpt(CODELESS_LOG_GATT_OPERATION, TAG, "didWriteValueForCharacteristic: %@", characteristic.UUID);
+    if (CodelessLibConfig.COMMAND_STATS && !error && [characteristic isEqual:self.codelessInbound])
+        [self.commandPending markStage:CODELESS_COMMAND_STAGE_WRITTEN];
     if (CodelessLibConfig.GATT_DEQUEUE_BEFORE_PROCESSING)
         [self dequeueGattOperation];
 
@@ -1740,7 +2258,11 @@ static NSString* const TAG = @"CodelessManager";
 
 /// %CBPeripheralDelegate <code>peripheral:peripheralIsReadyToSendWriteWithoutResponse:</code> implementation.
 - (void) peripheralIsReadyToSendWriteWithoutResponse:(CBPeripheral*)peripheral {
-    CodelessLogPrefixOpt(CodelessLibLog.GATT_OPERATION, TAG, "peripheralIsReadyToSendWriteWithoutResponse");
+    CodelessLogPrefixOpt(CODELESS_LOG_GATT_OPERATION, TAG, "peripheralIsReadyToSendWriteWithoutResponse");
+    if (counters.gattWriteReadyWaitStart) {
+        counters.gattWriteReadyWaitTime += NSProcessInfo.processInfo.systemUptime - counters.gattWriteReadyWaitStart;
+        counters.gattWriteReadyWaitStart = 0;
+    }
     [self dequeueGattOperation];
 }
 
@@ -1750,7 +2272,7 @@ static NSString* const TAG = @"CodelessManager";
  */
 - (void) peripheral:(CBPeripheral*)peripheral didReadRSSI:(NSNumber*)RSSI error:(nullable NSError*)error {
     if (!error) {
-        CodelessLogPrefixOpt(CodelessLibLog.GATT_OPERATION, TAG, "RSSI: %d", RSSI.intValue);
+        CodelessLogPrefixOpt(CODELESS_LOG_GATT_OPERATION, TAG, "RSSI: %d", RSSI.intValue);
         [self sendEvent:CodelessLibEvent.Rssi object:[[CodelessRssiEvent alloc] initWithManager:self rssi:RSSI]];
     } else {
         CodelessLogPrefix(TAG, "Failed to read RSSI");
@@ -1774,6 +2296,8 @@ static NSString* const TAG = @"CodelessManager";
                 [self.gattQueue addObject:operation];
             else
                 [self enqueueGattOperationWithPriority:operation];
+            if (self.gattQueue.count > counters.gattQueueHighWater)
+                counters.gattQueueHighWater = (int) self.gattQueue.count;
         } else {
             [self executeGattOperation:operation];
         }
@@ -1795,6 +2319,8 @@ static NSString* const TAG = @"CodelessManager";
             [self.gattQueue addObjectsFromArray:operations];
         else
             [self enqueueGattOperationsWithPriority:operations];
+        if (self.gattQueue.count > counters.gattQueueHighWater)
+            counters.gattQueueHighWater = (int) self.gattQueue.count;
         if (!self.gattOperationPending) {
             [self dequeueGattOperation];
         }
@@ -1858,12 +2384,23 @@ static NSString* const TAG = @"CodelessManager";
 - (void) executeGattOperation:(CodelessManager_GattOperation*)operation {
     self.gattOperationPending = operation;
     [operation onExecute];
+    if (CodelessLibConfig.DSPS_STATS && [operation isKindOfClass:CodelessManager_DspsGattOperation.class])
+        [self.dspsTxLatencyStats record:NSProcessInfo.processInfo.systemUptime - ((CodelessManager_DspsGattOperation*) operation).enqueueTime];
+    if ([operation isKindOfClass:CodelessManager_DspsGattOperation.class])
+        counters.dspsTxBytes += operation.value.length;
     switch (operation.type) {
         case GattOperationReadCharacteristic:
+            counters.gattReads++;
             [self executeReadCharacteristic:operation.characteristic];
             break;
         case GattOperationWriteCharacteristic:
         case GattOperationWriteCommand:
+            if (operation.type == GattOperationWriteCharacteristic) {
+                counters.gattWrites++;
+            } else {
+                counters.gattWriteCommands++;
+                counters.gattWriteReadyWaitStart = NSProcessInfo.processInfo.systemUptime;
+            }
             [self executeWriteCharacteristic:operation.characteristic value:operation.value response:operation.type == GattOperationWriteCharacteristic];
             break;
     }
@@ -1921,6 +2458,21 @@ static NSString* const TAG = @"CodelessManager";
 @end
 
 
+@implementation CodelessManager_EventObserver
+
+- (instancetype) initWithObserver:(id)observer selector:(SEL)selector {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.observer = observer;
+    self.selector = selector;
+    self.method = [observer methodForSelector:selector];
+    return self;
+}
+
+@end
+
+
 @implementation CodelessManager_GattOperation
 
 - (instancetype) initWithCharacteristic:(CBCharacteristic*)characteristic {
@@ -1969,6 +2521,8 @@ static NSString* const TAG = @"CodelessManager";
     if (!self)
         return nil;
     self.manager = manager;
+    if (CodelessLibConfig.DSPS_STATS)
+        self.enqueueTime = NSProcessInfo.processInfo.systemUptime;
     return self;
 }
 
@@ -1978,7 +2532,7 @@ static NSString* const TAG = @"CodelessManager";
 @implementation CodelessManager_DspsChunkOperation
 
 - (void) onExecute {
-    CodelessLogOpt(CodelessLibLog.DSPS_CHUNK, TAG, "%@Send DSPS chunk: %@", self.manager.logPrefix, [CodelessUtil hexArrayLog:self.value]);
+    CodelessLogDataSubsystem(CODELESS_LOG_DSPS_CHUNK, TAG, self.value, "%@Send DSPS chunk: ", self.manager.logPrefix);
 }
 
 @end
@@ -2002,13 +2556,13 @@ static NSString* const TAG = @"CodelessManager";
 }
 
 - (void) onExecute {
-    CodelessLogOpt(CodelessLibLog.DSPS_PERIODIC_CHUNK, TAG, "%@Send periodic DSPS chunk: count %d (%d of %d) %@",
-            self.manager.logPrefix, self.count, self.chunk, self.totalChunks, [CodelessUtil hexArrayLog:self.value]);
+    CodelessLogDataSubsystem(CODELESS_LOG_DSPS_PERIODIC_CHUNK, TAG, self.value, "%@Send periodic DSPS chunk: count %d (%d of %d) ",
+            self.manager.logPrefix, self.count, self.chunk, self.totalChunks);
     if (CodelessLibConfig.DSPS_STATS)
         [self.operation updateBytesSent:self.value.length];
     if (self.operation.pattern) {
         self.operation.patternSentCount = (self.count - 1) % self.operation.patternMaxCount;
-        [self.manager sendEvent:CodelessLibEvent.DspsPatternChunk object:[[DspsPatternChunkEvent alloc] initWithManager:self.manager operation:self.operation count:self.operation.patternSentCount]];
+        [self.manager sendDspsPatternChunkEvent:self.operation count:self.operation.patternSentCount];
     }
 }
 
@@ -2031,17 +2585,17 @@ static NSString* const TAG = @"CodelessManager";
 }
 
 - (void) onExecute {
-    CodelessLogOpt(CodelessLibLog.DSPS_FILE_CHUNK, TAG, "%@Send file chunk: %@ (%d of %d) %@",
-            self.manager.logPrefix, self.operation, self.chunk, self.operation.totalChunks, [CodelessUtil hexArrayLog:self.value]);
+    CodelessLogDataSubsystem(CODELESS_LOG_DSPS_FILE_CHUNK, TAG, self.value, "%@Send file chunk: %@ (%d of %d) ",
+            self.manager.logPrefix, self.operation, self.chunk, self.operation.totalChunks);
     self.operation.sentChunks = self.chunk;
     if (CodelessLibConfig.DSPS_STATS)
         [self.operation updateBytesSent:self.value.length];
     if (self.chunk == self.operation.totalChunks) {
-        CodelessLogOpt(CodelessLibLog.DSPS, TAG, "%@File sent: %@", self.manager.logPrefix, self.operation);
+        CodelessLogSubsystem(CODELESS_LOG_DSPS, TAG, "%@File sent: %@", self.manager.logPrefix, self.operation);
         [self.operation setComplete];
         [self.manager.dspsFiles removeObject:self.operation];
     }
-    [self.manager sendEvent:CodelessLibEvent.DspsFileChunk object:[[DspsFileChunkEvent alloc] initWithManager:self.manager operation:self.operation chunk:self.chunk]];
+    [self.manager sendDspsFileChunkEvent:self.operation chunk:self.chunk];
 }
 
 @end
@@ -0,0 +1,100 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Snapshot of the internal counters of a {@link CodelessManager}.
+ *
+ * The counters are always enabled and are cheap to update. They are cumulative since the manager was created
+ * or {@link CodelessManager#resetMetrics reset}, except for the queue depths, which are current values.
+ * <p> Use {@link CodelessManager#metrics} to get a snapshot, or enable {@link CodelessLibConfig#METRICS_EVENT}
+ * to receive periodic {@link CodelessLibEvent#Metrics Metrics} events.
+ */
+@interface CodelessMetrics : NSObject
+
+/// The time the snapshot was taken (system uptime).
+@property NSTimeInterval time;
+
+// GATT operation queue
+/// The number of enqueued GATT operations.
+@property int gattQueueDepth;
+/// The maximum number of enqueued GATT operations.
+@property int gattQueueHighWater;
+/// The number of executed read characteristic operations.
+@property int64_t gattReads;
+/// The number of executed write characteristic (with response) operations.
+@property int64_t gattWrites;
+/// The number of executed write command (without response) operations.
+@property int64_t gattWriteCommands;
+/// The total time spent waiting for the peer to be ready for the next write command (seconds).
+@property NSTimeInterval gattWriteReadyWaitTime;
+
+// DSPS flow control
+/// The number of times the peer device turned DSPS TX flow off (XOFF).
+@property int64_t dspsTxXoffCount;
+/// The total time DSPS TX flow was off (seconds).
+@property NSTimeInterval dspsTxXoffTime;
+/// The number of times the library turned DSPS RX flow off (XOFF).
+@property int64_t dspsRxXoffCount;
+
+// DSPS data
+/// The number of DSPS bytes written to the peer device.
+@property int64_t dspsTxBytes;
+/// The number of DSPS bytes received from the peer device.
+@property int64_t dspsRxBytes;
+/// The number of DSPS chunks dropped because TX flow was off and the pending queue was full.
+@property int64_t dspsTxDroppedChunks;
+
+// Commands
+/// The number of enqueued outgoing commands.
+@property int commandQueueDepth;
+/// The number of commands in progress (outgoing and incoming).
+@property int commandsInFlight;
+/// The number of sent commands.
+@property int64_t commandsSent;
+/// The number of sent commands that timed out.
+@property int64_t commandTimeouts;
+/// The number of rejected commands (invalid or unsupported commands, sent or received).
+@property int64_t parseErrors;
+
+/// Returns the metrics as a dictionary (property name to value), for serialization.
+- (NSDictionary<NSString*, NSNumber*>*) dictionary;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,67 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessMetrics.h"
+
+@implementation CodelessMetrics
+
+- (NSDictionary<NSString*, NSNumber*>*) dictionary {
+    return @{
+        @"time" : @(self.time),
+        @"gattQueueDepth" : @(self.gattQueueDepth),
+        @"gattQueueHighWater" : @(self.gattQueueHighWater),
+        @"gattReads" : @(self.gattReads),
+        @"gattWrites" : @(self.gattWrites),
+        @"gattWriteCommands" : @(self.gattWriteCommands),
+        @"gattWriteReadyWaitTime" : @(self.gattWriteReadyWaitTime),
+        @"dspsTxXoffCount" : @(self.dspsTxXoffCount),
+        @"dspsTxXoffTime" : @(self.dspsTxXoffTime),
+        @"dspsRxXoffCount" : @(self.dspsRxXoffCount),
+        @"dspsTxBytes" : @(self.dspsTxBytes),
+        @"dspsRxBytes" : @(self.dspsRxBytes),
+        @"dspsTxDroppedChunks" : @(self.dspsTxDroppedChunks),
+        @"commandQueueDepth" : @(self.commandQueueDepth),
+        @"commandsInFlight" : @(self.commandsInFlight),
+        @"commandsSent" : @(self.commandsSent),
+        @"commandTimeouts" : @(self.commandTimeouts),
+        @"parseErrors" : @(self.parseErrors),
+    };
+}
+
+- (NSString*) description {
+    return [NSString stringWithFormat:@"%@", self.dictionary];
+}
+
+@end
@@ -73,6 +73,7 @@ NS_ASSUME_NONNULL_BEGIN
 #define CODELESS_UUID_MESH_PROXY_SERVICE   @"00001828-0000-1000-8000-00805f9b34fb"
 #define CODELESS_UUID_IMMEDIATE_ALERT_SERVICE   @"00001802-0000-1000-8000-00805f9b34fb"
 #define CODELESS_UUID_LINK_LOSS_SERVICE   @"00001803-0000-1000-8000-00805f9b34fb"
+#define CODELESS_UUID_EDDYSTONE_SERVICE   @"0000feaa-0000-1000-8000-00805f9b34fb"
 // Device information service
 #define CODELESS_UUID_DEVICE_INFORMATION_SERVICE   @"0000180a-0000-1000-8000-00805f9b34fb"
 #define CODELESS_UUID_MANUFACTURER_NAME_STRING   @"00002A29-0000-1000-8000-00805f9b34fb"
@@ -106,6 +107,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (class, readonly) CBUUID* MESH_PROXY_SERVICE_UUID;
 @property (class, readonly) CBUUID* IMMEDIATE_ALERT_SERVICE_UUID;
 @property (class, readonly) CBUUID* LINK_LOSS_SERVICE_UUID;
+@property (class, readonly) CBUUID* EDDYSTONE_SERVICE_UUID;
 // Device information service
 @property (class, readonly) CBUUID* DEVICE_INFORMATION_SERVICE_UUID;
 @property (class, readonly) CBUUID* MANUFACTURER_NAME_STRING_UUID;
@@ -215,6 +217,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property (class, readonly) NSString* INVALID_ARGUMENTS;
 /// Error message for GATT operation error (local).
 @property (class, readonly) NSString* GATT_OPERATION_ERROR;
+/// Error message for a sent command that the peer device did not respond to in time (local).
+@property (class, readonly) NSString* COMMAND_TIMEOUT_ERROR;
 /// Error message pattern, when receiving an error response from the peer device.
 @property (class, readonly) NSString* ERROR_MESSAGE_PATTERN_STRING;
 @property (class, readonly) NSRegularExpression* ERROR_MESSAGE_PATTERN;
@@ -530,6 +534,22 @@ enum CODELESS_COMMAND_SECURITY_MODE {
  * @return the created command object
  */
 + (CodelessCommand*) createCommand:(CodelessManager*)manager commandClass:(Class)commandClass command:(NSString*)command;
+/**
+ * Normalizes a text command before parsing.
+ * <p> Whitespace is trimmed and the AT command prefix is added, if {@link CodelessLibConfig#AUTO_ADD_PREFIX enabled}.
+ * @param line the text command
+ * @return the normalized text command
+ */
++ (NSString*) normalizeTextCommand:(NSString*)line;
+/**
+ * Parses a normalized text command to a {@link CodelessCommand} subclass object.
+ * <p> If the command is not recognized, a {@link CodelessCustomCommand} object is created.
+ * @param line      the normalized text command
+ * @param manager   the associated manager (may be <code>nil</code> for commands that are not going to be sent)
+ * @return the command subclass object
+ * @see #normalizeTextCommand:
+ */
++ (CodelessCommand*) createTextCommand:(NSString*)line manager:(nullable CodelessManager*)manager;
 
 /**
  * Enumeration of CodeLess command identifiers.
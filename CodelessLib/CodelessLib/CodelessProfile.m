@@ -33,7 +33,7 @@
  **********************************************************************************
  */
 
-#import <CoreBluetooth/CoreBluetooth.h>
+#import "CodelessCoreBluetooth.h"
 #import "CodelessCommand.h"
 #import "CodelessProfile.h"
 #import "CodelessBasicCommand.h"
@@ -100,6 +100,7 @@
 #import "CodelessSecurityModeCommand.h"
 #import "CodelessFlowControlCommand.h"
 #import "CodelessLibLog.h"
+#import "CodelessLibConfig.h"
 #import "CodelessCustomCommand.h"
 
 @implementation CodelessProfile
@@ -127,6 +128,7 @@ static CBUUID* MESH_PROVISIONING_SERVICE_UUID;
 static CBUUID* MESH_PROXY_SERVICE_UUID;
 static CBUUID* IMMEDIATE_ALERT_SERVICE_UUID;
 static CBUUID* LINK_LOSS_SERVICE_UUID;
+static CBUUID* EDDYSTONE_SERVICE_UUID;
 static CBUUID* DEVICE_INFORMATION_SERVICE_UUID;
 static CBUUID* MANUFACTURER_NAME_STRING_UUID;
 static CBUUID* MODEL_NUMBER_STRING_UUID;
@@ -161,6 +163,7 @@ static NSString* NO_ARGUMENTS;
 static NSString* WRONG_NUMBER_OF_ARGUMENTS;
 static NSString* INVALID_ARGUMENTS;
 static NSString* GATT_OPERATION_ERROR;
+static NSString* COMMAND_TIMEOUT_ERROR;
 static NSString* ERROR_MESSAGE_PATTERN_STRING;
 static NSRegularExpression* ERROR_MESSAGE_PATTERN;
 static NSString* PEER_INVALID_COMMAND;
@@ -191,6 +194,7 @@ static NSSet<NSNumber*>* modeCommands;
     MESH_PROXY_SERVICE_UUID = [CBUUID UUIDWithString:CODELESS_UUID_MESH_PROXY_SERVICE];
     IMMEDIATE_ALERT_SERVICE_UUID = [CBUUID UUIDWithString:CODELESS_UUID_IMMEDIATE_ALERT_SERVICE];
     LINK_LOSS_SERVICE_UUID = [CBUUID UUIDWithString:CODELESS_UUID_LINK_LOSS_SERVICE];
+    EDDYSTONE_SERVICE_UUID = [CBUUID UUIDWithString:CODELESS_UUID_EDDYSTONE_SERVICE];
     DEVICE_INFORMATION_SERVICE_UUID = [CBUUID UUIDWithString:CODELESS_UUID_DEVICE_INFORMATION_SERVICE];
     MANUFACTURER_NAME_STRING_UUID = [CBUUID UUIDWithString:CODELESS_UUID_MANUFACTURER_NAME_STRING];
     MODEL_NUMBER_STRING_UUID = [CBUUID UUIDWithString:CODELESS_UUID_MODEL_NUMBER_STRING];
@@ -225,6 +229,7 @@ static NSSet<NSNumber*>* modeCommands;
     WRONG_NUMBER_OF_ARGUMENTS = @"Wrong number of arguments";
     INVALID_ARGUMENTS = @"Invalid arguments";
     GATT_OPERATION_ERROR = @"Gatt operation error";
+    COMMAND_TIMEOUT_ERROR = @"Timeout";
     ERROR_MESSAGE_PATTERN_STRING = @"^(?:ERROR|INVALID COMMAND|EC\\d{1,8}:).*";
     ERROR_MESSAGE_PATTERN = [NSRegularExpression regularExpressionWithPattern:ERROR_MESSAGE_PATTERN_STRING options:0 error:&error];
     PEER_INVALID_COMMAND = @"INVALID COMMAND";
@@ -373,6 +378,10 @@ static NSSet<NSNumber*>* modeCommands;
     return LINK_LOSS_SERVICE_UUID;
 }
 
++ (CBUUID*) EDDYSTONE_SERVICE_UUID {
+    return EDDYSTONE_SERVICE_UUID;
+}
+
 + (CBUUID*) DEVICE_INFORMATION_SERVICE_UUID {
     return DEVICE_INFORMATION_SERVICE_UUID;
 }
@@ -535,6 +544,10 @@ static NSSet<NSNumber*>* modeCommands;
     return GATT_OPERATION_ERROR;
 }
 
++ (NSString*) COMMAND_TIMEOUT_ERROR {
+    return COMMAND_TIMEOUT_ERROR;
+}
+
 + (NSString*) ERROR_MESSAGE_PATTERN_STRING {
     return ERROR_MESSAGE_PATTERN_STRING;
 }
@@ -613,6 +626,24 @@ static NSSet<NSNumber*>* modeCommands;
     return [[CodelessCustomCommand alloc] initWithManager:manager command:[PREFIX stringByAppendingString:command] parse:true];
 }
 
++ (NSString*) normalizeTextCommand:(NSString*)line {
+    line = [line stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
+    if (CodelessLibConfig.AUTO_ADD_PREFIX && ![self hasPrefix:line])
+        line = [PREFIX stringByAppendingString:line];
+    return line;
+}
+
++ (CodelessCommand*) createTextCommand:(NSString*)line manager:(CodelessManager*)manager {
+    NSString* id = [self getCommand:line];
+    Class commandClass = id ? commandMap[id] : nil;
+    if (!commandClass)
+        return [[CodelessCustomCommand alloc] initWithManager:manager command:line parse:true];
+    NSString* prefix = [self getPrefix:line];
+    CodelessCommand* command = [self createCommand:manager commandClass:commandClass command:[self removeCommandPrefix:line]];
+    command.prefix = prefix;
+    return command;
+}
+
 + (NSSet<NSNumber*>*) modeCommands {
     return modeCommands;
 }
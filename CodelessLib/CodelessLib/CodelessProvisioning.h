@@ -0,0 +1,207 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+@class CodelessManager;
+@class CodelessCommand;
+@class CodelessScript;
+@class CodelessGPIO;
+@class CodelessEventConfig;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Information about a single step of a {@link CodelessProvisioning provisioning} operation.
+ *
+ * Each step corresponds to one AT command round trip, or to a setting that was skipped
+ * because the device configuration already matches the target configuration.
+ */
+@interface CodelessProvisioningStep : NSObject
+
+/// Provisioning step type.
+enum CODELESS_PROVISIONING_STEP {
+    /// Device state read back from the peer device.
+    CODELESS_PROVISIONING_STEP_READ = 0,
+    /// Setting written to the peer device.
+    CODELESS_PROVISIONING_STEP_WRITE = 1,
+    /// Setting skipped, the device configuration already matches.
+    CODELESS_PROVISIONING_STEP_SKIP = 2,
+    /// Settings written to a command slot, in order to be executed in one batch.
+    CODELESS_PROVISIONING_STEP_BATCH_STORE = 3,
+    /// Batched settings executed on the peer device.
+    CODELESS_PROVISIONING_STEP_BATCH_PLAY = 4,
+};
+
+/// The step {@link CODELESS_PROVISIONING_STEP type}.
+@property (readonly) int type;
+/// The step description.
+@property (readonly) NSString* name;
+/// The command sent for this step (<code>nil</code> for skipped steps).
+@property (readonly, nullable) CodelessCommand* command;
+/// The time the step was started (system uptime).
+@property (readonly) NSTimeInterval startTime;
+/// The time the step was complete (system uptime).
+@property (readonly) NSTimeInterval endTime;
+/// <code>true</code> if the step is complete.
+@property (readonly) BOOL complete;
+/// The error message, if the step failed.
+@property (readonly, nullable) NSString* error;
+
+/// Returns the step duration (seconds).
+- (NSTimeInterval) duration;
+
+@end
+
+
+/**
+ * CodeLess device provisioning operation.
+ *
+ * ## Usage ##
+ * Provisioning brings the peer device to a target configuration using the least possible number of round trips.
+ * The target configuration consists of:
+ * <ul>
+ * <li>{@link #ioConfig IO pin functionality} (<code>AT+IOCFG</code>)</li>
+ * <li>{@link #eventConfig Predefined events activation status} (<code>AT+EVENT</code>)</li>
+ * <li>{@link #storedCommands Stored commands} (<code>AT+CMDSTORE</code>)</li>
+ * <li>Other {@link #commands commands}, which cannot be read back and are always sent</li>
+ * </ul>
+ * The target configuration can be set directly, or extracted from a {@link CodelessScript script} or script text.
+ *
+ * When the operation is {@link #start started}, the current device state is read back with <code>AT+IOCFG</code>,
+ * <code>AT+EVENT</code> and <code>AT+CMD</code>, and compared with the target configuration. Settings that already
+ * match are skipped (IO pin settings with an output level are always sent, since the level is not read back).
+ * The rest are sent to the peer device. If a {@link #batchSlot batch slot} is set, the settings are
+ * stored to that command slot with a single <code>AT+CMDSTORE</code> and executed with a single <code>AT+CMDPLAY</code>,
+ * instead of one round trip per setting. Provisioning an already configured device takes only the read pass.
+ *
+ * A {@link CodelessLibEvent#ProvisioningStep ProvisioningStep} event is generated for each completed step.
+ * When the operation is complete, a {@link CodelessLibEvent#ProvisioningEnd ProvisioningEnd} event is generated.
+ * Use {@link #steps} to get the per step timings.
+ *
+ * For example, provision a device from script text, batching the changes in command slot 3:
+ * <blockquote><pre>
+ * NSString* text = @@"AT+IOCFG=10,4\n"
+ *                  "AT+EVENT=2,1\n"
+ *                  "AT+CMDSTORE=0,AT+IO=10,0;ATZ";
+ * CodelessProvisioning* provisioning = [[%CodelessProvisioning alloc] initWithManager:self.manager text:text];
+ * provisioning.batchSlot = 3;
+ * [provisioning start];</pre></blockquote>
+ *
+ * @see CodelessScript
+ * @see CodelessLibEvent
+ */
+@interface CodelessProvisioning : NSObject
+
+@property (class, readonly) NSString* TAG;
+
+/// Indicates that command batching is disabled.
+#define CODELESS_PROVISIONING_NO_BATCH -1
+
+/// The provisioning name.
+@property NSString* name;
+/// The associated {@link CodelessManager manager}.
+@property (weak, readonly) CodelessManager* manager;
+/// The target IO pin functionality (only the specified pins are checked).
+@property (readonly) NSMutableArray<CodelessGPIO*>* ioConfig;
+/// The target predefined events activation status (only the specified events are checked).
+@property (readonly) NSMutableArray<CodelessEventConfig*>* eventConfig;
+/// The target stored commands (semicolon separated), per command slot index.
+@property (readonly) NSMutableDictionary<NSNumber*, NSString*>* storedCommands;
+/// Commands that cannot be checked against the device state, which are always sent after the changed settings.
+@property (readonly) NSMutableArray<CodelessCommand*>* commands;
+/**
+ * The command slot used to batch the changed settings, or {@link CODELESS_PROVISIONING_NO_BATCH} to send them one by one.
+ * <p> The previous contents of the slot are overwritten. Batching is disabled if the slot is part of the target {@link #storedCommands}.
+ */
+@property int batchSlot;
+/// <code>true</code> to stop the operation if a command fails, <code>false</code> to continue. When stopped, the remaining commands are not sent.
+@property BOOL stopOnError;
+/// The provisioning steps, in the order they were performed.
+@property (readonly) NSArray<CodelessProvisioningStep*>* steps;
+/// The number of settings that were sent to the peer device.
+@property (readonly) int changed;
+/// The number of settings that were skipped.
+@property (readonly) int skipped;
+/// <code>true</code> if the operation has started.
+@property (readonly) BOOL started;
+/// <code>true</code> if the operation is complete.
+@property (readonly) BOOL complete;
+/// <code>true</code> if one of the provisioning steps failed.
+@property (readonly) BOOL error;
+/// The operation start time (system uptime).
+@property (readonly) NSTimeInterval startTime;
+/// The operation end time (system uptime).
+@property (readonly) NSTimeInterval endTime;
+
+/**
+ * Creates a provisioning operation with an empty target configuration.
+ * @param manager the manager used for provisioning
+ */
+- (instancetype) initWithManager:(CodelessManager*)manager;
+/**
+ * Creates a provisioning operation, extracting the target configuration from script text.
+ * @param manager   the manager used for provisioning
+ * @param text      the script text
+ */
+- (instancetype) initWithManager:(CodelessManager*)manager text:(NSString*)text;
+/**
+ * Creates a provisioning operation, extracting the target configuration from a {@link CodelessScript script}.
+ * <p> The script itself is not started.
+ * @param manager   the manager used for provisioning
+ * @param script    the script
+ */
+- (instancetype) initWithManager:(CodelessManager*)manager script:(CodelessScript*)script;
+
+/**
+ * Adds a command to the target configuration.
+ * <p> IO configuration, event configuration and stored commands are checked against the device state. Other commands are always sent.
+ * @param command the command to add
+ */
+- (void) addCommand:(CodelessCommand*)command;
+
+/**
+ * Starts the provisioning operation.
+ * <p> The device state is read back and compared with the target configuration.
+ */
+- (void) start;
+/// Stops the provisioning operation.
+- (void) stop;
+/// Returns the total duration of the provisioning operation (seconds).
+- (NSTimeInterval) duration;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,469 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessProvisioning.h"
+#import "CodelessProfile.h"
+#import "CodelessManager.h"
+#import "CodelessScript.h"
+#import "CodelessLibLog.h"
+#import "CodelessLibEvent.h"
+#import "CodelessCommand.h"
+#import "CodelessIoConfigCommand.h"
+#import "CodelessEventConfigCommand.h"
+#import "CodelessCmdGetCommand.h"
+#import "CodelessCmdStoreCommand.h"
+#import "CodelessCmdPlayCommand.h"
+
+@interface CodelessProvisioningStep ()
+
+@property int type;
+@property NSString* name;
+@property CodelessCommand* command;
+@property NSTimeInterval startTime;
+@property NSTimeInterval endTime;
+@property BOOL complete;
+@property NSString* error;
+
+@end
+
+@implementation CodelessProvisioningStep
+
+- (instancetype) initWithType:(int)type name:(NSString*)name command:(CodelessCommand*)command {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.type = type;
+    self.name = name;
+    self.command = command;
+    return self;
+}
+
+- (NSTimeInterval) duration {
+    return self.complete ? self.endTime - self.startTime : 0;
+}
+
+- (NSString*) description {
+    return [NSString stringWithFormat:@"[%@ %.1fms%@]", self.name, self.duration * 1000, self.error ? [@" " stringByAppendingString:self.error] : @""];
+}
+
+@end
+
+
+@interface CodelessProvisioning ()
+
+@property (weak) CodelessManager* manager;
+@property NSMutableArray<CodelessGPIO*>* ioConfig;
+@property NSMutableArray<CodelessEventConfig*>* eventConfig;
+@property NSMutableDictionary<NSNumber*, NSString*>* storedCommands;
+@property NSMutableArray<CodelessCommand*>* commands;
+@property NSMutableArray<CodelessProvisioningStep*>* stepList;
+@property NSMutableArray<CodelessProvisioningStep*>* pending;
+@property int changed;
+@property int skipped;
+@property BOOL started;
+@property BOOL complete;
+@property BOOL error;
+@property BOOL writePhase;
+@property NSTimeInterval startTime;
+@property NSTimeInterval endTime;
+@property NSTimeInterval lastStepTime;
+@property CodelessIoConfigCommand* ioConfigRead;
+@property CodelessEventConfigCommand* eventConfigRead;
+@property NSMutableDictionary<NSNumber*, CodelessCmdGetCommand*>* storedCommandsRead;
+
+@end
+
+@implementation CodelessProvisioning
+
+static NSString* const TAG = @"CodelessProvisioning";
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) initWithManager:(CodelessManager*)manager {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.manager = manager;
+    self.ioConfig = [NSMutableArray array];
+    self.eventConfig = [NSMutableArray array];
+    self.storedCommands = [NSMutableDictionary dictionary];
+    self.commands = [NSMutableArray array];
+    self.stepList = [NSMutableArray array];
+    self.pending = [NSMutableArray array];
+    self.storedCommandsRead = [NSMutableDictionary dictionary];
+    self.batchSlot = CODELESS_PROVISIONING_NO_BATCH;
+    self.stopOnError = true;
+    return self;
+}
+
+- (instancetype) initWithManager:(CodelessManager*)manager text:(NSString*)text {
+    self = [self initWithManager:manager];
+    if (!self)
+        return nil;
+    for (__strong NSString* line in [text componentsSeparatedByString:@"\n"]) {
+        line = [line stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
+        if (line.length)
+            [self addCommand:[manager parseTextCommand:line]];
+    }
+    return self;
+}
+
+- (instancetype) initWithManager:(CodelessManager*)manager script:(CodelessScript*)script {
+    self = [self initWithManager:manager];
+    if (!self)
+        return nil;
+    self.name = script.name;
+    // Commands are parsed again, so that the script is not affected when they complete.
+    for (NSString* line in script.script)
+        [self addCommand:[manager parseTextCommand:line]];
+    return self;
+}
+
+- (NSArray<CodelessProvisioningStep*>*) steps {
+    return [NSArray arrayWithArray:self.stepList];
+}
+
+- (NSTimeInterval) duration {
+    if (!self.started)
+        return 0;
+    return (self.complete ? self.endTime : NSProcessInfo.processInfo.systemUptime) - self.startTime;
+}
+
+- (void) addCommand:(CodelessCommand*)command {
+    if (self.started)
+        return;
+
+    if ([command isKindOfClass:CodelessIoConfigCommand.class]) {
+        CodelessGPIO* gpio = ((CodelessIoConfigCommand*) command).gpio;
+        if (command.isValid && gpio.validGpio && gpio.validFunction) {
+            [self.ioConfig removeObject:gpio];
+            [self.ioConfig addObject:gpio];
+            return;
+        }
+    } else if ([command isKindOfClass:CodelessEventConfigCommand.class]) {
+        CodelessEventConfig* eventConfig = ((CodelessEventConfigCommand*) command).eventConfig;
+        if (command.isValid && eventConfig) {
+            for (int i = 0; i < self.eventConfig.count; i++) {
+                if (self.eventConfig[i].type == eventConfig.type) {
+                    [self.eventConfig removeObjectAtIndex:i];
+                    break;
+                }
+            }
+            [self.eventConfig addObject:eventConfig];
+            return;
+        }
+    } else if ([command isKindOfClass:CodelessCmdStoreCommand.class]) {
+        CodelessCmdStoreCommand* cmdStore = (CodelessCmdStoreCommand*) command;
+        if (command.isValid && cmdStore.commandString) {
+            self.storedCommands[@(cmdStore.index)] = cmdStore.commandString;
+            return;
+        }
+    }
+
+    [self.commands addObject:command];
+}
+
+- (void) start {
+    if (self.started)
+        return;
+    self.started = true;
+    self.startTime = NSProcessInfo.processInfo.systemUptime;
+    self.lastStepTime = self.startTime;
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Provisioning start: %@", self);
+
+    if (!self.manager.isReady) {
+        CodelessLog(TAG, "Provisioning failed, device not ready: %@", self);
+        self.error = true;
+        [self end];
+        return;
+    }
+
+    [self.manager addEventObserver:self selector:@selector(onCommandComplete:) event:CodelessLibEvent.CommandSuccess];
+    [self.manager addEventObserver:self selector:@selector(onCommandComplete:) event:CodelessLibEvent.CommandError];
+    [self.manager addEventObserver:self selector:@selector(onConnection:) event:CodelessLibEvent.Connection];
+
+    // Read back the device state that is part of the target configuration
+    NSMutableArray<CodelessProvisioningStep*>* steps = [NSMutableArray array];
+    if (self.ioConfig.count) {
+        self.ioConfigRead = [[CodelessIoConfigCommand alloc] initWithManager:self.manager];
+        [steps addObject:[[CodelessProvisioningStep alloc] initWithType:CODELESS_PROVISIONING_STEP_READ name:@"Read IO configuration" command:self.ioConfigRead]];
+    }
+    if (self.eventConfig.count) {
+        self.eventConfigRead = [[CodelessEventConfigCommand alloc] initWithManager:self.manager];
+        [steps addObject:[[CodelessProvisioningStep alloc] initWithType:CODELESS_PROVISIONING_STEP_READ name:@"Read event configuration" command:self.eventConfigRead]];
+    }
+    for (NSNumber* index in [self.storedCommands.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        CodelessCmdGetCommand* command = [[CodelessCmdGetCommand alloc] initWithManager:self.manager index:index.intValue];
+        self.storedCommandsRead[index] = command;
+        [steps addObject:[[CodelessProvisioningStep alloc] initWithType:CODELESS_PROVISIONING_STEP_READ name:[NSString stringWithFormat:@"Read stored commands %@", index] command:command]];
+    }
+
+    if (steps.count)
+        [self sendSteps:steps];
+    else
+        [self writeChanges];
+}
+
+- (void) stop {
+    if (self.complete)
+        return;
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Provisioning stopped: %@", self);
+    self.complete = true;
+    self.endTime = NSProcessInfo.processInfo.systemUptime;
+    [self.pending removeAllObjects];
+    [self.manager cancelCommands:self];
+    [self.manager removeEventObserver:self];
+}
+
+/**
+ * Sends the commands of the specified steps.
+ * <p> All commands are enqueued at once, so that the manager sends them back to back.
+ * If the operation ends early (error or {@link #stop}), the commands that were not sent yet are removed from the command queue.
+ * @param steps the steps to perform
+ */
+- (void) sendSteps:(NSArray<CodelessProvisioningStep*>*)steps {
+    NSTimeInterval now = NSProcessInfo.processInfo.systemUptime;
+    NSMutableArray<CodelessCommand*>* commands = [NSMutableArray arrayWithCapacity:steps.count];
+    for (CodelessProvisioningStep* step in steps) {
+        step.startTime = now;
+        step.command.origin = self;
+        [self.stepList addObject:step];
+        [self.pending addObject:step];
+        [commands addObject:step.command];
+    }
+    [self.manager sendCommands:commands];
+}
+
+- (void) onCommandComplete:(CodelessCommandEvent*)event {
+    if (event.command.origin != self)
+        return;
+    CodelessProvisioningStep* step;
+    for (CodelessProvisioningStep* pending in self.pending) {
+        if (pending.command == event.command) {
+            step = pending;
+            break;
+        }
+    }
+    if (!step)
+        return;
+    [self.pending removeObject:step];
+
+    // Commands are sent back to back, so each step starts when the previous one is complete.
+    step.startTime = MAX(step.startTime, self.lastStepTime);
+    step.endTime = NSProcessInfo.processInfo.systemUptime;
+    self.lastStepTime = step.endTime;
+    step.complete = true;
+    step.error = step.command.error;
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Provisioning step: %@ %@", self, step);
+    [self sendEvent:CodelessLibEvent.ProvisioningStep object:[[CodelessProvisioningStepEvent alloc] initWithProvisioning:self step:step]];
+
+    // Failed reads are handled as unknown device state, which is overwritten.
+    if (step.error && step.type != CODELESS_PROVISIONING_STEP_READ) {
+        self.error = true;
+        if (self.stopOnError) {
+            [self end];
+            return;
+        }
+    }
+
+    if (self.pending.count)
+        return;
+    if (!self.writePhase)
+        [self writeChanges];
+    else
+        [self end];
+}
+
+- (void) onConnection:(CodelessConnectionEvent*)event {
+    if (self.manager.isDisconnected && !self.complete) {
+        CodelessLog(TAG, "Provisioning failed, device disconnected: %@", self);
+        self.error = true;
+        [self end];
+    }
+}
+
+/**
+ * Compares the device state with the target configuration and sends the required changes.
+ * <p> Settings that already match the target configuration are skipped.
+ */
+- (void) writeChanges {
+    self.writePhase = true;
+
+    NSMutableArray<CodelessCommand*>* storeCommands = [NSMutableArray array];
+    NSMutableArray<CodelessCommand*>* changes = [NSMutableArray array];
+
+    for (NSNumber* index in [self.storedCommands.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        NSString* target = self.storedCommands[index];
+        CodelessCmdGetCommand* read = self.storedCommandsRead[index];
+        if (read && !read.failed && [[self normalizeCommandString:read.commandString] isEqualToString:[self normalizeCommandString:target]]) {
+            [self skip:[NSString stringWithFormat:@"Stored commands %@", index]];
+            continue;
+        }
+        [storeCommands addObject:[[CodelessCmdStoreCommand alloc] initWithManager:self.manager index:index.intValue commandString:target]];
+    }
+
+    NSArray<CodelessGPIO*>* ioConfig = self.ioConfigRead && !self.ioConfigRead.failed ? self.ioConfigRead.configuration : nil;
+    for (CodelessGPIO* gpio in self.ioConfig) {
+        NSUInteger current = ioConfig ? [ioConfig indexOfObject:gpio] : NSNotFound;
+        // The IO configuration response contains only the pin functionality, so the level cannot be checked.
+        // Targets that set the output level are always written.
+        if (current != NSNotFound && ioConfig[current].function == gpio.function && !gpio.validLevel) {
+            [self skip:[NSString stringWithFormat:@"IO configuration %@", gpio.name]];
+            continue;
+        }
+        [changes addObject:[[CodelessIoConfigCommand alloc] initWithManager:self.manager gpio:gpio]];
+    }
+
+    NSArray<CodelessEventConfig*>* eventConfig = self.eventConfigRead && !self.eventConfigRead.failed ? self.eventConfigRead.eventStatusTable : nil;
+    for (CodelessEventConfig* event in self.eventConfig) {
+        BOOL match = false;
+        for (CodelessEventConfig* current in eventConfig) {
+            if (current.type == event.type) {
+                match = current.status == event.status;
+                break;
+            }
+        }
+        if (match) {
+            [self skip:[NSString stringWithFormat:@"Event configuration %d", event.type]];
+            continue;
+        }
+        [changes addObject:[[CodelessEventConfigCommand alloc] initWithManager:self.manager eventConfig:event]];
+    }
+
+    self.changed = (int) (storeCommands.count + changes.count);
+    [changes addObjectsFromArray:self.commands];
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Provisioning changes: %@ changed=%d skipped=%d other=%d", self, self.changed, self.skipped, (int) self.commands.count);
+
+    NSMutableArray<CodelessProvisioningStep*>* steps = [NSMutableArray array];
+    for (CodelessCommand* command in storeCommands)
+        [steps addObject:[[CodelessProvisioningStep alloc] initWithType:CODELESS_PROVISIONING_STEP_WRITE name:[NSString stringWithFormat:@"Store commands %d", ((CodelessCmdStoreCommand*) command).index] command:command]];
+
+    NSString* batch = [self batchCommandString:changes];
+    if (batch) {
+        CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Provisioning batch: %@ slot=%d commands=%d", self, self.batchSlot, (int) changes.count);
+        [steps addObject:[[CodelessProvisioningStep alloc] initWithType:CODELESS_PROVISIONING_STEP_BATCH_STORE name:[NSString stringWithFormat:@"Store batch %d", self.batchSlot] command:[[CodelessCmdStoreCommand alloc] initWithManager:self.manager index:self.batchSlot commandString:batch]]];
+        [steps addObject:[[CodelessProvisioningStep alloc] initWithType:CODELESS_PROVISIONING_STEP_BATCH_PLAY name:[NSString stringWithFormat:@"Play batch %d", self.batchSlot] command:[[CodelessCmdPlayCommand alloc] initWithManager:self.manager index:self.batchSlot]]];
+    } else {
+        for (CodelessCommand* command in changes)
+            [steps addObject:[[CodelessProvisioningStep alloc] initWithType:CODELESS_PROVISIONING_STEP_WRITE name:command.description command:command]];
+    }
+
+    if (steps.count)
+        [self sendSteps:steps];
+    else
+        [self end];
+}
+
+/**
+ * Packs the specified commands to a stored commands text that can be executed in one batch.
+ * @param commands the commands to batch
+ * @return the stored commands text, or <code>nil</code> if the commands should be sent one by one
+ */
+- (NSString*) batchCommandString:(NSArray<CodelessCommand*>*)commands {
+    if (self.batchSlot == CODELESS_PROVISIONING_NO_BATCH || commands.count < 2)
+        return nil;
+    if (self.storedCommands[@(self.batchSlot)]) {
+        CodelessLog(TAG, "Batch slot %d is part of the target configuration, batching disabled", self.batchSlot);
+        return nil;
+    }
+
+    NSMutableArray<NSString*>* batch = [NSMutableArray arrayWithCapacity:commands.count];
+    for (CodelessCommand* command in commands) {
+        if (!command.isValid || [command isKindOfClass:CodelessCmdStoreCommand.class] || [command isKindOfClass:CodelessCmdPlayCommand.class])
+            return nil;
+        NSString* text;
+        if (command.commandID == CODELESS_COMMAND_ID_CUSTOM)
+            text = command.command;
+        else
+            text = [CodelessProfile.PREFIX_LOCAL stringByAppendingString:command.parsed ? command.command : [command packCommand]];
+        if ([text containsString:@";"])
+            return nil;
+        [batch addObject:text];
+    }
+    return [batch componentsJoinedByString:@";"];
+}
+
+/**
+ * Normalizes a stored commands text, so that it can be compared with the device state.
+ * @param commandString the stored commands text (semicolon separated)
+ */
+- (NSString*) normalizeCommandString:(NSString*)commandString {
+    NSMutableArray<NSString*>* commands = [NSMutableArray array];
+    for (__strong NSString* command in [commandString componentsSeparatedByString:@";"]) {
+        command = [command stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
+        if (command.length)
+            [commands addObject:[CodelessProfile removeCommandPrefix:command]];
+    }
+    return [commands componentsJoinedByString:@";"];
+}
+
+/**
+ * Records a skipped setting.
+ * @param name the setting description
+ */
+- (void) skip:(NSString*)name {
+    CodelessProvisioningStep* step = [[CodelessProvisioningStep alloc] initWithType:CODELESS_PROVISIONING_STEP_SKIP name:name command:nil];
+    step.startTime = step.endTime = NSProcessInfo.processInfo.systemUptime;
+    step.complete = true;
+    [self.stepList addObject:step];
+    self.skipped++;
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Provisioning skip: %@ %@", self, name);
+    [self sendEvent:CodelessLibEvent.ProvisioningStep object:[[CodelessProvisioningStepEvent alloc] initWithProvisioning:self step:step]];
+}
+
+/**
+ * Completes the provisioning operation.
+ * <p> A {@link CodelessLibEvent#ProvisioningEnd ProvisioningEnd} event is generated.
+ */
+- (void) end {
+    self.complete = true;
+    self.endTime = NSProcessInfo.processInfo.systemUptime;
+    [self.pending removeAllObjects];
+    [self.manager cancelCommands:self];
+    [self.manager removeEventObserver:self];
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Provisioning end: %@ changed=%d skipped=%d time=%.1fms%@", self, self.changed, self.skipped, self.duration * 1000, self.error ? @" (error)" : @"");
+    [self sendEvent:CodelessLibEvent.ProvisioningEnd object:[[CodelessProvisioningEndEvent alloc] initWithProvisioning:self error:self.error]];
+}
+
+- (void) sendEvent:(NSString*)event object:(CodelessEvent*)object {
+    [self.manager sendEvent:event object:object];
+}
+
+- (NSString*) description {
+    return [NSString stringWithFormat:@"[%@]", self.name ? self.name : @"Provisioning"];
+}
+
+@end
@@ -0,0 +1,94 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessCoreBluetooth.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Scan filter used by {@link CodelessBluetoothManager} to drop uninteresting advertising events.
+ *
+ * ## Usage ##
+ * The {@link #services} (or the required CodeLess/DSPS service, if no services are set) are passed to CoreBluetooth,
+ * so that non matching devices are filtered by the system. The rest of the criteria are checked by the library,
+ * on the raw advertising data, before they are parsed and before any {@link CodelessLibEvent#ScanResult ScanResult} event is generated.
+ * The checks run from the cheapest to the most expensive one: RSSI, manufacturer ID, name prefix, services, custom predicate.
+ *
+ * For example, scan only for CodeLess devices with a name starting with "Dialog", that are in close range:
+ * <blockquote><pre>
+ * CodelessScanFilter* filter = [CodelessScanFilter new];
+ * filter.codeless = true;
+ * filter.namePrefix = @@"Dialog";
+ * filter.minRssi = -70;
+ * CodelessBluetoothManager.instance.scanFilter = filter;
+ * [CodelessBluetoothManager.instance startScanning];</pre></blockquote>
+ *
+ * @see CodelessBluetoothManager#scanFilter
+ */
+@interface CodelessScanFilter : NSObject
+
+/// Custom predicate, called with the raw advertising data. Return <code>false</code> to drop the advertising event.
+typedef BOOL (^CodelessScanPredicate)(CBPeripheral* peripheral, NSDictionary<NSString*, id>* advertisementData, int rssi);
+
+/// Accept only devices that advertise one of these services (passed to CoreBluetooth).
+@property (nullable) NSArray<CBUUID*>* services;
+/// Accept only devices with an advertised name that starts with this prefix.
+@property (nullable) NSString* namePrefix;
+/// Accept only devices with manufacturer specific data from one of these manufacturer IDs.
+@property (nullable) NSSet<NSNumber*>* manufacturerIds;
+/// Accept only advertising events with RSSI greater than or equal to this value (default: -127, accept all).
+@property int minRssi;
+/// Accept only devices that advertise the CodeLess service.
+@property BOOL codeless;
+/// Accept only devices that advertise the DSPS service.
+@property BOOL dsps;
+/// Custom predicate, checked after all other criteria.
+@property (nullable, copy) CodelessScanPredicate predicate;
+
+/// Returns the services that are passed to CoreBluetooth when scanning (<code>nil</code> for all devices).
+- (nullable NSArray<CBUUID*>*) scanServices;
+/**
+ * Checks if an advertising event matches the filter.
+ * @param peripheral        the found device
+ * @param advertisementData the raw advertising data
+ * @param rssi              the RSSI of the advertising event
+ * @return <code>true</code> if the advertising event should be processed
+ */
+- (BOOL) matches:(CBPeripheral*)peripheral advertisementData:(NSDictionary<NSString*, id>*)advertisementData rssi:(int)rssi;
+
+@end
+
+NS_ASSUME_NONNULL_END
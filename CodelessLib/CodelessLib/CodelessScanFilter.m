@@ -0,0 +1,106 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessScanFilter.h"
+#import "CodelessBluetoothManager.h"
+#import "CodelessProfile.h"
+
+@implementation CodelessScanFilter
+
+- (instancetype) init {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.minRssi = -127;
+    return self;
+}
+
+- (NSArray<CBUUID*>*) scanServices {
+    if (self.services.count)
+        return self.services;
+    // CoreBluetooth accepts devices advertising any of the services, so only one is used if both are required.
+    if (self.codeless)
+        return @[ CodelessProfile.CODELESS_SERVICE_UUID ];
+    if (self.dsps)
+        return @[ CodelessProfile.DSPS_SERVICE_UUID ];
+    return nil;
+}
+
+/// Checks if the advertised services contain a service.
+static BOOL advertises(NSDictionary<NSString*, id>* data, CBUUID* service) {
+    return [(NSArray*) data[CBAdvertisementDataServiceUUIDsKey] containsObject:service] || [(NSArray*) data[CBAdvertisementDataOverflowServiceUUIDsKey] containsObject:service];
+}
+
+- (BOOL) matches:(CBPeripheral*)peripheral advertisementData:(NSDictionary<NSString*, id>*)data rssi:(int)rssi {
+    if (rssi < self.minRssi || (rssi == CODELESS_RSSI_UNAVAILABLE && self.minRssi > -127))
+        return false;
+
+    if (self.manufacturerIds) {
+        NSData* manufacturerData = data[CBAdvertisementDataManufacturerDataKey];
+        if (manufacturerData.length < 2)
+            return false;
+        const uint8_t* bytes = manufacturerData.bytes;
+        if (![self.manufacturerIds containsObject:@(bytes[0] | bytes[1] << 8)])
+            return false;
+    }
+
+    if (self.namePrefix) {
+        NSString* name = data[CBAdvertisementDataLocalNameKey];
+        if (!name)
+            name = peripheral.name;
+        if (![name hasPrefix:self.namePrefix])
+            return false;
+    }
+
+    if (self.codeless && !advertises(data, CodelessProfile.CODELESS_SERVICE_UUID))
+        return false;
+    if (self.dsps && !advertises(data, CodelessProfile.DSPS_SERVICE_UUID))
+        return false;
+    if (self.services.count) {
+        BOOL found = false;
+        for (CBUUID* service in self.services) {
+            if (advertises(data, service)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            return false;
+    }
+
+    return !self.predicate || self.predicate(peripheral, data, rssi);
+}
+
+@end
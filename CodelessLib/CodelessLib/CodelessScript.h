@@ -37,6 +37,7 @@
 
 @class CodelessCommand;
 @class CodelessManager;
+@class CodelessCompiledScript;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -56,6 +57,32 @@ NS_ASSUME_NONNULL_BEGIN
  * When the script is complete, a {@link CodelessLibEvent#ScriptEnd ScriptEnd} event is generated.
  * By default, the script will stop if a command fails. Use {@link #stopOnError} to modify this behavior.
  *
+ * ## Control statements ##
+ * Lines starting with <code>@</code> are control statements, which are executed by the library
+ * between the script commands:
+ * <ul>
+ * <li><code>@LOOP [count]</code> ... <code>@ENDLOOP</code>: repeats the enclosed lines (forever if count is missing).</li>
+ * <li><code>@LOOP [count]</code> ... <code>@UNTIL regex</code>: repeats the enclosed lines until the last response matches.</li>
+ * <li><code>@IF regex</code> ... [<code>@ELSE</code> ...] <code>@ENDIF</code>: executes the enclosed lines if the last response matches.</li>
+ * <li><code>@WAIT ms</code>: waits for the specified time.</li>
+ * <li><code>@WAITDATA ms</code>: waits for DSPS data from the peer device (the data become the last response) or the specified timeout.</li>
+ * <li><code>@SET name value</code>: sets a variable.</li>
+ * <li><code>@CAPTURE name regex</code>: sets a variable to the first capturing group (or the whole match) of the last response.</li>
+ * </ul>
+ * The last response is the response text of the last complete command (one line per response line).
+ * Variables can be used in commands and control statement arguments as <code>$name</code> or <code>${name}</code>.
+ * Commands that use variables are parsed when they are executed.
+ *
+ * For example, poll an input pin until it goes high, then report the ADC value:
+ * <blockquote><pre>
+ * NSString* text = @@"@LOOP 100\n"
+ *                  "AT+IO=5\n"
+ *                  "@WAIT 50\n"
+ *                  "@UNTIL ^1$\n"
+ *                  "AT+ADC=6\n"
+ *                  "@CAPTURE adc ^(\\d+)$\n"
+ *                  "AT+PRINT=ADC $adc";</pre></blockquote>
+ *
  * For example, a script that uses two timers to toggle an output pin:
  * <blockquote><pre>
  * NSString* text = @@"AT+IOCFG=10,4\n"
@@ -97,6 +124,12 @@ NS_ASSUME_NONNULL_BEGIN
 @property (readonly) BOOL stopped;
 /// <code>true</code> if the script is complete.
 @property (readonly) BOOL complete;
+/// <code>true</code> if the script contains control statements.
+@property (readonly) BOOL controlFlow;
+/// The response text of the last complete command, or the last DSPS data received by <code>@WAITDATA</code>.
+@property (readonly, nullable) NSString* lastResponse;
+/// The script variables.
+@property (readonly) NSDictionary<NSString*, NSString*>* variables;
 
 /**
  * Creates a CodelessScript with no commands.
@@ -135,6 +168,28 @@ NS_ASSUME_NONNULL_BEGIN
  * @param script    the script text (one command per line)
  */
 - (instancetype) initWithName:(NSString*)name manager:(CodelessManager*)manager script:(NSArray<NSString*>*)script;
+/**
+ * Creates a CodelessScript from a {@link CodelessCompiledScript compiled script}.
+ * <p> The script commands are created from the compiled ones, without parsing the script text again.
+ * @param manager   the manager used to run the script
+ * @param compiled  the compiled script
+ * @see CodelessCompiledScript#scriptWithManager:
+ */
+- (instancetype) initWithManager:(CodelessManager*)manager compiledScript:(CodelessCompiledScript*)compiled;
+
+/**
+ * Checks if a script line is a control statement.
+ * @param line the script line
+ */
++ (BOOL) isControlStatement:(NSString*)line;
+
+/**
+ * Sets a script variable.
+ * <p> Can be used to pass values to the script before starting it.
+ * @param name  the variable name
+ * @param value the variable value (<code>nil</code> to remove the variable)
+ */
+- (void) setVariable:(NSString*)name value:(nullable NSString*)value;
 
 /**
  * Starts the script.
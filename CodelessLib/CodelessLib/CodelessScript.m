@@ -34,11 +34,64 @@
  */
 
 #import "CodelessScript.h"
+#import "CodelessCompiledScript.h"
 #import "CodelessProfile.h"
 #import "CodelessCommand.h"
 #import "CodelessManager.h"
 #import "CodelessLibLog.h"
 #import "CodelessLibEvent.h"
+#import "CodelessLibConfig.h"
+
+/// Script instruction type.
+enum {
+    CodelessScriptCommand,
+    CodelessScriptLoop,
+    CodelessScriptEndLoop,
+    CodelessScriptUntil,
+    CodelessScriptIf,
+    CodelessScriptElse,
+    CodelessScriptEndIf,
+    CodelessScriptWait,
+    CodelessScriptWaitData,
+    CodelessScriptSet,
+    CodelessScriptCapture,
+};
+
+/// Compiled script line (command or control statement).
+@interface CodelessScript_Instruction : NSObject
+
+/// The instruction type.
+@property int type;
+/// The script line index.
+@property int line;
+/// The command index (for commands).
+@property int command;
+/// The variable name (for <code>@SET</code>, <code>@CAPTURE</code>).
+@property NSString* name;
+/// The statement argument.
+@property NSString* argument;
+/// The statement pattern, if the argument does not use variables.
+@property NSRegularExpression* pattern;
+/// The matching block statement index (for block statements).
+@property int target;
+
+@end
+
+@implementation CodelessScript_Instruction
+
+- (instancetype) initWithType:(int)type line:(int)line {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.type = type;
+    self.line = line;
+    self.command = -1;
+    self.target = -1;
+    return self;
+}
+
+@end
+
 
 @interface CodelessScript ()
 
@@ -48,6 +101,14 @@
 @property BOOL started;
 @property BOOL stopped;
 @property BOOL complete;
+@property BOOL controlFlow;
+@property NSString* lastResponse;
+@property NSMutableDictionary<NSString*, NSString*>* variableMap;
+@property NSArray<CodelessScript_Instruction*>* program;
+@property NSArray<NSNumber*>* commandLines;
+@property int pc;
+@property NSMutableDictionary<NSNumber*, NSNumber*>* loopCounters;
+@property BOOL waitingData;
 
 @end
 
@@ -58,6 +119,31 @@ static NSString* const TAG = @"CodelessScript";
     return TAG;
 }
 
+static NSString* const CONTROL_PREFIX = @"@";
+static NSDictionary<NSString*, NSNumber*>* CONTROL_STATEMENTS;
+static NSRegularExpression* VARIABLE_PATTERN;
+
++ (void) initialize {
+    if (self != CodelessScript.class)
+        return;
+
+    CONTROL_STATEMENTS = @{
+            @"LOOP" : @(CodelessScriptLoop),
+            @"ENDLOOP" : @(CodelessScriptEndLoop),
+            @"UNTIL" : @(CodelessScriptUntil),
+            @"IF" : @(CodelessScriptIf),
+            @"ELSE" : @(CodelessScriptElse),
+            @"ENDIF" : @(CodelessScriptEndIf),
+            @"WAIT" : @(CodelessScriptWait),
+            @"WAITDATA" : @(CodelessScriptWaitData),
+            @"SET" : @(CodelessScriptSet),
+            @"CAPTURE" : @(CodelessScriptCapture),
+    };
+
+    NSError* error = nil;
+    VARIABLE_PATTERN = [NSRegularExpression regularExpressionWithPattern:@"\\$(?:\\{(\\w+)\\}|(\\w+))" options:0 error:&error];
+}
+
 static int nextScriptId;
 
 - (instancetype) init {
@@ -68,6 +154,8 @@ static int nextScriptId;
     _script = @[];
     _commands = @[];
     self.stopOnError = true;
+    self.variableMap = [NSMutableDictionary dictionary];
+    self.loopCounters = [NSMutableDictionary dictionary];
     return self;
 }
 
@@ -119,47 +207,199 @@ static int nextScriptId;
     return self;
 }
 
+- (instancetype) initWithManager:(CodelessManager*)manager compiledScript:(CodelessCompiledScript*)compiled {
+    self = [self initWithManager:manager];
+    if (!self)
+        return nil;
+    self.name = compiled.name;
+    _script = compiled.script;
+    [self initScript:[compiled commandsWithManager:manager]];
+    return self;
+}
+
++ (BOOL) isControlStatement:(NSString*)line {
+    return [line hasPrefix:CONTROL_PREFIX];
+}
+
 /// Initializes the script by parsing the script text to a list of {@link CodelessCommand} objects.
 - (void) initScript {
+    [self initScript:nil];
+}
+
+/**
+ * Initializes the script by parsing the script text to a list of {@link CodelessCommand} objects and control statements.
+ * @param prepared the commands for the script command lines, if they are already created, or <code>nil</code> to parse the script text
+ */
+- (void) initScript:(NSArray<CodelessCommand*>*)prepared {
+    self.invalid = false;
+    self.custom = false;
+    self.controlFlow = false;
     NSMutableArray<CodelessCommand*>* commands = [NSMutableArray arrayWithCapacity:self.script.count];
-    for (NSString* text in self.script) {
-        CodelessCommand* command = [self.manager parseTextCommand:text];
+    NSMutableArray<CodelessScript_Instruction*>* program = [NSMutableArray arrayWithCapacity:self.script.count];
+    NSMutableArray<NSNumber*>* commandLines = [NSMutableArray arrayWithCapacity:self.script.count];
+    NSMutableArray<NSNumber*>* blocks = [NSMutableArray array];
+
+    for (int i = 0; i < self.script.count; i++) {
+        NSString* text = self.script[i];
+        if ([CodelessScript isControlStatement:text]) {
+            self.controlFlow = true;
+            CodelessScript_Instruction* instruction = [self parseControlStatement:text line:i];
+            if (!instruction) {
+                CodelessLog(TAG, "Invalid control statement: %@ %@", self, text);
+                self.invalid = true;
+                continue;
+            }
+            if (![self matchBlock:instruction index:(int) program.count program:program blocks:blocks]) {
+                CodelessLog(TAG, "Unmatched control statement: %@ %@", self, text);
+                self.invalid = true;
+            }
+            [program addObject:instruction];
+            continue;
+        }
+
+        CodelessCommand* command = prepared && commands.count < prepared.count ? prepared[commands.count] : [self.manager parseTextCommand:text];
         command.script = self;
+        CodelessScript_Instruction* instruction = [[CodelessScript_Instruction alloc] initWithType:CodelessScriptCommand line:i];
+        instruction.command = (int) commands.count;
+        [program addObject:instruction];
         [commands addObject:command];
-        if (!command.isValid)
+        [commandLines addObject:@(i)];
+        // Commands that use variables are parsed again when they are executed.
+        if (!command.isValid && ![self hasVariables:text])
             self.invalid = true;
         if (command.commandID == CODELESS_COMMAND_ID_CUSTOM)
             self.custom = true;
     }
+
+    if (blocks.count) {
+        CodelessLog(TAG, "Unterminated control statement: %@ %@", self, self.script[program[blocks.lastObject.intValue].line]);
+        self.invalid = true;
+    }
     _commands = [NSArray arrayWithArray:commands];
+    self.program = [NSArray arrayWithArray:program];
+    self.commandLines = [NSArray arrayWithArray:commandLines];
+}
+
+/**
+ * Parses a control statement.
+ * @param text  the statement text
+ * @param line  the script line index
+ * @return the parsed instruction, or <code>nil</code> if the statement is invalid
+ */
+- (CodelessScript_Instruction*) parseControlStatement:(NSString*)text line:(int)line {
+    text = [text substringFromIndex:CONTROL_PREFIX.length];
+    NSRange separator = [text rangeOfCharacterFromSet:NSCharacterSet.whitespaceCharacterSet];
+    NSString* keyword = separator.location != NSNotFound ? [text substringToIndex:separator.location] : text;
+    NSString* argument = separator.location != NSNotFound ? [[text substringFromIndex:separator.location] stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet] : @"";
+    NSNumber* type = CONTROL_STATEMENTS[keyword.uppercaseString];
+    if (!type)
+        return nil;
+
+    CodelessScript_Instruction* instruction = [[CodelessScript_Instruction alloc] initWithType:type.intValue line:line];
+    switch (instruction.type) {
+        case CodelessScriptWait:
+        case CodelessScriptWaitData:
+            if (!argument.length)
+                return nil;
+            break;
+
+        case CodelessScriptSet:
+        case CodelessScriptCapture: {
+            separator = [argument rangeOfCharacterFromSet:NSCharacterSet.whitespaceCharacterSet];
+            instruction.name = separator.location != NSNotFound ? [argument substringToIndex:separator.location] : argument;
+            argument = separator.location != NSNotFound ? [[argument substringFromIndex:separator.location] stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet] : @"";
+            if (!instruction.name.length || instruction.type == CodelessScriptCapture && !argument.length)
+                return nil;
+            break;
+        }
+
+        case CodelessScriptUntil:
+        case CodelessScriptIf:
+            if (!argument.length)
+                return nil;
+            break;
+    }
+    instruction.argument = argument;
+
+    if ((instruction.type == CodelessScriptUntil || instruction.type == CodelessScriptIf || instruction.type == CodelessScriptCapture) && ![self hasVariables:argument]) {
+        NSError* error = nil;
+        instruction.pattern = [NSRegularExpression regularExpressionWithPattern:argument options:NSRegularExpressionAnchorsMatchLines error:&error];
+        if (!instruction.pattern)
+            return nil;
+    }
+    return instruction;
+}
+
+/**
+ * Links block statements (<code>@LOOP</code>, <code>@IF</code>) with their matching end statements.
+ * @return <code>false</code> if the statement does not match the current block
+ */
+- (BOOL) matchBlock:(CodelessScript_Instruction*)instruction index:(int)index program:(NSArray<CodelessScript_Instruction*>*)program blocks:(NSMutableArray<NSNumber*>*)blocks {
+    CodelessScript_Instruction* block = blocks.count ? program[blocks.lastObject.intValue] : nil;
+    switch (instruction.type) {
+        case CodelessScriptLoop:
+        case CodelessScriptIf:
+            [blocks addObject:@(index)];
+            return true;
+
+        case CodelessScriptEndLoop:
+        case CodelessScriptUntil:
+            if (block.type != CodelessScriptLoop)
+                return false;
+            instruction.target = blocks.lastObject.intValue;
+            block.target = index;
+            [blocks removeLastObject];
+            return true;
+
+        case CodelessScriptElse:
+            if (block.type != CodelessScriptIf)
+                return false;
+            block.target = index;
+            [blocks removeLastObject];
+            [blocks addObject:@(index)];
+            return true;
+
+        case CodelessScriptEndIf:
+            if (block.type != CodelessScriptIf && block.type != CodelessScriptElse)
+                return false;
+            block.target = index;
+            [blocks removeLastObject];
+            return true;
+    }
+    return true;
 }
 
 - (void) start {
     if (self.started)
         return;
     self.started = true;
-    CodelessLogOpt(CodelessLibLog.SCRIPT, TAG, "Script start: %@", self);
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script start: %@", self);
     [self.manager addScript:self];
     [self sendEvent:CodelessLibEvent.ScriptStart object:[[CodelessScriptStartEvent alloc] initWithScript:self]];
     _current = -1;
+    self.pc = 0;
+    [self.loopCounters removeAllObjects];
     [self sendNextCommand];
 }
 
 - (void) stop {
-    CodelessLogOpt(CodelessLibLog.SCRIPT, TAG, "Script stopped: %@", self);
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script stopped: %@", self);
     self.stopped = true;
     self.complete = true;
+    [self cancelWait];
     [self.manager removeScript:self];
 }
 
 - (void) onSuccess:(CodelessCommand*)command {
-    CodelessLogOpt(CodelessLibLog.SCRIPT, TAG, "Script command success: %@ %@", self, command);
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script command success: %@ %@", self, command);
+    self.lastResponse = [command.response componentsJoinedByString:@"\n"];
     [self sendEvent:CodelessLibEvent.ScriptCommand object:[[CodelessScriptCommandEvent alloc] initWithScript:self command:command]];
     [self sendNextCommand];
 }
 
 - (void) onError:(CodelessCommand*)command {
-    CodelessLogOpt(CodelessLibLog.SCRIPT, TAG, "Script command error: %@ %@ %@", self, command, command.error);
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script command error: %@ %@ %@", self, command, command.error);
+    self.lastResponse = [command.response componentsJoinedByString:@"\n"];
     [self sendEvent:CodelessLibEvent.ScriptCommand object:[[CodelessScriptCommandEvent alloc] initWithScript:self command:command]];
     if (!self.stopOnError) {
         [self sendNextCommand];
@@ -178,19 +418,236 @@ static int nextScriptId;
         [self sendEvent:CodelessLibEvent.ScriptEnd object:[[CodelessScriptEndEvent alloc] initWithScript:self error:false]];
     if (self.complete)
         return;
+    if (self.controlFlow) {
+        [self runProgram];
+        return;
+    }
     _current++;
     if (self.current < self.commands.count) {
         CodelessCommand* command = [self getCurrentCommand];
-        CodelessLogOpt(CodelessLibLog.SCRIPT, TAG, "Script command: %@[%d] %@", self, self.current +  1, command);
+        CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script command: %@[%d] %@", self, self.current +  1, command);
         [self.manager sendCommand:command];
     } else {
-        self.complete = true;
-        [self.manager removeScript:self];
-        CodelessLogOpt(CodelessLibLog.SCRIPT, TAG, "Script end: %@", self);
-        [self sendEvent:CodelessLibEvent.ScriptEnd object:[[CodelessScriptEndEvent alloc] initWithScript:self error:false]];
+        [self end];
     }
 }
 
+/// Completes the script execution.
+- (void) end {
+    self.complete = true;
+    [self.manager removeScript:self];
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script end: %@", self);
+    [self sendEvent:CodelessLibEvent.ScriptEnd object:[[CodelessScriptEndEvent alloc] initWithScript:self error:false]];
+}
+
+/**
+ * Executes the script instructions, until a command is sent, a wait statement is reached, or the script is complete.
+ * <p> Used if the script contains control statements.
+ */
+- (void) runProgram {
+    int steps = 0;
+    while (!self.complete) {
+        if (self.pc >= self.program.count) {
+            [self end];
+            return;
+        }
+        if (++steps > CodelessLibConfig.SCRIPT_MAX_CONTROL_STEPS) {
+            CodelessLog(TAG, "Script control statement limit reached: %@", self);
+            [self stop];
+            [self sendEvent:CodelessLibEvent.ScriptEnd object:[[CodelessScriptEndEvent alloc] initWithScript:self error:true]];
+            return;
+        }
+
+        CodelessScript_Instruction* instruction = self.program[self.pc];
+        switch (instruction.type) {
+            case CodelessScriptCommand: {
+                self.pc++;
+                _current = instruction.command;
+                CodelessCommand* command = [self commandForInstruction:instruction];
+                CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script command: %@[%d] %@", self, instruction.line + 1, command);
+                [self.manager sendCommand:command];
+                return;
+            }
+
+            case CodelessScriptLoop: {
+                int count = instruction.argument.length ? [self expand:instruction.argument].intValue : -1;
+                if (count == 0) {
+                    self.pc = instruction.target + 1;
+                    break;
+                }
+                self.loopCounters[@(self.pc)] = @(count);
+                self.pc++;
+                break;
+            }
+
+            case CodelessScriptUntil:
+                if ([self matchResponse:instruction]) {
+                    [self.loopCounters removeObjectForKey:@(instruction.target)];
+                    self.pc++;
+                    break;
+                }
+            // fall through
+            case CodelessScriptEndLoop: {
+                NSNumber* loop = @(instruction.target);
+                int count = self.loopCounters[loop].intValue;
+                if (count > 0)
+                    count--;
+                if (count != 0) {
+                    self.loopCounters[loop] = @(count);
+                    self.pc = instruction.target + 1;
+                } else {
+                    [self.loopCounters removeObjectForKey:loop];
+                    self.pc++;
+                }
+                break;
+            }
+
+            case CodelessScriptIf:
+                self.pc = [self matchResponse:instruction] ? self.pc + 1 : instruction.target + 1;
+                break;
+
+            case CodelessScriptElse:
+                self.pc = instruction.target + 1;
+                break;
+
+            case CodelessScriptEndIf:
+                self.pc++;
+                break;
+
+            case CodelessScriptWait: {
+                self.pc++;
+                int delay = [self expand:instruction.argument].intValue;
+                CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script wait: %@ %dms", self, delay);
+                [self performSelector:@selector(runProgram) withObject:nil afterDelay:delay / 1000.];
+                return;
+            }
+
+            case CodelessScriptWaitData: {
+                self.pc++;
+                int timeout = [self expand:instruction.argument].intValue;
+                CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script wait for data: %@ %dms", self, timeout);
+                self.waitingData = true;
+                [self.manager addEventObserver:self selector:@selector(onDspsRxData:) event:CodelessLibEvent.DspsRxData];
+                [self performSelector:@selector(onWaitDataTimeout) withObject:nil afterDelay:timeout / 1000.];
+                return;
+            }
+
+            case CodelessScriptSet:
+                [self setVariable:instruction.name value:[self expand:instruction.argument]];
+                self.pc++;
+                break;
+
+            case CodelessScriptCapture: {
+                NSTextCheckingResult* match = [self matchResponse:instruction];
+                if (match) {
+                    NSRange range = match.numberOfRanges > 1 && [match rangeAtIndex:1].location != NSNotFound ? [match rangeAtIndex:1] : match.range;
+                    [self setVariable:instruction.name value:[self.lastResponse substringWithRange:range]];
+                }
+                self.pc++;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Returns the command to send for a command instruction.
+ * <p> Commands that use variables are parsed again with the current variable values.
+ * Commands that are executed more than once (in a loop) are copied, so that each execution has its own response.
+ * @param instruction the command instruction
+ */
+- (CodelessCommand*) commandForInstruction:(CodelessScript_Instruction*)instruction {
+    CodelessCommand* command = self.commands[instruction.command];
+    NSString* text = self.script[instruction.line];
+    if (self.variableMap.count && [self hasVariables:text]) {
+        NSString* expanded = [self expand:text];
+        if (![expanded isEqualToString:text]) {
+            command = [self.manager parseTextCommand:expanded];
+            command.script = self;
+            return command;
+        }
+    }
+    if (command.complete || command.response.count) {
+        command = [[command.class alloc] initWithManager:self.manager parsedCommand:command];
+        command.script = self;
+    }
+    return command;
+}
+
+- (NSTextCheckingResult*) matchResponse:(CodelessScript_Instruction*)instruction {
+    NSRegularExpression* pattern = instruction.pattern;
+    if (!pattern) {
+        NSError* error = nil;
+        pattern = [NSRegularExpression regularExpressionWithPattern:[self expand:instruction.argument] options:NSRegularExpressionAnchorsMatchLines error:&error];
+        if (!pattern) {
+            CodelessLog(TAG, "Invalid pattern: %@ %@", self, instruction.argument);
+            return nil;
+        }
+    }
+    NSString* response = self.lastResponse ? self.lastResponse : @"";
+    return [pattern firstMatchInString:response options:0 range:NSMakeRange(0, response.length)];
+}
+
+- (void) onDspsRxData:(DspsRxDataEvent*)event {
+    if (!self.waitingData)
+        return;
+    NSString* text = [[NSString alloc] initWithData:event.data encoding:NSASCIIStringEncoding];
+    self.lastResponse = text ? text : @"";
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script data received: %@ %@", self, self.lastResponse);
+    [self cancelWait];
+    [self runProgram];
+}
+
+- (void) onWaitDataTimeout {
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script wait for data timeout: %@", self);
+    self.lastResponse = @"";
+    [self cancelWait];
+    [self runProgram];
+}
+
+/// Cancels a pending wait statement.
+- (void) cancelWait {
+    self.waitingData = false;
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    [self.manager removeEventObserver:self event:CodelessLibEvent.DspsRxData];
+}
+
+- (BOOL) hasVariables:(NSString*)text {
+    return [text containsString:@"$"] && [VARIABLE_PATTERN firstMatchInString:text options:0 range:NSMakeRange(0, text.length)] != nil;
+}
+
+/**
+ * Replaces the variables in the specified text with their values.
+ * <p> Undefined variables are not replaced.
+ * @param text the text to expand
+ */
+- (NSString*) expand:(NSString*)text {
+    if (![text containsString:@"$"] || !self.variableMap.count)
+        return text;
+    NSMutableString* expanded = [NSMutableString stringWithCapacity:text.length];
+    __block NSUInteger last = 0;
+    [VARIABLE_PATTERN enumerateMatchesInString:text options:0 range:NSMakeRange(0, text.length) usingBlock:^(NSTextCheckingResult* match, NSMatchingFlags flags, BOOL* stop) {
+        NSRange name = [match rangeAtIndex:1].location != NSNotFound ? [match rangeAtIndex:1] : [match rangeAtIndex:2];
+        NSString* value = self.variableMap[[text substringWithRange:name]];
+        if (!value)
+            return;
+        [expanded appendString:[text substringWithRange:NSMakeRange(last, match.range.location - last)]];
+        [expanded appendString:value];
+        last = NSMaxRange(match.range);
+    }];
+    [expanded appendString:[text substringFromIndex:last]];
+    return [NSString stringWithString:expanded];
+}
+
+- (NSDictionary<NSString*, NSString*>*) variables {
+    return [NSDictionary dictionaryWithDictionary:self.variableMap];
+}
+
+- (void) setVariable:(NSString*)name value:(NSString*)value {
+    CodelessLogSubsystem(CODELESS_LOG_SCRIPT, TAG, "Script variable: %@ %@=%@", self, name, value);
+    self.variableMap[name] = value;
+}
+
 /**
  * Sets the script text and parses it to a list of {@link CodelessCommand} objects.
  * @param script the script text (one command per line)
@@ -234,6 +691,9 @@ static int nextScriptId;
     if (self.started)
         return;
     _commands = commands;
+    self.controlFlow = false;
+    self.program = nil;
+    self.commandLines = nil;
     NSMutableArray* script = [NSMutableArray arrayWithCapacity:commands.count];
     for (CodelessCommand* command in commands) {
         if (!command.parsed)
@@ -255,7 +715,7 @@ static int nextScriptId;
 }
 
 - (NSString*) getCurrentCommandText {
-    return self.script[self.current];
+    return self.script[self.commandLines ? self.commandLines[self.current].intValue : self.current];
 }
 
 - (int) getCommandIndex:(CodelessCommand*)command {
@@ -272,7 +732,7 @@ static int nextScriptId;
 }
 
 - (void) sendEvent:(NSString*)event object:(CodelessEvent*)object {
-    [NSNotificationCenter.defaultCenter postNotificationName:event object:self.manager userInfo:@{ @"event" : object }];
+    [self.manager sendEvent:event object:object];
 }
 
 - (NSString*) description {
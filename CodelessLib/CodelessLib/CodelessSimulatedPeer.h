@@ -0,0 +1,135 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessCoreBluetooth.h"
+#import "CodelessTransport.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Handles a command received by the {@link CodelessSimulatedPeer simulated peer}.
+ * @param command the received command text (for example, <code>AT+BINREQ</code>)
+ * @return the response text (for example, <code>OK</code>), or <code>nil</code> for the default response
+ */
+typedef NSString* _Nullable (^CodelessSimulatedCommandHandler)(NSString* command);
+/// Receives the DSPS data written by the central to the {@link CodelessSimulatedPeer simulated peer}.
+typedef void (^CodelessSimulatedDataHandler)(NSData* data);
+
+/**
+ * In-process {@link CodelessTransport transport} that simulates a CodeLess/DSPS peripheral.
+ *
+ * It exposes the CodeLess and DSPS services and implements the peer side of the protocol, so that
+ * a {@link CodelessManager} can run AT commands, binary mode transitions, DSPS flow control and
+ * file transfers without a Bluetooth device.
+ * <p> The link is modeled as a sequence of connection events, every {@link #connectionInterval} ms.
+ * GATT operations complete at the next connection event. At most {@link #txCreditLimit} packets of
+ * {@link #mtu}-3 bytes are sent in each direction per connection event. Incoming DSPS data are consumed
+ * at {@link #rxRate} and, if {@link #flowControl} is enabled, the peer sends XOFF/XON when the buffered
+ * data cross {@link #xoffThreshold}/{@link #xonThreshold}.
+ * <p> Usage:
+ * <pre>
+ * CodelessSimulatedPeer* peer = [[CodelessSimulatedPeer alloc] init];
+ * CodelessManager* manager = [[CodelessManager alloc] initWithBluetoothManager:CodelessBluetoothManager.instance device:nil transport:peer];
+ * [manager connect];
+ * </pre>
+ * All methods must be called on the main thread. Callbacks are delivered on the main thread.
+ */
+@interface CodelessSimulatedPeer : NSObject <CodelessTransport>
+
+@property (class, readonly) NSString* TAG;
+
+/// A random identifier, unique for each simulated peer.
+@property (readonly, nonatomic) NSUUID* identifier;
+/// The object that receives the GATT operation results (the manager).
+@property (weak, nonatomic, nullable) id<CBPeripheralDelegate> delegate;
+/// The simulated services (available after connection).
+@property (readonly, nullable) NSArray<CBService*>* services;
+
+/// The simulated MTU (default: 247).
+@property int mtu;
+/// The connection interval in ms (default: 30).
+@property int connectionInterval;
+/// The number of packets that can be sent in each direction per connection event (default: 4).
+@property int txCreditLimit;
+/// The rate (bytes/s) at which the peer consumes incoming DSPS data, 0 for unlimited (default: 0).
+@property int rxRate;
+/// <code>true</code> if the peer sends XON/XOFF based on its incoming DSPS data buffer (default: true).
+@property BOOL flowControl;
+/// The buffered incoming DSPS data size (bytes) above which the peer sends XOFF (default: 2048).
+@property int xoffThreshold;
+/// The buffered incoming DSPS data size (bytes) below which the peer sends XON (default: 512).
+@property int xonThreshold;
+/// The RSSI value reported by {@link #readRSSI} (default: -50).
+@property int rssi;
+/// The number of next connection attempts that are not completed, so that the central times out (default: 0).
+/// It is decremented on each ignored attempt. Use a negative value to ignore all attempts.
+@property int ignoredConnections;
+/// Custom command handler, called before the default one.
+@property (copy, nullable) CodelessSimulatedCommandHandler commandHandler;
+/// Receives the DSPS data written by the central.
+@property (copy, nullable) CodelessSimulatedDataHandler dspsDataHandler;
+
+/// <code>true</code> if the peer is connected.
+@property (readonly) BOOL connected;
+/// <code>true</code> if the peer is in binary mode.
+@property (readonly) BOOL binaryMode;
+/// <code>true</code> if the central allows the peer to send DSPS data (XON).
+@property (readonly) BOOL dspsTxFlowOn;
+/// <code>true</code> if the peer allows the central to send DSPS data (XON).
+@property (readonly) BOOL dspsRxFlowOn;
+/// The total DSPS data received from the central (bytes).
+@property (readonly) uint64_t dspsRxBytes;
+/// The total DSPS data sent to the central (bytes).
+@property (readonly) uint64_t dspsTxBytes;
+/// The number of connection events since connection.
+@property (readonly) uint64_t connectionEvents;
+
+/**
+ * Sends a command to the central (peer-initiated command).
+ * <p> The central's response is consumed by the peer.
+ * @param command the command text (for example, <code>AT+BINREQ</code>)
+ */
+- (void) sendCommand:(NSString*)command;
+/**
+ * Sends DSPS data to the central.
+ * <p> The data are split in {@link #mtu}-3 byte packets, sent over the next connection events while the central's flow control is on.
+ * @param data the data to send
+ */
+- (void) sendDspsData:(NSData*)data;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,442 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessSimulatedPeer.h"
+#import "CodelessManager.h"
+#import "CodelessBluetoothManager.h"
+#import "CodelessProfile.h"
+#import "CodelessLibConfig.h"
+#import "CodelessLibEvent.h"
+#import "CodelessLibLog.h"
+
+@interface CodelessSimulatedPeer ()
+
+@property (nonatomic) NSUUID* identifier;
+@property (nullable) NSArray<CBService*>* services;
+@property BOOL connected;
+@property BOOL binaryMode;
+@property BOOL dspsTxFlowOn;
+@property BOOL dspsRxFlowOn;
+@property uint64_t dspsRxBytes;
+@property uint64_t dspsTxBytes;
+@property uint64_t connectionEvents;
+
+@property CBMutableService* codelessService;
+@property CBMutableCharacteristic* codelessInbound;
+@property CBMutableCharacteristic* codelessOutbound;
+@property CBMutableCharacteristic* codelessFlowControl;
+@property CBMutableService* dspsService;
+@property CBMutableCharacteristic* dspsServerTx;
+@property CBMutableCharacteristic* dspsServerRx;
+@property CBMutableCharacteristic* dspsFlowControl;
+
+@property dispatch_source_t connectionTimer;
+/// Callbacks delivered at the next connection event.
+@property NSMutableArray<dispatch_block_t>* pending;
+/// Responses and peer commands waiting to be read from the outbound characteristic.
+@property NSMutableArray<NSString*>* outbound;
+/// Peer-initiated commands waiting for the central's response to the previous one.
+@property NSMutableArray<NSString*>* commandQueue;
+@property BOOL commandPending;
+@property NSMutableData* dspsTxBuffer;
+@property int dspsRxBuffered;
+@property int credits;
+@property BOOL readyPending;
+
+@end
+
+@implementation CodelessSimulatedPeer
+
+static NSString* const TAG = @"CodelessSimulatedPeer";
+
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) init {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.identifier = [NSUUID UUID];
+    self.mtu = 247;
+    self.connectionInterval = 30;
+    self.txCreditLimit = 4;
+    self.rxRate = 0;
+    self.flowControl = true;
+    self.xoffThreshold = 2048;
+    self.xonThreshold = 512;
+    self.rssi = -50;
+    self.pending = [NSMutableArray array];
+    self.outbound = [NSMutableArray array];
+    self.commandQueue = [NSMutableArray array];
+    self.dspsTxBuffer = [NSMutableData data];
+
+    self.codelessInbound = [[CBMutableCharacteristic alloc] initWithType:CodelessProfile.CODELESS_INBOUND_COMMAND_UUID properties:CBCharacteristicPropertyWrite value:nil permissions:CBAttributePermissionsWriteable];
+    self.codelessOutbound = [[CBMutableCharacteristic alloc] initWithType:CodelessProfile.CODELESS_OUTBOUND_COMMAND_UUID properties:CBCharacteristicPropertyRead value:nil permissions:CBAttributePermissionsReadable];
+    self.codelessFlowControl = [[CBMutableCharacteristic alloc] initWithType:CodelessProfile.CODELESS_FLOW_CONTROL_UUID properties:CBCharacteristicPropertyNotify value:nil permissions:CBAttributePermissionsReadable];
+    self.codelessService = [[CBMutableService alloc] initWithType:CodelessProfile.CODELESS_SERVICE_UUID primary:true];
+    self.codelessService.characteristics = @[self.codelessInbound, self.codelessOutbound, self.codelessFlowControl];
+
+    self.dspsServerTx = [[CBMutableCharacteristic alloc] initWithType:CodelessProfile.DSPS_SERVER_TX_UUID properties:CBCharacteristicPropertyNotify value:nil permissions:CBAttributePermissionsReadable];
+    self.dspsServerRx = [[CBMutableCharacteristic alloc] initWithType:CodelessProfile.DSPS_SERVER_RX_UUID properties:CBCharacteristicPropertyWriteWithoutResponse value:nil permissions:CBAttributePermissionsWriteable];
+    self.dspsFlowControl = [[CBMutableCharacteristic alloc] initWithType:CodelessProfile.DSPS_FLOW_CONTROL_UUID properties:CBCharacteristicPropertyNotify | CBCharacteristicPropertyWriteWithoutResponse value:nil permissions:CBAttributePermissionsReadable | CBAttributePermissionsWriteable];
+    self.dspsService = [[CBMutableService alloc] initWithType:CodelessProfile.DSPS_SERVICE_UUID primary:true];
+    self.dspsService.characteristics = @[self.dspsServerTx, self.dspsServerRx, self.dspsFlowControl];
+    return self;
+}
+
+- (void) dealloc {
+    if (self.connectionTimer)
+        dispatch_source_cancel(self.connectionTimer);
+}
+
+- (NSString*) description {
+    return [NSString stringWithFormat:@"SIM-%p", self];
+}
+
+/// The peripheral passed to the delegate (the manager's device, if any).
+- (CBPeripheral*) peripheral {
+    id delegate = self.delegate;
+    return [delegate isKindOfClass:CodelessManager.class] ? ((CodelessManager*) delegate).device : nil;
+}
+
+/// Delivers a callback at the next connection event.
+- (void) post:(dispatch_block_t)block {
+    [self.pending addObject:block];
+}
+
+#pragma mark - Connection
+
+- (void) connect {
+    if (self.connected)
+        return;
+    CodelessLog(TAG, "%@ Connect", self);
+    self.connected = true;
+    self.binaryMode = false;
+    self.dspsTxFlowOn = true;
+    self.dspsRxFlowOn = true;
+    self.dspsRxBuffered = 0;
+    self.dspsRxBytes = 0;
+    self.dspsTxBytes = 0;
+    self.connectionEvents = 0;
+    self.credits = self.txCreditLimit;
+    self.readyPending = false;
+    self.commandPending = false;
+    self.codelessOutbound.value = nil;
+    [self.pending removeAllObjects];
+    [self.outbound removeAllObjects];
+    [self.commandQueue removeAllObjects];
+    [self.dspsTxBuffer setLength:0];
+
+    self.connectionTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+    uint64_t interval = self.connectionInterval * NSEC_PER_MSEC;
+    dispatch_source_set_timer(self.connectionTimer, dispatch_time(DISPATCH_TIME_NOW, interval), interval, 0);
+    __weak CodelessSimulatedPeer* weakSelf = self;
+    dispatch_source_set_event_handler(self.connectionTimer, ^{
+        [weakSelf onConnectionEvent];
+    });
+    dispatch_resume(self.connectionTimer);
+
+    if (self.ignoredConnections) {
+        CodelessLog(TAG, "%@ Ignore connection", self);
+        if (self.ignoredConnections > 0)
+            self.ignoredConnections--;
+        return;
+    }
+    [self post:^{
+        CodelessManager* manager = (CodelessManager*) self.delegate;
+        manager = [manager.bluetoothManager managerForIdentifier:self.identifier];
+        [manager onConnection:[[CodelessDeviceConnectedEvent alloc] initWithManager:manager.bluetoothManager device:manager.device]];
+    }];
+}
+
+- (void) disconnect {
+    if (!self.connected)
+        return;
+    CodelessLog(TAG, "%@ Disconnect", self);
+    self.connected = false;
+    self.services = nil;
+    dispatch_source_cancel(self.connectionTimer);
+    self.connectionTimer = nil;
+    [self.pending removeAllObjects];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        CodelessManager* manager = (CodelessManager*) self.delegate;
+        manager = [manager.bluetoothManager managerForIdentifier:self.identifier];
+        [manager onDisconnection:[[CodelessDeviceDisconnectedEvent alloc] initWithManager:manager.bluetoothManager device:manager.device error:nil]];
+    });
+}
+
+/**
+ * Executes a connection event.
+ * <p> Pending callbacks are delivered, the TX credits are refilled, incoming DSPS data are consumed
+ * and outgoing DSPS data are sent.
+ */
+- (void) onConnectionEvent {
+    self.connectionEvents++;
+    self.credits = self.txCreditLimit;
+
+    NSArray<dispatch_block_t>* pending = self.pending;
+    self.pending = [NSMutableArray array];
+    for (dispatch_block_t block in pending) {
+        if (!self.connected)
+            return;
+        block();
+    }
+
+    if (self.readyPending) {
+        self.readyPending = false;
+        [self.delegate peripheralIsReadyToSendWriteWithoutResponse:self.peripheral];
+        if (!self.connected)
+            return;
+    }
+
+    [self consumeDspsData];
+
+    int packets = self.txCreditLimit;
+    int chunkSize = self.mtu - 3;
+    while (packets-- > 0 && self.dspsTxFlowOn && self.dspsTxBuffer.length && self.connected) {
+        NSUInteger length = MIN(self.dspsTxBuffer.length, chunkSize);
+        NSData* chunk = [self.dspsTxBuffer subdataWithRange:NSMakeRange(0, length)];
+        [self.dspsTxBuffer replaceBytesInRange:NSMakeRange(0, length) withBytes:NULL length:0];
+        self.dspsTxBytes += length;
+        [self notify:self.dspsServerTx value:chunk];
+    }
+}
+
+/// Sends a notification to the central.
+- (void) notify:(CBMutableCharacteristic*)characteristic value:(NSData*)value {
+    characteristic.value = value;
+    [self.delegate peripheral:self.peripheral didUpdateValueForCharacteristic:characteristic error:nil];
+}
+
+/// Sends a notification to the central at the next connection event.
+- (void) postNotify:(CBMutableCharacteristic*)characteristic value:(NSData*)value {
+    __weak CodelessSimulatedPeer* weakSelf = self;
+    [self post:^{
+        [weakSelf notify:characteristic value:value];
+    }];
+}
+
+#pragma mark - CodelessTransport
+
+- (void) discoverServices:(NSArray<CBUUID*>*)serviceUUIDs {
+    [self post:^{
+        self.services = @[self.codelessService, self.dspsService];
+        [self.delegate peripheral:self.peripheral didDiscoverServices:nil];
+    }];
+}
+
+- (void) discoverCharacteristics:(NSArray<CBUUID*>*)characteristicUUIDs forService:(CBService*)service {
+    [self post:^{
+        [self.delegate peripheral:self.peripheral didDiscoverCharacteristicsForService:service error:nil];
+    }];
+}
+
+- (void) setNotifyValue:(BOOL)enabled forCharacteristic:(CBCharacteristic*)characteristic {
+    [self post:^{
+        [self.delegate peripheral:self.peripheral didUpdateNotificationStateForCharacteristic:characteristic error:nil];
+    }];
+}
+
+- (void) readValueForCharacteristic:(CBCharacteristic*)characteristic {
+    [self post:^{
+        if ([characteristic isEqual:self.codelessOutbound]) {
+            NSString* text = self.outbound.firstObject;
+            if (text)
+                [self.outbound removeObjectAtIndex:0];
+            self.codelessOutbound.value = [[text ?: @"" stringByAppendingString:@"\r\n"] dataUsingEncoding:CodelessLibConfig.CHARSET];
+        }
+        [self.delegate peripheral:self.peripheral didUpdateValueForCharacteristic:characteristic error:nil];
+    }];
+}
+
+- (void) writeValue:(NSData*)data forCharacteristic:(CBCharacteristic*)characteristic type:(CBCharacteristicWriteType)type {
+    if ([characteristic isEqual:self.codelessInbound]) {
+        [self onCodelessInbound:data];
+    } else if ([characteristic isEqual:self.dspsServerRx]) {
+        [self onDspsData:data];
+    } else if ([characteristic isEqual:self.dspsFlowControl]) {
+        [self onDspsFlowControl:data];
+    }
+
+    if (type == CBCharacteristicWriteWithResponse) {
+        [self post:^{
+            [self.delegate peripheral:self.peripheral didWriteValueForCharacteristic:characteristic error:nil];
+        }];
+    } else if (--self.credits > 0) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (self.connected)
+                [self.delegate peripheralIsReadyToSendWriteWithoutResponse:self.peripheral];
+        });
+    } else {
+        self.readyPending = true;
+    }
+}
+
+- (NSUInteger) maximumWriteValueLengthForType:(CBCharacteristicWriteType)type {
+    return self.mtu - 3;
+}
+
+- (void) readRSSI {
+    [self post:^{
+        [self.delegate peripheral:self.peripheral didReadRSSI:@(self.rssi) error:nil];
+    }];
+}
+
+#pragma mark - CodeLess
+
+- (void) sendCommand:(NSString*)command {
+    if (self.commandPending) {
+        [self.commandQueue addObject:command];
+        return;
+    }
+    CodelessLogSubsystem(CODELESS_LOG_CODELESS, TAG, "%@ Send command: %@", self, command);
+    self.commandPending = true;
+    [self queueOutbound:command];
+}
+
+/// Queues text to be read by the central and notifies it that data are pending.
+- (void) queueOutbound:(NSString*)text {
+    [self.outbound addObject:text];
+    uint8_t pending = CODELESS_DATA_PENDING;
+    [self postNotify:self.codelessFlowControl value:[NSData dataWithBytes:&pending length:1]];
+}
+
+/// Handles a command or a response written by the central.
+- (void) onCodelessInbound:(NSData*)data {
+    NSString* text = [[NSString alloc] initWithData:data encoding:CodelessLibConfig.CHARSET];
+    text = [text stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"\r\n\0 "]];
+
+    // Response to a peer command
+    if (self.commandPending && ![text.uppercaseString hasPrefix:@"AT"]) {
+        CodelessLogSubsystem(CODELESS_LOG_CODELESS, TAG, "%@ Response: %@", self, text);
+        NSString* last = [text componentsSeparatedByString:@"\n"].lastObject;
+        if ([last hasPrefix:@"OK"] || [last hasPrefix:@"ERROR"]) {
+            self.commandPending = false;
+            if (self.commandQueue.count) {
+                NSString* command = self.commandQueue.firstObject;
+                [self.commandQueue removeObjectAtIndex:0];
+                [self sendCommand:command];
+            }
+        }
+        return;
+    }
+
+    CodelessLogSubsystem(CODELESS_LOG_CODELESS, TAG, "%@ Command: %@", self, text);
+    NSString* response = self.commandHandler ? self.commandHandler(text) : nil;
+    if (!response)
+        response = [self defaultResponse:text];
+    [self queueOutbound:response];
+}
+
+/**
+ * Returns the default response to a command.
+ * <p> Binary mode requests are accepted and acknowledged. Any other command gets an <code>OK</code> response.
+ */
+- (NSString*) defaultResponse:(NSString*)command {
+    NSString* upper = command.uppercaseString;
+    if ([upper isEqualToString:@"AT+BINREQ"]) {
+        self.binaryMode = true;
+        [self postCommand:@"AT+BINREQACK"];
+    } else if ([upper isEqualToString:@"AT+BINREQACK"]) {
+        self.binaryMode = true;
+    } else if ([upper isEqualToString:@"AT+BINEXIT"]) {
+        self.binaryMode = false;
+        [self postCommand:@"AT+BINEXITACK"];
+    } else if ([upper isEqualToString:@"AT+BINEXITACK"]) {
+        self.binaryMode = false;
+    }
+    return @"OK";
+}
+
+/// Sends a peer command at the next connection event, after the current response is queued.
+- (void) postCommand:(NSString*)command {
+    __weak CodelessSimulatedPeer* weakSelf = self;
+    [self post:^{
+        [weakSelf sendCommand:command];
+    }];
+}
+
+#pragma mark - DSPS
+
+- (void) sendDspsData:(NSData*)data {
+    [self.dspsTxBuffer appendData:data];
+}
+
+/// Handles DSPS data written by the central.
+- (void) onDspsData:(NSData*)data {
+    self.dspsRxBytes += data.length;
+    self.dspsRxBuffered += data.length;
+    if (self.dspsDataHandler)
+        self.dspsDataHandler(data);
+    [self updateDspsRxFlowControl];
+}
+
+/// Handles the central's DSPS flow control.
+- (void) onDspsFlowControl:(NSData*)data {
+    if (!data.length)
+        return;
+    uint8_t value = ((uint8_t*)data.bytes)[0];
+    if (value == CODELESS_DSPS_XON || value == CODELESS_DSPS_XOFF)
+        self.dspsTxFlowOn = value == CODELESS_DSPS_XON;
+}
+
+/// Consumes buffered incoming DSPS data at the configured rate.
+- (void) consumeDspsData {
+    if (!self.rxRate)
+        self.dspsRxBuffered = 0;
+    else
+        self.dspsRxBuffered = MAX(0, self.dspsRxBuffered - MAX(1, self.rxRate * self.connectionInterval / 1000));
+    [self updateDspsRxFlowControl];
+}
+
+/// Sends XOFF/XON when the buffered incoming DSPS data cross the thresholds.
+- (void) updateDspsRxFlowControl {
+    if (!self.flowControl)
+        return;
+    BOOL on = self.dspsRxFlowOn;
+    if (on && self.dspsRxBuffered >= self.xoffThreshold)
+        on = false;
+    else if (!on && self.dspsRxBuffered <= self.xonThreshold)
+        on = true;
+    if (on == self.dspsRxFlowOn)
+        return;
+    self.dspsRxFlowOn = on;
+    CodelessLogSubsystem(CODELESS_LOG_DSPS, TAG, "%@ DSPS RX flow control: %@", self, on ? @"ON" : @"OFF");
+    uint8_t value = on ? CODELESS_DSPS_XON : CODELESS_DSPS_XOFF;
+    [self notify:self.dspsFlowControl value:[NSData dataWithBytes:&value length:1]];
+}
+
+@end
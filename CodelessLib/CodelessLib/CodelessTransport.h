@@ -0,0 +1,98 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+#import "CodelessCoreBluetooth.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * GATT transport used by {@link CodelessManager} to communicate with the peer device.
+ *
+ * The transport executes the GATT operations requested by the manager and reports the results
+ * to its {@link #delegate} through the %CBPeripheralDelegate methods.
+ * The method signatures match the ones of %CBPeripheral, which is the default transport.
+ * Other transports, like {@link CodelessSimulatedPeer}, allow the protocol engine (GATT queue, AT command parsing,
+ * DSPS flow control, file send/receive) to run without a Bluetooth device.
+ * @see CodelessManager#transport
+ */
+@protocol CodelessTransport <NSObject>
+
+/// The identifier of the peer device, used by the {@link CodelessBluetoothManager} to route connection events.
+@property (readonly, nonatomic) NSUUID* identifier;
+/// The object that receives the GATT operation results (the manager).
+@property (weak, nonatomic, nullable) id<CBPeripheralDelegate> delegate;
+/// The discovered services.
+@property (readonly, nullable) NSArray<CBService*>* services;
+
+/// Discovers the specified services.
+- (void) discoverServices:(nullable NSArray<CBUUID*>*)serviceUUIDs;
+/// Discovers the characteristics of a service.
+- (void) discoverCharacteristics:(nullable NSArray<CBUUID*>*)characteristicUUIDs forService:(CBService*)service;
+/// Enables or disables notifications for a characteristic.
+- (void) setNotifyValue:(BOOL)enabled forCharacteristic:(CBCharacteristic*)characteristic;
+/// Reads the value of a characteristic.
+- (void) readValueForCharacteristic:(CBCharacteristic*)characteristic;
+/// Writes the value of a characteristic.
+- (void) writeValue:(NSData*)data forCharacteristic:(CBCharacteristic*)characteristic type:(CBCharacteristicWriteType)type;
+/// Returns the maximum amount of data that can be sent in a single write.
+- (NSUInteger) maximumWriteValueLengthForType:(CBCharacteristicWriteType)type;
+/// Reads the RSSI of the connection.
+- (void) readRSSI;
+
+@optional
+/**
+ * Connects to the peer device.
+ * <p> If not implemented, the manager connects through its {@link CodelessBluetoothManager}.
+ * Otherwise, the transport must call {@link CodelessManager#onConnection:} when connected, on the manager
+ * {@link CodelessBluetoothManager#managerForIdentifier: registered} for its {@link #identifier}.
+ */
+- (void) connect;
+/**
+ * Disconnects from the peer device.
+ * <p> If not implemented, the manager disconnects through its {@link CodelessBluetoothManager}.
+ * Otherwise, the transport must call {@link CodelessManager#onDisconnection:} when disconnected, on the manager
+ * {@link CodelessBluetoothManager#managerForIdentifier: registered} for its {@link #identifier}.
+ */
+- (void) disconnect;
+
+@end
+
+
+/// %CBPeripheral is the default {@link CodelessTransport transport}.
+@interface CBPeripheral (CodelessTransport) <CodelessTransport>
+@end
+
+NS_ASSUME_NONNULL_END
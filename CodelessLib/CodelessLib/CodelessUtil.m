@@ -37,7 +37,11 @@
 
 static const char HEX_DIGITS_LC[] = "0123456789abcdef";
 static const char HEX_DIGITS_UC[] = "0123456789ABCDEF";
-static NSDictionary<NSNumber*, NSNumber*>* HEX_DIGITS_MAP;
+// Byte to hex digit pair tables, used to encode a byte with a single 2-byte copy.
+static char HEX_PAIRS_LC[512];
+static char HEX_PAIRS_UC[512];
+// Hex digit to nibble table, -1 for non-hex characters.
+static int8_t HEX_DECODE[256];
 static NSRegularExpression* BLUETOOTH_ADDRESS;
 
 @implementation CodelessUtil
@@ -46,27 +50,49 @@ static NSRegularExpression* BLUETOOTH_ADDRESS;
     if (self != CodelessUtil.class)
         return;
 
-    NSMutableDictionary<NSNumber*, NSNumber*>* hexDigitsMap = [NSMutableDictionary dictionary];
+    memset(HEX_DECODE, -1, sizeof(HEX_DECODE));
     for (int i = 0; i < 16; ++i) {
-        hexDigitsMap[@(HEX_DIGITS_LC[i])] = @(i);
-        hexDigitsMap[@(HEX_DIGITS_UC[i])] = @(i);
+        HEX_DECODE[(uint8_t) HEX_DIGITS_LC[i]] = i;
+        HEX_DECODE[(uint8_t) HEX_DIGITS_UC[i]] = i;
+    }
+    for (int i = 0; i < 256; ++i) {
+        HEX_PAIRS_LC[2 * i] = HEX_DIGITS_LC[i >> 4];
+        HEX_PAIRS_LC[2 * i + 1] = HEX_DIGITS_LC[i & 0x0f];
+        HEX_PAIRS_UC[2 * i] = HEX_DIGITS_UC[i >> 4];
+        HEX_PAIRS_UC[2 * i + 1] = HEX_DIGITS_UC[i & 0x0f];
     }
-    HEX_DIGITS_MAP = [NSDictionary dictionaryWithDictionary:hexDigitsMap];
 
     NSString* pattern = @"^(?:[0-9A-F]{2}:){5}[0-9A-F]{2}$";
     BLUETOOTH_ADDRESS = [NSRegularExpression regularExpressionWithPattern:pattern options:0 error:nil];
 }
 
+/**
+ * Creates a string that takes ownership of a malloc'd ASCII buffer.
+ * <p> The buffer is freed if the string creation fails.
+ */
+static NSString* asciiStringNoCopy(char* buffer, NSUInteger length) {
+    NSString* string = [[NSString alloc] initWithBytesNoCopy:buffer length:length encoding:NSASCIIStringEncoding freeWhenDone:true];
+    if (!string)
+        free(buffer);
+    return string;
+}
+
 + (NSString*) hex:(NSData*)v uppercase:(BOOL)uppercase {
     if (!v)
         return @"<null>";
-    NSString* hexFormat = uppercase ? @"%02X" : @"%02x";
-    NSMutableString* buffer = [NSMutableString stringWithCapacity:v.length * 2];
+    NSUInteger length = v.length;
+    if (!length)
+        return @"";
+    char* buffer = malloc(length * 2);
+    if (!buffer)
+        return nil;
+    const char* pairs = uppercase ? HEX_PAIRS_UC : HEX_PAIRS_LC;
     const uint8_t* b = v.bytes;
-    for (int i = 0; i < v.length; ++i) {
-        [buffer appendFormat:hexFormat, b[i]];
+    char* out = buffer;
+    for (NSUInteger i = 0; i < length; ++i, out += 2) {
+        memcpy(out, pairs + 2 * b[i], 2);
     }
-    return buffer;
+    return asciiStringNoCopy(buffer, length * 2);
 }
 
 + (NSString*) hex:(NSData*)v {
@@ -76,19 +102,29 @@ static NSRegularExpression* BLUETOOTH_ADDRESS;
 + (NSString*) hexArray:(NSData*)v uppercase:(BOOL)uppercase brackets:(BOOL)brackets {
     if (!v)
         return @"[]";
-    NSString* hexFormat = uppercase ? @"%02X " : @"%02x ";
-    NSMutableString* buffer = [NSMutableString stringWithCapacity:v.length * 3 + 3];
-    if (brackets)
-        [buffer appendString:@"[ "];
+    NSUInteger length = v.length;
+    if (!length)
+        return brackets ? @"[ ]" : @"";
+    // "XX " per byte, plus "[ " and "]", or without the trailing space (which is still written to the buffer)
+    NSUInteger capacity = brackets ? length * 3 + 3 : length * 3;
+    NSUInteger size = brackets ? capacity : capacity - 1;
+    char* buffer = malloc(capacity);
+    if (!buffer)
+        return nil;
+    const char* pairs = uppercase ? HEX_PAIRS_UC : HEX_PAIRS_LC;
     const uint8_t* b = v.bytes;
-    for (int i = 0; i < v.length; ++i) {
-        [buffer appendFormat:hexFormat, b[i]];
+    char* out = buffer;
+    if (brackets) {
+        *out++ = '[';
+        *out++ = ' ';
+    }
+    for (NSUInteger i = 0; i < length; ++i, out += 3) {
+        memcpy(out, pairs + 2 * b[i], 2);
+        out[2] = ' ';
     }
     if (brackets)
-        [buffer appendString:@"]"];
-    else if (buffer.length)
-        [buffer deleteCharactersInRange:NSMakeRange(buffer.length - 1, 1)];
-    return buffer;
+        *out = ']';
+    return asciiStringNoCopy(buffer, size);
 }
 
 + (NSString*) hexArray:(NSData*)v {
@@ -100,22 +136,37 @@ static NSRegularExpression* BLUETOOTH_ADDRESS;
 }
 
 + (NSData*) hex2bytes:(NSString*)s {
-    s = [s stringByReplacingOccurrencesOfString:@"0x" withString:@""];
-    NSMutableString* m = s.mutableCopy;
-    NSRegularExpression* pattern = [NSRegularExpression regularExpressionWithPattern:@"[^a-fA-F0-9]" options:NSRegularExpressionCaseInsensitive error:nil];
-    [pattern replaceMatchesInString:m options:0 range:NSMakeRange(0, m.length) withTemplate:@""];
-    s = m;
-    if (s.length % 2 != 0)
+    const char* chars = s.UTF8String;
+    if (!chars)
+        return nil;
+    NSUInteger length = [s lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+    // Upper bound, the actual size is known after non-hex characters are skipped.
+    uint8_t* buffer = malloc(length / 2 + 1);
+    if (!buffer)
         return nil;
-    NSMutableData* data = [NSMutableData dataWithLength:s.length / 2];
-    uint8_t* b = data.mutableBytes;
-    for (int i = 0; i < s.length; ++i) {
-        NSNumber* d = HEX_DIGITS_MAP[@([s characterAtIndex:i])];
-        if (!d)
-            return nil;
-        b[i / 2] |= i % 2 == 0 ? d.unsignedCharValue << 4 : d.unsignedCharValue;
+    NSUInteger count = 0;
+    int high = -1;
+    for (NSUInteger i = 0; i < length; ++i) {
+        uint8_t c = chars[i];
+        if (c == '0' && i + 1 < length && chars[i + 1] == 'x') {
+            ++i;
+            continue;
+        }
+        int d = HEX_DECODE[c];
+        if (d < 0)
+            continue;
+        if (high < 0) {
+            high = d;
+        } else {
+            buffer[count++] = high << 4 | d;
+            high = -1;
+        }
     }
-    return data;
+    if (high >= 0) {
+        free(buffer);
+        return nil;
+    }
+    return [NSData dataWithBytesNoCopy:buffer length:count freeWhenDone:true];
 }
 
 + (BOOL) checkBluetoothAddress:(NSString*)address {
@@ -52,6 +52,7 @@ static const int ID = CODELESS_COMMAND_ID_ADC;
 
 static NSString* PATTERN_STRING = @"^ADC=(\\d+)$"; // <pin>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessAdcReadCommand.class)
@@ -61,6 +62,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid ADC GPIO"],
+    ]];
 }
 
 + (NSString*) COMMAND {
@@ -124,6 +129,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -143,7 +152,7 @@ static NSRegularExpression* PATTERN;
             return;
         }
         self.gpio.state = num;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "ADC: %@ %d", self.gpio.name, self.gpio.state);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "ADC: %@ %d", self.gpio.name, self.gpio.state);
     }
 }
 
@@ -153,14 +162,6 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.AnalogRead object:[[CodelessAnalogReadEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    return [CodelessProfile countArguments:self.command split:@","] == 1;
-}
-
 - (NSString*) parseArguments {
     _gpio = [[CodelessGPIO alloc] init];
     NSNumber* num = [self decodeNumberArgument:1];
@@ -110,7 +110,7 @@ static NSRegularExpression* PATTERN;
         if (self.invalid)
             CodelessLog(TAG, "Received invalid advertising data: %@", response);
         else
-            CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Advertising data: %@", [CodelessUtil hexArrayLog:self.data]);
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Advertising data: %@", [CodelessUtil hexArrayLog:self.data]);
     }
 }
 
@@ -119,7 +119,7 @@ static NSRegularExpression* PATTERN;
     if (self.isValid) {
         if (!self.data) {
             self.data = [NSData data];
-            CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "No advertising data");
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "No advertising data");
         }
         [self sendEvent:CodelessLibEvent.AdvertisingData object:[[CodelessAdvertisingDataEvent alloc] initWithCommand:self]];
     }
@@ -110,7 +110,7 @@ static NSRegularExpression* PATTERN;
         if (self.invalid)
             CodelessLog(TAG, "Received invalid scan response data: %@", response);
         else
-            CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Scan response data: %@", [CodelessUtil hexArrayLog:self.data]);
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Scan response data: %@", [CodelessUtil hexArrayLog:self.data]);
     }
 }
 
@@ -119,7 +119,7 @@ static NSRegularExpression* PATTERN;
     if (self.isValid) {
         if (!self.data) {
             self.data = [NSData data];
-            CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "No response data");
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "No response data");
         }
         [self sendEvent:CodelessLibEvent.ScanResponseData object:[[CodelessScanResponseDataEvent alloc] initWithCommand:self]];
     }
@@ -57,6 +57,7 @@ static const int ID = CODELESS_COMMAND_ID_ADVSTART;
 
 static NSString* PATTERN_STRING = @"^ADVSTART(?:=(\\d+))?$"; // <interval>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessAdvertisingStartCommand.class)
@@ -66,6 +67,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid interval" check:CodelessLibConfig.CHECK_ADVERTISING_INTERVAL min:CodelessLibConfig.ADVERTISING_INTERVAL_MIN max:CodelessLibConfig.ADVERTISING_INTERVAL_MAX],
+    ] counts:@[ @0, @1 ]];
 }
 
 + (NSString*) COMMAND {
@@ -117,23 +122,22 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
-- (NSString*) getArguments {
-    return self.hasArguments ? @(self.interval).stringValue : nil;
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 1;
+- (NSString*) getArguments {
+    return self.hasArguments ? @(self.interval).stringValue : nil;
 }
 
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_ADVERTISING_INTERVAL && (value < CodelessLibConfig.ADVERTISING_INTERVAL_MIN || value > CodelessLibConfig.ADVERTISING_INTERVAL_MAX))
+    if (!num)
         return @"Invalid interval";
     _interval = value;
 
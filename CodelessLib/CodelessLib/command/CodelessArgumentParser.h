@@ -0,0 +1,168 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Maximum number of arguments supported by {@link CodelessArgumentParser}.
+#define CODELESS_ARGUMENTS_MAX 8
+
+/// Command arguments parsed by {@link CodelessArgumentParser}.
+typedef struct {
+    /// The number of arguments.
+    int count;
+    /// The argument values (number arguments).
+    int64_t values[CODELESS_ARGUMENTS_MAX];
+    /// The argument ranges in the command text.
+    NSRange ranges[CODELESS_ARGUMENTS_MAX];
+} CodelessArgumentValues;
+
+/**
+ * Declarative specification of a command argument, used by {@link CodelessArgumentParser}.
+ * <p> The range check is evaluated once, when the specification is created, so that the
+ * {@link CodelessLibConfig} check options do not have to be tested on every parse.
+ */
+@interface CodelessArgumentSpec : NSObject
+
+/// Argument type.
+enum CODELESS_ARGUMENT_TYPE {
+    /// Decimal number (digits only).
+    CODELESS_ARGUMENT_DECIMAL,
+    /// Decimal or hex number (with <code>0x</code> prefix).
+    CODELESS_ARGUMENT_NUMBER,
+    /// Text (any characters except the argument separator).
+    CODELESS_ARGUMENT_TEXT,
+    /// Text that extends to the end of the command (may contain the argument separator).
+    CODELESS_ARGUMENT_TEXT_REST,
+};
+
+/// The argument {@link CODELESS_ARGUMENT_TYPE type}.
+@property (readonly) int type;
+/// The error message if the argument value is out of range.
+@property (readonly) NSString* error;
+/// The maximum number of digits (0 for no limit).
+@property (readonly) int digits;
+/// <code>true</code> if the argument value range is checked.
+@property (readonly) BOOL check;
+/// The minimum argument value.
+@property (readonly) int64_t min;
+/// The maximum argument value.
+@property (readonly) int64_t max;
+
+/**
+ * Creates a decimal number argument.
+ * @param error the error message if the argument value is out of range
+ */
++ (instancetype) decimal:(NSString*)error;
+/**
+ * Creates a decimal number argument with limited number of digits.
+ * @param error     the error message if the argument value is out of range
+ * @param digits    the maximum number of digits
+ */
++ (instancetype) decimal:(NSString*)error digits:(int)digits;
+/**
+ * Creates a decimal number argument with range check.
+ * @param error the error message if the argument value is out of range
+ * @param check <code>true</code> to check the argument value range
+ * @param min   the minimum argument value
+ * @param max   the maximum argument value
+ */
++ (instancetype) decimal:(NSString*)error check:(BOOL)check min:(int64_t)min max:(int64_t)max;
+/**
+ * Creates a decimal or hex number argument.
+ * @param error the error message if the argument value is out of range
+ */
++ (instancetype) number:(NSString*)error;
+/**
+ * Creates a decimal or hex number argument with limited number of hex digits.
+ * @param error     the error message if the argument value is out of range
+ * @param digits    the maximum number of hex digits
+ */
++ (instancetype) number:(NSString*)error hexDigits:(int)digits;
+/**
+ * Creates a decimal or hex number argument with range check.
+ * @param error the error message if the argument value is out of range
+ * @param check <code>true</code> to check the argument value range
+ * @param min   the minimum argument value
+ * @param max   the maximum argument value
+ */
++ (instancetype) number:(NSString*)error check:(BOOL)check min:(int64_t)min max:(int64_t)max;
+/// Creates a text argument.
++ (instancetype) text;
+/// Creates a text argument that extends to the end of the command.
++ (instancetype) textRest;
+
+@end
+
+/**
+ * Single pass command arguments parser, created from a list of {@link CodelessArgumentSpec argument specifications}.
+ *
+ * The parser replaces the regular expression matching, argument counting and number scanning
+ * that is performed by {@link CodelessCommand#parseCommand:} for commands without a parser.
+ * The command text is scanned once, argument values are decoded and range checked in place,
+ * without creating any intermediate objects.
+ * <p> Command subclasses create their parser once and return it from {@link CodelessCommand#argumentParser}.
+ */
+@interface CodelessArgumentParser : NSObject
+
+/// The argument specifications.
+@property (readonly) NSArray<CodelessArgumentSpec*>* arguments;
+
+/**
+ * Creates a parser for a fixed number of arguments.
+ * @param arguments the argument specifications
+ */
+- (instancetype) initWithArguments:(NSArray<CodelessArgumentSpec*>*)arguments;
+/**
+ * Creates a parser.
+ * @param arguments the argument specifications
+ * @param counts    the allowed number of arguments (0 if the arguments are optional)
+ */
+- (instancetype) initWithArguments:(NSArray<CodelessArgumentSpec*>*)arguments counts:(NSArray<NSNumber*>*)counts;
+
+/// Checks if the command requires arguments.
+- (BOOL) requiresArguments;
+/**
+ * Parses the command text arguments.
+ * @param command   the command text (without the AT command prefix)
+ * @param values    the parsed arguments
+ * @return <code>nil</code> if the arguments were parsed successfully, otherwise the parse error message
+ */
+- (nullable NSString*) parse:(NSString*)command values:(CodelessArgumentValues*)values;
+
+@end
+
+NS_ASSUME_NONNULL_END
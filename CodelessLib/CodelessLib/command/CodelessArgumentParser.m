@@ -0,0 +1,260 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessArgumentParser.h"
+#import "CodelessProfile.h"
+
+@interface CodelessArgumentSpec ()
+
+@property int type;
+@property NSString* error;
+@property int digits;
+@property BOOL check;
+@property int64_t min;
+@property int64_t max;
+
+@end
+
+@implementation CodelessArgumentSpec
+
+- (instancetype) initWithType:(int)type error:(NSString*)error {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.type = type;
+    self.error = error;
+    return self;
+}
+
++ (instancetype) decimal:(NSString*)error {
+    return [[CodelessArgumentSpec alloc] initWithType:CODELESS_ARGUMENT_DECIMAL error:error];
+}
+
++ (instancetype) decimal:(NSString*)error digits:(int)digits {
+    CodelessArgumentSpec* spec = [self decimal:error];
+    spec.digits = digits;
+    return spec;
+}
+
++ (instancetype) decimal:(NSString*)error check:(BOOL)check min:(int64_t)min max:(int64_t)max {
+    CodelessArgumentSpec* spec = [self decimal:error];
+    spec.check = check;
+    spec.min = min;
+    spec.max = max;
+    return spec;
+}
+
++ (instancetype) number:(NSString*)error {
+    return [[CodelessArgumentSpec alloc] initWithType:CODELESS_ARGUMENT_NUMBER error:error];
+}
+
++ (instancetype) number:(NSString*)error hexDigits:(int)digits {
+    CodelessArgumentSpec* spec = [self number:error];
+    spec.digits = digits;
+    return spec;
+}
+
++ (instancetype) number:(NSString*)error check:(BOOL)check min:(int64_t)min max:(int64_t)max {
+    CodelessArgumentSpec* spec = [self number:error];
+    spec.check = check;
+    spec.min = min;
+    spec.max = max;
+    return spec;
+}
+
++ (instancetype) text {
+    return [[CodelessArgumentSpec alloc] initWithType:CODELESS_ARGUMENT_TEXT error:CodelessProfile.INVALID_ARGUMENTS];
+}
+
++ (instancetype) textRest {
+    return [[CodelessArgumentSpec alloc] initWithType:CODELESS_ARGUMENT_TEXT_REST error:CodelessProfile.INVALID_ARGUMENTS];
+}
+
+@end
+
+
+/// Argument specification data, used by the parser to avoid message sends in the parsing loop.
+typedef struct {
+    int type;
+    int digits;
+    BOOL check;
+    int64_t min;
+    int64_t max;
+} CodelessArgumentParser_Spec;
+
+@interface CodelessArgumentParser () {
+    CodelessArgumentParser_Spec specs[CODELESS_ARGUMENTS_MAX];
+    int specCount;
+    // Bit mask of allowed argument counts.
+    uint32_t counts;
+}
+
+@property NSArray<CodelessArgumentSpec*>* arguments;
+
+@end
+
+@implementation CodelessArgumentParser
+
+- (instancetype) initWithArguments:(NSArray<CodelessArgumentSpec*>*)arguments {
+    return self = [self initWithArguments:arguments counts:@[ @(arguments.count) ]];
+}
+
+- (instancetype) initWithArguments:(NSArray<CodelessArgumentSpec*>*)arguments counts:(NSArray<NSNumber*>*)counts {
+    self = [super init];
+    if (!self)
+        return nil;
+    NSAssert(arguments.count <= CODELESS_ARGUMENTS_MAX, @"Too many arguments");
+    self.arguments = arguments;
+    specCount = (int) MIN(arguments.count, CODELESS_ARGUMENTS_MAX);
+    for (int i = 0; i < specCount; i++) {
+        CodelessArgumentSpec* spec = arguments[i];
+        specs[i] = (CodelessArgumentParser_Spec) { spec.type, spec.digits, spec.check, spec.min, spec.max };
+    }
+    for (NSNumber* count in counts)
+        self->counts |= 1u << count.intValue;
+    return self;
+}
+
+- (BOOL) requiresArguments {
+    return !(counts & 1);
+}
+
+static inline int hexDigit(unichar c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * Decodes a number argument.
+ * @return <code>false</code> if the argument text is not a valid number
+ */
+static BOOL parseNumber(const unichar* text, NSUInteger length, const CodelessArgumentParser_Spec* spec, int64_t* value) {
+    if (!length)
+        return false;
+    if (spec->type == CODELESS_ARGUMENT_NUMBER && length > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        if (spec->digits && length - 2 > spec->digits)
+            return false;
+        uint64_t number = 0;
+        for (NSUInteger i = 2; i < length; i++) {
+            int digit = hexDigit(text[i]);
+            if (digit < 0)
+                return false;
+            // Saturate like NSScanner
+            number = number <= UINT32_MAX ? number << 4 | digit : number;
+        }
+        *value = MIN(number, UINT32_MAX);
+        return true;
+    }
+    if (spec->type == CODELESS_ARGUMENT_DECIMAL && spec->digits && length > spec->digits)
+        return false;
+    int64_t number = 0;
+    for (NSUInteger i = 0; i < length; i++) {
+        if (text[i] < '0' || text[i] > '9')
+            return false;
+        // Saturate like NSScanner
+        number = number <= INT32_MAX ? number * 10 + (text[i] - '0') : number;
+    }
+    *value = MIN(number, INT32_MAX);
+    return true;
+}
+
+- (NSString*) parse:(NSString*)command values:(CodelessArgumentValues*)values {
+    values->count = 0;
+    NSUInteger length = command.length;
+    unichar buffer[128];
+    unichar* text = length <= 128 ? buffer : malloc(length * sizeof(unichar));
+    [command getCharacters:text range:NSMakeRange(0, length)];
+
+    NSUInteger position = 0;
+    while (position < length && text[position] != '=')
+        position++;
+
+    int count = 0;
+    BOOL invalid = false;
+    NSString* error = nil;
+    if (position < length) {
+        NSUInteger start = ++position;
+        while (true) {
+            const CodelessArgumentParser_Spec* spec = count < specCount ? &specs[count] : NULL;
+            if (!spec || spec->type != CODELESS_ARGUMENT_TEXT_REST) {
+                while (position < length && text[position] != ',')
+                    position++;
+            } else {
+                position = length;
+            }
+            if (count < CODELESS_ARGUMENTS_MAX) {
+                values->ranges[count] = NSMakeRange(start, position - start);
+                values->values[count] = 0;
+            }
+            if (spec && !invalid) {
+                if (spec->type == CODELESS_ARGUMENT_DECIMAL || spec->type == CODELESS_ARGUMENT_NUMBER) {
+                    int64_t value;
+                    if (!parseNumber(text + start, position - start, spec, &value)) {
+                        invalid = true;
+                    } else {
+                        values->values[count] = value;
+                        if (!error && spec->check && (value < spec->min || value > spec->max))
+                            error = self.arguments[count].error;
+                    }
+                } else if (spec->type == CODELESS_ARGUMENT_TEXT && position == start) {
+                    invalid = true;
+                }
+            }
+            count++;
+            if (position >= length)
+                break;
+            start = ++position;
+        }
+    }
+
+    if (text != buffer)
+        free(text);
+    values->count = MIN(count, CODELESS_ARGUMENTS_MAX);
+
+    if (!count && [self requiresArguments])
+        return CodelessProfile.NO_ARGUMENTS;
+    if (count >= 32 || !(counts & 1u << count))
+        return CodelessProfile.WRONG_NUMBER_OF_ARGUMENTS;
+    if (invalid)
+        return CodelessProfile.INVALID_ARGUMENTS;
+    return error;
+}
+
+@end
@@ -104,7 +104,7 @@ static NSRegularExpression* PATTERN;
 
 - (void) onSuccess {
     [super onSuccess];
-    CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "OK");
+    CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "OK");
     [self sendEvent:CodelessLibEvent.Ping object:[[CodelessPingEvent alloc] initWithCommand:self]];
 }
 
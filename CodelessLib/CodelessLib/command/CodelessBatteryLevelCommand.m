@@ -33,7 +33,9 @@
  **********************************************************************************
  */
 
+#if __has_include(<UIKit/UIKit.h>)
 #import <UIKit/UIKit.h>
+#endif
 #import "CodelessBatteryLevelCommand.h"
 #import "CodelessProfile.h"
 #import "CodelessLibEvent.h"
@@ -122,7 +124,7 @@ static NSRegularExpression* PATTERN;
             return;
         }
         self.level = num;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Battery level: %d", self.level);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Battery level: %d", self.level);
     }
 }
 
@@ -136,7 +138,7 @@ static NSRegularExpression* PATTERN;
     if (self.level == -1)
         self.level = [self getBatteryLevel];
     if (self.level != -1) {
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Send battery level: %d", self.level);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Send battery level: %d", self.level);
         [self sendSuccess:@(self.level).stringValue];
     } else {
         CodelessLog(TAG, "Failed to retrieve battery level");
@@ -144,13 +146,17 @@ static NSRegularExpression* PATTERN;
     }
 }
 
-/// Returns the host device battery level.
+/// Returns the host device battery level, or -1 if it is not available (for example, on platforms without UIKit).
 - (int) getBatteryLevel {
+#if __has_include(<UIKit/UIKit.h>)
     BOOL batteryMonitoring = UIDevice.currentDevice.isBatteryMonitoringEnabled;
     UIDevice.currentDevice.batteryMonitoringEnabled = YES;
     int level = UIDevice.currentDevice.batteryState != UIDeviceBatteryStateUnknown ? (int) (UIDevice.currentDevice.batteryLevel * 100) : -1;
     UIDevice.currentDevice.batteryMonitoringEnabled = batteryMonitoring;
     return level;
+#else
+    return -1;
+#endif
 }
 
 @end
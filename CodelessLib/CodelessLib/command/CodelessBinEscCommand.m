@@ -58,6 +58,7 @@ static const int ID = CODELESS_COMMAND_ID_BINESC;
 
 static NSString* PATTERN_STRING = @"^BINESC(?:=(\\d+),(0[xX][0-9a-fA-F]{1,6}|\\d+),(\\d+))?$"; // <time_prior> <seq> <time_after>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 static NSString* RESPONSE_PATTERN_STRING = @"^(\\d+).([0-9a-fA-F]{1,6}).(\\d+)$"; // <time_prior> <seq> <time_after>
 static NSRegularExpression* RESPONSE_PATTERN;
@@ -71,6 +72,12 @@ static NSRegularExpression* RESPONSE_PATTERN;
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
     RESPONSE_PATTERN = [NSRegularExpression regularExpressionWithPattern:RESPONSE_PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid escape time prior" check:true min:0 max:0xffff],
+            [CodelessArgumentSpec number:@"Invalid escape sequence" check:true min:0 max:0xffffff],
+            [CodelessArgumentSpec decimal:@"Invalid escape time after" check:true min:0 max:0xffff],
+    ] counts:@[ @0, @3 ]];
 }
 
 + (NSString*) COMMAND {
@@ -136,6 +143,10 @@ static NSRegularExpression* RESPONSE_PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? [NSString stringWithFormat:@"%d,%#x,%d", self.timePrior, self.sequence, self.timeAfter] : nil;
 }
@@ -173,7 +184,7 @@ static NSRegularExpression* RESPONSE_PATTERN;
         if (self.invalid)
             CodelessLog(TAG, @"Received invalid escape parameters: %@", response);
         else
-            CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Escape sequence: %#x (\"%@\") time=%d,%d", self.sequence, [self getSequenceString], self.timePrior, self.timeAfter);
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Escape sequence: %#x (\"%@\") time=%d,%d", self.sequence, [self getSequenceString], self.timePrior, self.timeAfter);
     }
 }
 
@@ -183,31 +194,26 @@ static NSRegularExpression* RESPONSE_PATTERN;
         [self sendEvent:CodelessLibEvent.BinEsc object:[[CodelessBinEscEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 3;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
     NSNumber* num = [self decodeNumberArgument:1];
     uint32_t value = num.unsignedShortValue;
-    if (!num || value > 0xffff)
+    if (!num)
         return @"Invalid escape time prior";
     _timePrior = value;
 
     num = [self decodeNumberArgument:2];
     value = num.unsignedIntValue;
-    if (!num || value > 0xffffff)
+    if (!num)
         return @"Invalid escape sequence";
     _sequence = value;
 
     num = [self decodeNumberArgument:3];
     value = num.unsignedShortValue;
-    if (!num || value > 0xffff)
+    if (!num)
         return @"Invalid escape time after";
     _timeAfter = value;
 
@@ -37,6 +37,7 @@
 #import "CodelessManager.h"
 #import "CodelessProfile.h"
 #import "CodelessLibLog.h"
+#import "CodelessLibConfig.h"
 
 @implementation CodelessBinRequestCommand
 
@@ -102,6 +103,12 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (NSTimeInterval) timeout {
+    // The peer device may respond after it has processed its pending data.
+    NSTimeInterval timeout = super.timeout;
+    return timeout ? MAX(timeout, CodelessLibConfig.COMMAND_TIMEOUT_LONG / 1000.) : 0;
+}
+
 - (void) onSuccess {
     [super onSuccess];
     CodelessLog(TAG, "Binary mode request");
@@ -127,7 +127,7 @@ static NSRegularExpression* RESPONSE_PATTERN;
                 self.random = [[response substringWithRange:[matcher rangeAtIndex:2]] isEqualToString:@"R"];
                 log = [log stringByAppendingString:self.random ? @" (random)" : @" (public)"];
             }
-            CodelessLogOpt(CodelessLibLog.COMMAND, TAG, @"%@", log);
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, @"%@", log);
         } else {
             CodelessLog(TAG, "Received invalid BD address: %@", response);
             self.invalid = true;
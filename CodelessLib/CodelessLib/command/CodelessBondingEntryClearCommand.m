@@ -51,6 +51,7 @@ static const int ID = CODELESS_COMMAND_ID_CLRBNDE;
 
 static NSString* PATTERN_STRING = @"^CLRBNDE=(0x[0-9a-fA-F]+|\\d+)$"; // <index>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessBondingEntryClearCommand.class)
@@ -60,6 +61,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec number:@"Invalid bonding database index"],
+    ]];
 }
 
 + (NSString*) COMMAND {
@@ -110,6 +115,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -124,14 +133,6 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.BondingEntryClear object:[[CodelessBondingEntryClearEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    return [CodelessProfile countArguments:self.command split:@","] == 1;
-}
-
 - (NSString*) parseArguments {
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
@@ -59,6 +59,7 @@ static const int ID = CODELESS_COMMAND_ID_CHGBNDP;
 
 static NSString* PATTERN_STRING = @"^CHGBNDP(?:=(0x[0-9a-fA-F]+|\\d+),(\\d))?$"; // <index> <status>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessBondingEntryStatusCommand.class)
@@ -68,6 +69,11 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec number:@"Invalid bonding database index"],
+            [CodelessArgumentSpec decimal:@"Invalid bonding entry persistent status" digits:1],
+    ] counts:@[ @0, @2 ]];
 }
 
 + (NSString*) COMMAND {
@@ -120,6 +126,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? [NSString stringWithFormat:@"%d,%d", self.index, (self.persistent ? CODELESS_COMMAND_BONDING_ENTRY_PERSISTENT : CODELESS_COMMAND_BONDING_ENTRY_NON_PERSISTENT)] : nil;
 }
@@ -174,13 +184,8 @@ static NSRegularExpression* PATTERN;
     }
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 2;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
@@ -53,6 +53,7 @@ static const int ID = CODELESS_COMMAND_ID_IEBNDE;
 
 static NSString* PATTERN_STRING = @"^IEBNDE=(\\d+)(?:,([0-9a-fA-F]{54};[0-9a-fA-F]{50};[0-9a-fA-F]{32};[0-9a-fA-F]{2};[0-9a-fA-F]{8}))?$"; // <index> <entry>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 static NSString* ENTRY_ARGUMENT_PATTERN_STRING = @"^[0-9a-fA-F]{54};[0-9a-fA-F]{50};[0-9a-fA-F]{32};[0-9a-fA-F]{2};[0-9a-fA-F]{8}$";
 static NSRegularExpression* ENTRY_ARGUMENT_PATTERN;
@@ -66,6 +67,11 @@ static NSRegularExpression* ENTRY_ARGUMENT_PATTERN;
     NSError* patternError = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&patternError];
 
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid bonding database index" check:CodelessLibConfig.CHECK_BONDING_DATABASE_INDEX min:CodelessLibConfig.BONDING_DATABASE_INDEX_MIN max:CodelessLibConfig.BONDING_DATABASE_INDEX_MAX],
+            [CodelessArgumentSpec text],
+    ] counts:@[ @1, @2 ]];
+
     NSError* argumentPatternError = nil;
     ENTRY_ARGUMENT_PATTERN = [NSRegularExpression regularExpressionWithPattern:ENTRY_ARGUMENT_PATTERN_STRING options:0 error:&argumentPatternError];
 }
@@ -148,6 +154,10 @@ static NSRegularExpression* ENTRY_ARGUMENT_PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -170,7 +180,7 @@ static NSRegularExpression* ENTRY_ARGUMENT_PATTERN;
         if (self.invalid)
             CodelessLog(TAG, "Received invalid bonding entry: %@", response);
         else
-            CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Bonding entry: LTK:%@ EDIV:%04X(%d) Rand:%@ Key size:%02X(%d) CSRK:%@ Bluetooth address:%@ Address type:%02X(%d) Authentication level:%02X(%d) Bonding database slot:%02X(%d) IRK:%@ Persistence status:%02X(%d) Timestamp:%@",
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Bonding entry: LTK:%@ EDIV:%04X(%d) Rand:%@ Key size:%02X(%d) CSRK:%@ Bluetooth address:%@ Address type:%02X(%d) Authentication level:%02X(%d) Bonding database slot:%02X(%d) IRK:%@ Persistence status:%02X(%d) Timestamp:%@",
                            [CodelessUtil hexArray:self.bondingEntry.ltk], self.bondingEntry.ediv, self.bondingEntry.ediv, [CodelessUtil hexArray:self.bondingEntry.rand], self.bondingEntry.keySize, self.bondingEntry.keySize, [CodelessUtil hexArray:self.bondingEntry.csrk], [CodelessUtil hexArray:self.bondingEntry.bluetoothAddress], self.bondingEntry.addressType, self.bondingEntry.addressType,
                            self.bondingEntry.authenticationLevel, self.bondingEntry.authenticationLevel, self.bondingEntry.bondingDatabaseSlot, self.bondingEntry.bondingDatabaseSlot, [CodelessUtil hexArray:self.bondingEntry.irk], self.bondingEntry.persistenceStatus, self.bondingEntry.persistenceStatus, [CodelessUtil hexArray:self.bondingEntry.timestamp]);
     }
@@ -182,25 +192,16 @@ static NSRegularExpression* ENTRY_ARGUMENT_PATTERN;
         [self sendEvent:CodelessLibEvent.BondingEntry object:[[CodelessBondingEntryEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 1 || count == 2;
-}
-
 - (NSString*) parseArguments {
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_BONDING_DATABASE_INDEX && (value < CodelessLibConfig.BONDING_DATABASE_INDEX_MIN || value > CodelessLibConfig.BONDING_DATABASE_INDEX_MAX))
+    if (!num)
         return @"Invalid bonding database index";
     _index = value;
 
-    if ([CodelessProfile countArguments:self.command split:@","] == 1)
+    if (self.argumentCount == 1)
         return nil;
-    NSString* entry = [self.command substringWithRange:[self.matcher rangeAtIndex:2]];
+    NSString* entry = [self decodeTextArgument:2];
     if ([CodelessBondingEntryTransferCommand validData:entry]) {
         _entry = entry;
         [self parseEntry:entry];
@@ -52,6 +52,7 @@ static const int ID = CODELESS_COMMAND_ID_CMD;
 
 static NSString* PATTERN_STRING = @"^CMD=(\\d+)$"; // <index>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessCmdGetCommand.class)
@@ -61,6 +62,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid index" check:CodelessLibConfig.CHECK_COMMAND_STORE_INDEX min:CodelessLibConfig.COMMAND_STORE_INDEX_MIN max:CodelessLibConfig.COMMAND_STORE_INDEX_MAX],
+    ]];
 }
 
 + (NSString*) COMMAND {
@@ -119,6 +124,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -143,18 +152,10 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.StoredCommands object:[[CodelessStoredCommandsEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    return [CodelessProfile countArguments:self.command split:@","] == 1;
-}
-
 - (NSString*) parseArguments {
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_COMMAND_STORE_INDEX && (value < CodelessLibConfig.COMMAND_STORE_INDEX_MIN || value > CodelessLibConfig.COMMAND_STORE_INDEX_MAX))
+    if (!num)
         return @"Invalid index";
     _index = value;
     return nil;
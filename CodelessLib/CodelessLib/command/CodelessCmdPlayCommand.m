@@ -50,6 +50,7 @@ static const int ID = CODELESS_COMMAND_ID_CMDPLAY;
 
 static NSString* PATTERN_STRING = @"^CMDPLAY=(\\d+)$"; // <index>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessCmdPlayCommand.class)
@@ -59,6 +60,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid index" check:CodelessLibConfig.CHECK_COMMAND_STORE_INDEX min:CodelessLibConfig.COMMAND_STORE_INDEX_MIN max:CodelessLibConfig.COMMAND_STORE_INDEX_MAX],
+    ]];
 }
 
 + (NSString*) COMMAND {
@@ -109,26 +114,28 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
-- (BOOL) hasArguments {
-    return true;
+- (NSTimeInterval) timeout {
+    // The stored commands may take a long time to complete.
+    NSTimeInterval timeout = super.timeout;
+    return timeout ? MAX(timeout, CodelessLibConfig.COMMAND_TIMEOUT_LONG / 1000.) : 0;
 }
 
-- (NSString*) getArguments {
-    return @(self.index).stringValue;
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
 }
 
-- (BOOL) requiresArguments {
+- (BOOL) hasArguments {
     return true;
 }
 
-- (BOOL) checkArgumentsCount {
-    return [CodelessProfile countArguments:self.command split:@","] == 1;
+- (NSString*) getArguments {
+    return @(self.index).stringValue;
 }
 
 - (NSString*) parseArguments {
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_COMMAND_STORE_INDEX && (value < CodelessLibConfig.COMMAND_STORE_INDEX_MIN || value > CodelessLibConfig.COMMAND_STORE_INDEX_MAX))
+    if (!num)
         return @"Invalid index";
     _index = value;
     return nil;
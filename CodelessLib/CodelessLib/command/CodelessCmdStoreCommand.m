@@ -171,7 +171,7 @@ static NSRegularExpression* PATTERN;
     NSMutableArray<CodelessCommand*>* commandList = [NSMutableArray array];
     for (NSString* command in commandArray) {
         if (command.length)
-            [commandList addObject:[self.manager parseTextCommand:command]];
+            [commandList addObject:self.manager ? [self.manager parseTextCommand:command] : [CodelessProfile createTextCommand:[CodelessProfile normalizeTextCommand:command] manager:nil]];
     }
     return commandList;
 }
@@ -34,6 +34,7 @@
  */
 
 #import <Foundation/Foundation.h>
+#import "CodelessArgumentParser.h"
 
 @class CodelessManager;
 @class CodelessScript;
@@ -56,7 +57,7 @@ NS_ASSUME_NONNULL_BEGIN
  * Required properties: {@link #TAG}, {@link #ID}, {@link #name}, {@link #commandID}, {@link #pattern}
  * </li>
  * <li>
- * Parsing methods: {@link #requiresArguments}, {@link #checkArgumentsCount}, {@link #parseArguments}
+ * Parsing methods: {@link #argumentParser} or {@link #requiresArguments}, {@link #checkArgumentsCount}, then {@link #parseArguments}
  * </li>
  * <li>
  * Outgoing commands: {@link #hasArguments}, {@link #getArguments}, {@link #parseResponse:}, {@link #onSuccess}, {@link #onError:}
@@ -81,6 +82,33 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @interface CodelessCommand : NSObject
 
+/**
+ * Processing stages of an outgoing command.
+ * <p> The time each stage is reached is recorded, if {@link CodelessLibConfig#COMMAND_STATS statistics} are enabled.
+ * @see CodelessManager#commandStageLatency
+ */
+enum CODELESS_COMMAND_STAGE {
+    /// The command object was created.
+    CODELESS_COMMAND_STAGE_CREATED,
+    /// The command was passed to the manager to be sent.
+    CODELESS_COMMAND_STAGE_QUEUED,
+    /// The command was dequeued for execution.
+    CODELESS_COMMAND_STAGE_EXECUTE,
+    /// The command text was packed and enqueued in the GATT operation queue.
+    CODELESS_COMMAND_STAGE_SENT,
+    /// The write to the CodeLess Inbound characteristic was started.
+    CODELESS_COMMAND_STAGE_GATT_WRITE,
+    /// The write to the CodeLess Inbound characteristic was completed.
+    CODELESS_COMMAND_STAGE_WRITTEN,
+    /// The peer device signaled pending data through the CodeLess Flow Control characteristic.
+    CODELESS_COMMAND_STAGE_PENDING,
+    /// The response was read from the CodeLess Outbound characteristic.
+    CODELESS_COMMAND_STAGE_READ,
+    /// The final response was parsed.
+    CODELESS_COMMAND_STAGE_COMPLETE,
+    CODELESS_COMMAND_STAGE_COUNT
+};
+
 @property (class, readonly) NSString* TAG;
 
 /// The associated manager.
@@ -111,6 +139,8 @@ NS_ASSUME_NONNULL_BEGIN
 @property NSString* error;
 /// The error code (if the sent or received command failed).
 @property int errorCode;
+/// The time the command was sent to the peer device (monotonic clock, 0 if not sent).
+@property NSTimeInterval sendTime;
 
 /**
  * Creates a CodelessCommand object without arguments.
@@ -125,6 +155,16 @@ NS_ASSUME_NONNULL_BEGIN
  * @param parse     <code>true</code> to parse the command text
  */
 - (instancetype) initWithManager:(CodelessManager*)manager command:(NSString*)command parse:(BOOL)parse;
+/**
+ * Creates a CodelessCommand object from an already parsed command of the same class.
+ *
+ * The command text is not validated and matched again. The parse result is copied
+ * and the arguments are extracted from the existing {@link #matcher}.
+ * Used to instantiate {@link CodelessCompiledScript compiled scripts}.
+ * @param manager   the associated manager
+ * @param command   the parsed command to copy
+ */
+- (instancetype) initWithManager:(CodelessManager*)manager parsedCommand:(CodelessCommand*)command;
 
 /// Sets the object that created the command.
 - (CodelessCommand*) origin:(NSObject*)origin;
@@ -140,6 +180,25 @@ NS_ASSUME_NONNULL_BEGIN
 - (void) setComplete;
 /// Checks if the command has failed.
 - (BOOL) failed;
+/**
+ * Records the time the command reached a processing stage, if not already recorded.
+ * @param stage the {@link CODELESS_COMMAND_STAGE stage}
+ */
+- (void) markStage:(int)stage;
+/**
+ * Returns the time the command reached a processing stage.
+ * @param stage the {@link CODELESS_COMMAND_STAGE stage}
+ * @return the time (monotonic clock), or 0 if the stage was not reached
+ */
+- (NSTimeInterval) stageTime:(int)stage;
+/**
+ * Returns the time to wait for the peer device response, after the command is sent.
+ * <p> If it expires, the command fails and the next command is sent.
+ * Subclasses may override it for commands that take longer to complete.
+ * @return the timeout (seconds), 0 for no timeout
+ * @see CodelessLibConfig#COMMAND_TIMEOUT
+ */
+- (NSTimeInterval) timeout;
 
 /// Returns the command log tag.
 - (NSString*) TAG;
@@ -205,10 +264,18 @@ NS_ASSUME_NONNULL_BEGIN
  * Then it checks if the number of arguments is {@link #checkArgumentsCount correct}.
  * After that, it uses the command {@link #pattern} to match the command text.
  * If the matching is successful, it {@link #parseArguments parses} the arguments.
+ * <p> If the command provides an {@link #argumentParser argument parser}, it is used instead of the
+ * above checks and the pattern matching. The arguments are parsed and range checked in a single pass.
  * @param command the command text
  * @return <code>nil</code> if the command was parsed successfully, otherwise the parse error message
  */
 - (NSString*) parseCommand:(NSString*)command;
+/**
+ * Returns the command arguments parser (used for {@link #parseCommand: parsing}).
+ * <p> Subclasses should create the parser once and return the same object.
+ * @return the parser, or <code>nil</code> to use the command {@link #pattern}
+ */
+- (nullable CodelessArgumentParser*) argumentParser;
 /// Checks if the command requires arguments (used for {@link #parseCommand: parsing}).
 - (BOOL) requiresArguments;
 /// Checks if the number of arguments is correct (used for {@link #parseCommand: parsing}).
@@ -218,6 +285,8 @@ NS_ASSUME_NONNULL_BEGIN
  *
  * The {@link #matcher} can be used to extract the arguments from the parsed text,
  * by using capturing groups defined in the command {@link #pattern}.
+ * The {@link #decodeNumberArgument:} and {@link #decodeTextArgument:} methods work with both
+ * the pattern and the {@link #argumentParser}.
  * @return <code>nil</code> if the arguments were parsed successfully, otherwise the parse error message
  */
 - (NSString*) parseArguments;
@@ -253,10 +322,17 @@ NS_ASSUME_NONNULL_BEGIN
 - (void) sendResponse:(NSString*)response more:(BOOL)more;
 
 /**
- * Decodes a number argument from a capturing group in {@link #matcher}.
- * @param group the capturing group index
+ * Decodes a number argument from a capturing group in {@link #matcher}, or from the parsed arguments.
+ * @param group the capturing group index, or the argument index (1-based)
+ */
+- (nullable NSNumber*) decodeNumberArgument:(int)group;
+/**
+ * Returns the text of an argument from a capturing group in {@link #matcher}, or from the parsed arguments.
+ * @param group the capturing group index, or the argument index (1-based)
  */
-- (NSNumber*) decodeNumberArgument:(int)group;
+- (nullable NSString*) decodeTextArgument:(int)group;
+/// Returns the number of arguments in the parsed command text.
+- (int) argumentCount;
 /// Generates a command event.
 - (void) sendEvent:(NSString*)event object:(CodelessCommandEvent*)object;
 
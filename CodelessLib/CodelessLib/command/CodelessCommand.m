@@ -39,6 +39,13 @@
 #import "CodelessScript.h"
 #import "CodelessProfile.h"
 #import "CodelessLibEvent.h"
+#import "CodelessLibConfig.h"
+
+@interface CodelessCommand () {
+    CodelessArgumentValues argumentValues;
+    NSTimeInterval stageTimes[CODELESS_COMMAND_STAGE_COUNT];
+}
+@end
 
 @implementation CodelessCommand
 
@@ -52,6 +59,8 @@ static NSString* const TAG = @"CodelessCommand";
     if (!self)
         return nil;
     self.response = [NSMutableArray array];
+    if (CodelessLibConfig.COMMAND_STATS)
+        [self markStage:CODELESS_COMMAND_STAGE_CREATED];
     return self;
 }
 
@@ -73,6 +82,21 @@ static NSString* const TAG = @"CodelessCommand";
     return self;
 }
 
+- (instancetype) initWithManager:(CodelessManager*)manager parsedCommand:(CodelessCommand*)command {
+    self = [self initWithManager:manager command:command.command parse:false];
+    if (!self)
+        return nil;
+    self.prefix = command.prefix;
+    self.parsed = command.parsed;
+    self.invalid = command.invalid;
+    self.error = command.error;
+    self.matcher = command.matcher;
+    argumentValues = command->argumentValues;
+    if (self.parsed && !self.invalid && (self.matcher || self.argumentParser))
+        [self parseArguments];
+    return self;
+}
+
 - (CodelessCommand*) origin:(NSObject*)origin {
     _origin = origin;
     return self;
@@ -102,6 +126,19 @@ static NSString* const TAG = @"CodelessCommand";
     return self.error != nil;
 }
 
+- (void) markStage:(int)stage {
+    if (!stageTimes[stage])
+        stageTimes[stage] = NSProcessInfo.processInfo.systemUptime;
+}
+
+- (NSTimeInterval) stageTime:(int)stage {
+    return stageTimes[stage];
+}
+
+- (NSTimeInterval) timeout {
+    return CodelessLibConfig.COMMAND_TIMEOUT / 1000.;
+}
+
 - (NSString*) TAG {
     return TAG;
 }
@@ -128,7 +165,7 @@ static NSString* const TAG = @"CodelessCommand";
 
 - (void) parseResponse:(NSString*)response {
     [self.response addObject:response];
-    CodelessLogOpt(CodelessLibLog.COMMAND, self.TAG, "Response: %@", response);
+    CodelessLogSubsystem(CODELESS_LOG_COMMAND, self.TAG, "Response: %@", response);
 }
 
 - (int) responseLine {
@@ -136,7 +173,7 @@ static NSString* const TAG = @"CodelessCommand";
 }
 
 - (void) onSuccess {
-    CodelessLogOpt(CodelessLibLog.COMMAND, self.TAG, "Command succeeded");
+    CodelessLogSubsystem(CODELESS_LOG_COMMAND, self.TAG, "Command succeeded");
     self.complete = true;
     [self sendEvent:CodelessLibEvent.CommandSuccess object:[[CodelessCommandSuccessEvent alloc] initWithCommand:self]];
     if (self.script)
@@ -144,7 +181,7 @@ static NSString* const TAG = @"CodelessCommand";
 }
 
 - (void) onError:(NSString*)msg {
-    CodelessLogOpt(CodelessLibLog.COMMAND, self.TAG, "Command failed: %@", msg);
+    CodelessLogSubsystem(CODELESS_LOG_COMMAND, self.TAG, "Command failed: %@", msg);
     if (!self.error)
         self.error = msg;
     self.complete = true;
@@ -159,10 +196,23 @@ static NSString* const TAG = @"CodelessCommand";
 }
 
 - (NSString*) parseCommand:(NSString*)command {
-    CodelessLogOpt(CodelessLibLog.COMMAND, self.TAG, "Parse command: %@", command);
+    CodelessLogSubsystem(CODELESS_LOG_COMMAND, self.TAG, "Parse command: %@", command);
     self.command = command;
     self.parsed = true;
 
+    CodelessArgumentParser* parser = self.argumentParser;
+    if (parser) {
+        NSString* msg = [parser parse:command values:&argumentValues];
+        if (!msg)
+            msg = [self parseArguments];
+        if (msg) {
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, self.TAG, "Invalid arguments: %@", msg);
+            self.error = msg;
+            self.invalid = true;
+        }
+        return msg;
+    }
+
     if (!self.pattern) {
         CodelessLog(self.TAG, "No command pattern");
         self.invalid = true;
@@ -170,35 +220,39 @@ static NSString* const TAG = @"CodelessCommand";
     }
 
     if (self.requiresArguments && ![CodelessProfile hasArguments:command]) {
-        CodelessLogOpt(CodelessLibLog.COMMAND, self.TAG, "No arguments");
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, self.TAG, "No arguments");
         self.invalid = true;
         return self.error = CodelessProfile.NO_ARGUMENTS;
     }
 
     if (![self checkArgumentsCount]) {
-        CodelessLogOpt(CodelessLibLog.COMMAND, self.TAG, "Wrong number of arguments");
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, self.TAG, "Wrong number of arguments");
         self.invalid = true;
         return self.error = CodelessProfile.WRONG_NUMBER_OF_ARGUMENTS;
     }
 
     self.matcher = [self.pattern firstMatchInString:command options:0 range:NSMakeRange(0, command.length)];
     if (!self.matcher) {
-        CodelessLogOpt(CodelessLibLog.COMMAND, self.TAG, "Command pattern match failed");
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, self.TAG, "Command pattern match failed");
         self.invalid = true;
         return self.error = CodelessProfile.INVALID_ARGUMENTS;
     }
 
     NSString* msg = [self parseArguments];
     if (msg) {
-        CodelessLogOpt(CodelessLibLog.COMMAND, self.TAG, "Invalid arguments: %@", msg);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, self.TAG, "Invalid arguments: %@", msg);
         self.error = msg;
         self.invalid = true;
     }
     return msg;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return nil;
+}
+
 - (BOOL) requiresArguments {
-    return false;
+    return self.argumentParser.requiresArguments;
 }
 
 - (BOOL) checkArgumentsCount {
@@ -237,6 +291,12 @@ static NSString* const TAG = @"CodelessCommand";
 }
 
 - (NSNumber*) decodeNumberArgument:(int)group {
+    CodelessArgumentParser* parser = self.argumentParser;
+    if (parser) {
+        if (group < 1 || group > argumentValues.count || group > parser.arguments.count || parser.arguments[group - 1].type >= CODELESS_ARGUMENT_TEXT)
+            return nil;
+        return @(argumentValues.values[group - 1]);
+    }
     NSRange range = [self.matcher rangeAtIndex:group];
     if (NSEqualRanges(range, NSMakeRange(NSNotFound, 0)))
         return nil;
@@ -245,22 +305,44 @@ static NSString* const TAG = @"CodelessCommand";
     if ([value hasPrefix:@"0x"] || [value hasPrefix:@"0X"]) {
         uint number;
         if (![scanner scanHexInt:&number]) {
-            CodelessLogOpt(CodelessLibLog.COMMAND, self.TAG, "Invalid number argument: %@", value);
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, self.TAG, "Invalid number argument: %@", value);
             return nil;
         }
         return @(number);
     } else {
         int number;
         if (![scanner scanInt:&number]) {
-            CodelessLogOpt(CodelessLibLog.COMMAND, self.TAG, "Invalid number argument: %@", value);
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, self.TAG, "Invalid number argument: %@", value);
             return nil;
         }
         return @(number);
     }
 }
 
+- (NSString*) decodeTextArgument:(int)group {
+    NSRange range;
+    if (self.argumentParser) {
+        if (group < 1 || group > argumentValues.count)
+            return nil;
+        range = argumentValues.ranges[group - 1];
+    } else {
+        if (!self.matcher || group >= self.matcher.numberOfRanges)
+            return nil;
+        range = [self.matcher rangeAtIndex:group];
+        if (range.location == NSNotFound)
+            return nil;
+    }
+    return [self.command substringWithRange:range];
+}
+
+- (int) argumentCount {
+    if (self.argumentParser)
+        return argumentValues.count;
+    return [CodelessProfile countArguments:self.command split:@","];
+}
+
 - (void) sendEvent:(NSString*)event object:(CodelessCommandEvent*)object {
-    [NSNotificationCenter.defaultCenter postNotificationName:event object:self.manager userInfo:@{ @"event" : object }];
+    [self.manager sendEvent:event object:object];
 }
 
 - (void) sendEvent:(NSString*)event class:(Class)eventClass {
@@ -270,7 +352,7 @@ static NSString* const TAG = @"CodelessCommand";
     if (![object respondsToSelector:@selector(initWithCommand:)])
         return;
     object = [object initWithCommand:self];
-    [NSNotificationCenter.defaultCenter postNotificationName:event object:self.manager userInfo:@{ @"event" : object }];
+    [self.manager sendEvent:event object:object];
 }
 
 - (NSString*) description {
@@ -58,6 +58,7 @@ static const int ID = CODELESS_COMMAND_ID_CONPAR;
 
 static NSString* PATTERN_STRING = @"^CONPAR(?:=(\\d+),(\\d+),(\\d+),(\\d+))?$"; // <interval> <latency> <timeout> <action>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 static NSString* RESPONSE_PATTERN_STRING = @"^(\\d+).(\\d+).(\\d+).(\\d+)$"; // <interval> <latency> <timeout> <action>
 static NSRegularExpression* RESPONSE_PATTERN;
@@ -71,6 +72,13 @@ static NSRegularExpression* RESPONSE_PATTERN;
     NSError* patternError = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&patternError];
 
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid connection interval" check:true min:CODELESS_COMMAND_CONNECTION_INTERVAL_MIN max:CODELESS_COMMAND_CONNECTION_INTERVAL_MAX],
+            [CodelessArgumentSpec decimal:@"Invalid slave latency" check:true min:CODELESS_COMMAND_SLAVE_LATENCY_MIN max:CODELESS_COMMAND_SLAVE_LATENCY_MAX],
+            [CodelessArgumentSpec decimal:@"Invalid supervision timeout" check:true min:CODELESS_COMMAND_SUPERVISION_TIMEOUT_MIN max:CODELESS_COMMAND_SUPERVISION_TIMEOUT_MAX],
+            [CodelessArgumentSpec decimal:@"Invalid parameter update action" check:true min:CODELESS_COMMAND_PARAMETER_UPDATE_ACTION_MIN max:CODELESS_COMMAND_PARAMETER_UPDATE_ACTION_MAX],
+    ] counts:@[ @0, @4 ]];
+
     NSError* responsePatternError = nil;
     RESPONSE_PATTERN = [NSRegularExpression regularExpressionWithPattern:RESPONSE_PATTERN_STRING options:0 error:&responsePatternError];
 }
@@ -135,6 +143,10 @@ static NSRegularExpression* RESPONSE_PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? [NSString stringWithFormat:@"%d,%d,%d,%d", self.interval, self.latency, self.timeout, self.action] : nil;
 }
@@ -177,7 +189,7 @@ static NSRegularExpression* RESPONSE_PATTERN;
                 return;
             }
             _action = num;
-            CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Connection parameters: ci=%d sl=%d st=%d a=%d", self.interval, self.latency, self.timeout, self.action);
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Connection parameters: ci=%d sl=%d st=%d a=%d", self.interval, self.latency, self.timeout, self.action);
         } else {
             self.invalid = true;
             CodelessLog(TAG, "%@", errorMsg);
@@ -191,37 +203,32 @@ static NSRegularExpression* RESPONSE_PATTERN;
         [self sendEvent:CodelessLibEvent.ConnectionParameters object:[[CodelessConnectionParametersEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 4;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
-    if (!num || value < CODELESS_COMMAND_CONNECTION_INTERVAL_MIN || value > CODELESS_COMMAND_CONNECTION_INTERVAL_MAX)
+    if (!num)
         return @"Invalid connection interval";
     _interval = value;
 
     num = [self decodeNumberArgument:2];
     value = num.intValue;
-    if (!num || value < CODELESS_COMMAND_SLAVE_LATENCY_MIN || value > CODELESS_COMMAND_SLAVE_LATENCY_MAX)
+    if (!num)
         return @"Invalid slave latency";
     _latency = value;
 
     num = [self decodeNumberArgument:3];
     value = num.intValue;
-    if (!num || value < CODELESS_COMMAND_SUPERVISION_TIMEOUT_MIN || value > CODELESS_COMMAND_SUPERVISION_TIMEOUT_MAX)
+    if (!num)
         return @"Invalid supervision timeout";
     _timeout = value;
 
     num = [self decodeNumberArgument:4];
     value = num.intValue;
-    if (!num || value < CODELESS_COMMAND_PARAMETER_UPDATE_ACTION_MIN || value > CODELESS_COMMAND_PARAMETER_UPDATE_ACTION_MAX)
+    if (!num)
         return @"Invalid parameter update action";
     _action = value;
 
@@ -36,6 +36,7 @@
 #import "CodelessCustomCommand.h"
 #import "CodelessProfile.h"
 #import "CodelessLibLog.h"
+#import "CodelessLibConfig.h"
 
 @implementation CodelessCustomCommand
 
@@ -80,8 +81,14 @@ static const int ID = CODELESS_COMMAND_ID_CUSTOM;
     return ID;
 }
 
+- (NSTimeInterval) timeout {
+    // The command is unidentified, so it may be a long running one.
+    NSTimeInterval timeout = super.timeout;
+    return timeout ? MAX(timeout, CodelessLibConfig.COMMAND_TIMEOUT_LONG / 1000.) : 0;
+}
+
 - (NSString*) parseCommand:(NSString*)command {
-    CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Custom command: %@", command);
+    CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Custom command: %@", command);
     self.command = command;
     self.parsed = true;
     return nil;
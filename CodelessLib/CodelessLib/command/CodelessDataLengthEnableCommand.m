@@ -58,6 +58,7 @@ static const int ID = CODELESS_COMMAND_ID_DLEEN;
 
 static NSString* PATTERN_STRING = @"^DLEEN(?:=(\\d),(\\d+),(\\d+))?$"; // <enable> <tx> <rx>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 static NSString* RESPONSE_PATTERN_STRING = @"^(\\d).(\\d+).(\\d+)$"; // <enable> <tx> <rx>
 static NSRegularExpression* RESPONSE_PATTERN;
@@ -71,6 +72,12 @@ static NSRegularExpression* RESPONSE_PATTERN;
     NSError* patternError = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&patternError];
 
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Enable must be 0 or 1" digits:1],
+            [CodelessArgumentSpec decimal:@"Invalid TX packet length" check:true min:CODELESS_COMMAND_DLE_PACKET_LENGTH_MIN max:CODELESS_COMMAND_DLE_PACKET_LENGTH_MAX],
+            [CodelessArgumentSpec decimal:@"Invalid RX packet length" check:true min:CODELESS_COMMAND_DLE_PACKET_LENGTH_MIN max:CODELESS_COMMAND_DLE_PACKET_LENGTH_MAX],
+    ] counts:@[ @0, @3 ]];
+
     NSError* responsePatternError = nil;
     RESPONSE_PATTERN = [NSRegularExpression regularExpressionWithPattern:RESPONSE_PATTERN_STRING options:0 error:&responsePatternError];
 }
@@ -138,6 +145,10 @@ static NSRegularExpression* RESPONSE_PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? [NSString stringWithFormat:@"%d,%d,%d", self.enabled ? CODELESS_COMMAND_DLE_ENABLED : CODELESS_COMMAND_DLE_DISABLED, self.txPacketLength, self.rxPacketLength] : nil;
 }
@@ -172,7 +183,7 @@ static NSRegularExpression* RESPONSE_PATTERN;
                 return;
             }
             _rxPacketLength = num;
-            CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "DLE: %@ tx=%d rx=%d", (self.enabled ? @"enabled" : @"disabled"), self.txPacketLength, self.rxPacketLength);
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "DLE: %@ tx=%d rx=%d", (self.enabled ? @"enabled" : @"disabled"), self.txPacketLength, self.rxPacketLength);
         } else {
             self.invalid = true;
             CodelessLog(TAG, "%@", errorMsg);
@@ -186,13 +197,8 @@ static NSRegularExpression* RESPONSE_PATTERN;
         [self sendEvent:CodelessLibEvent.DataLengthEnable object:[[CodelessDataLengthEnableEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 3;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
@@ -204,13 +210,13 @@ static NSRegularExpression* RESPONSE_PATTERN;
 
     num = [self decodeNumberArgument:2];
     value = num.intValue;
-    if (!num || value < CODELESS_COMMAND_DLE_PACKET_LENGTH_MIN || value > CODELESS_COMMAND_DLE_PACKET_LENGTH_MAX)
+    if (!num)
         return @"Invalid TX packet length";
     _txPacketLength = value;
 
     num = [self decodeNumberArgument:3];
     value = num.intValue;
-    if (!num || value < CODELESS_COMMAND_DLE_PACKET_LENGTH_MIN || value > CODELESS_COMMAND_DLE_PACKET_LENGTH_MAX)
+    if (!num)
         return @"Invalid RX packet length";
     _rxPacketLength = value;
 
@@ -107,7 +107,7 @@ static NSRegularExpression* PATTERN;
     [super parseResponse:response];
     if (self.responseLine == 1) {
         self.info = response;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Device info: %@", self.info);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Device info: %@", self.info);
     }
 }
 
@@ -125,7 +125,7 @@ static NSRegularExpression* PATTERN;
             self.info = [NSString stringWithFormat:@"CodeLess iOS %@", versionNumber];
         }
     }
-    CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Send device info: %@", self.info);
+    CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Send device info: %@", self.info);
     [self sendSuccess:self.info];
 }
 
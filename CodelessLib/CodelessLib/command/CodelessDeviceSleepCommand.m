@@ -49,6 +49,7 @@ static const int ID = CODELESS_COMMAND_ID_SLEEP;
 
 static NSString* PATTERN_STRING = @"^SLEEP=(\\d)$"; // <sleep>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessDeviceSleepCommand.class)
@@ -58,6 +59,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Argument must be 0 or 1" digits:1],
+    ]];
 }
 
 + (NSString*) COMMAND {
@@ -108,6 +113,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -116,14 +125,6 @@ static NSRegularExpression* PATTERN;
     return !self.sleep ? @(CODELESS_COMMAND_AWAKE_DEVICE).stringValue : @(CODELESS_COMMAND_PUT_DEVICE_IN_SLEEP).stringValue;
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    return [CodelessProfile countArguments:self.command split:@","] == 1;
-}
-
 - (NSString*) parseArguments {
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
@@ -58,6 +58,7 @@ static const int ID = CODELESS_COMMAND_ID_EVENT;
 
 static NSString* PATTERN_STRING = @"^EVENT(?:=(\\d+),(\\d))?$"; // <event> <status>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessEventConfigCommand.class)
@@ -67,6 +68,11 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid event number"],
+            [CodelessArgumentSpec decimal:@"Invalid event status" digits:1],
+    ] counts:@[ @0, @2 ]];
 }
 
 + (NSString*) COMMAND {
@@ -122,6 +128,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? [NSString stringWithFormat:@"%d,%d", self.eventConfig.type, self.eventConfig.status ? CODELESS_COMMAND_ACTIVATE_EVENT : CODELESS_COMMAND_DEACTIVATE_EVENT] : nil;
 }
@@ -168,15 +178,10 @@ static NSRegularExpression* PATTERN;
     }
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 2;
-}
-
 - (NSString*) parseArguments {
     _eventConfig = [[CodelessEventConfig alloc] init];
 
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
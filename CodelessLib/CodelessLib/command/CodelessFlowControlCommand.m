@@ -58,6 +58,7 @@ static const int ID = CODELESS_COMMAND_ID_FLOWCONTROL;
 
 static NSString* PATTERN_STRING = @"^FLOWCONTROL(?:=(\\d),(\\d+),(\\d+))?$"; // <fc_mode> <rts_pin> <cts_pin>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessFlowControlCommand.class)
@@ -67,6 +68,12 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid mode" digits:1],
+            [CodelessArgumentSpec decimal:@"Invalid RTS GPIO"],
+            [CodelessArgumentSpec decimal:@"Invalid CTS GPIO"],
+    ] counts:@[ @0, @3 ]];
 }
 
 + (NSString*) COMMAND {
@@ -124,6 +131,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? [NSString stringWithFormat:@"%d,%d,%d", self.mode, [self.rtsGpio getGpio], [self.ctsGpio getGpio]] : nil;
 }
@@ -165,7 +176,7 @@ static NSRegularExpression* PATTERN;
         }
         _ctsGpio = [[CodelessGPIO alloc] initWithPack:num];
         self.ctsGpio.function = CODELESS_COMMAND_GPIO_FUNCTION_UART_CTS;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Flow control: %@ RTS=%@ CTS=%@", self.mode == CODELESS_COMMAND_ENABLE_UART_FLOW_CONTROL ? @"Enabled" : @"Disabled", self.rtsGpio.name, self.ctsGpio.name);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Flow control: %@ RTS=%@ CTS=%@", self.mode == CODELESS_COMMAND_ENABLE_UART_FLOW_CONTROL ? @"Enabled" : @"Disabled", self.rtsGpio.name, self.ctsGpio.name);
     }
 }
 
@@ -175,13 +186,8 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.FlowControl object:[[CodelessFlowControlEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 3;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
@@ -37,6 +37,7 @@
 #import "CodelessProfile.h"
 #import "CodelessLibEvent.h"
 #import "CodelessLibLog.h"
+#import "CodelessLibConfig.h"
 
 @implementation CodelessGapConnectCommand
 
@@ -126,6 +127,12 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (NSTimeInterval) timeout {
+    // The connection may take several seconds to complete.
+    NSTimeInterval timeout = super.timeout;
+    return timeout ? MAX(timeout, CodelessLibConfig.COMMAND_TIMEOUT_LONG / 1000.) : 0;
+}
+
 - (void) parseResponse:(NSString*)response {
     [super parseResponse:response];
     if (![response isEqualToString:@"Connected"] && ![response isEqualToString:@"Connecting"]) {
@@ -136,7 +143,7 @@ static NSRegularExpression* PATTERN;
     if (self.invalid) {
         CodelessLog(TAG, "Received invalid response: %@", response);
     } else {
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Connect status: %@", response);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Connect status: %@", response);
     }
 }
 
@@ -111,7 +111,7 @@ static NSRegularExpression* PATTERN;
         if (self.invalid)
             CodelessLog(TAG, "Received invalid response: %@", response);
         else
-            CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Device disconnected");
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Device disconnected");
     }
 }
 
@@ -37,6 +37,7 @@
 #import "CodelessProfile.h"
 #import "CodelessLibEvent.h"
 #import "CodelessLibLog.h"
+#import "CodelessLibConfig.h"
 
 @implementation CodelessGapScanCommand
 
@@ -116,6 +117,12 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (NSTimeInterval) timeout {
+    // The scan may take several seconds to complete.
+    NSTimeInterval timeout = super.timeout;
+    return timeout ? MAX(timeout, CodelessLibConfig.COMMAND_TIMEOUT_LONG / 1000.) : 0;
+}
+
 - (void) parseResponse:(NSString*)response {
     [super parseResponse:response];
     if (!self.devices)
@@ -140,7 +147,7 @@ static NSRegularExpression* PATTERN;
     if (self.invalid)
         CodelessLog(TAG, "Received invalid scan response: %@", response);
     else
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Scanned device: Address:%@ Address type:%@ Type:%@ RSSI:%d", device.address, (device.addressType == CODELESS_COMMAND_GAP_ADDRESS_TYPE_PUBLIC ? CODELESS_COMMAND_GAP_ADDRESS_TYPE_PUBLIC_STRING : CODELESS_COMMAND_GAP_ADDRESS_TYPE_RANDOM_STRING), (device.type == CODELESS_COMMAND_GAP_SCAN_TYPE_ADV ? CODELESS_COMMAND_GAP_SCAN_TYPE_ADV_STRING : CODELESS_COMMAND_GAP_SCAN_TYPE_RSP_STRING), device.rssi);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Scanned device: Address:%@ Address type:%@ Type:%@ RSSI:%d", device.address, (device.addressType == CODELESS_COMMAND_GAP_ADDRESS_TYPE_PUBLIC ? CODELESS_COMMAND_GAP_ADDRESS_TYPE_PUBLIC_STRING : CODELESS_COMMAND_GAP_ADDRESS_TYPE_RANDOM_STRING), (device.type == CODELESS_COMMAND_GAP_SCAN_TYPE_ADV ? CODELESS_COMMAND_GAP_SCAN_TYPE_ADV_STRING : CODELESS_COMMAND_GAP_SCAN_TYPE_RSP_STRING), device.rssi);
 }
 
 - (void) onSuccess {
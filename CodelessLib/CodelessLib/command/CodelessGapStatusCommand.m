@@ -152,7 +152,7 @@ static NSRegularExpression* PATTERN;
         self.connected = self.manager.isConnected;
     }
     NSString* response = [NSString stringWithFormat:@"%d,%d", self.gapRole, self.connected ? CODELESS_COMMAND_GAP_STATUS_CONNECTED : CODELESS_COMMAND_GAP_STATUS_DISCONNECTED];
-    CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "GAP status: %@", response);
+    CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "GAP status: %@", response);
     [self sendSuccess:response];
 }
 
@@ -58,6 +58,7 @@ static const int ID = CODELESS_COMMAND_ID_HOSTSLP;
 
 static NSString* PATTERN_STRING = @"^HOSTSLP(?:=(\\d+),(\\d+),(\\d+),(\\d+))?$"; // <hst_slp_mode> <wkup_byte> <wkup_retry_interval> <wkup_retry_times>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessHostSleepCommand.class)
@@ -67,6 +68,13 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid host sleep mode"],
+            [CodelessArgumentSpec decimal:@"Invalid wakeup byte"],
+            [CodelessArgumentSpec decimal:@"Invalid wakeup retry interval"],
+            [CodelessArgumentSpec decimal:@"Invalid wakeup retry times"],
+    ] counts:@[ @0, @4 ]];
 }
 
 + (NSString*) COMMAND {
@@ -121,6 +129,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? [NSString stringWithFormat:@"%d,%d,%d,%d", self.hostSleepMode, self.wakeupByte, self.wakeupRetryInterval, self.wakeupRetryTimes] : nil;
 }
@@ -169,7 +181,7 @@ static NSRegularExpression* PATTERN;
         }
         _wakeupRetryTimes = num;
 
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Host sleep mode:%d wakeup byte:%d wakeup retry interval:%d wakeup retry times:%d", self.hostSleepMode, self.wakeupByte, self.wakeupRetryInterval, self.wakeupRetryTimes);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Host sleep mode:%d wakeup byte:%d wakeup retry interval:%d wakeup retry times:%d", self.hostSleepMode, self.wakeupByte, self.wakeupRetryInterval, self.wakeupRetryTimes);
     }
 }
 
@@ -179,13 +191,8 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.HostSleep object:[[CodelessHostSleepEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 4;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
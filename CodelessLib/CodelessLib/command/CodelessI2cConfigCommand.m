@@ -51,6 +51,7 @@ static const int ID = CODELESS_COMMAND_ID_I2CCFG;
 
 static NSString* PATTERN_STRING = @"^I2CCFG=(\\d+),(\\d+),(\\d+)$"; // <count> <rate> <width>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessI2cConfigCommand.class)
@@ -60,6 +61,12 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid slave addressing bit count"],
+            [CodelessArgumentSpec decimal:@"Invalid bit rate"],
+            [CodelessArgumentSpec decimal:@"Invalid register width"],
+    ]];
 }
 
 + (NSString*) COMMAND {
@@ -112,6 +119,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -126,14 +137,6 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.I2cConfig object:[[CodelessI2cConfigEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    return [CodelessProfile countArguments:self.command split:@","] == 3;
-}
-
 - (NSString*) parseArguments {
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
@@ -51,6 +51,7 @@ static const int ID = CODELESS_COMMAND_ID_I2CREAD;
 
 static NSString* PATTERN_STRING = @"^I2CREAD=(0[xX][0-9a-fA-F]+|\\d+),(0[xX][0-9a-fA-F]+|\\d+)(?:,(\\d+))?$"; // <address> <register> <bytes>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessI2cReadCommand.class)
@@ -60,6 +61,12 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec number:@"Invalid slave address"],
+            [CodelessArgumentSpec number:@"Invalid register"],
+            [CodelessArgumentSpec decimal:@"Invalid number of bytes"],
+    ] counts:@[ @2, @3 ]];
 }
 
 + (NSString*) COMMAND {
@@ -128,6 +135,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -153,7 +164,7 @@ static NSRegularExpression* PATTERN;
             }
             self.data[i] = @(num);
         }
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Read data: %@", self.data);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Read data: %@", self.data);
     }
 }
 
@@ -163,18 +174,9 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.I2cRead object:[[CodelessI2cReadEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 2 || count == 3;
-}
-
 - (NSString*) parseArguments {
     self.byteCount = -1;
-    int count = [CodelessProfile countArguments:self.command split:@","];
+    int count = self.argumentCount;
 
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
@@ -37,6 +37,7 @@
 #import "CodelessProfile.h"
 #import "CodelessLibEvent.h"
 #import "CodelessLibLog.h"
+#import "CodelessLibConfig.h"
 
 @implementation I2cDevice
 
@@ -150,6 +151,12 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (NSTimeInterval) timeout {
+    // Scanning the I2C bus may take several seconds to complete.
+    NSTimeInterval timeout = super.timeout;
+    return timeout ? MAX(timeout, CodelessLibConfig.COMMAND_TIMEOUT_LONG / 1000.) : 0;
+}
+
 - (void) parseResponse:(NSString*)response {
     [super parseResponse:response];
     NSArray<NSString*>* scanResults = [response componentsSeparatedByString:@","];
@@ -175,13 +182,13 @@ static NSRegularExpression* PATTERN;
         }
         [self.devices addObject:device];
     }
-    CodelessLogOpt(CodelessLibLog.COMMAND, TAG, @"I2C scan results: %@", self.devices);
+    CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, @"I2C scan results: %@", self.devices);
 }
 
 - (void) onSuccess {
     [super onSuccess];
     if (self.isValid) {
-        if (CodelessLibLog.COMMAND && !self.devices.count)
+        if (CodelessLogEnabled(CODELESS_LOG_COMMAND) && !self.devices.count)
             CodelessLog(TAG, "No I2C devices found");
         [self sendEvent:CodelessLibEvent.I2cScan object:[[CodelessI2cScanEvent alloc] initWithCommand:self]];
     }
@@ -49,6 +49,7 @@ static const int ID = CODELESS_COMMAND_ID_I2CWRITE;
 
 static NSString* PATTERN_STRING = @"^I2CWRITE=(0[xX][0-9a-fA-F]+|\\d+),(0[xX][0-9a-fA-F]+|\\d+),(0[xX][0-9a-fA-F]+|\\d+)$"; // <address> <register> <data>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessI2cWriteCommand.class)
@@ -58,6 +59,12 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec number:@"Invalid slave address"],
+            [CodelessArgumentSpec number:@"Invalid slave register"],
+            [CodelessArgumentSpec number:@"Invalid byte number"],
+    ]];
 }
 
 + (NSString*) COMMAND {
@@ -110,6 +117,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -118,14 +129,6 @@ static NSRegularExpression* PATTERN;
     return [NSString stringWithFormat:@"0x%02X,0x%02X,%d", self.address, self.i2cRegister, self.value];
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    return [CodelessProfile countArguments:self.command split:@","] == 3;
-}
-
 - (NSString*) parseArguments {
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
@@ -59,6 +59,7 @@ static const int ID = CODELESS_COMMAND_ID_IOCFG;
 
 static NSString* PATTERN_STRING = @"^IOCFG(?:=(\\d+),(\\d+)(?:,(\\d+))?)?$"; // <pin> <function> <level>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessIoConfigCommand.class)
@@ -68,6 +69,12 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid GPIO"],
+            [CodelessArgumentSpec decimal:@"Invalid GPIO function" check:CodelessLibConfig.CHECK_GPIO_FUNCTION min:CodelessLibConfig.GPIO_FUNCTION_MIN max:CodelessLibConfig.GPIO_FUNCTION_MAX],
+            [CodelessArgumentSpec decimal:@"Invalid level"],
+    ] counts:@[ @0, @2, @3 ]];
 }
 
 + (NSString*) COMMAND {
@@ -137,6 +144,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     if (!self.hasArguments)
         return nil;
@@ -178,12 +189,12 @@ static NSRegularExpression* PATTERN;
             return;
         }
 
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Using GPIO configuration: %@", gpioConfig);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Using GPIO configuration: %@", gpioConfig);
         for (int i = 0; i < function.count; i++) {
             if (gpioConfig[i].validGpio)
                 [self.configuration addObject:[[CodelessGPIO alloc] initWithGPIO:gpioConfig[i] function:function[i].intValue]];
         }
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "GPIO configuration: %@", self.configuration);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "GPIO configuration: %@", self.configuration);
     }
 }
 
@@ -197,15 +208,10 @@ static NSRegularExpression* PATTERN;
     }
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 2 || count == 3;
-}
-
 - (NSString*) parseArguments {
     self.gpio = [[CodelessGPIO alloc] init];
 
-    int count = [CodelessProfile countArguments:self.command split:@","];
+    int count = self.argumentCount;
     if (!count)
         return nil;
     self.hasArguments = true;
@@ -218,7 +224,7 @@ static NSRegularExpression* PATTERN;
 
     num = [self decodeNumberArgument:2];
     value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_GPIO_FUNCTION && (value < CodelessLibConfig.GPIO_FUNCTION_MIN || value > CodelessLibConfig.GPIO_FUNCTION_MAX))
+    if (!num)
         return @"Invalid GPIO function";
     self.gpio.function = value;
 
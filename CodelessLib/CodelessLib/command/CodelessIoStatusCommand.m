@@ -51,6 +51,7 @@ static const int ID = CODELESS_COMMAND_ID_IO;
 
 static NSString* PATTERN_STRING = @"^IO=(\\d+)(?:,(\\d))?$"; // <pin> <status>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessIoStatusCommand.class)
@@ -60,6 +61,11 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid GPIO"],
+            [CodelessArgumentSpec decimal:@"Argument must be 0 or 1" digits:1],
+    ] counts:@[ @1, @2 ]];
 }
 
 + (NSString*) COMMAND {
@@ -135,6 +141,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -156,7 +166,7 @@ static NSRegularExpression* PATTERN;
             return;
         }
         self.gpio.state = num;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "GPIO status: %@ %@", self.gpio.name, (self.gpio.isHigh ? @"high" : @"low"));
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "GPIO status: %@ %@", self.gpio.name, (self.gpio.isHigh ? @"high" : @"low"));
     }
 }
 
@@ -166,15 +176,6 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.IoStatus object:[[CodelessIoStatusEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 1 || count == 2;
-}
-
 - (NSString*) parseArguments {
     _gpio = [[CodelessGPIO alloc] init];
 
@@ -184,7 +185,7 @@ static NSRegularExpression* PATTERN;
         return @"Invalid GPIO";
     [self.gpio setGpio:value];
 
-    if ([CodelessProfile countArguments:self.command split:@","] == 2) {
+    if (self.argumentCount == 2) {
         num = [self decodeNumberArgument:2];
         value = num.intValue;
         if (!num || ![CodelessProfile isBinaryState:value])
@@ -58,6 +58,7 @@ static const int ID = CODELESS_COMMAND_ID_MAXMTU;
 
 static NSString* PATTERN_STRING = @"^MAXMTU(?:=(\\d+))?$"; // <mtu>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessMaxMtuCommand.class)
@@ -67,6 +68,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid MTU value" check:true min:CODELESS_COMMAND_MTU_MIN max:CODELESS_COMMAND_MTU_MAX],
+    ] counts:@[ @0, @1 ]];
 }
 
 + (NSString*) COMMAND {
@@ -118,6 +123,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? @(self.mtu).stringValue : nil;
 }
@@ -133,7 +142,7 @@ static NSRegularExpression* PATTERN;
             return;
         }
         _mtu = num;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "MTU=%d", self.mtu);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "MTU=%d", self.mtu);
     }
 }
 
@@ -143,19 +152,14 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.MaxMtu object:[[CodelessMaxMtuEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 1;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
-    if (!num || value < CODELESS_COMMAND_MTU_MIN || value > CODELESS_COMMAND_MTU_MAX)
+    if (!num)
         return @"Invalid MTU value";
     _mtu = value;
 
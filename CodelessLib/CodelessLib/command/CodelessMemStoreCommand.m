@@ -133,7 +133,7 @@ static NSRegularExpression* PATTERN;
     [super parseResponse:response];
     if (self.responseLine == 1) {
         _text = response;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Memory index: %d contains: %@", self.memIndex, self.text);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Memory index: %d contains: %@", self.memIndex, self.text);
     }
 }
 
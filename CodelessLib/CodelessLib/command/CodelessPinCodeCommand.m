@@ -58,6 +58,7 @@ static const int ID = CODELESS_COMMAND_ID_PIN;
 
 static NSString* PATTERN_STRING = @"^PIN(?:=(\\d+))?$"; // <pin>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessPinCodeCommand.class)
@@ -67,6 +68,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid PIN code"],
+    ] counts:@[ @0, @1 ]];
 }
 
 + (NSString*) COMMAND {
@@ -118,6 +123,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? @(self.pinCode).stringValue : nil;
 }
@@ -133,7 +142,7 @@ static NSRegularExpression* PATTERN;
             return;
         }
         self.pinCode = num;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "PIN code: %d", self.pinCode);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "PIN code: %d", self.pinCode);
     }
 }
 
@@ -143,13 +152,8 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.PinCode object:[[CodelessPinCodeEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 1;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
     NSNumber* num = [self decodeNumberArgument:1];
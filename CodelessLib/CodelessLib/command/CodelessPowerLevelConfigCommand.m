@@ -59,6 +59,7 @@ static const int ID = CODELESS_COMMAND_ID_PWRLVL;
 
 static NSString* PATTERN_STRING = @"^PWRLVL(?:=(\\d+))?$"; // <level>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessPowerLevelConfigCommand.class)
@@ -68,6 +69,11 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    // Inbound commands require the power level argument.
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid power level"],
+    ]];
 }
 
 + (NSString*) COMMAND {
@@ -119,17 +125,12 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
-- (NSString*) getArguments {
-    return self.hasArguments ? @(self.powerLevel).stringValue : nil;
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","] == 1;
-    return count == 0 || count == 1;
+- (NSString*) getArguments {
+    return self.hasArguments ? @(self.powerLevel).stringValue : nil;
 }
 
 - (void) parseResponse:(NSString*)response {
@@ -146,7 +147,7 @@ static NSRegularExpression* PATTERN;
             if (self.invalid)
                 CodelessLog(TAG, "Received invalid power level: %@", response);
             else
-                CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Power level: %d", self.powerLevel);
+                CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Power level: %d", self.powerLevel);
         } else {
             CodelessLog(TAG, "Power level not supported");
             self.notSupported = true;
@@ -161,7 +162,7 @@ static NSRegularExpression* PATTERN;
 }
 
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
@@ -59,6 +59,7 @@ static const int ID = CODELESS_COMMAND_ID_PWM;
 
 static NSString* PATTERN_STRING = @"^PWM(?:=(\\d+),(\\d+),(\\d+))?$"; // <frequency> <cycle> <duration>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 static NSString* RESPONSE_PATTERN_STRING = @"^(\\d+).(\\d+).(\\d+)?$";
 static NSRegularExpression* RESPONSE_PATTERN;
@@ -72,6 +73,12 @@ static NSRegularExpression* RESPONSE_PATTERN;
     NSError* patternError = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&patternError];
 
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid pulse frequency" check:CodelessLibConfig.CHECK_PWM_FREQUENCY min:CodelessLibConfig.PWM_FREQUENCY_MIN max:CodelessLibConfig.PWM_FREQUENCY_MAX],
+            [CodelessArgumentSpec decimal:@"Invalid pulse duty cycle" check:CodelessLibConfig.CHECK_PWM_DUTY_CYCLE min:CodelessLibConfig.PWM_DUTY_CYCLE_MIN max:CodelessLibConfig.PWM_DUTY_CYCLE_MAX],
+            [CodelessArgumentSpec decimal:@"Invalid pulse duration" check:CodelessLibConfig.CHECK_PWM_DURATION min:CodelessLibConfig.PWM_DURATION_MIN max:CodelessLibConfig.PWM_DURATION_MAX],
+    ] counts:@[ @0, @3 ]];
+
     NSError* responsePatternError = nil;
     RESPONSE_PATTERN = [NSRegularExpression regularExpressionWithPattern:RESPONSE_PATTERN_STRING options:0 error:&responsePatternError];
 }
@@ -135,6 +142,10 @@ static NSRegularExpression* RESPONSE_PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? [NSString stringWithFormat:@"%d,%d,%d", self.frequency, self.dutyCycle, self.duration] : nil;
 }
@@ -169,7 +180,7 @@ static NSRegularExpression* RESPONSE_PATTERN;
                 return;
             }
             _duration = num;
-            CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "PWM parameters: frequency=%d dc=%d duration=%d", self.frequency, self.dutyCycle, self.duration);
+            CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "PWM parameters: frequency=%d dc=%d duration=%d", self.frequency, self.dutyCycle, self.duration);
         } else {
             self.invalid = true;
             CodelessLog(TAG, "%@", errorMsg);
@@ -187,31 +198,26 @@ static NSRegularExpression* RESPONSE_PATTERN;
     }
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 3;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_PWM_FREQUENCY && (value < CodelessLibConfig.PWM_FREQUENCY_MIN || value > CodelessLibConfig.PWM_FREQUENCY_MAX))
+    if (!num)
         return @"Invalid pulse frequency";
     _frequency = value;
 
     num = [self decodeNumberArgument:2];
     value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_PWM_DUTY_CYCLE && (value < CodelessLibConfig.PWM_DUTY_CYCLE_MIN || value > CodelessLibConfig.PWM_DUTY_CYCLE_MAX))
+    if (!num)
         return @"Invalid pulse duty cycle";
     _dutyCycle = value;
 
     num = [self decodeNumberArgument:3];
     value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_PWM_DURATION && (value < CodelessLibConfig.PWM_DURATION_MIN || value > CodelessLibConfig.PWM_DURATION_MAX))
+    if (!num)
         return @"Invalid pulse duration";
     _duration = value;
 
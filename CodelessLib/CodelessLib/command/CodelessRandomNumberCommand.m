@@ -114,7 +114,7 @@ static NSRegularExpression* PATTERN;
             return;
         }
         self.number = value;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Random number: %d", self.number);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Random number: %d", self.number);
     }
 }
 
@@ -127,7 +127,7 @@ static NSRegularExpression* PATTERN;
 - (void) processInbound {
     if (!self.validNumber)
         [self initRandomNumber];
-    CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Send random number: %d", self.number);
+    CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Send random number: %d", self.number);
     [self sendSuccess:[NSString stringWithFormat:@"0x%08X", self.number]];
 }
 
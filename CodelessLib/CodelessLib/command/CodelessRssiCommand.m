@@ -133,7 +133,7 @@ static NSRegularExpression* RESPONSE_PATTERN;
             return;
         }
         self.rssi = num;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Peer RSSI: %d", self.rssi);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Peer RSSI: %d", self.rssi);
     }
 }
 
@@ -58,6 +58,7 @@ static const int ID = CODELESS_COMMAND_ID_SEC;
 
 static NSString* PATTERN_STRING = @"^SEC(?:=(\\d+))?$"; // <mode>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessSecurityModeCommand.class)
@@ -67,6 +68,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid security mode"],
+    ] counts:@[ @0, @1 ]];
 }
 
 + (NSString*) COMMAND {
@@ -118,6 +123,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? @(self.mode).stringValue : nil;
 }
@@ -133,7 +142,7 @@ static NSRegularExpression* PATTERN;
             return;
         }
         _mode = num;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Security mode: %d", self.mode);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Security mode: %d", self.mode);
     }
 }
 
@@ -143,13 +152,8 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.SecurityMode object:[[CodelessSecurityModeEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 1;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
@@ -59,6 +59,7 @@ static const int ID = CODELESS_COMMAND_ID_SPICFG;
 
 static NSString* PATTERN_STRING = @"^SPICFG(?:=(\\d+),(\\d+),(\\d+))?$"; // <speed> <mode> <size>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessSpiConfigCommand.class)
@@ -68,6 +69,12 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid SPI clock value"],
+            [CodelessArgumentSpec decimal:@"Invalid SPI mode"],
+            [CodelessArgumentSpec decimal:@"Invalid SPI word size" check:CodelessLibConfig.CHECK_SPI_WORD_SIZE min:CodelessLibConfig.SPI_WORD_SIZE max:CodelessLibConfig.SPI_WORD_SIZE],
+    ] counts:@[ @0, @3 ]];
 }
 
 + (NSString*) COMMAND {
@@ -121,6 +128,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? [NSString stringWithFormat:@"%d,%d,%d", self.speed, self.mode, self.size] : nil;
 }
@@ -129,7 +140,13 @@ static NSRegularExpression* PATTERN;
     [super parseResponse:response];
     if (self.responseLine == 1) {
         NSString* errorMsg = [NSString stringWithFormat:@"Received invalid SPI configuration: %@", response];
-        NSScanner* scanner = [NSScanner scannerWithString:[response substringWithRange:[self.matcher rangeAtIndex:1]]];
+        NSArray<NSString*>* values = [response componentsSeparatedByString:@","];
+        if (values.count != 3) {
+            self.invalid = true;
+            CodelessLog(TAG, "%@", errorMsg);
+            return;
+        }
+        NSScanner* scanner = [NSScanner scannerWithString:values[0]];
         int num;
         if (![scanner scanInt:&num] || num != CODELESS_COMMAND_SPI_CLOCK_VALUE_2_MHZ && num != CODELESS_COMMAND_SPI_CLOCK_VALUE_4_MHZ && num != CODELESS_COMMAND_SPI_CLOCK_VALUE_8_MHZ) {
             self.invalid = true;
@@ -138,7 +155,7 @@ static NSRegularExpression* PATTERN;
         }
         _speed = num;
 
-        scanner = [NSScanner scannerWithString:[response substringWithRange:[self.matcher rangeAtIndex:2]]];
+        scanner = [NSScanner scannerWithString:values[1]];
         if (![scanner scanInt:&num] || num != CODELESS_COMMAND_SPI_MODE_0 && num != CODELESS_COMMAND_SPI_MODE_1 && num != CODELESS_COMMAND_SPI_MODE_2 && num != CODELESS_COMMAND_SPI_MODE_3) {
             self.invalid = true;
             CodelessLog(TAG, "%@", errorMsg);
@@ -146,14 +163,14 @@ static NSRegularExpression* PATTERN;
         }
         _mode = num;
 
-        scanner = [NSScanner scannerWithString:[response substringWithRange:[self.matcher rangeAtIndex:3]]];
+        scanner = [NSScanner scannerWithString:values[2]];
         if (![scanner scanInt:&num] || CodelessLibConfig.CHECK_SPI_WORD_SIZE && num != CodelessLibConfig.SPI_WORD_SIZE) {
             self.invalid = true;
             CodelessLog(TAG, "%@", errorMsg);
             return;
         }
         _size = num;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "SPI configuration: speed=%d mode=%d size=%d", self.speed, self.mode, self.size);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "SPI configuration: speed=%d mode=%d size=%d", self.speed, self.mode, self.size);
     }
 }
 
@@ -163,13 +180,8 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.SpiConfig object:[[CodelessSpiConfigEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 3;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
@@ -187,7 +199,7 @@ static NSRegularExpression* PATTERN;
 
     num = [self decodeNumberArgument:3];
     value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_SPI_WORD_SIZE && value != CodelessLibConfig.SPI_WORD_SIZE)
+    if (!num)
         return @"Invalid SPI word size";
     _size = value;
 
@@ -52,6 +52,7 @@ static const int ID = CODELESS_COMMAND_ID_SPIRD;
 
 static NSString* PATTERN_STRING = @"^SPIRD=(\\d+)$"; // <bytes>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessSpiReadCommand.class)
@@ -61,6 +62,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid byte number" check:CodelessLibConfig.CHECK_SPI_READ_SIZE min:0 max:CodelessLibConfig.SPI_MAX_BYTE_READ_SIZE],
+    ]];
 }
 
 + (NSString*) COMMAND {
@@ -111,6 +116,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -134,7 +143,7 @@ static NSRegularExpression* PATTERN;
             }
             self.data[i] = @(num);
         }
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Read data: %@", self.data);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Read data: %@", self.data);
     }
 }
 
@@ -144,18 +153,10 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.SpiRead object:[[CodelessSpiReadEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    return [CodelessProfile countArguments:self.command split:@","] == 1;
-}
-
 - (NSString*) parseArguments {
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_SPI_READ_SIZE && value > CodelessLibConfig.SPI_MAX_BYTE_READ_SIZE)
+    if (!num)
         return @"Invalid byte number";
     _byteNumber = value;
 
@@ -134,7 +134,7 @@ static NSRegularExpression* PATTERN;
             }
             self.data[i] = @(num);
         }
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Read data: %@", self.data);
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Read data: %@", self.data);
     }
 }
 
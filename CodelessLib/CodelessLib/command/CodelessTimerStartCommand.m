@@ -50,6 +50,7 @@ static const int ID = CODELESS_COMMAND_ID_TMRSTART;
 
 static NSString* PATTERN_STRING = @"^TMRSTART=(\\d+),(\\d+),(\\d+)$"; // <timer> <command> <delay>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessTimerStartCommand.class)
@@ -59,6 +60,12 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid timer index" check:CodelessLibConfig.CHECK_TIMER_INDEX min:CodelessLibConfig.TIMER_INDEX_MIN max:CodelessLibConfig.TIMER_INDEX_MAX],
+            [CodelessArgumentSpec decimal:@"Invalid command index" check:CodelessLibConfig.CHECK_COMMAND_INDEX min:CodelessLibConfig.COMMAND_INDEX_MIN max:CodelessLibConfig.COMMAND_INDEX_MAX],
+            [CodelessArgumentSpec decimal:@"Invalid delay"],
+    ]];
 }
 
 + (NSString*) COMMAND {
@@ -111,6 +118,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -119,24 +130,16 @@ static NSRegularExpression* PATTERN;
     return [NSString stringWithFormat:@"%d,%d,%d", self.timerIndex, self.commandIndex, self.delay];
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    return [CodelessProfile countArguments:self.command split:@","] == 3;
-}
-
 - (NSString*) parseArguments {
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_TIMER_INDEX && (value < CodelessLibConfig.TIMER_INDEX_MIN || value > CodelessLibConfig.TIMER_INDEX_MAX))
+    if (!num)
         return @"Invalid timer index";
     _timerIndex = value;
 
     num = [self decodeNumberArgument:2];
     value = num.intValue;
-    if (!num  || CodelessLibConfig.CHECK_COMMAND_INDEX && (value < CodelessLibConfig.COMMAND_INDEX_MIN || value > CodelessLibConfig.COMMAND_INDEX_MAX))
+    if (!num)
         return @"Invalid command index";
     _commandIndex = value;
 
@@ -50,6 +50,7 @@ static const int ID = CODELESS_COMMAND_ID_TMRSTOP;
 
 static NSString* PATTERN_STRING = @"^TMRSTOP=(\\d+)$"; // <timer>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessTimerStopCommand.class)
@@ -59,6 +60,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid timer index" check:CodelessLibConfig.CHECK_TIMER_INDEX min:CodelessLibConfig.TIMER_INDEX_MIN max:CodelessLibConfig.TIMER_INDEX_MAX],
+    ]];
 }
 
 + (NSString*) COMMAND {
@@ -109,6 +114,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (BOOL) hasArguments {
     return true;
 }
@@ -117,18 +126,10 @@ static NSRegularExpression* PATTERN;
     return @(self.timerIndex).stringValue;
 }
 
-- (BOOL) requiresArguments {
-    return true;
-}
-
-- (BOOL) checkArgumentsCount {
-    return [CodelessProfile countArguments:self.command split:@","] == 1;
-}
-
 - (NSString*) parseArguments {
     NSNumber* num = [self decodeNumberArgument:1];
     int value = num.intValue;
-    if (!num || CodelessLibConfig.CHECK_TIMER_INDEX && (value < CodelessLibConfig.TIMER_INDEX_MIN || value > CodelessLibConfig.TIMER_INDEX_MAX))
+    if (!num)
         return @"Invalid timer index";
     _timerIndex = value;
     return nil;
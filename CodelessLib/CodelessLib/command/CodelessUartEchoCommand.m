@@ -58,6 +58,7 @@ static const int ID = CODELESS_COMMAND_ID_ATE;
 
 static NSString* PATTERN_STRING = @"^E(?:=(\\d))?$"; // <echo>
 static NSRegularExpression* PATTERN;
+static CodelessArgumentParser* ARGUMENT_PARSER;
 
 + (void) initialize {
     if (self != CodelessUartEchoCommand.class)
@@ -67,6 +68,10 @@ static NSRegularExpression* PATTERN;
 
     NSError* error = nil;
     PATTERN = [NSRegularExpression regularExpressionWithPattern:PATTERN_STRING options:0 error:&error];
+
+    ARGUMENT_PARSER = [[CodelessArgumentParser alloc] initWithArguments:@[
+            [CodelessArgumentSpec decimal:@"Invalid UART echo state" digits:1],
+    ] counts:@[ @0, @1 ]];
 }
 
 + (NSString*) COMMAND {
@@ -118,6 +123,10 @@ static NSRegularExpression* PATTERN;
     return PATTERN;
 }
 
+- (CodelessArgumentParser*) argumentParser {
+    return ARGUMENT_PARSER;
+}
+
 - (NSString*) getArguments {
     return self.hasArguments ? @(self.echo ? CODELESS_COMMAND_UART_ECHO_ON : CODELESS_COMMAND_UART_ECHO_OFF).stringValue : nil;
 }
@@ -133,7 +142,7 @@ static NSRegularExpression* PATTERN;
             return;
         }
         self.echo = num != CODELESS_COMMAND_UART_ECHO_OFF;
-        CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "UART echo state: %@", self.echo ? @"enabled" : @"disabled");
+        CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "UART echo state: %@", self.echo ? @"enabled" : @"disabled");
     }
 }
 
@@ -143,13 +152,8 @@ static NSRegularExpression* PATTERN;
         [self sendEvent:CodelessLibEvent.UartEcho object:[[CodelessUartEchoEvent alloc] initWithCommand:self]];
 }
 
-- (BOOL) checkArgumentsCount {
-    int count = [CodelessProfile countArguments:self.command split:@","];
-    return count == 0 || count == 1;
-}
-
 - (NSString*) parseArguments {
-    if (![CodelessProfile hasArguments:self.command])
+    if (!self.argumentCount)
         return nil;
     self.hasArguments = true;
 
@@ -132,7 +132,7 @@ static NSRegularExpression* PATTERN;
 }
 
 - (void) processInbound {
-    CodelessLogOpt(CodelessLibLog.COMMAND, TAG, "Received print command: %@", self.text);
+    CodelessLogSubsystem(CODELESS_LOG_COMMAND, TAG, "Received print command: %@", self.text);
     [self sendSuccess];
     [self sendEvent:CodelessLibEvent.Print object:[[CodelessPrintEvent alloc] initWithCommand:self]];
 }
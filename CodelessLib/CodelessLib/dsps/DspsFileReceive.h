@@ -37,6 +37,7 @@
 
 @class CodelessManager;
 @class DspsRxLogFile;
+@class DspsStats;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -53,6 +54,7 @@ NS_ASSUME_NONNULL_BEGIN
  * Name: &lt;file_name&gt; (no whitespace)
  * Size: &lt;n&gt; (bytes)
  * CRC: &lt;hex&gt; (CRC-32, optional)
+ * Compression: deflate (optional)
  * END (header end mark)
  * ... &lt;n&gt; bytes of data ...</pre></blockquote>
  * When the header is detected, the {@link DspsRxLogFile output file} with the specified name is created in
@@ -63,6 +65,9 @@ NS_ASSUME_NONNULL_BEGIN
  * After all the data are received, if the header contained a CRC value, the file data CRC is validated and
  * a {@link CodelessLibEvent#DspsRxFileCrc DspsRxFileCrc} event is generated.
  *
+ * If the header contains the compression line, the file data that follow are a zlib (deflate) stream,
+ * which is decompressed as it is received. The size and CRC in the header refer to the uncompressed data.
+ *
  * NOTE: A single null byte may also be used as the header end mark. The file data start immediately after.
  * @see CodelessManager
  */
@@ -75,24 +80,29 @@ NS_ASSUME_NONNULL_BEGIN
 /// The file name.
 @property (readonly) NSString* name;
 /// The file size.
-@property (readonly) int size;
+@property (readonly) int64_t size;
 /// The file data CRC, if it is set.
 @property (readonly) int64_t crc;
 /// The log file where the received data are saved.
 @property (readonly) DspsRxLogFile* file;
 /// The number of received bytes.
-@property (readonly) int bytesReceived;
+@property (readonly) int64_t bytesReceived;
 /// <code>true</code> if the operation has started.
 @property (readonly) BOOL started;
 /// <code>true</code> if the operation is complete.
 @property (readonly) BOOL complete;
-/// The operation start time.
+/// <code>true</code> if the file data are compressed.
+@property (readonly) BOOL compressed;
+/// The operation start time (system uptime).
 @property (readonly) NSTimeInterval startTime;
-/// The operation end time.
+/// The operation end time (system uptime).
 @property (readonly) NSTimeInterval endTime;
-/// The calculated current speed.
+/// The calculated current speed, averaged over the last {@link CodelessLibConfig#DSPS_STATS_WINDOW} statistics intervals.
 /// <p> Available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
 @property (readonly) int currentSpeed;
+/// The throughput statistics of the operation.
+/// <p> The speed values are available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
+@property (readonly) DspsStats* stats;
 
 /**
  * Creates a DSPS file receive operation.
@@ -109,6 +119,17 @@ NS_ASSUME_NONNULL_BEGIN
  * <p> Available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
  */
 - (int) averageSpeed;
+/**
+ * Returns the estimated time remaining until the operation is complete, based on the {@link DspsStats#ewmaSpeed EWMA speed}.
+ * <p> Available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
+ * @return the estimated time remaining, or -1 if it is not available
+ */
+- (NSTimeInterval) eta;
+/**
+ * Performs statistics calculations and generates a {@link CodelessLibEvent#DspsStats DspsStats} event.
+ * <p> Called by the manager every {@link CodelessLibConfig#DSPS_STATS_INTERVAL}.
+ */
+- (void) updateStats;
 /**
  * Starts the file receive operation.
  * @see CodelessManager#receiveFile()
@@ -130,6 +151,7 @@ NS_ASSUME_NONNULL_BEGIN
  * Name: &lt;file_name&gt; (no whitespace)
  * Size: &lt;n&gt; (bytes)
  * CRC: &lt;hex&gt; (CRC-32, optional)
+ * Compression: deflate (optional)
  * END (header end mark)
  * ... &lt;n&gt; bytes of data ...</pre></blockquote>
  * @param data the received data
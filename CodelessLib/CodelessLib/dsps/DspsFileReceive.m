@@ -39,28 +39,31 @@
 #import "CodelessLibEvent.h"
 #import "CodelessLibConfig.h"
 #import "DspsRxLogFile.h"
+#import "DspsStats.h"
 #import <zlib.h>
 
+#define DSPS_FILE_DECOMPRESSION_BUFFER_SIZE 16384
+
 #define CodelessLogPrefix(TAG, fmt, ...) CodelessLog(TAG, "%@" fmt, self.manager.logPrefix, ##__VA_ARGS__)
-#define CodelessLogPrefixOpt(enabled, TAG, fmt, ...) CodelessLogOpt(enabled, TAG, "%@" fmt, self.manager.logPrefix, ##__VA_ARGS__)
+#define CodelessLogPrefixOpt(subsystem, TAG, fmt, ...) CodelessLogSubsystem(subsystem, TAG, "%@" fmt, self.manager.logPrefix, ##__VA_ARGS__)
 
-@interface DspsFileReceive ()
+@interface DspsFileReceive () {
+    z_stream inflater;
+}
 
 @property (weak) CodelessManager* manager;
 @property NSMutableData* header;
 @property NSString* name;
-@property int size;
+@property int64_t size;
 @property int64_t crc;
 @property DspsRxLogFile* file;
-@property int bytesReceived;
+@property int64_t bytesReceived;
 @property uint64_t crc32;
 @property BOOL started;
 @property BOOL complete;
-@property NSTimeInterval startTime;
-@property NSTimeInterval endTime;
-@property NSTimeInterval lastInterval;
-@property int bytesReceivedInterval;
-@property int currentSpeed;
+@property BOOL compressed;
+@property BOOL inflating;
+@property DspsStats* stats;
 
 @end
 
@@ -77,7 +80,7 @@ static NSString* const TAG = @"DspsFileReceive";
         return nil;
     self.manager = manager;
     self.crc = -1;
-    self.currentSpeed = CodelessManager.SPEED_INVALID;
+    self.stats = [[DspsStats alloc] init];
     return self;
 }
 
@@ -89,11 +92,24 @@ static NSString* const TAG = @"DspsFileReceive";
     return self.crc != -1 && self.crc == self.crc32;
 }
 
+- (NSTimeInterval) startTime {
+    return self.stats.startTime;
+}
+
+- (NSTimeInterval) endTime {
+    return self.stats.endTime;
+}
+
+- (int) currentSpeed {
+    return self.stats.currentSpeed;
+}
+
 - (int) averageSpeed {
-    NSTimeInterval elapsed = (self.complete ? self.endTime : [NSDate date].timeIntervalSince1970) - self.startTime;
-    if (elapsed == 0)
-        elapsed = 0.001;
-    return (int) (self.bytesReceived / elapsed);
+    return self.stats.averageSpeed;
+}
+
+- (NSTimeInterval) eta {
+    return [self.stats etaForTotal:self.size];
 }
 
 /**
@@ -101,15 +117,9 @@ static NSString* const TAG = @"DspsFileReceive";
  * <p> A {@link CodelessLibEvent#DspsStats DspsStats} event is generated.
  */
 - (void) updateStats {
-    if (self.complete)
+    if (self.complete || !self.stats.running)
         return;
-    NSTimeInterval now = [NSDate date].timeIntervalSince1970;
-    if (now == self.lastInterval)
-        now += 0.001;
-    self.currentSpeed = (int) (self.bytesReceivedInterval / (now - self.lastInterval));
-    self.lastInterval = now;
-    self.bytesReceivedInterval = 0;
-    [self performSelector:@selector(updateStats) withObject:nil afterDelay:CodelessLibConfig.DSPS_STATS_INTERVAL / 1000.];
+    [self.stats update];
     [self sendEvent:CodelessLibEvent.DspsStats object:[[DspsStatsEvent alloc] initWithManager:self.manager operation:self currentSpeed:self.currentSpeed averageSpeed:self.averageSpeed]];
 }
 
@@ -117,21 +127,26 @@ static NSString* const TAG = @"DspsFileReceive";
     if (self.started)
         return;
     self.started = true;
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "Start file receive");
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "Start file receive");
     [self.manager startFileReceive:self];
 }
 
 - (void) stop {
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "Stop file receive");
-    self.endTime = [NSDate date].timeIntervalSince1970;
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "Stop file receive");
+    [self.stats stop];
+    [self endInflate];
     if (self.file)
         [self.file close];
-    if (CodelessLibConfig.DSPS_STATS) {
-        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(updateStats) object:nil];
-    }
     [self.manager stopFileReceive:self];
 }
 
+- (void) endInflate {
+    if (!self.inflating)
+        return;
+    self.inflating = false;
+    inflateEnd(&inflater);
+}
+
 - (void) onDspsData:(NSData*)data {
     if (!self.started)
         return;
@@ -149,7 +164,7 @@ static NSString* const TAG = @"DspsFileReceive";
             if (result) {
                 *stop = true;
                 self.name = [headerText substringWithRange:[result rangeAtIndex:2]];
-                self.size = [headerText substringWithRange:[result rangeAtIndex:3]].intValue;
+                self.size = [headerText substringWithRange:[result rangeAtIndex:3]].longLongValue;
                 NSString* crcText = [result rangeAtIndex:4].location != NSNotFound ? [headerText substringWithRange:[result rangeAtIndex:4]] : nil;
                 if (crcText) {
                     uint32_t crcValue;
@@ -158,17 +173,20 @@ static NSString* const TAG = @"DspsFileReceive";
                         self.crc = crcValue;
                 }
                 int start = [result rangeAtIndex:1].location + [result rangeAtIndex:1].length;
-                int end = [result rangeAtIndex:5].location;
+                self.compressed = [result rangeAtIndex:5].location != NSNotFound;
+                int end = [result rangeAtIndex:6].location;
 
                 headerData = [self.header subdataWithRange:NSMakeRange(end, self.header.length - end)];
                 self.header = [self.header subdataWithRange:NSMakeRange(start, end - start)];
 
-                CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "File receive: %@ size=%d crc=%@", self.name, self.size, self.crc != -1 ? crcText : @"N/A");
-                self.startTime = [NSDate date].timeIntervalSince1970;
-                if (CodelessLibConfig.DSPS_STATS) {
-                    self.lastInterval = self.startTime;
-                    [self performSelector:@selector(updateStats) withObject:nil afterDelay:CodelessLibConfig.DSPS_STATS_INTERVAL / 1000.];
+                CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "File receive: %@ size=%lld crc=%@%@", self.name, self.size, self.crc != -1 ? crcText : @"N/A", self.compressed ? @" (compressed)" : @"");
+                if (self.compressed) {
+                    memset(&self->inflater, 0, sizeof(z_stream));
+                    self.inflating = inflateInit(&self->inflater) == Z_OK;
+                    if (!self.inflating)
+                        CodelessLogPrefix(TAG, "Failed to initialize decompression: %@", self.name);
                 }
+                [self.stats start];
 
                 self.file = [[DspsRxLogFile alloc] initWithFileReceive:self];
                 [self sendEvent:CodelessLibEvent.DspsRxFileData object:[[DspsRxFileDataEvent alloc] initWithManager:self.manager operation:self size:self.size bytesReceived:self.bytesReceived]];
@@ -184,23 +202,62 @@ static NSString* const TAG = @"DspsFileReceive";
     if (!self.file || data.length == 0)
         return;
 
+    if (!self.compressed) {
+        [self receiveData:data];
+        return;
+    }
+
+    // Decompress data
+    if (!self.inflating) {
+        [self stop];
+        return;
+    }
+    uint8_t buffer[DSPS_FILE_DECOMPRESSION_BUFFER_SIZE];
+    inflater.next_in = (Bytef*) data.bytes;
+    inflater.avail_in = (uInt) data.length;
+    int status;
+    do {
+        inflater.next_out = buffer;
+        inflater.avail_out = sizeof(buffer);
+        status = inflate(&inflater, Z_NO_FLUSH);
+        if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+            CodelessLogPrefix(TAG, "File receive decompression error: %@ (%d)", self.name, status);
+            [self stop];
+            return;
+        }
+        NSUInteger length = sizeof(buffer) - inflater.avail_out;
+        if (length > 0)
+            [self receiveData:[NSData dataWithBytes:buffer length:length]];
+    } while (!self.complete && status == Z_OK && (inflater.avail_in > 0 || inflater.avail_out == 0));
+
+    if (status == Z_STREAM_END && !self.complete) {
+        CodelessLogPrefix(TAG, "File receive decompressed data end: %@ %lld of %lld", self.name, self.bytesReceived, self.size);
+        [self stop];
+    }
+}
+
+/**
+ * Processes received file data (decompressed, if the file is compressed).
+ * @param data the received file data
+ */
+- (void) receiveData:(NSData*)data {
     // Write data to file
-    if (data.length > self.size - self.bytesReceived)
-        data = [NSData dataWithBytes:data.bytes length:self.size - self.bytesReceived];
+    if ((int64_t) data.length > self.size - self.bytesReceived)
+        data = [NSData dataWithBytes:data.bytes length:(NSUInteger) (self.size - self.bytesReceived)];
     self.bytesReceived += data.length;
-    self.bytesReceivedInterval += data.length;
+    [self.stats addBytes:data.length];
 
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS_FILE_CHUNK, TAG, "File receive: %@ %d of %d", self.name, self.bytesReceived, self.size);
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS_FILE_CHUNK, TAG, "File receive: %@ %lld of %lld", self.name, self.bytesReceived, self.size);
     [self.file log:data];
     if (self.crc != -1)
         self.crc32 = crc32(self.crc32, data.bytes, data.length);
 
     if (self.bytesReceived == self.size) {
-        CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "File received: %@", self.name);
+        CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "File received: %@", self.name);
         self.complete = true;
-        self.endTime = [NSDate date].timeIntervalSince1970;
+        [self.stats stop];
+        [self endInflate];
         if (CodelessLibConfig.DSPS_STATS) {
-            [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(updateStats) object:nil];
             [self sendEvent:CodelessLibEvent.DspsStats object:[[DspsStatsEvent alloc] initWithManager:self.manager operation:self currentSpeed:self.currentSpeed averageSpeed:self.averageSpeed]];
         }
         [self.file close];
@@ -216,7 +273,7 @@ static NSString* const TAG = @"DspsFileReceive";
 }
 
 - (void) sendEvent:(NSString*)event object:(CodelessEvent*)object {
-    [NSNotificationCenter.defaultCenter postNotificationName:event object:self.manager userInfo:@{ @"event" : object }];
+    [self.manager sendEvent:event object:object];
 }
 
 @end
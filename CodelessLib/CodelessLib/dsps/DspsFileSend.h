@@ -36,6 +36,7 @@
 #import <Foundation/Foundation.h>
 
 @class CodelessManager;
+@class DspsStats;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -51,8 +52,13 @@ NS_ASSUME_NONNULL_BEGIN
  * The chunks are enqueued to be sent, one every the specified {@link #period}.
  * If the period is 0, all chunks are enqueued at once, which may be slower for large files.
  *
+ * If {@link #compressed compression} is enabled, the file data are compressed (zlib deflate) before they are split
+ * into chunks, and a {@link DspsFileReceive file header} is sent first, which advertises the compression, the
+ * uncompressed size and the CRC of the uncompressed data. The peer decompresses the data as they are received.
+ *
  * If the file fails to load, a {@link CodelessLibEvent#DspsFileError DspsFileError} event is generated.
- * A {@link CodelessLibEvent#DspsFileChunk DspsFileChunk} event is generated for each chunk that is sent to the peer device.
+ * A {@link CodelessLibEvent#DspsFileChunk DspsFileChunk} event is generated for each chunk that is sent to the peer device,
+ * or for each group of chunks if {@link CodelessManager#dspsEventCoalescing coalescing} is enabled.
  * Use {@link #stop} to stop the operation. If {@link CodelessLibConfig#DSPS_STATS statistics} are enabled,
  * a {@link CodelessLibEvent#DspsStats DspsStats} event is generated every {@link CodelessLibConfig#DSPS_STATS_INTERVAL}.
  * @see CodelessManager
@@ -69,6 +75,10 @@ NS_ASSUME_NONNULL_BEGIN
 @property (readonly) int chunkSize;
 /// The file chunks.
 @property (readonly) NSArray<NSData*>* chunks;
+/// <code>true</code> if the file data are sent compressed, with a file header.
+@property (readonly) BOOL compressed;
+/// The number of bytes that are sent to the peer device (file data, or header and compressed data).
+@property (readonly) int64_t transferSize;
 /// The current chunk index (0-based).
 /// <p> Current chunk is the last chunk that was enqueued.
 @property int chunk;
@@ -83,16 +93,19 @@ NS_ASSUME_NONNULL_BEGIN
 @property (readonly) BOOL started;
 /// <code>true</code> if the operation is complete.
 @property (readonly) BOOL complete;
-/// The operation start time.
+/// The operation start time (system uptime).
 @property (readonly) NSTimeInterval startTime;
-/// The operation end time.
+/// The operation end time (system uptime).
 @property (readonly) NSTimeInterval endTime;
 /// The total number of sent bytes.
 /// <p> Available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
-@property (readonly) int bytesSent;
-/// The calculated current speed.
+@property (readonly) int64_t bytesSent;
+/// The calculated current speed, averaged over the last {@link CodelessLibConfig#DSPS_STATS_WINDOW} statistics intervals.
 /// <p> Available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
 @property (readonly) int currentSpeed;
+/// The throughput statistics of the operation.
+/// <p> The speed values are available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
+@property (readonly) DspsStats* stats;
 
 /**
  * Creates a DSPS file send operation.
@@ -103,6 +116,16 @@ NS_ASSUME_NONNULL_BEGIN
  *                  Set to 0 to enqueue all chunks (may be slower for large files).
  */
 - (instancetype) initWithManager:(CodelessManager*)manager file:(NSString*)file chunkSize:(int)chunkSize period:(int)period;
+/**
+ * Creates a DSPS file send operation, with optional compression.
+ * @param manager       the associated manager
+ * @param file          the file to send
+ * @param chunkSize     the chunk size to use when splitting the file
+ * @param period        the chunks enqueueing period (ms).
+ *                      Set to 0 to enqueue all chunks (may be slower for large files).
+ * @param compressed    <code>true</code> to send a file header and the compressed file data
+ */
+- (instancetype) initWithManager:(CodelessManager*)manager file:(NSString*)file chunkSize:(int)chunkSize period:(int)period compressed:(BOOL)compressed;
 /**
  * Creates a DSPS file send operation, using the manager's chunk size.
  * @param manager   the associated manager
@@ -119,6 +142,19 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (instancetype) initWithManager:(CodelessManager*)manager file:(NSString*)file;
 
+/**
+ * Creates the compressed transfer data for some file data: a file header followed by the zlib deflate stream.
+ * <p> The header contains the name, the uncompressed size, the CRC-32 of the uncompressed data and the compression method.
+ * The data are compressed in a single streaming pass, using a bounded output buffer.
+ * <p> The whole output is kept in memory: header and compressed data, up to the file size for incompressible data.
+ * The file send operation then also copies the output into chunks, so a compressed send of an N byte file may hold
+ * up to about 2N bytes of memory, in addition to the (memory-mapped) file data.
+ * @param data  the file data
+ * @param name  the file name sent in the header (whitespace is replaced)
+ * @return the transfer data, or <code>nil</code> if compression failed
+ */
++ (nullable NSData*) compressedTransferData:(NSData*)data name:(NSString*)name;
+
 /// Returns the current chunk.
 - (NSData*) getCurrentChunk;
 /**
@@ -137,11 +173,22 @@ NS_ASSUME_NONNULL_BEGIN
  * <p> Available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
  */
 - (int) averageSpeed;
+/**
+ * Returns the estimated time remaining until the operation is complete, based on the {@link DspsStats#ewmaSpeed EWMA speed}.
+ * <p> Available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
+ * @return the estimated time remaining, or -1 if it is not available
+ */
+- (NSTimeInterval) eta;
 /**
  * Updates the byte counters used in statistics calculations.
  * @param bytes the number of sent bytes
  */
-- (void) updateBytesSent:(int)bytes;
+- (void) updateBytesSent:(int64_t)bytes;
+/**
+ * Performs statistics calculations and generates a {@link CodelessLibEvent#DspsStats DspsStats} event.
+ * <p> Called by the manager every {@link CodelessLibConfig#DSPS_STATS_INTERVAL}.
+ */
+- (void) updateStats;
 /// Checks if the file is loaded properly.
 - (BOOL) isLoaded;
 /**
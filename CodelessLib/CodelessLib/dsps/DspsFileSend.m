@@ -38,8 +38,13 @@
 #import "CodelessLibLog.h"
 #import "CodelessLibEvent.h"
 #import "CodelessLibConfig.h"
+#import "DspsStats.h"
+#import <zlib.h>
 
-#define CodelessLogPrefixOpt(enabled, TAG, fmt, ...) CodelessLogOpt(enabled, TAG, "%@" fmt, self.manager.logPrefix, ##__VA_ARGS__)
+/// Output buffer size used for streaming compression.
+#define DSPS_FILE_COMPRESSION_BUFFER_SIZE   16384
+
+#define CodelessLogPrefixOpt(subsystem, TAG, fmt, ...) CodelessLogSubsystem(subsystem, TAG, "%@" fmt, self.manager.logPrefix, ##__VA_ARGS__)
 
 @interface DspsFileSend ()
 
@@ -51,12 +56,9 @@
 @property int period;
 @property BOOL started;
 @property BOOL complete;
-@property NSTimeInterval startTime;
-@property NSTimeInterval endTime;
-@property int bytesSent;
-@property NSTimeInterval lastInterval;
-@property int bytesSentInterval;
-@property int currentSpeed;
+@property BOOL compressed;
+@property int64_t transferSize;
+@property DspsStats* stats;
 
 @end
 
@@ -67,7 +69,7 @@ static NSString* const TAG = @"DspsFileSend";
     return TAG;
 }
 
-- (instancetype) initWithManager:(CodelessManager*)manager file:(NSString*)file chunkSize:(int)chunkSize period:(int)period {
+- (instancetype) initWithManager:(CodelessManager*)manager file:(NSString*)file chunkSize:(int)chunkSize period:(int)period compressed:(BOOL)compressed {
     self = [super init];
     if (!self)
         return nil;
@@ -75,11 +77,16 @@ static NSString* const TAG = @"DspsFileSend";
     self.file = file;
     self.chunkSize = MIN(chunkSize, manager.dspsChunkSize);
     self.period = period;
-    self.currentSpeed = CodelessManager.SPEED_INVALID;
+    self.compressed = compressed;
+    self.stats = [[DspsStats alloc] init];
     [self loadFile];
     return self;
 }
 
+- (instancetype) initWithManager:(CodelessManager*)manager file:(NSString*)file chunkSize:(int)chunkSize period:(int)period {
+    return self = [self initWithManager:manager file:file chunkSize:chunkSize period:period compressed:false];
+}
+
 - (instancetype) initWithManager:(CodelessManager*)manager file:(NSString*)file period:(int)period {
     return self = [self initWithManager:manager file:file chunkSize:manager.dspsChunkSize period:period];
 }
@@ -98,23 +105,38 @@ static NSString* const TAG = @"DspsFileSend";
 
 - (void) setComplete {
     self.complete = true;
-    self.endTime = [NSDate date].timeIntervalSince1970;
+    [self.stats stop];
     if (CodelessLibConfig.DSPS_STATS) {
-        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(updateStats) object:nil];
         [self sendEvent:CodelessLibEvent.DspsStats object:[[DspsStatsEvent alloc] initWithManager:self.manager operation:self currentSpeed:self.currentSpeed averageSpeed:self.averageSpeed]];
     }
 }
 
+- (NSTimeInterval) startTime {
+    return self.stats.startTime;
+}
+
+- (NSTimeInterval) endTime {
+    return self.stats.endTime;
+}
+
+- (int64_t) bytesSent {
+    return self.stats.bytes;
+}
+
+- (int) currentSpeed {
+    return self.stats.currentSpeed;
+}
+
 - (int) averageSpeed {
-    NSTimeInterval elapsed = (self.complete ? self.endTime : [NSDate date].timeIntervalSince1970) - self.startTime;
-    if (elapsed == 0)
-        elapsed = 0.001;
-    return (int) (self.bytesSent / elapsed);
+    return self.stats.averageSpeed;
 }
 
-- (void) updateBytesSent:(int)bytes {
-    self.bytesSent += bytes;
-    self.bytesSentInterval += bytes;
+- (NSTimeInterval) eta {
+    return [self.stats etaForTotal:self.transferSize];
+}
+
+- (void) updateBytesSent:(int64_t)bytes {
+    [self.stats addBytes:bytes];
 }
 
 /**
@@ -122,15 +144,9 @@ static NSString* const TAG = @"DspsFileSend";
  * <p> A {@link CodelessLibEvent#DspsStats DspsStats} event is generated.
  */
 - (void) updateStats {
-    if (self.complete)
+    if (self.complete || !self.stats.running)
         return;
-    NSTimeInterval now = [NSDate date].timeIntervalSince1970;
-    if (now == self.lastInterval)
-        now += 0.001;
-    self.currentSpeed = (int) (self.bytesSentInterval / (now - self.lastInterval));
-    self.lastInterval = now;
-    self.bytesSentInterval = 0;
-    [self performSelector:@selector(updateStats) withObject:nil afterDelay:CodelessLibConfig.DSPS_STATS_INTERVAL / 1000.];
+    [self.stats update];
     [self sendEvent:CodelessLibEvent.DspsStats object:[[DspsStatsEvent alloc] initWithManager:self.manager operation:self currentSpeed:self.currentSpeed averageSpeed:self.averageSpeed]];
 }
 
@@ -139,10 +155,10 @@ static NSString* const TAG = @"DspsFileSend";
  * <p> If the file fails to load, a {@link CodelessLibEvent#DspsFileError DspsFileError} event is generated.
  */
 - (void) loadFile {
-    CodelessLogOpt(CodelessLibLog.DSPS, TAG, "Load file: %@", self.file);
+    CodelessLogSubsystem(CODELESS_LOG_DSPS, TAG, "Load file: %@", self.file);
 
     NSError* error;
-    NSData* data = [NSData dataWithContentsOfFile:self.file options:0 error:&error];
+    NSData* data = [NSData dataWithContentsOfFile:self.file options:NSDataReadingMappedIfSafe error:&error];
     if (error)
         CodelessLog(TAG, "Failed to load file: %@ %@", self.file, error);
     if (!data || data.length == 0) {
@@ -150,14 +166,67 @@ static NSString* const TAG = @"DspsFileSend";
         return;
     }
 
-    self.totalChunks = data.length / self.chunkSize + (data.length % self.chunkSize != 0 ? 1 : 0);
+    if (self.compressed) {
+        NSUInteger size = data.length;
+        data = [DspsFileSend compressedTransferData:data name:self.file.lastPathComponent];
+        if (!data) {
+            CodelessLog(TAG, "Failed to compress file: %@", self.file);
+            [self sendEvent:CodelessLibEvent.DspsFileError object:[[DspsFileErrorEvent alloc] initWithManager:self.manager operation:self]];
+            return;
+        }
+        CodelessLogSubsystem(CODELESS_LOG_DSPS, TAG, "Compressed file: %@ %llu -> %llu bytes", self.file, (unsigned long long) size, (unsigned long long) data.length);
+    }
+
+    self.transferSize = data.length;
+    self.totalChunks = (int) (data.length / self.chunkSize + (data.length % self.chunkSize != 0 ? 1 : 0));
     NSMutableArray* chunks = [NSMutableArray arrayWithCapacity:self.totalChunks];
-    for (int i = 0; i < data.length; i += self.chunkSize) {
+    for (NSUInteger i = 0; i < data.length; i += self.chunkSize) {
         [chunks addObject:[NSData dataWithBytes:(uint8_t*)data.bytes + i length:MIN(self.chunkSize, data.length - i)]];
     }
     self.chunks = [NSArray arrayWithArray:chunks];
 }
 
++ (NSData*) compressedTransferData:(NSData*)data name:(NSString*)name {
+    name = [[name componentsSeparatedByCharactersInSet:NSCharacterSet.whitespaceAndNewlineCharacterSet] componentsJoinedByString:@"_"];
+    if (name.length > 100)
+        name = [name substringFromIndex:name.length - 100];
+    // zlib lengths are uInt, so the data are processed in chunks of at most UINT_MAX bytes.
+    uLong crc = 0;
+    const Bytef* input = data.bytes;
+    NSUInteger remaining = data.length;
+    while (remaining) {
+        uInt length = (uInt) MIN(remaining, UINT_MAX);
+        crc = crc32(crc, input, length);
+        input += length;
+        remaining -= length;
+    }
+    NSString* header = [NSString stringWithFormat:@"Name: %@\nSize: %llu\nCRC: %08lx\nCompression: deflate\nEND\n", name, (unsigned long long) data.length, crc];
+    NSMutableData* output = [[header dataUsingEncoding:NSASCIIStringEncoding allowLossyConversion:true] mutableCopy];
+
+    z_stream stream = {0};
+    if (deflateInit(&stream, CodelessLibConfig.DSPS_FILE_COMPRESSION_LEVEL) != Z_OK)
+        return nil;
+    uint8_t buffer[DSPS_FILE_COMPRESSION_BUFFER_SIZE];
+    input = data.bytes;
+    remaining = data.length;
+    int result;
+    do {
+        if (!stream.avail_in && remaining) {
+            uInt length = (uInt) MIN(remaining, UINT_MAX);
+            stream.next_in = (Bytef*) input;
+            stream.avail_in = length;
+            input += length;
+            remaining -= length;
+        }
+        stream.next_out = buffer;
+        stream.avail_out = sizeof(buffer);
+        result = deflate(&stream, remaining ? Z_NO_FLUSH : Z_FINISH);
+        [output appendBytes:buffer length:sizeof(buffer) - stream.avail_out];
+    } while (result == Z_OK);
+    deflateEnd(&stream);
+    return result == Z_STREAM_END ? output : nil;
+}
+
 - (BOOL) isLoaded {
     return self.chunks != nil;
 }
@@ -166,35 +235,28 @@ static NSString* const TAG = @"DspsFileSend";
     if (self.started)
         return;
     self.started = true;
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "Start file send: %@", self);
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "Start file send: %@", self);
     self.chunk = -1;
-    self.startTime = [NSDate date].timeIntervalSince1970;
-    if (CodelessLibConfig.DSPS_STATS) {
-        self.lastInterval = self.startTime;
-        [self performSelector:@selector(updateStats) withObject:nil afterDelay:CodelessLibConfig.DSPS_STATS_INTERVAL / 1000.];
-    }
+    [self.stats start];
     [self.manager startFile:self resume:false];
 }
 
 - (void) stop {
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "Stop file send: %@", self);
-    self.endTime = [NSDate date].timeIntervalSince1970;
-    if (CodelessLibConfig.DSPS_STATS) {
-        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(updateStats) object:nil];
-    }
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "Stop file send: %@", self);
+    [self.stats stop];
     [self.manager stopFile:self];
 }
 
 - (void) sendChunk {
     self.chunk++;
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS_FILE_CHUNK, TAG, "Queue file chunk: %@ %d of %d", self, self.chunk + 1, self.totalChunks);
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS_FILE_CHUNK, TAG, "Queue file chunk: %@ %d of %d", self, self.chunk + 1, self.totalChunks);
     [self.manager sendFileData:self];
     if (self.chunk < self.totalChunks - 1)
         [self performSelector:@selector(sendChunk) withObject:nil afterDelay:self.period / 1000.];
 }
 
 - (void) sendEvent:(NSString*)event object:(CodelessEvent*)object {
-    [NSNotificationCenter.defaultCenter postNotificationName:event object:self.manager userInfo:@{ @"event" : object }];
+    [self.manager sendEvent:event object:object];
 }
 
 - (NSString*) description {
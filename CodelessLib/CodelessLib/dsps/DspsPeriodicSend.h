@@ -36,6 +36,7 @@
 #import <Foundation/Foundation.h>
 
 @class CodelessManager;
+@class DspsStats;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -66,7 +67,8 @@ NS_ASSUME_NONNULL_BEGIN
  *
  * Use one of the {@link CodelessManager#sendPattern:chunkSize:period: sendPattern} methods to create and {@link #start} the operation,
  * which will run until {@link #stop} is called. If the pattern fails to load, a {@link CodelessLibEvent#DspsPatternFileError DspsPatternFileError}
- * event is generated. A {@link CodelessLibEvent#DspsPatternChunk DspsPatternChunk} event is generated for each packet that is sent to the peer device.
+ * event is generated. A {@link CodelessLibEvent#DspsPatternChunk DspsPatternChunk} event is generated for each packet that is sent to the peer device,
+ * or for each group of packets if {@link CodelessManager#dspsEventCoalescing coalescing} is enabled.
  *
  * For example, if the pattern file contains the text "abcdefgh" and 4 digits with end of line are used,
  * the pattern will be the following, with one packet sent per line:
@@ -107,16 +109,19 @@ NS_ASSUME_NONNULL_BEGIN
 /// The pattern counter of the last sent packet.
 /// <p> Set by the library when a pattern packet is sent to the peer device.
 @property int patternSentCount;
-/// The operation start time.
+/// The operation start time (system uptime).
 @property (readonly) NSTimeInterval startTime;
-/// The operation end time.
+/// The operation end time (system uptime).
 @property (readonly) NSTimeInterval endTime;
 /// The total number of sent bytes.
 /// <p> Available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
-@property (readonly) int bytesSent;
-/// The calculated current speed.
+@property (readonly) int64_t bytesSent;
+/// The calculated current speed, averaged over the last {@link CodelessLibConfig#DSPS_STATS_WINDOW} statistics intervals.
 /// <p> Available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
 @property (readonly) int currentSpeed;
+/// The throughput statistics of the operation.
+/// <p> The speed values are available only if {@link CodelessLibConfig#DSPS_STATS statistics} are enabled.
+@property (readonly) DspsStats* stats;
 
 /**
  * Creates a DSPS periodic send operation, which sends a data packet periodically to the peer device.
@@ -187,7 +192,12 @@ NS_ASSUME_NONNULL_BEGIN
  * Updates the byte counters used in statistics calculations.
  * @param bytes the number of sent bytes
  */
-- (void) updateBytesSent:(int)bytes;
+- (void) updateBytesSent:(int64_t)bytes;
+/**
+ * Performs statistics calculations and generates a {@link CodelessLibEvent#DspsStats DspsStats} event.
+ * <p> Called by the manager every {@link CodelessLibConfig#DSPS_STATS_INTERVAL}.
+ */
+- (void) updateStats;
 /// Checks if the pattern is loaded properly.
 - (BOOL) isLoaded;
 /**
@@ -39,8 +39,10 @@
 #import "CodelessLibLog.h"
 #import "CodelessUtil.h"
 #import "CodelessLibEvent.h"
+#import "DspsStats.h"
 
-#define CodelessLogPrefixOpt(enabled, TAG, fmt, ...) CodelessLogOpt(enabled, TAG, "%@" fmt, self.manager.logPrefix, ##__VA_ARGS__)
+#define CodelessLogPrefixOpt(subsystem, TAG, fmt, ...) CodelessLogSubsystem(subsystem, TAG, "%@" fmt, self.manager.logPrefix, ##__VA_ARGS__)
+#define CodelessLogPrefixDataOpt(subsystem, TAG, data, fmt, ...) CodelessLogDataSubsystem(subsystem, TAG, data, "%@" fmt, self.manager.logPrefix, ##__VA_ARGS__)
 
 @interface DspsPeriodicSend ()
 
@@ -53,12 +55,7 @@
 @property BOOL pattern;
 @property int patternMaxCount;
 @property NSString* patternFormat;
-@property NSTimeInterval startTime;
-@property NSTimeInterval endTime;
-@property int bytesSent;
-@property NSTimeInterval lastInterval;
-@property int bytesSentInterval;
-@property int currentSpeed;
+@property DspsStats* stats;
 
 @end
 
@@ -77,7 +74,7 @@ static NSString* const TAG = @"DspsPeriodicSend";
     self.period = period;
     self.data = data;
     self.chunkSize = chunkSize;
-    self.currentSpeed = CodelessManager.SPEED_INVALID;
+    self.stats = [[DspsStats alloc] init];
     return self;
 }
 
@@ -100,7 +97,7 @@ static NSString* const TAG = @"DspsPeriodicSend";
     self.manager = manager;
     self.chunkSize = MAX(MIN(chunkSize, manager.dspsChunkSize), CodelessLibConfig.DSPS_PATTERN_DIGITS + (int) (CodelessLibConfig.DSPS_PATTERN_SUFFIX ? CodelessLibConfig.DSPS_PATTERN_SUFFIX.length : 0));
     self.period = period;
-    self.currentSpeed = CodelessManager.SPEED_INVALID;
+    self.stats = [[DspsStats alloc] init];
     self.pattern = true;
     self.patternMaxCount = (int) pow(10, CodelessLibConfig.DSPS_PATTERN_DIGITS);
     self.patternFormat = [NSString stringWithFormat:@"%%0%dd", CodelessLibConfig.DSPS_PATTERN_DIGITS];
@@ -120,16 +117,28 @@ static NSString* const TAG = @"DspsPeriodicSend";
     return (self.count - 1) % self.patternMaxCount;
 }
 
+- (NSTimeInterval) startTime {
+    return self.stats.startTime;
+}
+
+- (NSTimeInterval) endTime {
+    return self.stats.endTime;
+}
+
+- (int64_t) bytesSent {
+    return self.stats.bytes;
+}
+
+- (int) currentSpeed {
+    return self.stats.currentSpeed;
+}
+
 - (int) averageSpeed {
-    NSTimeInterval elapsed = (!self.active ? self.endTime : [NSDate date].timeIntervalSince1970) - self.startTime;
-    if (elapsed == 0)
-        elapsed = 0.001;
-    return (int) (self.bytesSent / elapsed);
+    return self.stats.averageSpeed;
 }
 
-- (void) updateBytesSent:(int)bytes {
-    self.bytesSent += bytes;
-    self.bytesSentInterval += bytes;
+- (void) updateBytesSent:(int64_t)bytes {
+    [self.stats addBytes:bytes];
 }
 
 /**
@@ -137,15 +146,9 @@ static NSString* const TAG = @"DspsPeriodicSend";
  * <p> A {@link CodelessLibEvent#DspsStats DspsStats} event is generated.
  */
 - (void) updateStats {
-    if (!self.active)
+    if (!self.active || !self.stats.running)
         return;
-    NSTimeInterval now = [NSDate date].timeIntervalSince1970;
-    if (now == self.lastInterval)
-        now += 0.001;
-    self.currentSpeed = (int) (self.bytesSentInterval / (now - self.lastInterval));
-    self.lastInterval = now;
-    self.bytesSentInterval = 0;
-    [self performSelector:@selector(updateStats) withObject:nil afterDelay:CodelessLibConfig.DSPS_STATS_INTERVAL / 1000.];
+    [self.stats update];
     [self sendEvent:CodelessLibEvent.DspsStats object:[[DspsStatsEvent alloc] initWithManager:self.manager operation:self currentSpeed:self.currentSpeed averageSpeed:self.averageSpeed]];
 }
 
@@ -153,23 +156,16 @@ static NSString* const TAG = @"DspsPeriodicSend";
     if (self.active)
         return;
     self.active = true;
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "Start periodic send%@: period=%dms %@", self.pattern ? @" (pattern)" : @"", self.period, [CodelessUtil hexArrayLog:self.data]);
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "Start periodic send%@: period=%dms %@", self.pattern ? @" (pattern)" : @"", self.period, [CodelessUtil hexArrayLog:self.data]);
     self.count = 0;
-    self.startTime = [NSDate date].timeIntervalSince1970;
-    if (CodelessLibConfig.DSPS_STATS) {
-        self.lastInterval = self.startTime;
-        [self performSelector:@selector(updateStats) withObject:nil afterDelay:CodelessLibConfig.DSPS_STATS_INTERVAL / 1000.];
-    }
+    [self.stats start];
     [self.manager startPeriodic:self];
 }
 
 - (void) stop {
     self.active = false;
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS, TAG, "Stop periodic send%@: period=%dms %@", self.pattern ? @" (pattern)" : @"", self.period, [CodelessUtil hexArrayLog:self.data]);
-    self.endTime = [NSDate date].timeIntervalSince1970;
-    if (CodelessLibConfig.DSPS_STATS) {
-        [NSTimer cancelPreviousPerformRequestsWithTarget:self selector:@selector(updateStats) object:nil];
-    }
+    CodelessLogPrefixOpt(CODELESS_LOG_DSPS, TAG, "Stop periodic send%@: period=%dms %@", self.pattern ? @" (pattern)" : @"", self.period, [CodelessUtil hexArrayLog:self.data]);
+    [self.stats stop];
     [self.manager stopPeriodic:self];
 }
 
@@ -180,7 +176,7 @@ static NSString* const TAG = @"DspsPeriodicSend";
         int position = self.data.length - CodelessLibConfig.DSPS_PATTERN_DIGITS - (CodelessLibConfig.DSPS_PATTERN_SUFFIX ? CodelessLibConfig.DSPS_PATTERN_SUFFIX.length : 0);
         memcpy((uint8_t*)((NSMutableData*)self.data).mutableBytes + position, patternBytes.bytes, CodelessLibConfig.DSPS_PATTERN_DIGITS);
     }
-    CodelessLogPrefixOpt(CodelessLibLog.DSPS_PERIODIC_CHUNK, TAG, "Queue periodic data (%d): %@", self.count, [CodelessUtil hexArrayLog:self.data]);
+    CodelessLogPrefixDataOpt(CODELESS_LOG_DSPS_PERIODIC_CHUNK, TAG, self.data, "Queue periodic data (%d): ", self.count);
     [self.manager sendPeriodicData:self];
     [self performSelector:@selector(sendData) withObject:nil afterDelay:self.period / 1000.];
 }
@@ -191,7 +187,7 @@ static NSString* const TAG = @"DspsPeriodicSend";
  * @param file  the selected file
  */
 - (void) loadPattern:(NSString*)file {
-    CodelessLogOpt(CodelessLibLog.DSPS, TAG, "Load pattern: %@", file);
+    CodelessLogSubsystem(CODELESS_LOG_DSPS, TAG, "Load pattern: %@", file);
 
     NSError* error;
     NSData* pattern = [NSData dataWithContentsOfFile:file options:0 error:&error];
@@ -217,7 +213,7 @@ static NSString* const TAG = @"DspsPeriodicSend";
 }
 
 - (void) sendEvent:(NSString*)event object:(CodelessEvent*)object {
-    [NSNotificationCenter.defaultCenter postNotificationName:event object:self.manager userInfo:@{ @"event" : object }];
+    [self.manager sendEvent:event object:object];
 }
 
 @end
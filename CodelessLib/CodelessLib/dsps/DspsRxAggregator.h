@@ -0,0 +1,162 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+@class CodelessManager;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * DSPS RX aggregate frame types.
+ * @see DspsRxAggregator
+ */
+enum DSPS_RX_AGGREGATE_FRAME {
+    /// Data: the received DSPS data.
+    DSPS_RX_AGGREGATE_DATA,
+    /// Data: the source name (UTF-8). Written when a source is added.
+    DSPS_RX_AGGREGATE_SOURCE,
+    /// Data: the number of dropped data frames (uint32) and bytes (uint64), since the previous drop frame of the source.
+    DSPS_RX_AGGREGATE_DROP,
+};
+
+/// The DSPS RX aggregate file magic ("DRA" and version).
+#define DSPS_RX_AGGREGATE_MAGIC   "DRA\x01"
+/// The DSPS RX aggregate frame header size: source (uint16), type (uint8), reserved (uint8), sequence (uint32), time in us (uint64), data length (uint32), little endian.
+#define DSPS_RX_AGGREGATE_FRAME_HEADER_SIZE   20
+
+
+/// Per source counters of a {@link DspsRxAggregator}.
+@interface DspsRxAggregatorSource : NSObject
+
+/// The source index, used in the frame header.
+@property (readonly) int index;
+/// The source name (the device identifier or the transport description).
+@property (readonly) NSString* name;
+/// The sequence number of the next data frame. Dropped frames also consume a sequence number.
+@property (readonly) uint32_t sequence;
+/// The number of data frames written.
+@property (readonly) int64_t frames;
+/// The number of data bytes written.
+@property (readonly) int64_t bytes;
+/// The number of dropped data frames.
+@property (readonly) int64_t droppedFrames;
+/// The number of dropped data bytes.
+@property (readonly) int64_t droppedBytes;
+
+@end
+
+
+/**
+ * Merges the DSPS received data of many managers into a single ordered, timestamped, framed output.
+ *
+ * Each added manager forwards its received DSPS data to the aggregator, instead of using a separate
+ * {@link CodelessLibConfig#DSPS_RX_LOG DSPS RX log file}. Each data packet becomes a frame with the source index,
+ * a per source sequence number and the time since the aggregator was created (monotonic). Frames are appended in
+ * arrival order to a buffer, which is handed to a single background writer every {@link CodelessLibConfig#DSPS_RX_AGGREGATE_BUFFER_SIZE}
+ * bytes or {@link CodelessLibConfig#DSPS_RX_AGGREGATE_FLUSH_INTERVAL}. The output is either a file or a callback.
+ * <p> If the writer falls behind more than {@link CodelessLibConfig#DSPS_RX_AGGREGATE_MAX_PENDING}, incoming data are
+ * dropped. Dropped data are counted per source, and reported in the output with a {@link DSPS_RX_AGGREGATE_DROP} frame
+ * when writing resumes. Gaps in the sequence numbers also show the dropped frames.
+ * <p> Output format: {@link DSPS_RX_AGGREGATE_MAGIC} followed by frames. Each frame consists of a
+ * {@link DSPS_RX_AGGREGATE_FRAME_HEADER_SIZE header} and its data.
+ *
+ * For example:
+ * <blockquote><pre>
+ * DspsRxAggregator* aggregator = [[DspsRxAggregator alloc] initWithFile:path];
+ * for (CodelessManager* manager in managers)
+ *     [aggregator addManager:manager];
+ * ...
+ * [aggregator close];</pre></blockquote>
+ * NOTE: The aggregator must be used from the queue where the manager events are generated (main queue).
+ */
+@interface DspsRxAggregator : NSObject
+
+@property (class, readonly) NSString* TAG;
+
+/// The output file path, or <code>nil</code> if a handler is used.
+@property (readonly, nullable) NSString* file;
+/// The added sources.
+@property (readonly) NSArray<DspsRxAggregatorSource*>* sources;
+/// The number of data frames written.
+@property (readonly) int64_t frames;
+/// The number of data bytes written.
+@property (readonly) int64_t bytes;
+/// The number of dropped data frames.
+@property (readonly) int64_t droppedFrames;
+/// <code>true</code> if the aggregator has been closed.
+@property (readonly) BOOL closed;
+
+/**
+ * Creates an aggregator that writes to a file.
+ * @param file the output file path (overwritten)
+ */
+- (instancetype) initWithFile:(NSString*)file;
+/**
+ * Creates an aggregator that passes the output to a handler.
+ * @param handler the handler that receives the output blocks, called in order on a background queue
+ */
+- (instancetype) initWithHandler:(void (^)(NSData* block))handler;
+
+/**
+ * Adds a manager as a source.
+ * <p> The manager received DSPS data are forwarded to the aggregator.
+ * @param manager the manager to add
+ * @return the added source
+ */
+- (DspsRxAggregatorSource*) addManager:(CodelessManager*)manager;
+/**
+ * Removes a manager. The source counters are kept.
+ * @param manager the manager to remove
+ */
+- (void) removeManager:(CodelessManager*)manager;
+/// Returns the source of a manager, or <code>nil</code> if the manager has not been added.
+- (nullable DspsRxAggregatorSource*) sourceForManager:(CodelessManager*)manager;
+
+/**
+ * Appends a data frame for the received DSPS data of a manager.
+ * <p> Called by the manager when DSPS data are received.
+ * @param manager   the manager that received the data
+ * @param data      the received data
+ */
+- (void) manager:(CodelessManager*)manager didReceiveData:(NSData*)data;
+/// Hands any buffered frames to the writer.
+- (void) flush;
+/// Removes all managers, writes any buffered frames and closes the output. Waits for the writer to finish.
+- (void) close;
+
+@end
+
+NS_ASSUME_NONNULL_END
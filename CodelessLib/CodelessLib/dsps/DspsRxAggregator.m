@@ -0,0 +1,269 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "DspsRxAggregator.h"
+#import "CodelessManager.h"
+#import "CodelessLibConfig.h"
+#import "CodelessLibLog.h"
+#import <stdatomic.h>
+
+@interface DspsRxAggregatorSource ()
+
+@property int index;
+@property NSString* name;
+@property uint32_t sequence;
+@property int64_t frames;
+@property int64_t bytes;
+@property int64_t droppedFrames;
+@property int64_t droppedBytes;
+/// Dropped data not yet reported with a drop frame.
+@property uint32_t unreportedFrames;
+@property uint64_t unreportedBytes;
+
+@end
+
+@implementation DspsRxAggregatorSource
+
+- (NSString*) description {
+    return [NSString stringWithFormat:@"%d %@ frames=%lld bytes=%lld dropped=%lld/%lld", self.index, self.name, self.frames, self.bytes, self.droppedFrames, self.droppedBytes];
+}
+
+@end
+
+
+@interface DspsRxAggregator () {
+    /// The amount of data handed to the writer and not yet written.
+    _Atomic int64_t pending;
+}
+
+@property (nullable) NSString* file;
+@property (nullable) NSFileHandle* handle;
+@property (nullable, copy) void (^handler)(NSData* block);
+@property dispatch_queue_t writerQueue;
+@property NSMutableArray<DspsRxAggregatorSource*>* sourceList;
+@property NSMapTable<CodelessManager*, DspsRxAggregatorSource*>* managers;
+@property NSMutableData* buffer;
+@property NSTimeInterval startTime;
+@property BOOL flushScheduled;
+@property int64_t frames;
+@property int64_t bytes;
+@property int64_t droppedFrames;
+@property BOOL closed;
+
+@end
+
+@implementation DspsRxAggregator
+
+static NSString* const TAG = @"DspsRxAggregator";
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) initWithOutput {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.writerQueue = dispatch_queue_create("DspsRxAggregator", DISPATCH_QUEUE_SERIAL);
+    self.sourceList = [NSMutableArray array];
+    self.managers = [NSMapTable weakToStrongObjectsMapTable];
+    self.buffer = [NSMutableData dataWithCapacity:CodelessLibConfig.DSPS_RX_AGGREGATE_BUFFER_SIZE];
+    [self.buffer appendBytes:DSPS_RX_AGGREGATE_MAGIC length:4];
+    self.startTime = NSProcessInfo.processInfo.systemUptime;
+    atomic_init(&pending, 0);
+    return self;
+}
+
+- (instancetype) initWithFile:(NSString*)file {
+    self = [self initWithOutput];
+    if (!self)
+        return nil;
+    self.file = file;
+    if ([NSFileManager.defaultManager createFileAtPath:file contents:nil attributes:nil])
+        self.handle = [NSFileHandle fileHandleForWritingAtPath:file];
+    if (!self.handle) {
+        CodelessLog(TAG, "Failed to create aggregate file: %@", file);
+        self.closed = true;
+    }
+    return self;
+}
+
+- (instancetype) initWithHandler:(void (^)(NSData* block))handler {
+    self = [self initWithOutput];
+    if (!self)
+        return nil;
+    self.handler = handler;
+    return self;
+}
+
+- (void) dealloc {
+    [self close];
+}
+
+- (NSArray<DspsRxAggregatorSource*>*) sources {
+    return [NSArray arrayWithArray:self.sourceList];
+}
+
+- (DspsRxAggregatorSource*) addManager:(CodelessManager*)manager {
+    DspsRxAggregatorSource* source = [self.managers objectForKey:manager];
+    if (source)
+        return source;
+    source = [[DspsRxAggregatorSource alloc] init];
+    source.index = (int) self.sourceList.count;
+    source.name = manager.device ? manager.device.identifier.UUIDString : manager.transport.description;
+    [self.sourceList addObject:source];
+    [self.managers setObject:source forKey:manager];
+    manager.dspsRxAggregator = self;
+    CodelessLog(TAG, "Add source %d: %@", source.index, source.name);
+    NSData* name = [source.name dataUsingEncoding:NSUTF8StringEncoding];
+    [self appendFrame:DSPS_RX_AGGREGATE_SOURCE source:source sequence:0 bytes:name.bytes length:(uint32_t) name.length];
+    return source;
+}
+
+- (void) removeManager:(CodelessManager*)manager {
+    if (![self.managers objectForKey:manager])
+        return;
+    [self.managers removeObjectForKey:manager];
+    if (manager.dspsRxAggregator == self)
+        manager.dspsRxAggregator = nil;
+}
+
+- (DspsRxAggregatorSource*) sourceForManager:(CodelessManager*)manager {
+    return [self.managers objectForKey:manager];
+}
+
+- (void) manager:(CodelessManager*)manager didReceiveData:(NSData*)data {
+    DspsRxAggregatorSource* source = [self.managers objectForKey:manager];
+    if (!source || self.closed)
+        return;
+    uint32_t sequence = source.sequence++;
+
+    if (atomic_load_explicit(&pending, memory_order_relaxed) + (int64_t) self.buffer.length > CodelessLibConfig.DSPS_RX_AGGREGATE_MAX_PENDING) {
+        source.droppedFrames++;
+        source.droppedBytes += data.length;
+        source.unreportedFrames++;
+        source.unreportedBytes += data.length;
+        self.droppedFrames++;
+        return;
+    }
+
+    if (source.unreportedFrames) {
+        uint8_t drop[12];
+        uint32_t frames = source.unreportedFrames;
+        uint64_t bytes = source.unreportedBytes;
+        for (int i = 0; i < 4; ++i)
+            drop[i] = frames >> (8 * i);
+        for (int i = 0; i < 8; ++i)
+            drop[4 + i] = bytes >> (8 * i);
+        CodelessLogSubsystem(CODELESS_LOG_DSPS, TAG, "Source %d: dropped %u frames, %llu bytes", source.index, frames, bytes);
+        [self appendFrame:DSPS_RX_AGGREGATE_DROP source:source sequence:sequence bytes:drop length:sizeof(drop)];
+        source.unreportedFrames = 0;
+        source.unreportedBytes = 0;
+    }
+
+    [self appendFrame:DSPS_RX_AGGREGATE_DATA source:source sequence:sequence bytes:data.bytes length:(uint32_t) data.length];
+    source.frames++;
+    source.bytes += data.length;
+    self.frames++;
+    self.bytes += data.length;
+}
+
+/// Appends a frame to the buffer.
+- (void) appendFrame:(int)type source:(DspsRxAggregatorSource*)source sequence:(uint32_t)sequence bytes:(const void*)bytes length:(uint32_t)length {
+    if (self.closed)
+        return;
+    uint64_t time = (uint64_t) ((NSProcessInfo.processInfo.systemUptime - self.startTime) * 1000000);
+    uint16_t index = (uint16_t) source.index;
+    uint8_t header[DSPS_RX_AGGREGATE_FRAME_HEADER_SIZE] = {
+        index, index >> 8, type, 0,
+        sequence, sequence >> 8, sequence >> 16, sequence >> 24,
+        time, time >> 8, time >> 16, time >> 24, time >> 32, time >> 40, time >> 48, time >> 56,
+        length, length >> 8, length >> 16, length >> 24,
+    };
+    [self.buffer appendBytes:header length:sizeof(header)];
+    if (length)
+        [self.buffer appendBytes:bytes length:length];
+
+    if (self.buffer.length >= CodelessLibConfig.DSPS_RX_AGGREGATE_BUFFER_SIZE) {
+        [self flush];
+    } else if (!self.flushScheduled) {
+        self.flushScheduled = true;
+        [self performSelector:@selector(flush) withObject:nil afterDelay:CodelessLibConfig.DSPS_RX_AGGREGATE_FLUSH_INTERVAL / 1000.];
+    }
+}
+
+- (void) flush {
+    if (self.flushScheduled) {
+        self.flushScheduled = false;
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(flush) object:nil];
+    }
+    if (!self.buffer.length || (!self.handle && !self.handler))
+        return;
+
+    NSData* block = self.buffer;
+    self.buffer = [NSMutableData dataWithCapacity:CodelessLibConfig.DSPS_RX_AGGREGATE_BUFFER_SIZE];
+    int64_t length = block.length;
+    atomic_fetch_add_explicit(&pending, length, memory_order_relaxed);
+    NSFileHandle* handle = self.handle;
+    void (^handler)(NSData*) = self.handler;
+    _Atomic int64_t* pendingRef = &pending;
+    dispatch_async(self.writerQueue, ^{
+        if (handle)
+            [handle writeData:block];
+        else
+            handler(block);
+        atomic_fetch_sub_explicit(pendingRef, length, memory_order_relaxed);
+    });
+}
+
+- (void) close {
+    if (self.closed && !self.handle && !self.handler)
+        return;
+    for (CodelessManager* manager in self.managers.keyEnumerator.allObjects)
+        [self removeManager:manager];
+    [self flush];
+    self.closed = true;
+    NSFileHandle* handle = self.handle;
+    dispatch_sync(self.writerQueue, ^{
+        if (handle) {
+            [handle synchronizeFile];
+            [handle closeFile];
+        }
+    });
+    self.handle = nil;
+    self.handler = nil;
+    CodelessLog(TAG, "Closed: %lld frames, %lld bytes, %lld dropped", self.frames, self.bytes, self.droppedFrames);
+}
+
+@end
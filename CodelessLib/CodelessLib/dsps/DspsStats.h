@@ -0,0 +1,98 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Throughput statistics of a DSPS data stream.
+ *
+ * Used by the manager and the DSPS operations to calculate the speed of sent or received data.
+ * <p> Byte counting is done from the data path with {@link #addBytes:}, which is a lock-free 64-bit atomic add.
+ * The speed values are calculated every {@link CodelessLibConfig#DSPS_STATS_INTERVAL} by {@link #update},
+ * which is called for all active streams by a single manager timer.
+ * <p> All time values are monotonic (system uptime), so they are not affected by wall clock changes.
+ * <ul>
+ * <li>{@link #currentSpeed}: average speed over the last {@link CodelessLibConfig#DSPS_STATS_WINDOW} intervals</li>
+ * <li>{@link #ewmaSpeed}: exponentially weighted moving average of the interval speed</li>
+ * <li>{@link #averageSpeed}: average speed since the start of the stream</li>
+ * </ul>
+ */
+@interface DspsStats : NSObject
+
+/// <code>true</code> if the statistics calculation is running.
+@property (readonly) BOOL running;
+/// The start time (system uptime).
+@property (readonly) NSTimeInterval startTime;
+/// The end time (system uptime), or 0 if running.
+@property (readonly) NSTimeInterval endTime;
+/// The time elapsed since the start, until now or the end time.
+@property (readonly) NSTimeInterval elapsed;
+/// The total number of bytes.
+@property (readonly) int64_t bytes;
+/// The sliding window speed (bytes/s), or {@link CodelessManager#SPEED_INVALID} if not yet calculated.
+@property (readonly) int currentSpeed;
+/// The exponentially weighted moving average speed (bytes/s), or {@link CodelessManager#SPEED_INVALID} if not yet calculated.
+@property (readonly) int ewmaSpeed;
+
+/// Starts the statistics calculation, clearing any previous values.
+- (void) start;
+/// Stops the statistics calculation. The speed values are kept.
+- (void) stop;
+/**
+ * Adds to the byte counter.
+ * <p> Safe to call from any thread.
+ * @param bytes the number of bytes
+ */
+- (void) addBytes:(int64_t)bytes;
+/**
+ * Calculates the speed values for the last interval.
+ * <p> Called by the manager every {@link CodelessLibConfig#DSPS_STATS_INTERVAL}.
+ */
+- (void) update;
+/// Returns the average speed (bytes/s) since the start, or {@link CodelessManager#SPEED_INVALID} if not available.
+- (int) averageSpeed;
+/**
+ * Returns the estimated time remaining until a total number of bytes is reached.
+ * <p> The estimation is based on the {@link #ewmaSpeed EWMA speed}.
+ * @param total the total number of bytes
+ * @return the estimated time remaining, or -1 if it is not available
+ */
+- (NSTimeInterval) etaForTotal:(int64_t)total;
+
+@end
+
+NS_ASSUME_NONNULL_END
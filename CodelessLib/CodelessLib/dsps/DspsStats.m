@@ -0,0 +1,162 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "DspsStats.h"
+#import "CodelessManager.h"
+#import "CodelessLibConfig.h"
+#import <stdatomic.h>
+
+@interface DspsStats () {
+    _Atomic int64_t totalBytes;
+    /// Sliding window samples (time, bytes), used as a ring buffer.
+    NSTimeInterval* windowTime;
+    int64_t* windowBytes;
+    int windowSize;
+    int windowCount;
+    int windowIndex;
+}
+
+@property BOOL running;
+@property NSTimeInterval startTime;
+@property NSTimeInterval endTime;
+@property int currentSpeed;
+@property int ewmaSpeed;
+@property NSTimeInterval lastInterval;
+@property int64_t lastBytes;
+
+@end
+
+@implementation DspsStats
+
+- (instancetype) init {
+    self = [super init];
+    if (!self)
+        return nil;
+    windowSize = MAX(CodelessLibConfig.DSPS_STATS_WINDOW, 1) + 1;
+    windowTime = calloc(windowSize, sizeof(NSTimeInterval));
+    windowBytes = calloc(windowSize, sizeof(int64_t));
+    atomic_init(&totalBytes, 0);
+    self.currentSpeed = CodelessManager.SPEED_INVALID;
+    self.ewmaSpeed = CodelessManager.SPEED_INVALID;
+    return self;
+}
+
+- (void) dealloc {
+    free(windowTime);
+    free(windowBytes);
+}
+
+- (void) start {
+    NSTimeInterval now = NSProcessInfo.processInfo.systemUptime;
+    atomic_store_explicit(&totalBytes, 0, memory_order_relaxed);
+    self.startTime = now;
+    self.endTime = 0;
+    self.lastInterval = now;
+    self.lastBytes = 0;
+    self.currentSpeed = CodelessManager.SPEED_INVALID;
+    self.ewmaSpeed = CodelessManager.SPEED_INVALID;
+    windowTime[0] = now;
+    windowBytes[0] = 0;
+    windowCount = 1;
+    windowIndex = 0;
+    self.running = true;
+}
+
+- (void) stop {
+    if (!self.running)
+        return;
+    self.running = false;
+    self.endTime = NSProcessInfo.processInfo.systemUptime;
+}
+
+- (int64_t) bytes {
+    return atomic_load_explicit(&totalBytes, memory_order_relaxed);
+}
+
+- (void) addBytes:(int64_t)bytes {
+    atomic_fetch_add_explicit(&totalBytes, bytes, memory_order_relaxed);
+}
+
+- (NSTimeInterval) elapsed {
+    if (!self.startTime)
+        return 0;
+    return (self.running ? NSProcessInfo.processInfo.systemUptime : self.endTime) - self.startTime;
+}
+
+- (void) update {
+    if (!self.running)
+        return;
+    NSTimeInterval now = NSProcessInfo.processInfo.systemUptime;
+    int64_t bytes = self.bytes;
+    NSTimeInterval interval = now - self.lastInterval;
+    if (interval <= 0)
+        return;
+
+    double speed = (bytes - self.lastBytes) / interval;
+    float alpha = CodelessLibConfig.DSPS_STATS_EWMA_ALPHA;
+    self.ewmaSpeed = self.ewmaSpeed == CodelessManager.SPEED_INVALID ? (int) speed : (int) (alpha * speed + (1 - alpha) * self.ewmaSpeed);
+    self.lastInterval = now;
+    self.lastBytes = bytes;
+
+    windowIndex = (windowIndex + 1) % windowSize;
+    windowTime[windowIndex] = now;
+    windowBytes[windowIndex] = bytes;
+    if (windowCount < windowSize)
+        windowCount++;
+    int oldest = (windowIndex - windowCount + 1 + windowSize) % windowSize;
+    self.currentSpeed = (int) ((bytes - windowBytes[oldest]) / (now - windowTime[oldest]));
+}
+
+- (int) averageSpeed {
+    NSTimeInterval elapsed = self.elapsed;
+    if (elapsed <= 0)
+        return CodelessManager.SPEED_INVALID;
+    return (int) (self.bytes / elapsed);
+}
+
+- (NSTimeInterval) etaForTotal:(int64_t)total {
+    int64_t remaining = total - self.bytes;
+    if (remaining <= 0)
+        return 0;
+    if (self.ewmaSpeed <= 0)
+        return -1;
+    return (NSTimeInterval) remaining / self.ewmaSpeed;
+}
+
+- (NSString*) description {
+    return [NSString stringWithFormat:@"bytes=%lld current=%d ewma=%d average=%d", self.bytes, self.currentSpeed, self.ewmaSpeed, self.averageSpeed];
+}
+
+@end
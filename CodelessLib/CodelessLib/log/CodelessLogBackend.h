@@ -0,0 +1,101 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Log output backend used by the library log macros.
+ * <p> The active backend is set with {@link CodelessLibLog#backend}. The default backend is selected by
+ * {@link CodelessLibLog#BACKEND_RING BACKEND_RING}.
+ */
+@protocol CodelessLogBackend <NSObject>
+
+/**
+ * Writes a log entry.
+ * @param tag       the log tag
+ * @param data      optional raw data, which are appended to the message as a hex array
+ * @param format    the message format
+ * @param args      the message arguments
+ */
+- (void) log:(NSString*)tag data:(nullable NSData*)data format:(NSString*)format arguments:(va_list)args;
+
+@end
+
+
+/// Log backend that writes each entry synchronously with <code>NSLog</code>.
+@interface CodelessConsoleLogBackend : NSObject <CodelessLogBackend>
+@end
+
+
+/**
+ * Log backend that stores log entries as binary records in a lock-free ring buffer.
+ *
+ * Each record contains the timestamp, the tag and format IDs, the raw argument values and optional raw data.
+ * Tags and formats are interned once, so the caller only copies scalar values and the text of object arguments.
+ * Formatting is deferred until the records are read, either by the background console reader (if
+ * {@link CodelessLibLog#CONSOLE CONSOLE} output is enabled) or by {@link #dump:}.
+ * <p> Writers never block. When the buffer is full, the oldest records are overwritten.
+ */
+@interface CodelessRingLogBackend : NSObject <CodelessLogBackend>
+
+/// The number of records in the ring buffer.
+@property (readonly) NSUInteger capacity;
+/// The total number of records written.
+@property (readonly) uint64_t written;
+
+/**
+ * Creates a ring buffer log backend.
+ * @param capacity  the number of records (rounded up to a power of two)
+ * @param console   <code>true</code> to write the records to the console from a background reader
+ */
+- (instancetype) initWithCapacity:(NSUInteger)capacity console:(BOOL)console;
+
+/**
+ * Formats the records written in the last seconds.
+ * @param seconds the time period, or 0 for all available records
+ * @return the formatted log entries, oldest first
+ */
+- (NSArray<NSString*>*) dump:(NSTimeInterval)seconds;
+/**
+ * Writes the records written in the last seconds to the console.
+ * @param seconds the time period, or 0 for all available records
+ */
+- (void) dumpToConsole:(NSTimeInterval)seconds;
+
+@end
+
+NS_ASSUME_NONNULL_END
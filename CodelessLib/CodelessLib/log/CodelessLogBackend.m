@@ -0,0 +1,518 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import <stdatomic.h>
+#import <CoreFoundation/CoreFoundation.h>
+#import "CodelessLogBackend.h"
+#import "CodelessLibLog.h"
+#import "CodelessUtil.h"
+
+// Record size is fixed, so a slot can be reserved with a single atomic increment.
+#define LOG_RECORD_PAYLOAD 224
+// Interned tags and formats, must be a power of two.
+#define LOG_INTERN_TABLE_SIZE 2048
+// Maximum number of interned strings, so that the table stays sparse.
+#define LOG_INTERN_MAX_COUNT (LOG_INTERN_TABLE_SIZE / 2)
+// Maximum number of slots checked to find or insert a string.
+#define LOG_INTERN_MAX_PROBE 8
+// Used for tags and formats that could not be interned.
+#define LOG_ID_NONE 0xffff
+
+#define LOG_FLAG_ARGS_TRUNCATED 1
+#define LOG_FLAG_DATA_TRUNCATED 2
+#define LOG_FLAG_DATA 4
+
+/// Argument types of format conversions.
+enum {
+    LOG_ARG_PERCENT,
+    LOG_ARG_INT,
+    LOG_ARG_LONG,
+    LOG_ARG_DOUBLE,
+    LOG_ARG_OBJECT,
+    LOG_ARG_CSTRING,
+    LOG_ARG_POINTER,
+};
+
+/// Format conversion specification.
+typedef struct {
+    NSRange range;
+    int type;
+} LogConversion;
+
+/// Interned tag or format. Formats are parsed once, <code>count</code> is -1 if the format is not supported.
+typedef struct {
+    CFStringRef string;
+    int count;
+    LogConversion* conversions;
+} LogIntern;
+
+/// Binary log record.
+typedef struct {
+    // Odd while the record is being written.
+    _Atomic uint64_t sequence;
+    CFAbsoluteTime time;
+    uint32_t dataTotal;
+    uint16_t tag;
+    uint16_t format;
+    uint16_t argsLength;
+    uint16_t dataLength;
+    uint8_t flags;
+    uint8_t payload[LOG_RECORD_PAYLOAD];
+} LogRecord;
+
+typedef struct {
+    _Atomic uint64_t head;
+    uint64_t mask;
+    LogRecord records[];
+} LogRing;
+
+enum {
+    LOG_READ_OK,
+    LOG_READ_PENDING,
+    LOG_READ_LOST,
+};
+
+static _Atomic(LogIntern*) internTable[LOG_INTERN_TABLE_SIZE];
+static _Atomic int internCount;
+
+static BOOL isOneOf(unichar c, const char* set) {
+    return c && c < 128 && strchr(set, c);
+}
+
+/// Parses the conversions of a format string.
+static void parseFormat(LogIntern* intern) {
+    NSString* format = (__bridge NSString*) intern->string;
+    NSUInteger length = format.length;
+    unichar* chars = malloc(length * sizeof(unichar));
+    [format getCharacters:chars range:NSMakeRange(0, length)];
+    intern->conversions = malloc((length / 2 + 1) * sizeof(LogConversion));
+    intern->count = 0;
+
+    for (NSUInteger i = 0; i < length; ++i) {
+        if (chars[i] != '%')
+            continue;
+        NSUInteger start = i++;
+        while (i < length && isOneOf(chars[i], "-+ #0'"))
+            ++i;
+        while (i < length && isOneOf(chars[i], "0123456789."))
+            ++i;
+        BOOL isLong = false;
+        while (i < length && isOneOf(chars[i], "hlqztj")) {
+            if (chars[i] != 'h')
+                isLong = true;
+            ++i;
+        }
+        int type = -1;
+        if (i < length) {
+            switch (chars[i]) {
+                case '%':
+                    type = LOG_ARG_PERCENT;
+                    break;
+                case 'd': case 'i': case 'o': case 'u': case 'x': case 'X': case 'c': case 'C':
+                    type = isLong ? LOG_ARG_LONG : LOG_ARG_INT;
+                    break;
+                case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                    type = LOG_ARG_DOUBLE;
+                    break;
+                case '@':
+                    type = LOG_ARG_OBJECT;
+                    break;
+                case 's':
+                    type = !isLong ? LOG_ARG_CSTRING : -1;
+                    break;
+                case 'p':
+                    type = LOG_ARG_POINTER;
+                    break;
+            }
+        }
+        // Unsupported conversion (for example '*' width), the format is formatted when logged.
+        if (type == -1) {
+            intern->count = -1;
+            break;
+        }
+        intern->conversions[intern->count++] = (LogConversion) { NSMakeRange(start, i - start + 1), type };
+    }
+    free(chars);
+}
+
+/**
+ * Returns the ID of an interned tag or format, interning it if needed.
+ * <p> The table is keyed by string identity, which is stable for the constant strings used by the log macros.
+ * Insertion is lock-free, so concurrent writers may parse the same format, but only one copy is kept.
+ * <p> Strings built at runtime get a new identity on each call, so they could fill the table. The number of
+ * interned strings and the probe length are bounded: if a string is not found within {@link LOG_INTERN_MAX_PROBE}
+ * slots and cannot be inserted, {@link LOG_ID_NONE} is returned and the record is written un-interned.
+ */
+static uint16_t internString(NSString* string, BOOL format) {
+    uintptr_t key = (uintptr_t) (__bridge void*) string;
+    NSUInteger index = (key >> 4) * 2654435761u;
+    for (int probe = 0; probe < LOG_INTERN_MAX_PROBE; ++probe, ++index) {
+        _Atomic(LogIntern*)* slot = &internTable[index & (LOG_INTERN_TABLE_SIZE - 1)];
+        LogIntern* intern = atomic_load_explicit(slot, memory_order_acquire);
+        if (!intern) {
+            // Strings are never removed, so an empty slot means the string is not in the table.
+            if (atomic_fetch_add_explicit(&internCount, 1, memory_order_relaxed) >= LOG_INTERN_MAX_COUNT) {
+                atomic_fetch_sub_explicit(&internCount, 1, memory_order_relaxed);
+                return LOG_ID_NONE;
+            }
+            LogIntern* created = calloc(1, sizeof(LogIntern));
+            created->string = (CFStringRef) CFBridgingRetain(string);
+            if (format)
+                parseFormat(created);
+            if (atomic_compare_exchange_strong_explicit(slot, &intern, created, memory_order_acq_rel, memory_order_acquire))
+                return index & (LOG_INTERN_TABLE_SIZE - 1);
+            atomic_fetch_sub_explicit(&internCount, 1, memory_order_relaxed);
+            CFRelease(created->string);
+            free(created->conversions);
+            free(created);
+        }
+        if ((uintptr_t) intern->string == key)
+            return index & (LOG_INTERN_TABLE_SIZE - 1);
+    }
+    return LOG_ID_NONE;
+}
+
+static LogIntern* internedString(uint16_t id) {
+    return id != LOG_ID_NONE ? atomic_load_explicit(&internTable[id], memory_order_acquire) : NULL;
+}
+
+/// Appends a scalar argument to a record payload.
+static BOOL putScalar(LogRecord* record, const void* value) {
+    if (record->argsLength + 8 > LOG_RECORD_PAYLOAD) {
+        record->flags |= LOG_FLAG_ARGS_TRUNCATED;
+        return false;
+    }
+    memcpy(record->payload + record->argsLength, value, 8);
+    record->argsLength += 8;
+    return true;
+}
+
+/// Appends a string argument to a record payload, truncated to the available space.
+static BOOL putString(LogRecord* record, NSString* string) {
+    if (record->argsLength + 2 > LOG_RECORD_PAYLOAD) {
+        record->flags |= LOG_FLAG_ARGS_TRUNCATED;
+        return false;
+    }
+    NSUInteger used = 0;
+    NSRange remaining;
+    [string getBytes:record->payload + record->argsLength + 2 maxLength:LOG_RECORD_PAYLOAD - record->argsLength - 2 usedLength:&used
+            encoding:NSUTF8StringEncoding options:0 range:NSMakeRange(0, string.length) remainingRange:&remaining];
+    uint16_t length = used;
+    memcpy(record->payload + record->argsLength, &length, 2);
+    record->argsLength += 2 + used;
+    if (remaining.length)
+        record->flags |= LOG_FLAG_ARGS_TRUNCATED;
+    return true;
+}
+
+/// Copies a record from the ring buffer, checking that it was not modified while being copied.
+static int readRecord(LogRing* ring, uint64_t index, LogRecord* out) {
+    LogRecord* record = &ring->records[index & ring->mask];
+    uint64_t sequence = atomic_load_explicit(&record->sequence, memory_order_acquire);
+    if (sequence < 2 * index + 2)
+        return LOG_READ_PENDING;
+    if (sequence != 2 * index + 2)
+        return LOG_READ_LOST;
+    memcpy(&out->time, &record->time, sizeof(LogRecord) - offsetof(LogRecord, time));
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&record->sequence, memory_order_relaxed) == sequence ? LOG_READ_OK : LOG_READ_LOST;
+}
+
+/// Reads the next string argument of a record.
+static NSString* getString(const LogRecord* record, NSUInteger* offset) {
+    if (*offset + 2 > record->argsLength)
+        return nil;
+    uint16_t length;
+    memcpy(&length, record->payload + *offset, 2);
+    NSString* string = [[NSString alloc] initWithBytes:record->payload + *offset + 2 length:length encoding:NSUTF8StringEncoding];
+    *offset += 2 + length;
+    return string ?: @"";
+}
+
+/// Formats the message of a record.
+static NSString* formatRecord(const LogRecord* record) {
+    NSUInteger offset = 0;
+    NSMutableString* message;
+    LogIntern* intern = internedString(record->format);
+    if (!intern) {
+        message = [NSMutableString stringWithString:getString(record, &offset) ?: @""];
+    } else {
+        NSString* format = (__bridge NSString*) intern->string;
+        message = [NSMutableString stringWithCapacity:format.length + record->argsLength];
+        NSUInteger literal = 0;
+        for (int i = 0; i < intern->count; ++i) {
+            LogConversion* conversion = &intern->conversions[i];
+            [message appendString:[format substringWithRange:NSMakeRange(literal, conversion->range.location - literal)]];
+            literal = NSMaxRange(conversion->range);
+            NSString* spec = [format substringWithRange:conversion->range];
+            if (conversion->type == LOG_ARG_PERCENT) {
+                [message appendString:@"%"];
+                continue;
+            }
+            if (conversion->type == LOG_ARG_OBJECT || conversion->type == LOG_ARG_CSTRING) {
+                NSString* string = getString(record, &offset);
+                if (!string)
+                    [message appendString:@"?"];
+                else if (conversion->type == LOG_ARG_OBJECT)
+                    [message appendFormat:spec, string];
+                else
+                    [message appendFormat:spec, string.UTF8String];
+                continue;
+            }
+            if (offset + 8 > record->argsLength) {
+                [message appendString:@"?"];
+                continue;
+            }
+            uint64_t value;
+            memcpy(&value, record->payload + offset, 8);
+            offset += 8;
+            switch (conversion->type) {
+                case LOG_ARG_INT:
+                    [message appendFormat:spec, (int) value];
+                    break;
+                case LOG_ARG_LONG:
+                    [message appendFormat:spec, (long long) value];
+                    break;
+                case LOG_ARG_DOUBLE: {
+                    double d;
+                    memcpy(&d, &value, 8);
+                    [message appendFormat:spec, d];
+                    break;
+                }
+                case LOG_ARG_POINTER:
+                    [message appendFormat:spec, (void*) (uintptr_t) value];
+                    break;
+            }
+        }
+        [message appendString:[format substringFromIndex:literal]];
+    }
+    if (record->flags & LOG_FLAG_ARGS_TRUNCATED)
+        [message appendString:@"..."];
+    if (record->flags & LOG_FLAG_DATA) {
+        [message appendString:[CodelessUtil hexArrayLog:[NSData dataWithBytesNoCopy:(void*) (record->payload + record->argsLength) length:record->dataLength freeWhenDone:false]]];
+        if (record->flags & LOG_FLAG_DATA_TRUNCATED)
+            [message appendFormat:@" (%d of %u bytes)", record->dataLength, record->dataTotal];
+    }
+    return message;
+}
+
+static NSString* recordTag(const LogRecord* record) {
+    LogIntern* intern = internedString(record->tag);
+    return intern ? (__bridge NSString*) intern->string : @"?";
+}
+
+
+@implementation CodelessConsoleLogBackend
+
+- (void) log:(NSString*)tag data:(NSData*)data format:(NSString*)format arguments:(va_list)args {
+    NSString* message = [[NSString alloc] initWithFormat:format arguments:args];
+    if (data)
+        message = [message stringByAppendingString:[CodelessUtil hexArrayLog:data]];
+    NSLog(@"%@: %@", tag, message);
+}
+
+@end
+
+
+@interface CodelessRingLogBackend () {
+    LogRing* ring;
+    // Accessed only on the reader queue.
+    uint64_t readIndex;
+}
+
+@property NSUInteger capacity;
+@property dispatch_queue_t readerQueue;
+@property dispatch_source_t readerTimer;
+
+@end
+
+@implementation CodelessRingLogBackend
+
+static NSString* const TAG = @"CodelessRingLogBackend";
+
+- (instancetype) initWithCapacity:(NSUInteger)capacity console:(BOOL)console {
+    self = [super init];
+    if (!self)
+        return nil;
+    NSUInteger size = 1;
+    while (size < capacity)
+        size <<= 1;
+    self.capacity = size;
+    ring = calloc(1, sizeof(LogRing) + size * sizeof(LogRecord));
+    ring->mask = size - 1;
+    if (console) {
+        self.readerQueue = dispatch_queue_create("CodelessRingLogBackend", DISPATCH_QUEUE_SERIAL);
+        self.readerTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.readerQueue);
+        uint64_t interval = CodelessLibLog.CONSOLE_INTERVAL * NSEC_PER_MSEC;
+        dispatch_source_set_timer(self.readerTimer, dispatch_time(DISPATCH_TIME_NOW, interval), interval, interval / 10);
+        __weak CodelessRingLogBackend* weakSelf = self;
+        dispatch_source_set_event_handler(self.readerTimer, ^{
+            [weakSelf readToConsole];
+        });
+        dispatch_resume(self.readerTimer);
+    }
+    return self;
+}
+
+- (void) dealloc {
+    if (self.readerTimer)
+        dispatch_source_cancel(self.readerTimer);
+    free(ring);
+}
+
+- (uint64_t) written {
+    return atomic_load_explicit(&ring->head, memory_order_acquire);
+}
+
+- (void) log:(NSString*)tag data:(NSData*)data format:(NSString*)format arguments:(va_list)args {
+    // Build the record on the stack, so the ring slot is marked as being written only for the copy.
+    LogRecord record;
+    record.time = CFAbsoluteTimeGetCurrent();
+    record.tag = internString(tag, false);
+    record.format = internString(format, true);
+    record.argsLength = 0;
+    record.flags = 0;
+
+    LogIntern* intern = internedString(record.format);
+    if (!intern || intern->count < 0 || record.tag == LOG_ID_NONE) {
+        // Un-interned record, the tag is kept in the message
+        NSString* message = [[NSString alloc] initWithFormat:format arguments:args];
+        if (record.tag == LOG_ID_NONE && tag)
+            message = [NSString stringWithFormat:@"%@: %@", tag, message];
+        record.format = LOG_ID_NONE;
+        putString(&record, message);
+    } else {
+        for (int i = 0; i < intern->count; ++i) {
+            BOOL stored = true;
+            switch (intern->conversions[i].type) {
+                case LOG_ARG_INT: {
+                    int64_t v = va_arg(args, int);
+                    stored = putScalar(&record, &v);
+                    break;
+                }
+                case LOG_ARG_LONG: {
+                    int64_t v = va_arg(args, long long);
+                    stored = putScalar(&record, &v);
+                    break;
+                }
+                case LOG_ARG_DOUBLE: {
+                    double v = va_arg(args, double);
+                    stored = putScalar(&record, &v);
+                    break;
+                }
+                case LOG_ARG_POINTER: {
+                    uint64_t v = (uintptr_t) va_arg(args, void*);
+                    stored = putScalar(&record, &v);
+                    break;
+                }
+                case LOG_ARG_OBJECT: {
+                    id v = va_arg(args, id);
+                    stored = putString(&record, v ? [v description] : @"(null)");
+                    break;
+                }
+                case LOG_ARG_CSTRING: {
+                    const char* v = va_arg(args, const char*);
+                    stored = putString(&record, v ? @(v) : @"(null)");
+                    break;
+                }
+            }
+            if (!stored)
+                break;
+        }
+    }
+
+    record.dataTotal = (uint32_t) MIN(data.length, UINT32_MAX);
+    record.dataLength = MIN(data.length, (NSUInteger) (LOG_RECORD_PAYLOAD - record.argsLength));
+    if (data)
+        record.flags |= LOG_FLAG_DATA;
+    if (record.dataLength)
+        memcpy(record.payload + record.argsLength, data.bytes, record.dataLength);
+    if (record.dataLength < data.length)
+        record.flags |= LOG_FLAG_DATA_TRUNCATED;
+
+    uint64_t index = atomic_fetch_add_explicit(&ring->head, 1, memory_order_relaxed);
+    LogRecord* slot = &ring->records[index & ring->mask];
+    atomic_store_explicit(&slot->sequence, 2 * index + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    memcpy(&slot->time, &record.time, offsetof(LogRecord, payload) - offsetof(LogRecord, time) + record.argsLength + record.dataLength);
+    atomic_store_explicit(&slot->sequence, 2 * index + 2, memory_order_release);
+}
+
+/// Writes the new records to the console. Called periodically on the reader queue.
+- (void) readToConsole {
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint64_t lost = 0;
+    if (head - readIndex > self.capacity) {
+        lost = head - self.capacity - readIndex;
+        readIndex = head - self.capacity;
+    }
+    LogRecord record;
+    for (; readIndex < head; ++readIndex) {
+        int result = readRecord(ring, readIndex, &record);
+        if (result == LOG_READ_PENDING)
+            break;
+        if (result == LOG_READ_LOST) {
+            ++lost;
+            continue;
+        }
+        NSLog(@"%@: %@", recordTag(&record), formatRecord(&record));
+    }
+    if (lost)
+        NSLog(@"%@: %llu log records overwritten before output", TAG, lost);
+}
+
+- (NSArray<NSString*>*) dump:(NSTimeInterval)seconds {
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    uint64_t start = head > self.capacity ? head - self.capacity : 0;
+    CFAbsoluteTime since = seconds > 0 ? CFAbsoluteTimeGetCurrent() - seconds : 0;
+    NSDateFormatter* dateFormatter = [[NSDateFormatter alloc] init];
+    dateFormatter.dateFormat = @"HH:mm:ss.SSS";
+    NSMutableArray<NSString*>* lines = [NSMutableArray array];
+    LogRecord record;
+    for (uint64_t index = start; index < head; ++index) {
+        if (readRecord(ring, index, &record) != LOG_READ_OK || record.time < since)
+            continue;
+        NSString* time = [dateFormatter stringFromDate:[NSDate dateWithTimeIntervalSinceReferenceDate:record.time]];
+        [lines addObject:[NSString stringWithFormat:@"%@ %@: %@", time, recordTag(&record), formatRecord(&record)]];
+    }
+    return lines;
+}
+
+- (void) dumpToConsole:(NSTimeInterval)seconds {
+    NSArray<NSString*>* lines = [self dump:seconds];
+    NSLog(@"%@: Log dump (%lu entries)\n%@", TAG, (unsigned long) lines.count, [lines componentsJoinedByString:@"\n"]);
+}
+
+@end
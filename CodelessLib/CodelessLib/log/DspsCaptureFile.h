@@ -0,0 +1,166 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "CodelessLogFileBase.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// DSPS capture record direction.
+enum DSPS_CAPTURE_DIRECTION {
+    /// Received from the peer device.
+    DSPS_CAPTURE_RX,
+    /// Sent to the peer device.
+    DSPS_CAPTURE_TX,
+};
+
+/// The DSPS capture file magic ("DRC" and version).
+#define DSPS_CAPTURE_MAGIC   "DRC\x01"
+/**
+ * The DSPS capture file header size.
+ * <p> Header fields (little endian): magic (4), header size (uint32), data area size (uint64), head offset (uint64),
+ * tail offset (uint64), number of records (uint64), number of overwritten records (uint64),
+ * start time (Unix time, double), total number of written records (uint64).
+ */
+#define DSPS_CAPTURE_HEADER_SIZE   64
+/**
+ * The DSPS capture record header size.
+ * <p> Record header fields (little endian): time since start in us (uint64), {@link DSPS_CAPTURE_DIRECTION direction} (uint8),
+ * {@link CODELESS_GATT_TRACE_CHARACTERISTIC characteristic} (uint8), data length (uint16).
+ * <p> A record length of {@link DSPS_CAPTURE_WRAP} marks the end of the used data area (the next record is at offset 0).
+ * The same applies if there is not enough space for a record header until the end of the data area.
+ */
+#define DSPS_CAPTURE_RECORD_HEADER_SIZE   12
+/// Record length value that marks a wrap around to the start of the data area.
+#define DSPS_CAPTURE_WRAP   0xffff
+/// The DSPS capture file extension.
+#define DSPS_CAPTURE_FILE_EXTENSION   @".dcap"
+
+
+/**
+ * DSPS capture file.
+ *
+ * Used by the library to capture the DSPS traffic (received and sent data, flow control), if capture is
+ * {@link CodelessLibConfig#DSPS_CAPTURE enabled}. Unlike {@link DspsRxLogFile}, each record has a monotonic timestamp,
+ * the direction and the characteristic, so that the capture can be correlated with the library events and logs.
+ * <p> The file is preallocated with a fixed {@link CodelessLibConfig#DSPS_CAPTURE_SIZE size} and memory-mapped.
+ * Records are copied to the mapped memory (no system call per record) and the data area is used as a ring buffer:
+ * when it is full, the oldest records are overwritten. The header is kept up to date after each record, so the file
+ * is readable even if the app is terminated.
+ * <p> Use {@link DspsCaptureReader} to read the file or export it to CSV or pcap.
+ * @see CodelessManager
+ */
+@interface DspsCaptureFile : CodelessLogFileBase
+
+@property (class, readonly) NSString* TAG;
+
+/// The file size.
+@property (readonly) int64_t size;
+/// The number of records currently in the file.
+@property (readonly) int64_t records;
+/// The number of records that were overwritten.
+@property (readonly) int64_t overwritten;
+
+/**
+ * Creates a DSPS capture file, using the {@link CodelessLibConfig#DSPS_CAPTURE_SIZE configured size}.
+ * @param manager the associated manager
+ */
+- (instancetype) initWithManager:(CodelessManager*)manager;
+/**
+ * Creates a DSPS capture file at a specific path.
+ * @param path  the file path (overwritten)
+ * @param size  the file size
+ */
+- (instancetype) initWithPath:(NSString*)path size:(int64_t)size;
+
+/**
+ * Appends a record to the capture file.
+ * <p> The file is created on the first record.
+ * @param data              the record data
+ * @param direction         the {@link DSPS_CAPTURE_DIRECTION direction}
+ * @param characteristic    the {@link CODELESS_GATT_TRACE_CHARACTERISTIC characteristic}
+ */
+- (void) log:(NSData*)data direction:(int)direction characteristic:(int)characteristic;
+
+@end
+
+
+/**
+ * Reads a {@link DspsCaptureFile DSPS capture file} offline.
+ *
+ * The records are read from the oldest to the newest. They can also be exported to CSV, or to pcap
+ * (Bluetooth HCI H4 with direction link type), where each record is converted to an ATT notification
+ * (received data) or write command (sent data), so that the capture can be inspected with Wireshark.
+ */
+@interface DspsCaptureReader : NSObject
+
+@property (class, readonly) NSString* TAG;
+
+/// <code>true</code> if the file is a valid capture file.
+@property (readonly) BOOL valid;
+/// The capture start time (Unix time).
+@property (readonly) NSTimeInterval startTime;
+/// The number of records in the file.
+@property (readonly) int64_t records;
+/// The number of records that were overwritten.
+@property (readonly) int64_t overwritten;
+
+/**
+ * Opens a capture file for reading.
+ * @param file the capture file path
+ */
+- (instancetype) initWithFile:(NSString*)file;
+
+/**
+ * Enumerates the records, oldest first.
+ * @param block the block called for each record, with the time since the capture start, the direction, the characteristic and the data
+ */
+- (void) enumerateRecords:(void (NS_NOESCAPE ^)(NSTimeInterval time, int direction, int characteristic, NSData* data, BOOL* stop))block;
+/**
+ * Exports the records to a CSV file.
+ * <p> Columns: time (s), direction, characteristic, length, data (hex).
+ * @param file the output file path (overwritten)
+ * @return <code>true</code> if the export succeeded
+ */
+- (BOOL) exportCSV:(NSString*)file;
+/**
+ * Exports the records to a pcap file.
+ * @param file the output file path (overwritten)
+ * @return <code>true</code> if the export succeeded
+ */
+- (BOOL) exportPcap:(NSString*)file;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,461 @@
+/*
+ **********************************************************************************
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright (c) 2020-2024 Renesas Electronics Corporation and/or its affiliates
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of Renesas nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY RENESAS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, NONINFRINGEMENT, AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL RENESAS OR CONTRIBUTORS BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **********************************************************************************
+ */
+
+#import "DspsCaptureFile.h"
+#import "CodelessManager.h"
+#import "CodelessLibConfig.h"
+#import "CodelessLibLog.h"
+#import "CodelessGattTrace.h"
+#import "CodelessUtil.h"
+#import <sys/mman.h>
+#import <fcntl.h>
+#import <unistd.h>
+#if __has_include(<libkern/OSByteOrder.h>)
+#import <libkern/OSByteOrder.h>
+#else
+#import <endian.h>
+
+// OSByteOrder equivalents for platforms without libkern (for example, GNUstep on Linux).
+// The fields are not aligned, so they are accessed with memcpy.
+
+static inline uint16_t OSReadLittleInt16(const void* base, uintptr_t offset) {
+    uint16_t value;
+    memcpy(&value, (const uint8_t*) base + offset, sizeof(value));
+    return le16toh(value);
+}
+
+static inline uint32_t OSReadLittleInt32(const void* base, uintptr_t offset) {
+    uint32_t value;
+    memcpy(&value, (const uint8_t*) base + offset, sizeof(value));
+    return le32toh(value);
+}
+
+static inline uint64_t OSReadLittleInt64(const void* base, uintptr_t offset) {
+    uint64_t value;
+    memcpy(&value, (const uint8_t*) base + offset, sizeof(value));
+    return le64toh(value);
+}
+
+static inline void OSWriteLittleInt16(void* base, uintptr_t offset, uint16_t data) {
+    data = htole16(data);
+    memcpy((uint8_t*) base + offset, &data, sizeof(data));
+}
+
+static inline void OSWriteLittleInt32(void* base, uintptr_t offset, uint32_t data) {
+    data = htole32(data);
+    memcpy((uint8_t*) base + offset, &data, sizeof(data));
+}
+
+static inline void OSWriteLittleInt64(void* base, uintptr_t offset, uint64_t data) {
+    data = htole64(data);
+    memcpy((uint8_t*) base + offset, &data, sizeof(data));
+}
+
+static inline void OSWriteBigInt32(void* base, uintptr_t offset, uint32_t data) {
+    data = htobe32(data);
+    memcpy((uint8_t*) base + offset, &data, sizeof(data));
+}
+#endif
+
+// Header field offsets
+#define HEADER_SIZE         4
+#define HEADER_CAPACITY     8
+#define HEADER_HEAD         16
+#define HEADER_TAIL         24
+#define HEADER_RECORDS      32
+#define HEADER_OVERWRITTEN  40
+#define HEADER_START_TIME   48
+#define HEADER_TOTAL        56
+
+/// The maximum record data length (the length field must not match the wrap marker).
+#define DSPS_CAPTURE_MAX_LENGTH   (DSPS_CAPTURE_WRAP - 1)
+
+static void writeDouble(uint8_t* base, int offset, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    OSWriteLittleInt64(base, offset, bits);
+}
+
+static double readDouble(const uint8_t* base, int offset) {
+    uint64_t bits = OSReadLittleInt64(base, offset);
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+
+@interface DspsCaptureFile () {
+    int fd;
+    uint8_t* map;
+    uint8_t* data;
+    uint64_t capacity;
+    uint64_t head;
+    uint64_t tail;
+    uint64_t total;
+}
+
+@property int64_t size;
+@property int64_t records;
+@property int64_t overwritten;
+@property NSTimeInterval startTime;
+
+@end
+
+@implementation DspsCaptureFile
+
+static NSString* const TAG = @"DspsCaptureFile";
++ (NSString*) TAG {
+    return TAG;
+}
+
+- (instancetype) initWithManager:(CodelessManager*)manager {
+    self = [super initWithManager:manager prefix:CodelessLibConfig.DSPS_CAPTURE_FILE_PREFIX];
+    if (!self)
+        return nil;
+    self.name = [self.name.stringByDeletingPathExtension stringByAppendingString:DSPS_CAPTURE_FILE_EXTENSION];
+    self.path = [self.path.stringByDeletingLastPathComponent stringByAppendingPathComponent:self.name];
+    self.size = CodelessLibConfig.DSPS_CAPTURE_SIZE;
+    fd = -1;
+    return self;
+}
+
+- (instancetype) initWithPath:(NSString*)path size:(int64_t)size {
+    self = [super init];
+    if (!self)
+        return nil;
+    self.name = path.lastPathComponent;
+    self.path = path;
+    self.size = size;
+    fd = -1;
+    return self;
+}
+
+- (void) dealloc {
+    [self close];
+}
+
+- (NSString*) TAG {
+    return TAG;
+}
+
+- (BOOL) create {
+    if (self.size < DSPS_CAPTURE_HEADER_SIZE + 2 * DSPS_CAPTURE_RECORD_HEADER_SIZE) {
+        CodelessLog(TAG, "Invalid capture file size: %lld", self.size);
+        self.closed = true;
+        return false;
+    }
+    fd = open(self.path.fileSystemRepresentation, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        CodelessLog(TAG, "Failed to create capture file: %@ (%d)", self.path, errno);
+        self.closed = true;
+        return false;
+    }
+#ifdef F_PREALLOCATE
+    fstore_t store = { F_ALLOCATEALL, F_PEOFPOSMODE, 0, self.size, 0 };
+    fcntl(fd, F_PREALLOCATE, &store);
+#endif
+    if (ftruncate(fd, self.size) != 0) {
+        CodelessLog(TAG, "Failed to allocate capture file: %@ (%d)", self.path, errno);
+        [self close];
+        return false;
+    }
+    void* mapped = mmap(NULL, self.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        CodelessLog(TAG, "Failed to map capture file: %@ (%d)", self.path, errno);
+        [self close];
+        return false;
+    }
+    map = mapped;
+    data = map + DSPS_CAPTURE_HEADER_SIZE;
+    capacity = self.size - DSPS_CAPTURE_HEADER_SIZE;
+    head = tail = total = 0;
+    self.startTime = NSProcessInfo.processInfo.systemUptime;
+
+    memcpy(map, DSPS_CAPTURE_MAGIC, 4);
+    OSWriteLittleInt32(map, HEADER_SIZE, DSPS_CAPTURE_HEADER_SIZE);
+    OSWriteLittleInt64(map, HEADER_CAPACITY, capacity);
+    writeDouble(map, HEADER_START_TIME, [NSDate date].timeIntervalSince1970);
+    [self updateHeader];
+    CodelessLogSubsystem(CODELESS_LOG_DSPS, TAG, "Capture file: %@ (%lld bytes)", self.path, self.size);
+    return true;
+}
+
+- (void) close {
+    if (map) {
+        msync(map, self.size, MS_SYNC);
+        munmap(map, self.size);
+        map = data = NULL;
+    }
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    self.closed = true;
+}
+
+- (void) updateHeader {
+    OSWriteLittleInt64(map, HEADER_HEAD, head);
+    OSWriteLittleInt64(map, HEADER_TAIL, tail);
+    OSWriteLittleInt64(map, HEADER_RECORDS, self.records);
+    OSWriteLittleInt64(map, HEADER_OVERWRITTEN, self.overwritten);
+    OSWriteLittleInt64(map, HEADER_TOTAL, total);
+}
+
+/// Drops the oldest records, while the tail is in the specified range of the data area.
+- (void) freeFrom:(uint64_t)start to:(uint64_t)end {
+    while (self.records && tail >= start && tail < end) {
+        tail += DSPS_CAPTURE_RECORD_HEADER_SIZE + OSReadLittleInt16(data, tail + 10);
+        self.records--;
+        self.overwritten++;
+        if (capacity - tail < DSPS_CAPTURE_RECORD_HEADER_SIZE || OSReadLittleInt16(data, tail + 10) == DSPS_CAPTURE_WRAP)
+            tail = 0;
+    }
+}
+
+- (void) log:(NSData*)value direction:(int)direction characteristic:(int)characteristic {
+    if (self.closed)
+        return;
+    if (!map && ![self create])
+        return;
+
+    uint16_t length = (uint16_t) MIN(value.length, MIN(DSPS_CAPTURE_MAX_LENGTH, capacity / 2 - DSPS_CAPTURE_RECORD_HEADER_SIZE));
+    uint64_t size = DSPS_CAPTURE_RECORD_HEADER_SIZE + length;
+    if (capacity - head < size) {
+        [self freeFrom:head to:capacity];
+        if (capacity - head >= DSPS_CAPTURE_RECORD_HEADER_SIZE)
+            OSWriteLittleInt16(data, head + 10, DSPS_CAPTURE_WRAP);
+        head = 0;
+    }
+    [self freeFrom:head to:head + size];
+    if (!self.records)
+        tail = head;
+
+    uint8_t* record = data + head;
+    OSWriteLittleInt64(record, 0, (uint64_t) ((NSProcessInfo.processInfo.systemUptime - self.startTime) * 1000000));
+    record[8] = direction;
+    record[9] = characteristic;
+    OSWriteLittleInt16(record, 10, length);
+    memcpy(record + DSPS_CAPTURE_RECORD_HEADER_SIZE, value.bytes, length);
+
+    head += size;
+    if (capacity - head < DSPS_CAPTURE_RECORD_HEADER_SIZE)
+        head = 0;
+    self.records++;
+    total++;
+    [self updateHeader];
+}
+
+@end
+
+
+@interface DspsCaptureReader ()
+
+@property NSData* content;
+@property BOOL valid;
+@property NSTimeInterval startTime;
+@property int64_t records;
+@property int64_t overwritten;
+@property uint64_t capacity;
+@property uint64_t tail;
+
+@end
+
+@implementation DspsCaptureReader
+
+static NSString* const READER_TAG = @"DspsCaptureReader";
++ (NSString*) TAG {
+    return READER_TAG;
+}
+
+static NSArray<NSString*>* characteristicNames;
+
++ (void) initialize {
+    if (self != DspsCaptureReader.class)
+        return;
+    characteristicNames = @[ @"CodelessInbound", @"CodelessOutbound", @"CodelessFlowControl", @"DspsServerTx", @"DspsServerRx", @"DspsFlowControl" ];
+}
+
+- (instancetype) initWithFile:(NSString*)file {
+    self = [super init];
+    if (!self)
+        return nil;
+    NSError* error;
+    self.content = [NSData dataWithContentsOfFile:file options:NSDataReadingMappedIfSafe error:&error];
+    const uint8_t* map = self.content.bytes;
+    if (!self.content || self.content.length < DSPS_CAPTURE_HEADER_SIZE || memcmp(map, DSPS_CAPTURE_MAGIC, 4) != 0) {
+        CodelessLog(READER_TAG, "Invalid capture file: %@ %@", file, error);
+        return self;
+    }
+    uint32_t headerSize = OSReadLittleInt32(map, HEADER_SIZE);
+    self.capacity = OSReadLittleInt64(map, HEADER_CAPACITY);
+    if (headerSize < DSPS_CAPTURE_HEADER_SIZE || headerSize + self.capacity > self.content.length) {
+        CodelessLog(READER_TAG, "Invalid capture file header: %@", file);
+        return self;
+    }
+    self.tail = OSReadLittleInt64(map, HEADER_TAIL);
+    self.records = OSReadLittleInt64(map, HEADER_RECORDS);
+    self.overwritten = OSReadLittleInt64(map, HEADER_OVERWRITTEN);
+    self.startTime = readDouble(map, HEADER_START_TIME);
+    self.valid = true;
+    return self;
+}
+
+- (void) enumerateRecords:(void (NS_NOESCAPE ^)(NSTimeInterval time, int direction, int characteristic, NSData* data, BOOL* stop))block {
+    if (!self.valid)
+        return;
+    const uint8_t* data = (const uint8_t*) self.content.bytes + OSReadLittleInt32(self.content.bytes, HEADER_SIZE);
+    uint64_t offset = self.tail;
+    BOOL wrapped = false;
+    BOOL stop = false;
+    for (int64_t i = 0; i < self.records && !stop; ++i) {
+        if (self.capacity - offset < DSPS_CAPTURE_RECORD_HEADER_SIZE || OSReadLittleInt16(data, offset + 10) == DSPS_CAPTURE_WRAP) {
+            if (wrapped)
+                break;
+            wrapped = true;
+            offset = 0;
+        }
+        const uint8_t* record = data + offset;
+        uint16_t length = OSReadLittleInt16(record, 10);
+        if (offset + DSPS_CAPTURE_RECORD_HEADER_SIZE + length > self.capacity) {
+            CodelessLog(READER_TAG, "Invalid record at offset %llu", offset);
+            break;
+        }
+        NSData* value = [NSData dataWithBytesNoCopy:(void*) (record + DSPS_CAPTURE_RECORD_HEADER_SIZE) length:length freeWhenDone:NO];
+        block(OSReadLittleInt64(record, 0) / 1000000., record[8], record[9], value, &stop);
+        offset += DSPS_CAPTURE_RECORD_HEADER_SIZE + length;
+    }
+}
+
+/// Writes the output buffer to the file, if it is full or if forced.
+static BOOL flushOutput(NSFileHandle* handle, NSMutableData* buffer, BOOL force) {
+    if (buffer.length < 65536 && !force)
+        return true;
+    @try {
+        [handle writeData:buffer];
+    } @catch (NSException* exception) {
+        return false;
+    }
+    [buffer setLength:0];
+    return true;
+}
+
+- (nullable NSFileHandle*) createOutput:(NSString*)file {
+    if (![NSFileManager.defaultManager createFileAtPath:file contents:nil attributes:nil]) {
+        CodelessLog(READER_TAG, "Failed to create export file: %@", file);
+        return nil;
+    }
+    return [NSFileHandle fileHandleForWritingAtPath:file];
+}
+
+- (BOOL) exportCSV:(NSString*)file {
+    if (!self.valid)
+        return false;
+    NSFileHandle* handle = [self createOutput:file];
+    if (!handle)
+        return false;
+    NSMutableData* buffer = [NSMutableData data];
+    [buffer appendData:[@"time,direction,characteristic,length,data\n" dataUsingEncoding:NSUTF8StringEncoding]];
+    __block BOOL ok = true;
+    [self enumerateRecords:^(NSTimeInterval time, int direction, int characteristic, NSData* data, BOOL* stop) {
+        NSString* name = characteristic < characteristicNames.count ? characteristicNames[characteristic] : [NSString stringWithFormat:@"%d", characteristic];
+        NSString* line = [NSString stringWithFormat:@"%.6f,%@,%@,%d,%@\n", time, direction == DSPS_CAPTURE_TX ? @"TX" : @"RX", name, (int) data.length, [CodelessUtil hex:data uppercase:false]];
+        [buffer appendData:[line dataUsingEncoding:NSUTF8StringEncoding]];
+        if (!flushOutput(handle, buffer, false)) {
+            ok = false;
+            *stop = true;
+        }
+    }];
+    ok = ok && flushOutput(handle, buffer, true);
+    [handle closeFile];
+    return ok;
+}
+
+/// pcap link type: Bluetooth HCI UART transport layer plus pseudo-header.
+#define PCAP_LINKTYPE_BLUETOOTH_HCI_H4_WITH_PHDR   201
+/// Synthetic connection handle used in the exported ACL packets.
+#define PCAP_CONNECTION_HANDLE   0x0001
+/// Synthetic attribute handle of the first characteristic value. Each characteristic uses a separate handle.
+#define PCAP_ATTRIBUTE_HANDLE_BASE   0x0010
+
+- (BOOL) exportPcap:(NSString*)file {
+    if (!self.valid)
+        return false;
+    NSFileHandle* handle = [self createOutput:file];
+    if (!handle)
+        return false;
+    NSMutableData* buffer = [NSMutableData data];
+    uint8_t header[24];
+    OSWriteLittleInt32(header, 0, 0xa1b2c3d4);
+    OSWriteLittleInt16(header, 4, 2);
+    OSWriteLittleInt16(header, 6, 4);
+    OSWriteLittleInt32(header, 8, 0);
+    OSWriteLittleInt32(header, 12, 0);
+    OSWriteLittleInt32(header, 16, 65535);
+    OSWriteLittleInt32(header, 20, PCAP_LINKTYPE_BLUETOOTH_HCI_H4_WITH_PHDR);
+    [buffer appendBytes:header length:sizeof(header)];
+
+    NSTimeInterval startTime = self.startTime;
+    __block BOOL ok = true;
+    [self enumerateRecords:^(NSTimeInterval time, int direction, int characteristic, NSData* data, BOOL* stop) {
+        // Pseudo-header (4), H4 type (1), ACL header (4), L2CAP header (4), ATT opcode and handle (3)
+        uint32_t attLength = 3 + (uint32_t) data.length;
+        uint32_t length = 4 + 1 + 4 + 4 + attLength;
+        NSTimeInterval timestamp = startTime + time;
+        uint8_t packet[16 + 16];
+        OSWriteLittleInt32(packet, 0, (uint32_t) timestamp);
+        OSWriteLittleInt32(packet, 4, (uint32_t) ((timestamp - floor(timestamp)) * 1000000));
+        OSWriteLittleInt32(packet, 8, length);
+        OSWriteLittleInt32(packet, 12, length);
+        OSWriteBigInt32(packet, 16, direction == DSPS_CAPTURE_RX ? 1 : 0);
+        packet[20] = 0x02; // ACL data
+        OSWriteLittleInt16(packet, 21, PCAP_CONNECTION_HANDLE | 0x2000);
+        OSWriteLittleInt16(packet, 23, 4 + attLength);
+        OSWriteLittleInt16(packet, 25, attLength);
+        OSWriteLittleInt16(packet, 27, 0x0004); // ATT
+        packet[29] = direction == DSPS_CAPTURE_RX ? 0x1b : 0x52; // Handle Value Notification, Write Command
+        OSWriteLittleInt16(packet, 30, PCAP_ATTRIBUTE_HANDLE_BASE + 2 * characteristic);
+        [buffer appendBytes:packet length:sizeof(packet)];
+        [buffer appendData:data];
+        if (!flushOutput(handle, buffer, false)) {
+            ok = false;
+            *stop = true;
+        }
+    }];
+    ok = ok && flushOutput(handle, buffer, true);
+    [handle closeFile];
+    return ok;
+}
+
+@end